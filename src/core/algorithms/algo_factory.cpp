@@ -9,6 +9,7 @@
 #include "core/algorithms/create_algorithm.h"
 #include "core/config/names.h"
 #include "core/config/tabular_data/input_tables_type.h"
+#include "core/parser/csv_parser/create_csv_stream.h"
 
 namespace algos {
 
@@ -46,7 +47,7 @@ void LoadAlgorithmData(Algorithm& algorithm, StdParamsMap const& options) {
     ConfigureFromFunction(algorithm, [&options](std::string_view option_name) {
         using namespace config::names;
         auto create_input_table = [](CSVConfig const& csv_config) -> config::InputTable {
-            return std::make_shared<CSVParser>(csv_config);
+            return CreateCSVStream(csv_config);
         };
 
         if (option_name == kTable && options.find(std::string{kTable}) == options.end()) {
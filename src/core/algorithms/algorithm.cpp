@@ -87,7 +87,26 @@ unsigned long long Algorithm::Execute() {
     if (!AllRequiredOptionsAreSet())
         throw std::logic_error("All options need to be set before execution.");
     ResetState();
-    auto time_ms = ExecuteInternal();
+    if (result_sink_ != nullptr) {
+        result_sink_->Start();
+    }
+    unsigned long long time_ms;
+    try {
+        time_ms = ExecuteInternal();
+    } catch (...) {
+        // Consumers waiting for the results must learn that there will be no more of them. The
+        // error of the execution is the one to report, not the one of the sink.
+        if (result_sink_ != nullptr) {
+            try {
+                result_sink_->Finish();
+            } catch (...) {
+            }
+        }
+        throw;
+    }
+    if (result_sink_ != nullptr) {
+        result_sink_->Finish();
+    }
     for (auto const& opt_name : available_options_) {
         possible_options_.at(opt_name)->Unset();
     }
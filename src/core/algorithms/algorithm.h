@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string_view>
 #include <typeindex>
 #include <unordered_map>
@@ -10,6 +11,7 @@
 
 #include <boost/any.hpp>
 
+#include "core/algorithms/result_sink.h"
 #include "core/config/ioption.h"
 #include "core/config/option.h"
 #include "core/model/table/idataset_stream.h"
@@ -28,6 +30,9 @@ private:
 
     bool data_loaded_ = false;
 
+    // Started and finished around every execution
+    std::shared_ptr<ResultSinkBase> result_sink_;
+
     // Clear the necessary fields for Execute to run repeatedly with different
     // configuration parameters on the same dataset.
     virtual void ResetState() = 0;
@@ -66,6 +71,12 @@ protected:
     // given through LoadData
     virtual void MakeExecuteOptsAvailable();
 
+    // Used by the SetResultSink methods of the bases of algorithms that mine a kind of
+    // dependencies
+    void SetResultSinkBase(std::shared_ptr<ResultSinkBase> sink) noexcept {
+        result_sink_ = std::move(sink);
+    }
+
 public:
     Algorithm(Algorithm const& other) = delete;
     Algorithm& operator=(Algorithm const& other) = delete;
@@ -60,7 +60,8 @@ util::WorkerThreadPool* FastADC::GetThreadPool() {
 
 void FastADC::LoadDataInternal() {
     // kMixed type will be treated as a string type
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, true, true);
+    typed_relation_ =
+            model::ColumnLayoutTypedRelationData::CreateCachedFrom(*input_table_, true, true);
 
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: DC mining is meaningless.");
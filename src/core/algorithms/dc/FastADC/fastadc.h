@@ -26,7 +26,7 @@ private:
     unsigned threads_;
 
     config::InputTable input_table_;
-    std::unique_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
 
     std::shared_ptr<PredicateIndexProvider> pred_index_provider_;
     PredicateProvider pred_provider_;
@@ -1,6 +1,11 @@
 #include "core/algorithms/fd/aidfd/aid.h"
 
+#include <algorithm>
+#include <optional>
+
+#include "core/config/names.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 
 namespace algos {
 
@@ -11,6 +16,11 @@ Aid::Aid() : FDAlgorithm() {
 
 void Aid::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void Aid::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::names::kThreads});
 }
 
 void Aid::LoadDataInternal() {
@@ -45,6 +55,7 @@ void Aid::ResetStateFd() {
     clusters_.assign(number_of_attributes_, std::unordered_map<size_t, Cluster>{});
     indices_in_clusters_.assign(number_of_attributes_, std::vector<size_t>(number_of_tuples_));
     constant_columns_.reset();
+    neg_cover_.clear();
     prev_ratios_.assign(kWindowSize, 1.0);
     sum_ = double{kWindowSize};
 }
@@ -52,11 +63,17 @@ void Aid::ResetStateFd() {
 unsigned long long Aid::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool.emplace(threads_num_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? &*pool : nullptr;
+
     BuildClusters();
 
-    CreateNegativeCover();
+    CreateNegativeCover(pool_ptr);
 
-    InvertNegativeCover();
+    InvertNegativeCover(pool_ptr);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -103,11 +120,41 @@ bool Aid::IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio) {
     return false;
 }
 
-void Aid::CreateNegativeCover() {
+void Aid::CreateNegativeCover(util::WorkerThreadPool* pool) {
+    size_t const num_blocks = (number_of_tuples_ + kTuplesPerBlock - 1) / kTuplesPerBlock;
+    size_t const window_size = pool == nullptr ? 1 : pool->ThreadNum() * kBlocksPerThread;
+    std::vector<std::vector<boost::dynamic_bitset<>>> block_agree_sets(window_size);
+
     size_t prev_neg_cover_size = 0;
     for (size_t index = 1;; ++index) {
-        for (size_t tuple_num = 0; tuple_num < number_of_tuples_; ++tuple_num) {
-            HandleTuple(tuple_num, index);
+        // neg_cover_ is only read while the agree sets of a window are built. The agree sets are
+        // added block by block afterwards, so neg_cover_ gets them in the same order as when the
+        // tuples are handled one after another.
+        for (size_t window_begin = 0; window_begin < num_blocks; window_begin += window_size) {
+            size_t const window_blocks = std::min(window_size, num_blocks - window_begin);
+            auto handle_block = [this, index, window_begin, &block_agree_sets](size_t block) {
+                std::vector<boost::dynamic_bitset<>>& agree_sets = block_agree_sets[block];
+                agree_sets.clear();
+                size_t const tuples_begin = (window_begin + block) * kTuplesPerBlock;
+                size_t const tuples_end =
+                        std::min(tuples_begin + kTuplesPerBlock, number_of_tuples_);
+                for (size_t tuple_num = tuples_begin; tuple_num < tuples_end; ++tuple_num) {
+                    HandleTuple(tuple_num, index, agree_sets);
+                }
+            };
+            if (pool == nullptr || window_blocks == 1) {
+                for (size_t block = 0; block < window_blocks; ++block) {
+                    handle_block(block);
+                }
+            } else {
+                pool->ExecIndex(handle_block, window_blocks);
+            }
+
+            for (size_t block = 0; block < window_blocks; ++block) {
+                for (auto& agree_set : block_agree_sets[block]) {
+                    neg_cover_.insert(std::move(agree_set));
+                }
+            }
         }
 
         size_t curr_neg_cover_size = neg_cover_.size();
@@ -127,7 +174,8 @@ void Aid::CreateNegativeCover() {
     }
 }
 
-void Aid::HandleTuple(size_t tuple_num, size_t iteration_num) {
+void Aid::HandleTuple(size_t tuple_num, size_t iteration_num,
+                      std::vector<boost::dynamic_bitset<>>& new_agree_sets) const {
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
         size_t value = tuples_[tuple_num][attr_num];
         Cluster const& cluster = clusters_[attr_num].at(value);
@@ -137,12 +185,14 @@ void Aid::HandleTuple(size_t tuple_num, size_t iteration_num) {
                     GenerateSecondClusterIndex(index_in_cluster, iteration_num);
             size_t another_tuple_num = cluster[another_index_in_cluster];
             auto tuples_agree_set = BuildAgreeSet(tuple_num, another_tuple_num);
-            neg_cover_.insert(tuples_agree_set);
+            if (!neg_cover_.contains(tuples_agree_set)) {
+                new_agree_sets.push_back(std::move(tuples_agree_set));
+            }
         }
     }
 }
 
-boost::dynamic_bitset<> Aid::BuildAgreeSet(size_t t1, size_t t2) {
+boost::dynamic_bitset<> Aid::BuildAgreeSet(size_t t1, size_t t2) const {
     boost::dynamic_bitset<> equal_attr(number_of_attributes_);
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
         if (tuples_[t1][attr_num] == tuples_[t2][attr_num]) {
@@ -166,7 +216,7 @@ void Aid::HandleConstantColumns(boost::dynamic_bitset<>& attributes) {
 }
 
 void Aid::HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTree& pos_cover_tree,
-                          size_t rhs) {
+                          size_t rhs) const {
     std::vector<boost::dynamic_bitset<>> subsets;
     pos_cover_tree.ForEachSubset(neg_cover_el, [&subsets](boost::dynamic_bitset<> const& subset) {
         subsets.push_back(subset);
@@ -192,7 +242,7 @@ void Aid::HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTre
     }
 }
 
-void Aid::InvertNegativeCover() {
+void Aid::InvertNegativeCover(util::WorkerThreadPool* pool) {
     boost::dynamic_bitset<> attributes(number_of_attributes_);
     attributes.set();
     HandleConstantColumns(attributes);
@@ -216,29 +266,55 @@ void Aid::InvertNegativeCover() {
         neg_cover_el = ChangeAttributesOrder(neg_cover_el, inv_attr_indices);
     }
 
+    // The positive covers of different right-hand sides are built independently
+    std::vector<std::vector<boost::dynamic_bitset<>>> pos_covers(number_of_attributes_);
+    auto invert_for_rhs = [this, &attributes, &neg_cover_vector, &pos_covers](size_t rhs) {
+        if (constant_columns_[rhs]) {
+            return;
+        }
+
+        boost::dynamic_bitset<> lhs_attributes = attributes;
+        lhs_attributes[rhs] = false;
+        pos_covers[rhs] = InvertForRhs(rhs, lhs_attributes, neg_cover_vector);
+    };
+    if (pool == nullptr) {
+        for (size_t rhs = 0; rhs < number_of_attributes_; ++rhs) {
+            invert_for_rhs(rhs);
+        }
+    } else {
+        pool->ExecIndex(invert_for_rhs, number_of_attributes_);
+    }
+
     for (size_t rhs = 0; rhs < number_of_attributes_; ++rhs) {
         if (constant_columns_[rhs]) {
             continue;
         }
 
-        attributes[rhs] = false;
-        SearchTree pos_cover_tree(attributes);
-        for (auto const& neg_cover_el : neg_cover_vector) {
-            if (!neg_cover_el[rhs]) {
-                HandleInvalidFd(neg_cover_el, pos_cover_tree, rhs);
-            }
+        std::vector<boost::dynamic_bitset<>> pos_cover_vector;
+        pos_cover_vector.reserve(pos_covers[rhs].size());
+        for (auto const& pos_cover_el : pos_covers[rhs]) {
+            pos_cover_vector.push_back(ChangeAttributesOrder(pos_cover_el, attr_indices));
         }
 
-        size_t real_rhs = attr_indices[rhs];
-        std::vector<boost::dynamic_bitset<>> pos_cover_vector;
-        pos_cover_tree.ForEach(
-                [&pos_cover_vector, &attr_indices](boost::dynamic_bitset<> const& pos_cover_el) {
-                    pos_cover_vector.push_back(ChangeAttributesOrder(pos_cover_el, attr_indices));
-                });
+        RegisterFDs(attr_indices[rhs], pos_cover_vector);
+    }
+}
 
-        RegisterFDs(real_rhs, pos_cover_vector);
-        attributes[rhs] = true;
+std::vector<boost::dynamic_bitset<>> Aid::InvertForRhs(
+        size_t rhs, boost::dynamic_bitset<> const& attributes,
+        std::vector<boost::dynamic_bitset<>> const& neg_cover_vector) const {
+    SearchTree pos_cover_tree(attributes);
+    for (auto const& neg_cover_el : neg_cover_vector) {
+        if (!neg_cover_el[rhs]) {
+            HandleInvalidFd(neg_cover_el, pos_cover_tree, rhs);
+        }
     }
+
+    std::vector<boost::dynamic_bitset<>> pos_cover_vector;
+    pos_cover_tree.ForEach([&pos_cover_vector](boost::dynamic_bitset<> const& pos_cover_el) {
+        pos_cover_vector.push_back(pos_cover_el);
+    });
+    return pos_cover_vector;
 }
 
 void Aid::RegisterFDs(size_t rhs_attribute,
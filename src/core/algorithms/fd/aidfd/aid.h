@@ -3,23 +3,28 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "core/algorithms/fd/aidfd/search_tree.h"
 #include "core/algorithms/fd/fd_algorithm.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
 #include "core/model/table/relational_schema.h"
 #include "core/model/table/vertical.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
 class Aid : public FDAlgorithm {
 private:
     using Cluster = std::vector<size_t>;
+    using AgreeSets = std::unordered_set<boost::dynamic_bitset<>>;
 
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_ = 1;
 
     std::shared_ptr<RelationalSchema> schema_{};
     std::vector<std::vector<size_t>> tuples_;
@@ -27,11 +32,15 @@ private:
     size_t number_of_attributes_{};
     size_t number_of_tuples_{};
 
-    std::unordered_set<boost::dynamic_bitset<>> neg_cover_{};
+    AgreeSets neg_cover_{};
 
     constexpr static double const kGrowthThreshold = 0.01;
     constexpr static size_t const kWindowSize = 10;
     constexpr static size_t const kPrime = 10619863;
+    // The tuples of a sampling iteration are handled in blocks of kTuplesPerBlock, the agree sets
+    // of kBlocksPerThread blocks per thread are collected before they are added to neg_cover_.
+    constexpr static size_t const kTuplesPerBlock = 256;
+    constexpr static size_t const kBlocksPerThread = 4;
 
     std::vector<double> prev_ratios_;
     double sum_{};
@@ -42,6 +51,7 @@ private:
     boost::dynamic_bitset<> constant_columns_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final;
 
@@ -49,12 +59,19 @@ private:
     unsigned long long ExecuteInternal() final;
 
     void BuildClusters();
-    void CreateNegativeCover();
-    void InvertNegativeCover();
-
-    void HandleTuple(size_t tuple_num, size_t index);
+    // pool is nullptr when a single thread is used
+    void CreateNegativeCover(util::WorkerThreadPool* pool);
+    void InvertNegativeCover(util::WorkerThreadPool* pool);
+
+    // Appends the agree sets that are not in the negative cover yet to new_agree_sets
+    void HandleTuple(size_t tuple_num, size_t iteration_num,
+                     std::vector<boost::dynamic_bitset<>>& new_agree_sets) const;
+    // Positive cover for rhs in the attribute order of neg_cover_vector, attributes has rhs unset
+    std::vector<boost::dynamic_bitset<>> InvertForRhs(
+            size_t rhs, boost::dynamic_bitset<> const& attributes,
+            std::vector<boost::dynamic_bitset<>> const& neg_cover_vector) const;
     void HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTree& pos_cover_tree,
-                         size_t rhs);
+                         size_t rhs) const;
     size_t GenerateSecondClusterIndex(size_t index_in_cluster, size_t iteration_num) const;
     bool IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio);
 
@@ -66,7 +83,7 @@ private:
     std::vector<size_t> GetAttributesSortedByFrequency(
             std::vector<boost::dynamic_bitset<>> const& neg_cover_vector) const;
 
-    boost::dynamic_bitset<> BuildAgreeSet(size_t t1, size_t t2);
+    boost::dynamic_bitset<> BuildAgreeSet(size_t t1, size_t t2) const;
 
 public:
     Aid();
@@ -1,27 +1,51 @@
 #include "core/algorithms/fd/dfd/dfd.h"
 
+#include <cstdint>
+
 #include <boost/asio.hpp>
 
 #include "core/algorithms/fd/dfd/lattice_traversal/lattice_traversal.h"
+#include "core/config/checkpoint/option.h"
+#include "core/config/flat_pli/option.h"
 #include "core/config/max_lhs/option.h"
+#include "core/config/mem_limit/option.h"
+#include "core/config/memory_budget/option.h"
 #include "core/config/thread_number/option.h"
+#include "core/config/time_limit/option.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/position_list_index.h"
 #include "core/model/table/relational_schema.h"
+#include "core/util/checkpoint_file.h"
 #include "core/util/logger.h"
 
 namespace algos {
 
+namespace {
+// The only kind of the checkpoint records: the index of an RHS whose search space has been
+// traversed, then the LHSs of the minimal FDs with it
+constexpr std::uint32_t kRhsRecord = 0;
+}  // namespace
+
 DFD::DFD() : PliBasedFDAlgorithm() {
     RegisterOptions();
+    UseThreadsForLoading(&number_of_threads_);
 }
 
 void DFD::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&number_of_threads_));
+    RegisterOption(config::kFlatPliOpt(&flat_pli_));
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
+    RegisterOption(config::kMemoryBudgetMbOpt(&memory_budget_mb_));
+    RegisterOption(config::kCheckpointPathOpt(&checkpoint_path_));
 }
 
 void DFD::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName(), config::kFlatPliOpt.GetName(),
+                          config::kTimeLimitSecondsOpt.GetName(),
+                          config::kMemLimitMbOpt.GetName(),
+                          config::kMemoryBudgetMbOpt.GetName(),
+                          config::kCheckpointPathOpt.GetName()});
 }
 
 void DFD::ResetStateFd() {
@@ -29,10 +53,16 @@ void DFD::ResetStateFd() {
 }
 
 unsigned long long DFD::ExecuteInternal() {
-    auto partition_storage = std::make_unique<PartitionStorage>(relation_.get());
+    // The cached partitions are evicted to stay within mem_limit, memory_budget stops the search
+    // if the rest of its state outgrows it
+    auto partition_storage = std::make_unique<PartitionStorage>(
+            relation_.get(), flat_pli_, static_cast<std::size_t>(mem_limit_mb_) << 20);
     RelationalSchema const* const schema = relation_->GetSchema();
 
     auto start_time = std::chrono::system_clock::now();
+    util::CancellationToken& cancellation_token = GetCancellationToken();
+    cancellation_token.Start(std::chrono::seconds(time_limit_seconds_),
+                             static_cast<std::size_t>(memory_budget_mb_) << 20);
 
     // search for unique columns
     for (auto const& column : schema->GetColumns()) {
@@ -46,10 +76,43 @@ unsigned long long DFD::ExecuteInternal() {
         }
     }
 
+    // Every RHS is saved as soon as its search space is traversed, so there are no snapshots
+    std::unique_ptr<util::CheckpointFile> checkpoint = OpenCheckpoint(checkpoint_path_, 0, "dfd");
+    boost::dynamic_bitset<> done_rhss(schema->GetNumColumns());
+    if (checkpoint != nullptr) {
+        for (util::CheckpointFile::Record const& record : checkpoint->GetRecords()) {
+            util::CheckpointDecoder decoder{record.payload};
+            auto const rhs_index = decoder.Read<std::uint32_t>();
+            done_rhss.set(rhs_index);
+            while (!decoder.AtEnd()) {
+                RegisterFd(decoder.ReadBitset(), rhs_index, relation_->GetSharedPtrSchema());
+            }
+        }
+        if (done_rhss.any()) {
+            LOG_INFO("Resuming with {} of {} RHSs done", done_rhss.count(), done_rhss.size());
+        }
+    }
+    auto save_rhs = [&checkpoint, &cancellation_token](Column const& rhs, auto const& lhss) {
+        // The LHSs found by a cancelled traversal may be not all of them
+        if (checkpoint == nullptr || cancellation_token.WasCancelled()) return;
+        util::CheckpointEncoder encoder;
+        encoder.Write<std::uint32_t>(rhs.GetIndex());
+        for (Vertical const& lhs : lhss) {
+            encoder.Write(lhs.GetColumnIndices());
+        }
+        checkpoint->Append(kRhsRecord, encoder.Release());
+    };
+
     boost::asio::thread_pool search_space_pool(number_of_threads_);
 
     for (auto& rhs : schema->GetColumns()) {
-        boost::asio::post(search_space_pool, [this, &rhs, schema, &partition_storage]() {
+        if (done_rhss[rhs->GetIndex()]) continue;
+        boost::asio::post(search_space_pool, [this, &rhs, schema, &partition_storage,
+                                              &cancellation_token, &save_rhs]() {
+            if (cancellation_token.IsCancelled()) {
+                return;
+            }
+
             ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
             model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
 
@@ -59,20 +122,25 @@ unsigned long long DFD::ExecuteInternal() {
              * */
             if (rhs_pli->GetNepAsLong() == relation_->GetNumTuplePairs()) {
                 RegisterFd(schema->CreateEmptyVertical(), *rhs, relation_->GetSharedPtrSchema());
+                save_rhs(*rhs, std::vector{schema->CreateEmptyVertical()});
                 return;
             }
 
             auto search_space = LatticeTraversal(rhs.get(), relation_.get(), unique_columns_,
-                                                 partition_storage.get());
+                                                 partition_storage.get(), cancellation_token);
             auto const minimal_deps = search_space.FindLHSs();
 
             for (auto const& minimal_dependency_lhs : minimal_deps) {
                 RegisterFd(minimal_dependency_lhs, *rhs, relation_->GetSharedPtrSchema());
             }
+            save_rhs(*rhs, minimal_deps);
         });
     }
 
     search_space_pool.join();
+    if (checkpoint != nullptr && IsComplete()) {
+        checkpoint->Remove();
+    }
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
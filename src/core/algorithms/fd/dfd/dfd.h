@@ -5,7 +5,12 @@
 
 #include "core/algorithms/fd/dfd/partition_storage/partition_storage.h"
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
+#include "core/config/checkpoint/type.h"
+#include "core/config/flat_pli/type.h"
+#include "core/config/mem_limit/type.h"
+#include "core/config/memory_budget/type.h"
 #include "core/config/thread_number/type.h"
+#include "core/config/time_limit/type.h"
 #include "core/model/table/vertical.h"
 
 namespace algos {
@@ -15,6 +20,11 @@ private:
     std::vector<Vertical> unique_columns_;
 
     config::ThreadNumType number_of_threads_;
+    config::FlatPliType flat_pli_;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::MemLimitMBType mem_limit_mb_;
+    config::MemoryBudgetMBType memory_budget_mb_ = 0;
+    config::CheckpointPathType checkpoint_path_;
 
     void MakeExecuteOptsAvailableFDInternal() final;
     void RegisterOptions();
@@ -9,6 +9,7 @@
 #include "core/algorithms/fd/dfd/pruning_maps/dependencies_map.h"
 #include "core/algorithms/fd/dfd/pruning_maps/non_dependencies_map.h"
 #include "core/model/table/vertical.h"
+#include "core/util/cancellation_token.h"
 
 class LatticeTraversal {
 private:
@@ -25,6 +26,7 @@ private:
     std::vector<Vertical> const& unique_columns_;
     ColumnLayoutRelationData const* const relation_;
     PartitionStorage* const partition_storage_;
+    util::CancellationToken& cancellation_token_;
 
     std::random_device rd_;
     std::mt19937 gen_;
@@ -41,7 +43,9 @@ private:
 public:
     LatticeTraversal(Column const* const rhs, ColumnLayoutRelationData const* const relation,
                      std::vector<Vertical> const& unique_verticals,
-                     PartitionStorage* const partition_storage);
+                     PartitionStorage* const partition_storage,
+                     util::CancellationToken& cancellation_token);
 
+    // Stops early if the token is cancelled, returning the minimal LHSs found by then
     std::unordered_set<Vertical> FindLHSs();
 };
@@ -1,50 +1,151 @@
 #include "core/algorithms/fd/dfd/partition_storage/partition_storage.h"
 
-#include <boost/format.hpp>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <vector>
+
 #include <boost/optional.hpp>
 
 #include "core/model/table/vertical_map.h"
 #include "core/util/logger.h"
 
-model::PositionListIndex* PartitionStorage::Get(Vertical const& vertical) {
-    return index_->Get(vertical).get();
+std::shared_ptr<model::PositionListIndex> PartitionStorage::Get(Vertical const& vertical) {
+    return store_->index.Get(vertical);
 }
 
-PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data)
-    : relation_data_(relation_data),
-      index_(std::make_unique<model::BlockingVerticalMap<model::PositionListIndex>>(
-              relation_data->GetSchema())) {
+PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data, bool flat_pli,
+                                   std::size_t budget_bytes)
+    : relation_data_(relation_data), budget_(budget_bytes) {
+    if (flat_pli) {
+        flat_arena_ = std::make_unique<std::pmr::synchronized_pool_resource>();
+        flat_store_ = std::make_unique<Store<model::FlatPositionListIndex>>(
+                relation_data->GetSchema());
+        for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
+            model::PositionListIndex const* column_pli =
+                    relation_data->GetColumnData(column_ptr->GetIndex()).GetPositionListIndex();
+            flat_store_->index.Put(static_cast<Vertical>(*column_ptr),
+                                   model::FlatPositionListIndex::CreateFrom(*column_pli,
+                                                                            flat_arena_.get()));
+        }
+        return;
+    }
+    store_ = std::make_unique<Store<model::PositionListIndex>>(relation_data->GetSchema());
     for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
-        index_->Put(static_cast<Vertical>(*column_ptr),
-                    relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
+        store_->index.Put(static_cast<Vertical>(*column_ptr),
+                          relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
     }
 }
 
-PartitionStorage::~PartitionStorage() {}
+PartitionStorage::~PartitionStorage() {
+    // The partitions have to go before the arena they are allocated from
+    flat_store_.reset();
+}
+
+std::shared_ptr<model::PositionListIndex> PartitionStorage::GetOrCreateFor(
+        Vertical const& vertical) {
+    assert(!IsFlat());
+    return GetOrCreateIn(*store_, vertical);
+}
+
+std::shared_ptr<model::FlatPositionListIndex> PartitionStorage::GetOrCreateFlatFor(
+        Vertical const& vertical) {
+    assert(IsFlat());
+    return GetOrCreateIn(*flat_store_, vertical);
+}
+
+unsigned long long PartitionStorage::GetOrCreateNepFor(Vertical const& vertical) {
+    if (IsFlat()) {
+        return GetOrCreateFlatFor(vertical)->GetNepAsLong();
+    }
+    return GetOrCreateIn(*store_, vertical)->GetNepAsLong();
+}
+
+std::unique_ptr<model::PositionListIndex> PartitionStorage::Intersect(
+        model::PositionListIndex const& pli, model::PositionListIndex const& that) {
+    return pli.Intersect(&that);
+}
+
+std::unique_ptr<model::FlatPositionListIndex> PartitionStorage::Intersect(
+        model::FlatPositionListIndex const& pli, model::FlatPositionListIndex const& that) {
+    return pli.Intersect(that, flat_arena_.get());
+}
+
+std::unique_ptr<model::PositionListIndex> PartitionStorage::ProbeAll(
+        model::PositionListIndex& pli, Vertical const& probing_columns) {
+    return pli.ProbeAll(probing_columns, *relation_data_);
+}
+
+std::unique_ptr<model::FlatPositionListIndex> PartitionStorage::ProbeAll(
+        model::FlatPositionListIndex& pli, Vertical const& probing_columns) {
+    return pli.ProbeAll(probing_columns, *relation_data_, flat_arena_.get());
+}
+
+template <typename Pli>
+auto PartitionStorage::GetShard(Store<Pli>& store, Vertical const& vertical) -> Shard<Pli>& {
+    return store.shards[std::hash<Vertical>{}(vertical) % kShardNumber];
+}
 
 // obtains or calculates a PositionListIndex using cache
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
-    std::scoped_lock lock(getting_pli_mutex_);
+template <typename Pli>
+std::shared_ptr<Pli> PartitionStorage::GetOrCreateIn(Store<Pli>& store, Vertical const& vertical) {
     LOG_DEBUG("PLI for {} requested: ", vertical.ToString());
+    if (vertical.GetArity() == 1) {
+        // Partitions of single columns are never evicted
+        budget_.CountHit();
+        return store.index.Get(vertical);
+    }
+
+    Shard<Pli>& shard = GetShard(store, vertical);
+    std::promise<std::shared_ptr<Pli>> promise;
+    {
+        std::unique_lock lock(shard.mutex);
+        if (auto it = shard.cached.find(vertical); it != shard.cached.end()) {
+            it->second.last_use = ++use_clock_;
+            budget_.CountHit();
+            LOG_DEBUG("Served from PLI cache.");
+            return it->second.pli;
+        }
+        auto [it, is_first] = shard.in_flight.try_emplace(vertical);
+        if (!is_first) {
+            std::shared_future<std::shared_ptr<Pli>> const computed = it->second;
+            lock.unlock();
+            budget_.CountHit();
+            LOG_DEBUG("Waiting for another thread to compute the PLI.");
+            return computed.get();
+        }
+        it->second = promise.get_future().share();
+    }
+    budget_.CountMiss();
 
-    // is PLI already cached?
-    model::PositionListIndex* pli = Get(vertical);
-    if (pli != nullptr) {
-        pli->IncFreq();
-        LOG_DEBUG("Served from PLI cache.");
-        // addToUsageCounter
-        return pli;
+    std::shared_ptr<Pli> pli;
+    try {
+        pli = Create(store, vertical);
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::scoped_lock lock(shard.mutex);
+        shard.in_flight.erase(vertical);
+        throw;
     }
+    promise.set_value(pli);
+    // The partition has been cached by then, the threads that come after find it there
+    std::scoped_lock lock(shard.mutex);
+    shard.in_flight.erase(vertical);
+    return pli;
+}
+
+template <typename Pli>
+std::shared_ptr<Pli> PartitionStorage::Create(Store<Pli>& store, Vertical const& vertical) {
     // look for cached PLIs to construct the requested one
-    auto subset_entries = index_->GetSubsetEntries(vertical);
-    boost::optional<PositionListIndexRank> smallest_pli_rank;
-    std::vector<PositionListIndexRank> ranks;
+    auto subset_entries = store.index.GetSubsetEntries(vertical);
+    boost::optional<PositionListIndexRank<Pli>> smallest_pli_rank;
+    std::vector<PositionListIndexRank<Pli>> ranks;
     ranks.reserve(subset_entries.size());
     for (auto& [sub_vertical, sub_pli_ptr] : subset_entries) {
-        PositionListIndexRank pli_rank(
-                &sub_vertical, std::const_pointer_cast<model::PositionListIndex>(sub_pli_ptr),
-                sub_vertical.GetArity());
+        PositionListIndexRank<Pli> pli_rank(&sub_vertical,
+                                            std::const_pointer_cast<Pli>(sub_pli_ptr),
+                                            sub_vertical.GetArity());
         ranks.push_back(pli_rank);
         if (!smallest_pli_rank || smallest_pli_rank->pli_->GetSize() > pli_rank.pli_->GetSize() ||
             (smallest_pli_rank->pli_->GetSize() == pli_rank.pli_->GetSize() &&
@@ -54,16 +155,15 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     }
     assert(smallest_pli_rank);  // check if smallest_pli_rank is initialized
 
-    std::vector<PositionListIndexRank> operands;
+    std::vector<PositionListIndexRank<Pli>> operands;
     boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
     boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
     if (smallest_pli_rank) {
-        smallest_pli_rank->pli_->IncFreq();
         operands.push_back(*smallest_pli_rank);
         cover |= smallest_pli_rank->vertical_->GetColumnIndices();
 
         while (cover.count() < vertical.GetArity() && !ranks.empty()) {
-            boost::optional<PositionListIndexRank> best_rank;
+            boost::optional<PositionListIndexRank<Pli>> best_rank;
             // erase ranks with low added_arity_
             ranks.erase(std::remove_if(ranks.begin(), ranks.end(),
                                        [&cover_tester, &cover](auto& rank) {
@@ -84,7 +184,6 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             }
 
             if (best_rank) {
-                best_rank->pli_->IncFreq();
                 operands.push_back(*best_rank);
                 cover |= best_rank->vertical_->GetColumnIndices();
             }
@@ -96,9 +195,8 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     for (auto& column : vertical.GetColumns()) {
         if (!cover[column->GetIndex()]) {
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
-            auto column_pli = index_->Get(**vertical_columns.rbegin());
+            auto column_pli = store.index.Get(**vertical_columns.rbegin());
             operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
-            column_pli->IncFreq();
         }
     }
     // sort operands by ascending order
@@ -112,46 +210,84 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     }
 
     // Intersect and cache
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-            variant_intersection_pli;
+    std::shared_ptr<Pli> intersection_pli;
     if (operands.size() >= 4) {
-        PositionListIndexRank base_pli_rank = operands[0];
-        auto intersection_pli = base_pli_rank.pli_->ProbeAll(
-                vertical.Without(*base_pli_rank.vertical_), *relation_data_);
-        variant_intersection_pli = CachingProcess(vertical, std::move(intersection_pli));
+        PositionListIndexRank<Pli> base_pli_rank = operands[0];
+        auto probed_pli =
+                ProbeAll(*base_pli_rank.pli_, vertical.Without(*base_pli_rank.vertical_));
+        intersection_pli = CachingProcess(store, vertical, std::move(probed_pli));
     } else {
         Vertical current_vertical = *operands.begin()->vertical_;
-        variant_intersection_pli = operands.begin()->pli_.get();
+        intersection_pli = operands.begin()->pli_;
 
         for (size_t i = 1; i < operands.size(); i++) {
             current_vertical = current_vertical.Union(*operands[i].vertical_);
-            variant_intersection_pli =
-                    std::holds_alternative<model::PositionListIndex*>(variant_intersection_pli)
-                            ? std::get<model::PositionListIndex*>(variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get())
-                            : std::get<std::unique_ptr<model::PositionListIndex>>(
-                                      variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get());
-            variant_intersection_pli = CachingProcess(
-                    current_vertical, std::move(std::get<std::unique_ptr<model::PositionListIndex>>(
-                                              variant_intersection_pli)));
+            intersection_pli = CachingProcess(store, current_vertical,
+                                              Intersect(*intersection_pli, *operands[i].pli_));
         }
     }
 
     LOG_DEBUG("Calculated from {} sub-PLIs (saved {} intersections).", operands.size(),
               (vertical.GetArity() - operands.size()));
 
-    return variant_intersection_pli;
+    return intersection_pli;
 }
 
 size_t PartitionStorage::Size() const {
-    return index_->GetSize();
+    return IsFlat() ? flat_store_->index.GetSize() : store_->index.GetSize();
 }
 
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::CachingProcess(Vertical const& vertical,
-                                 std::unique_ptr<model::PositionListIndex> pli) {
-    auto pli_pointer = pli.get();
-    index_->Put(vertical, std::move(pli));
-    return pli_pointer;
+PartitionStorage::Stats PartitionStorage::GetStats() const {
+    return budget_.GetStats();
+}
+
+template <typename Pli>
+std::shared_ptr<Pli> PartitionStorage::CachingProcess(Store<Pli>& store, Vertical const& vertical,
+                                                      std::unique_ptr<Pli> pli) {
+    std::shared_ptr<Pli> cached_pli = std::move(pli);
+    std::size_t const bytes = cached_pli->EstimateBytes();
+    {
+        Shard<Pli>& shard = GetShard(store, vertical);
+        std::scoped_lock lock(shard.mutex);
+        auto [it, inserted] = shard.cached.try_emplace(
+                vertical, typename Shard<Pli>::CachedEntry{cached_pli, bytes, ++use_clock_});
+        // Another thread has cached the same intermediate partition meanwhile
+        if (!inserted) return it->second.pli;
+        store.index.Put(vertical, cached_pli);
+    }
+    if (budget_.Admit(bytes)) {
+        EvictOverBudget(store);
+    }
+    return cached_pli;
+}
+
+template <typename Pli>
+void PartitionStorage::EvictOverBudget(Store<Pli>& store) {
+    std::unique_lock eviction_lock(eviction_mutex_, std::try_to_lock);
+    if (!eviction_lock.owns_lock()) return;
+
+    struct Candidate {
+        Vertical vertical;
+        std::uint64_t last_use;
+    };
+    std::vector<Candidate> candidates;
+    for (Shard<Pli>& shard : store.shards) {
+        std::scoped_lock lock(shard.mutex);
+        for (auto const& [vertical, entry] : shard.cached) {
+            candidates.push_back({vertical, entry.last_use});
+        }
+    }
+    std::ranges::sort(candidates, std::less<>{}, &Candidate::last_use);
+
+    budget_.Evict(candidates, [&](Candidate const& candidate) -> std::optional<std::size_t> {
+        Shard<Pli>& shard = GetShard(store, candidate.vertical);
+        std::scoped_lock lock(shard.mutex);
+        auto it = shard.cached.find(candidate.vertical);
+        if (it == shard.cached.end()) return std::nullopt;
+        LOG_DEBUG("Evicting PLI for {} from the storage.", candidate.vertical.ToString());
+        std::size_t const bytes = it->second.bytes;
+        store.index.Remove(candidate.vertical);
+        shard.cached.erase(it);
+        return bytes;
+    });
 }
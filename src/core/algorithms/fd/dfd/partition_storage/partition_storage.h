@@ -1,39 +1,130 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <unordered_map>
 
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/flat_position_list_index.h"
 #include "core/model/table/vertical_map.h"
+#include "core/util/cache_budget.h"
 
+/// Partitions of column combinations shared by the lattice traversals of DFD, which run on
+/// several threads.
+///
+/// Cached partitions are looked up in one of kShardNumber shards chosen by the hash of the column
+/// combination, so threads asking for different partitions do not contend. A partition that is
+/// being computed is not computed again: the other threads asking for it wait for the first one.
+/// Once the estimated size of the cached multi-column partitions exceeds the budget, the least
+/// recently used ones are evicted. The partitions are shared, so evicting one does not free it
+/// under its users.
 class PartitionStorage {
+public:
+    /// Waiting for another thread to compute the partition counts as a hit, sizes are those of
+    /// the cached multi-column partitions
+    using Stats = util::CacheBudget::Stats;
+
 private:
+    template <typename Pli>
     class PositionListIndexRank {
     public:
         Vertical const* vertical_;
-        std::shared_ptr<model::PositionListIndex> pli_;
+        std::shared_ptr<Pli> pli_;
         int added_arity_;
 
-        PositionListIndexRank(Vertical const* vertical,
-                              std::shared_ptr<model::PositionListIndex> pli, int initial_arity)
+        PositionListIndexRank(Vertical const* vertical, std::shared_ptr<Pli> pli,
+                              int initial_arity)
             : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
     };
 
+    static constexpr std::size_t kShardNumber = 64;
+
+    template <typename Pli>
+    struct Shard {
+        struct CachedEntry {
+            std::shared_ptr<Pli> pli;
+            std::size_t bytes;
+            std::uint64_t last_use;
+        };
+
+        std::mutex mutex;
+        std::unordered_map<Vertical, CachedEntry> cached;
+        std::unordered_map<Vertical, std::shared_future<std::shared_ptr<Pli>>> in_flight;
+    };
+
+    // Partitions of one layout. The map only serves to find the cached subsets of a column
+    // combination, the shards are the ones to look a partition up in.
+    template <typename Pli>
+    struct Store {
+        model::BlockingVerticalMap<Pli> index;
+        std::array<Shard<Pli>, kShardNumber> shards;
+
+        explicit Store(RelationalSchema const* schema) : index(schema) {}
+    };
+
     ColumnLayoutRelationData* relation_data_;
-    std::unique_ptr<model::VerticalMap<model::PositionListIndex>> index_;
+    std::unique_ptr<Store<model::PositionListIndex>> store_;
+    // Used instead of store_ if the partitions are stored in the flat layout
+    std::unique_ptr<std::pmr::synchronized_pool_resource> flat_arena_;
+    std::unique_ptr<Store<model::FlatPositionListIndex>> flat_store_;
+
+    util::CacheBudget budget_;
+    // Stamps the cached partitions when they are used, the least recent one has the lowest stamp
+    std::atomic<std::uint64_t> use_clock_ = 0;
+    // Only one thread evicts at a time, the others go on while it does
+    std::mutex eviction_mutex_;
+
+    template <typename Pli>
+    static Shard<Pli>& GetShard(Store<Pli>& store, Vertical const& vertical);
+    template <typename Pli>
+    std::shared_ptr<Pli> GetOrCreateIn(Store<Pli>& store, Vertical const& vertical);
+    template <typename Pli>
+    std::shared_ptr<Pli> Create(Store<Pli>& store, Vertical const& vertical);
 
-    mutable std::mutex getting_pli_mutex_;
+    std::unique_ptr<model::PositionListIndex> Intersect(model::PositionListIndex const& pli,
+                                                        model::PositionListIndex const& that);
+    std::unique_ptr<model::FlatPositionListIndex> Intersect(
+            model::FlatPositionListIndex const& pli, model::FlatPositionListIndex const& that);
+    std::unique_ptr<model::PositionListIndex> ProbeAll(model::PositionListIndex& pli,
+                                                       Vertical const& probing_columns);
+    std::unique_ptr<model::FlatPositionListIndex> ProbeAll(model::FlatPositionListIndex& pli,
+                                                           Vertical const& probing_columns);
 
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    CachingProcess(Vertical const& vertical, std::unique_ptr<model::PositionListIndex> pli);
+    template <typename Pli>
+    std::shared_ptr<Pli> CachingProcess(Store<Pli>& store, Vertical const& vertical,
+                                        std::unique_ptr<Pli> pli);
+    template <typename Pli>
+    void EvictOverBudget(Store<Pli>& store);
 
 public:
-    PartitionStorage(ColumnLayoutRelationData* relation_data);
+    /// With `flat_pli` the partitions of column combinations are kept as FlatPositionListIndex
+    /// allocated from an arena of the storage, only GetOrCreateFlatFor and GetOrCreateNepFor can
+    /// be used then. While the estimated size of the cached multi-column partitions exceeds
+    /// `budget_bytes`, the least recently used ones are evicted.
+    explicit PartitionStorage(ColumnLayoutRelationData* relation_data, bool flat_pli = false,
+                              std::size_t budget_bytes = std::numeric_limits<std::size_t>::max());
 
-    model::PositionListIndex* Get(Vertical const& vertical);
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    GetOrCreateFor(Vertical const& vertical);
+    std::shared_ptr<model::PositionListIndex> Get(Vertical const& vertical);
+    std::shared_ptr<model::PositionListIndex> GetOrCreateFor(Vertical const& vertical);
+    std::shared_ptr<model::FlatPositionListIndex> GetOrCreateFlatFor(Vertical const& vertical);
+
+    /// Number of equal pairs of the partition of `vertical`, works with both layouts.
+    unsigned long long GetOrCreateNepFor(Vertical const& vertical);
+
+    bool IsFlat() const noexcept {
+        return flat_store_ != nullptr;
+    }
 
     size_t Size() const;
 
+    Stats GetStats() const;
+
     virtual ~PartitionStorage();
 };
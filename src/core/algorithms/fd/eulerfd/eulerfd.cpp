@@ -1,11 +1,16 @@
 #include "core/algorithms/fd/eulerfd/eulerfd.h"
 
+#include <optional>
+
+#include "core/config/thread_number/option.h"
+
 namespace algos {
 
 EulerFD::EulerFD() : FDAlgorithm(), mlfq_(kQueuesNumber) {
     last_ncover_ratios_.fill(1);
     last_pcover_ratios_.fill(1);
     RegisterOption(config::kCustomRandomFlagOpt(&custom_random_opt_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 
     // Set configuration options
     RegisterOption(config::kTableOpt(&input_table_));
@@ -16,7 +21,8 @@ EulerFD::EulerFD() : FDAlgorithm(), mlfq_(kQueuesNumber) {
 }
 
 void EulerFD::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kCustomRandomFlagOpt.GetName()});
+    MakeOptionsAvailable(
+            {config::kCustomRandomFlagOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void EulerFD::LoadDataInternal() {
@@ -171,30 +177,70 @@ EulerFD::Bitset EulerFD::BuildAgreeSet(size_t t1, size_t t2) const {
     return equal_attr;
 }
 
-double EulerFD::SamplingInCluster(Cluster* cluster) {
-    return cluster->Sample([this](size_t t1, size_t t2) -> size_t {
+double EulerFD::SamplingInCluster(Cluster* cluster, std::vector<Bitset>& new_agree_sets) const {
+    std::unordered_set<Bitset> sampled;
+    return cluster->Sample([this, &sampled, &new_agree_sets](size_t t1, size_t t2) -> size_t {
         Bitset agree_set = BuildAgreeSet(t1, t2);
-        auto&& [_, result] = invalids_.insert(agree_set);
 
         // Check that this is a new FD
-        if (result) {
-            new_invalids_.insert(agree_set);
-            return agree_set.size() - agree_set.count();
-        } else {
+        if (invalids_.contains(agree_set) || !sampled.insert(agree_set).second) {
             return 0;
         }
+        size_t const not_agreeing = agree_set.size() - agree_set.count();
+        new_agree_sets.push_back(std::move(agree_set));
+        return not_agreeing;
     });
 }
 
-void EulerFD::Sampling() {
+std::vector<double> EulerFD::SamplingInClusters(std::vector<Cluster*> const& clusters,
+                                                util::WorkerThreadPool* pool) {
+    // invalids_ is only read while the clusters are sampled, so an agree set that is new to
+    // several clusters of a batch counts in the effect of each of them
+    std::vector<std::vector<Bitset>> new_agree_sets(clusters.size());
+    std::vector<double> effects(clusters.size());
+    auto sample = [this, &clusters, &new_agree_sets, &effects](size_t i) {
+        effects[i] = SamplingInCluster(clusters[i], new_agree_sets[i]);
+    };
+    if (pool == nullptr || clusters.size() == 1) {
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            sample(i);
+        }
+    } else {
+        pool->ExecIndex(sample, clusters.size());
+    }
+
+    for (std::vector<Bitset>& cluster_agree_sets : new_agree_sets) {
+        for (Bitset& agree_set : cluster_agree_sets) {
+            auto [it, inserted] = invalids_.insert(std::move(agree_set));
+            if (inserted) {
+                new_invalids_.insert(*it);
+            }
+        }
+    }
+    return effects;
+}
+
+void EulerFD::Sampling(util::WorkerThreadPool* pool) {
+    // With a single thread every batch holds one cluster, so clusters are sampled one after
+    // another, each seeing the agree sets of the previous ones
+    size_t const batch_size = pool == nullptr ? 1 : pool->ThreadNum() * kClustersPerThread;
+    std::vector<Cluster*> batch;
+    batch.reserve(batch_size);
+
     if (is_first_sample_) {
         // In first sampling mlfq is empty, we fill it.
         // We put all clusters in mlfq, even if effective coefficient was 0
         is_first_sample_ = false;
 
-        for (auto& cluster : clusters_) {
-            double eff = SamplingInCluster(&cluster);
-            mlfq_.Add(&cluster, eff, true);
+        for (size_t begin = 0; begin < clusters_.size(); begin += batch_size) {
+            batch.clear();
+            for (size_t i = begin; i < std::min(begin + batch_size, clusters_.size()); ++i) {
+                batch.push_back(&clusters_[i]);
+            }
+            std::vector<double> effects = SamplingInClusters(batch, pool);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                mlfq_.Add(batch[i], effects[i], true);
+            }
         }
 
         if (mlfq_.GetLastQueueSize() > 0) {
@@ -207,9 +253,14 @@ void EulerFD::Sampling() {
     // Sampling in first queues of mlfq
     new_invalids_.clear();
     while (mlfq_.GetEffectiveSize() > 0) {
-        Cluster* cluster = mlfq_.Get();
-        SamplingInCluster(cluster);
-        mlfq_.Add(cluster, cluster->GetAverage());
+        batch.clear();
+        while (batch.size() < batch_size && mlfq_.GetEffectiveSize() > 0) {
+            batch.push_back(mlfq_.Get());
+        }
+        SamplingInClusters(batch, pool);
+        for (Cluster* cluster : batch) {
+            mlfq_.Add(cluster, cluster->GetAverage());
+        }
     }
 
     if (mlfq_.GetLastQueueSize() > 0) {
@@ -217,10 +268,19 @@ void EulerFD::Sampling() {
     }
 
     // Sampling in last queues (it is priority queues) of mlfq
-    while (mlfq_.GetLastQueueSize() > 0 && mlfq_.MaxEffectInLastQueue() >= effective_threshold_) {
-        Cluster* cluster = mlfq_.Get();
-        SamplingInCluster(cluster);
-        mlfq_.AddAtLast(cluster);
+    auto is_last_queue_effective = [this]() {
+        return mlfq_.GetLastQueueSize() > 0 &&
+               mlfq_.MaxEffectInLastQueue() >= effective_threshold_;
+    };
+    while (is_last_queue_effective()) {
+        batch.clear();
+        while (batch.size() < batch_size && is_last_queue_effective()) {
+            batch.push_back(mlfq_.Get());
+        }
+        SamplingInClusters(batch, pool);
+        for (Cluster* cluster : batch) {
+            mlfq_.AddAtLast(cluster);
+        }
     }
 }
 
@@ -320,7 +380,7 @@ size_t EulerFD::Invert(size_t rhs, std::vector<Bitset> const& neg) {
     return tree.GetCardinality();
 }
 
-size_t EulerFD::GenerateResults() {
+size_t EulerFD::GenerateResults(util::WorkerThreadPool* pool) {
     // Check is new non fd discovered
     if (old_invalid_size_ == invalids_.size()) {
         return fd_num_;
@@ -354,11 +414,11 @@ size_t EulerFD::GenerateResults() {
     std::sort(neg_cover_vector.begin(), neg_cover_vector.end(),
               [](Bitset const& left, Bitset const& right) { return left.count() > right.count(); });
 
-    // Creating ncover and pcover trees for each rhs
-    size_t fd_num = 0;
-    for (size_t rhs = 0; rhs < number_of_attributes_; rhs++) {
+    // Creating ncover and pcover trees for each rhs, the trees of different rhs are independent
+    std::vector<size_t> rhs_fd_nums(number_of_attributes_, 0);
+    auto build_covers = [this, &inv_indexes, &neg_cover_vector, &rhs_fd_nums](size_t rhs) {
         if (constant_columns_[rhs]) {
-            continue;
+            return;
         }
 
         size_t real_rhs = inv_indexes[rhs];
@@ -367,9 +427,16 @@ size_t EulerFD::GenerateResults() {
         std::sort(neg.begin(), neg.end(), [](Bitset const& left, Bitset const& right) {
             return left.count() > right.count();
         });
-        fd_num += Invert(real_rhs, neg);
+        rhs_fd_nums[rhs] = Invert(real_rhs, neg);
+    };
+    if (pool == nullptr) {
+        for (size_t rhs = 0; rhs < number_of_attributes_; rhs++) {
+            build_covers(rhs);
+        }
+    } else {
+        pool->ExecIndex(build_covers, number_of_attributes_);
     }
-    return fd_num;
+    return std::accumulate(rhs_fd_nums.begin(), rhs_fd_nums.end(), size_t{0});
 }
 
 unsigned long long EulerFD::ExecuteInternal() {
@@ -388,6 +455,12 @@ unsigned long long EulerFD::ExecuteInternal() {
 
     auto start_time = std::chrono::system_clock::now();
 
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool.emplace(threads_num_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? &*pool : nullptr;
+
     BuildPartition();
     if (clusters_.empty()) {
         // In small datasets sometimes after clusters stripping there are no clusters for sampling
@@ -399,7 +472,7 @@ unsigned long long EulerFD::ExecuteInternal() {
     size_t iteration_number = 0;
     while (true) {
         size_t ncover_size = invalids_.size();
-        Sampling();
+        Sampling(pool_ptr);
 
         last_ncover_ratios_[iteration_number % kWindow] =
                 invalids_.empty() ? 0 : (double)(invalids_.size() - ncover_size) / invalids_.size();
@@ -407,7 +480,7 @@ unsigned long long EulerFD::ExecuteInternal() {
         // Check criterion for enter second EulerFD cycle
         if (IsNCoverGrowthSmall()) {
             size_t pcover_size = fd_num_;
-            fd_num_ = GenerateResults();
+            fd_num_ = GenerateResults(pool_ptr);
             last_pcover_ratios_[iteration_number % kWindow] =
                     fd_num_ == 0 ? 0 : (double)(fd_num_ - pcover_size) / fd_num_;
             if (IsPCoverGrowthSmall()) {
@@ -21,10 +21,12 @@
 #include "core/config/custom_random_seed/type.h"
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
 #include "core/model/table/relational_schema.h"
 #include "core/model/table/vertical.h"
 #include "core/util/custom_random.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -46,6 +48,7 @@ class EulerFD : public FDAlgorithm {
     std::vector<std::vector<size_t>> tuples_;
 
     config::EqNullsType is_null_equal_null_{};
+    config::ThreadNumType threads_num_ = 1;
 
     // Thresholds to checking criterion of EulerFD cycles
     constexpr static double kPosCoverGrowthThreshold = 0.01;
@@ -64,6 +67,9 @@ class EulerFD : public FDAlgorithm {
     MLFQ mlfq_;
     constexpr static double kInitialEffectiveThreshold = 0.01;
     double effective_threshold_ = kInitialEffectiveThreshold;
+    // With several threads the clusters are taken from mlfq in batches of kClustersPerThread per
+    // thread, which are sampled concurrently
+    constexpr static size_t kClustersPerThread = 8;
 
     // Invalid fds storages
     std::unordered_set<Bitset> invalids_;
@@ -89,9 +95,15 @@ class EulerFD : public FDAlgorithm {
     void InitCovers();
     void BuildPartition();
 
-    double SamplingInCluster(Cluster* cluster);
-    void Sampling();
-    size_t GenerateResults();
+    // Appends the agree sets of the cluster's sample that are not invalid FDs yet to
+    // new_agree_sets, returns the effect of the sample
+    double SamplingInCluster(Cluster* cluster, std::vector<Bitset>& new_agree_sets) const;
+    // Returns the effects of the samples, the agree sets are added to invalids_ in the order of
+    // the clusters. pool is nullptr when a single thread is used.
+    std::vector<double> SamplingInClusters(std::vector<Cluster*> const& clusters,
+                                           util::WorkerThreadPool* pool);
+    void Sampling(util::WorkerThreadPool* pool);
+    size_t GenerateResults(util::WorkerThreadPool* pool);
 
     [[nodiscard]] std::vector<size_t> GetAttributesSortedByFrequency(
             std::vector<Bitset> const& neg_cover_vector);
@@ -10,7 +10,9 @@
 #include <boost/thread.hpp>
 
 #include "core/config/max_lhs/option.h"
+#include "core/config/memory_budget/option.h"
 #include "core/config/thread_number/option.h"
+#include "core/config/time_limit/option.h"
 #include "core/model/table/agree_set_factory.h"
 #include "core/util/logger.h"
 #include "core/util/parallel_for.h"
@@ -21,14 +23,19 @@ using std::vector, std::set;
 
 FastFDs::FastFDs() : PliBasedFDAlgorithm() {
     RegisterOptions();
+    UseThreadsForLoading(&threads_num_);
 }
 
 void FastFDs::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterOption(config::kMemoryBudgetMbOpt(&memory_budget_mb_));
 }
 
 void FastFDs::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName(),
+                          config::kTimeLimitSecondsOpt.GetName(),
+                          config::kMemoryBudgetMbOpt.GetName()});
 }
 
 void FastFDs::ResetStateFd() {
@@ -39,6 +46,8 @@ unsigned long long FastFDs::ExecuteInternal() {
     schema_ = relation_->GetSchema();
 
     auto start_time = std::chrono::system_clock::now();
+    GetCancellationToken().Start(std::chrono::seconds(time_limit_seconds_),
+                                 static_cast<std::size_t>(memory_budget_mb_) << 20);
 
     GenDiffSets();
 
@@ -46,7 +55,9 @@ unsigned long long FastFDs::ExecuteInternal() {
             std::chrono::system_clock::now() - start_time);
     LOG_INFO("TIME TO DIFF SETS GENERATION: {}", elapsed_mills_to_gen_diff_sets.count());
 
-    if (diff_sets_.size() == 1 && diff_sets_.back().IsEmpty()) {
+    // Covers of a part of the difference sets need not be FDs
+    if (GetCancellationToken().IsCancelled() ||
+        (diff_sets_.size() == 1 && diff_sets_.back().IsEmpty())) {
         auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now() - start_time);
         return elapsed_milliseconds.count();
@@ -59,6 +70,9 @@ unsigned long long FastFDs::ExecuteInternal() {
             RegisterFd(empty_vertical, *column, relation_->GetSharedPtrSchema());
             return;
         }
+        if (GetCancellationToken().IsCancelled()) {
+            return;
+        }
 
         vector<DiffSet> diff_sets_mod = GetDiffSetsMod(*column);
         assert(!diff_sets_mod.empty());
@@ -98,7 +112,7 @@ bool FastFDs::ColumnContainsOnlyEqualValues(Column const& column) const {
 void FastFDs::FindCovers(Column const& attribute, vector<DiffSet> const& diff_sets_mod,
                          vector<DiffSet> const& cur_diff_sets, Vertical const& path,
                          set<Column, OrderingComparator> const& ordering) {
-    if (path.GetArity() > max_lhs_) {
+    if (path.GetArity() > max_lhs_ || GetCancellationToken().IsCancelled()) {
         return;
     }
 
@@ -6,7 +6,9 @@
 #include <boost/thread/mutex.hpp>
 
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
+#include "core/config/memory_budget/type.h"
 #include "core/config/thread_number/type.h"
+#include "core/config/time_limit/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/vertical.h"
 
@@ -70,6 +72,8 @@ private:
     RelationalSchema const* schema_;
     std::vector<DiffSet> diff_sets_;
     config::ThreadNumType threads_num_;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::MemoryBudgetMBType memory_budget_mb_ = 0;
 };
 
 }  // namespace algos
@@ -1,7 +1,10 @@
 #include "core/algorithms/fd/fd_algorithm.h"
 
+#include <algorithm>
 #include <map>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "core/config/max_lhs/option.h"
@@ -21,8 +24,24 @@ void FDAlgorithm::MakeExecuteOptsAvailable() {
     MakeExecuteOptsAvailableFDInternal();
 }
 
+void ResultFormat<FD>::WriteJson(std::ostream& out, FD const& fd) {
+    out << fd.ToJSONString();
+}
+
+void ResultFormat<FD>::WriteBinary(std::ostream& out, FD const& fd) {
+    WriteIndices(out, fd.GetLhsIndices());
+    WriteVarint(out, fd.GetRhsIndex());
+}
+
+void FDAlgorithm::SetResultSink(std::shared_ptr<ResultSink<FD>> sink, bool retain_fds) {
+    SetResultSinkBase(sink);
+    fd_sink_ = std::move(sink);
+    retain_fds_ = retain_fds || fd_sink_ == nullptr;
+}
+
 void FDAlgorithm::ResetState() {
     fd_collection_.Clear();
+    cancellation_token_.Start();
     ResetStateFd();
 }
 
@@ -40,17 +59,39 @@ std::list<FD>& FDAlgorithm::SortedFdList() {
     return fd_collection;
 }
 
+namespace {
+
+// Passes the JSON of FDAlgorithm::FDsToJson piece by piece to consume
+template <typename Consumer>
+void StreamJsonFDs(std::vector<std::string> fd_strings, Consumer consume) {
+    std::sort(fd_strings.begin(), fd_strings.end());
+    consume("{\"fds\": [");
+    for (std::size_t i = 0; i < fd_strings.size(); ++i) {
+        if (i != 0) {
+            consume(",");
+        }
+        consume(fd_strings[i]);
+    }
+    consume("]}");
+}
+
+}  // namespace
+
 std::string FDAlgorithm::GetJsonFDs() const {
-    return FDsToJson(FdList());
+    std::string result;
+    StreamJsonFDs(fd_collection_.ToJsonStrings(),
+                  [&result](std::string_view piece) { result += piece; });
+    return result;
 }
 
 unsigned int FDAlgorithm::Fletcher16() {
-    std::string to_hash = GetJsonFDs();
     unsigned int sum1 = 0, sum2 = 0, modulus = 255;
-    for (auto ch : to_hash) {
-        sum1 = (sum1 + ch) % modulus;
-        sum2 = (sum2 + sum1) % modulus;
-    }
+    StreamJsonFDs(fd_collection_.ToJsonStrings(), [&](std::string_view piece) {
+        for (auto ch : piece) {
+            sum1 = (sum1 + ch) % modulus;
+            sum2 = (sum2 + sum1) % modulus;
+        }
+    });
     return (sum2 << 8) | sum1;
 }
 
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <list>
-#include <mutex>
+#include <memory>
+#include <ostream>
 
 #include <boost/any.hpp>
 
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/fd/fd.h"
+#include "core/algorithms/fd/fd_store.h"
+#include "core/algorithms/result_sink.h"
 #include "core/config/max_lhs/type.h"
-#include "core/util/primitive_collection.h"
+#include "core/util/cancellation_token.h"
 
 namespace model {
 class AgreeSetFactory;
@@ -17,6 +21,16 @@ class AgreeSetFactory;
 
 namespace algos {
 
+template <>
+struct ResultFormat<FD> {
+    static constexpr std::uint8_t kKind = 0;
+
+    // The same object as FD::ToJSONString gives
+    static void WriteJson(std::ostream& out, FD const& fd);
+    // Indices of the LHS, then the index of the RHS
+    static void WriteBinary(std::ostream& out, FD const& fd);
+};
+
 /* It is highly recommended to inherit your Algorithm from this class.
  * Consider TANE as an example of such a FDAlgorithm usage.
  * */
@@ -26,6 +40,11 @@ private:
 
     void RegisterOptions();
 
+    std::shared_ptr<ResultSink<FD>> fd_sink_;
+    bool retain_fds_ = true;
+
+    util::CancellationToken cancellation_token_;
+
     void ResetState() final;
     virtual void MakeExecuteOptsAvailableFDInternal() {};
     void MakeExecuteOptsAvailable() override;
@@ -34,35 +53,79 @@ private:
 protected:
     config::MaxLhsType max_lhs_;
 
+    /* Polled by the algorithms that honor the time and memory limits. They start it with their
+     * limits at the beginning of the execution and stop as soon as it is cancelled, registering
+     * the FDs that are known to hold.
+     */
+    util::CancellationToken& GetCancellationToken() noexcept {
+        return cancellation_token_;
+    }
+
     /* Collection of all discovered FDs
      * Every FD mining algorithm should place discovered dependencies here. Don't add new FDs by
      * accessing this field directly, use RegisterFd methods instead
      */
-    util::PrimitiveCollection<FD> fd_collection_;
+    FdStore fd_collection_;
 
     /* Registers new FD.
      * Should be overridden if custom behavior is needed
      */
     virtual void RegisterFd(Vertical lhs, Column rhs,
                             std::shared_ptr<RelationalSchema const> const& schema) {
-        if (lhs.GetArity() <= max_lhs_)
-            fd_collection_.Register(std::move(lhs), std::move(rhs), schema);
+        if (lhs.GetArity() > max_lhs_) return;
+        if (fd_sink_ != nullptr) fd_sink_->Consume(FD{lhs, rhs, schema});
+        if (retain_fds_) fd_collection_.Register(lhs, rhs, schema);
     }
 
     virtual void RegisterFd(FD fd_to_register) {
-        if (fd_to_register.GetLhs().GetArity() <= max_lhs_)
-            fd_collection_.Register(std::move(fd_to_register));
+        if (fd_to_register.GetLhs().GetArity() > max_lhs_) return;
+        if (fd_sink_ != nullptr) fd_sink_->Consume(fd_to_register);
+        if (retain_fds_) fd_collection_.Register(fd_to_register);
+    }
+
+    /* Registers new FD given by the indices of its columns, no Vertical and Column are built
+     * unless there is a result sink.
+     * Should be overridden if custom behavior is needed
+     */
+    virtual void RegisterFd(boost::dynamic_bitset<> const& lhs, model::ColumnIndex rhs,
+                            std::shared_ptr<RelationalSchema const> const& schema) {
+        if (lhs.count() > max_lhs_) return;
+        if (fd_sink_ != nullptr) {
+            fd_sink_->Consume(FD{Vertical(schema.get(), lhs), *schema->GetColumn(rhs), schema});
+        }
+        if (retain_fds_) fd_collection_.Register(lhs, rhs, schema);
     }
 
 public:
     explicit FDAlgorithm();
 
-    /* Returns the list of discovered FDs */
-    std::list<FD> const& FdList() const noexcept {
+    /* Passes every FD to sink as soon as it is registered, possibly from several threads at once.
+     * If retain_fds is false, the FDs are not kept in memory and FdList() stays empty. nullptr
+     * removes the sink.
+     */
+    void SetResultSink(std::shared_ptr<ResultSink<FD>> sink, bool retain_fds = true);
+
+    /* Stops the execution running on another thread as soon as possible, the FDs found so far are
+     * kept. Only the algorithms that honor the time limit respond to it. Called before the
+     * execution starts, it stops the execution at once.
+     */
+    void Cancel() noexcept {
+        cancellation_token_.Cancel();
+    }
+
+    /* Whether the last execution found all the FDs, i.e. it was neither cancelled nor ran out of
+     * its time or memory limit */
+    bool IsComplete() const noexcept {
+        return !cancellation_token_.WasCancelled();
+    }
+
+    /* Returns the list of discovered FDs, the FD objects are built on the first call after the
+     * execution */
+    std::list<FD> const& FdList() const {
         return fd_collection_.AsList();
     }
 
-    std::list<FD>& FdList() noexcept {
+    std::list<FD>& FdList() {
         return fd_collection_.AsList();
     }
 
@@ -0,0 +1,112 @@
+#include "core/algorithms/fd/fd_store.h"
+
+#include <atomic>
+#include <cassert>
+
+namespace {
+
+std::uint64_t NextStoreId() {
+    static std::atomic<std::uint64_t> next_id = 1;
+    return next_id.fetch_add(1, std::memory_order::relaxed);
+}
+
+}  // namespace
+
+namespace algos {
+
+FdStore::FdStore() : id_(NextStoreId()) {}
+
+FdStore::Shard& FdStore::GetThreadShard(std::shared_ptr<RelationalSchema const> const& schema) {
+    // The shard of the store the thread has registered to last
+    thread_local std::uint64_t cached_id = 0;
+    thread_local Shard* cached_shard = nullptr;
+    if (cached_id == id_) {
+        assert(schema.get() == schema_.get());
+        return *cached_shard;
+    }
+
+    std::scoped_lock lock(mutex_);
+    if (schema_ == nullptr) {
+        schema_ = schema;
+        blocks_per_lhs_ = boost::dynamic_bitset<>(schema->GetNumColumns()).num_blocks();
+    }
+    assert(schema.get() == schema_.get());
+    Shard*& shard = thread_shards_[std::this_thread::get_id()];
+    if (shard == nullptr) {
+        shard = shards_.emplace_back(std::make_unique<Shard>()).get();
+    }
+    cached_id = id_;
+    cached_shard = shard;
+    return *shard;
+}
+
+void FdStore::Append(Shard& shard, boost::dynamic_bitset<> const& lhs,
+                     model::ColumnIndex rhs) const {
+    // A default constructed Vertical has an empty bitset
+    assert(lhs.num_blocks() <= blocks_per_lhs_);
+    std::size_t const lhs_begin = shard.lhs_blocks.size();
+    shard.lhs_blocks.resize(lhs_begin + blocks_per_lhs_);
+    boost::to_block_range(lhs, shard.lhs_blocks.begin() + lhs_begin);
+    shard.rhs_indices.push_back(rhs);
+}
+
+void FdStore::Register(boost::dynamic_bitset<> const& lhs, model::ColumnIndex rhs,
+                       std::shared_ptr<RelationalSchema const> const& schema) {
+    Append(GetThreadShard(schema), lhs, rhs);
+}
+
+void FdStore::Clear() {
+    std::scoped_lock lock(mutex_);
+    schema_ = nullptr;
+    blocks_per_lhs_ = 0;
+    shards_.clear();
+    thread_shards_.clear();
+    // Threads that cached a shard of the previous generation take the locked path again
+    id_ = NextStoreId();
+    materialized_.clear();
+    materialized_size_ = 0;
+}
+
+std::size_t FdStore::Size() const {
+    std::scoped_lock lock(mutex_);
+    std::size_t size = 0;
+    for (auto const& shard : shards_) {
+        size += shard->rhs_indices.size();
+    }
+    return size;
+}
+
+std::vector<std::string> FdStore::ToJsonStrings() const {
+    std::vector<std::string> fd_strings;
+    fd_strings.reserve(Size());
+    ForEach([&fd_strings](boost::dynamic_bitset<> const& lhs, model::ColumnIndex rhs) {
+        std::string fd_string = "{\"lhs\": [";
+        for (std::size_t index = lhs.find_first(); index != boost::dynamic_bitset<>::npos;
+             index = lhs.find_next(index)) {
+            if (fd_string.back() != '[') {
+                fd_string += ',';
+            }
+            fd_string += std::to_string(index);
+        }
+        fd_string += "], \"rhs\": " + std::to_string(rhs) + "}";
+        fd_strings.push_back(std::move(fd_string));
+    });
+    return fd_strings;
+}
+
+std::list<FD> const& FdStore::AsList() const {
+    std::size_t const size = Size();
+    if (materialized_size_ == size) {
+        return materialized_;
+    }
+
+    materialized_.clear();
+    ForEach([this](boost::dynamic_bitset<> const& lhs, model::ColumnIndex rhs) {
+        materialized_.emplace_back(Vertical(schema_.get(), lhs), *schema_->GetColumn(rhs),
+                                   schema_);
+    });
+    materialized_size_ = size;
+    return materialized_;
+}
+
+}  // namespace algos
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "core/algorithms/fd/fd.h"
+#include "core/model/table/column_index.h"
+#include "core/model/table/relational_schema.h"
+
+namespace algos {
+
+/* Collection of the FDs discovered by an FDAlgorithm, all of them over the same schema.
+ *
+ * FDs are stored packed: the blocks of the LHS bitsets follow one another in a single buffer, the
+ * RHS indices are in another one. Every registering thread appends to a shard of its own, a lock
+ * is only taken the first time a thread registers an FD. FD objects are built on the first call
+ * to AsList() after the collection has changed.
+ */
+class FdStore {
+public:
+    using Block = boost::dynamic_bitset<>::block_type;
+
+private:
+    struct Shard {
+        std::vector<Block> lhs_blocks;
+        std::vector<model::ColumnIndex> rhs_indices;
+    };
+
+    std::shared_ptr<RelationalSchema const> schema_;
+    std::size_t blocks_per_lhs_ = 0;
+
+    std::mutex mutable mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::unordered_map<std::thread::id, Shard*> thread_shards_;
+    // Identifies this store and the generation of its shards in the caches of the threads
+    std::uint64_t id_;
+
+    std::list<FD> mutable materialized_;
+    std::size_t mutable materialized_size_ = 0;
+
+    Shard& GetThreadShard(std::shared_ptr<RelationalSchema const> const& schema);
+
+    void Append(Shard& shard, boost::dynamic_bitset<> const& lhs, model::ColumnIndex rhs) const;
+
+public:
+    FdStore();
+
+    FdStore(FdStore const&) = delete;
+    FdStore& operator=(FdStore const&) = delete;
+
+    void Register(boost::dynamic_bitset<> const& lhs, model::ColumnIndex rhs,
+                  std::shared_ptr<RelationalSchema const> const& schema);
+
+    void Register(Vertical const& lhs, Column const& rhs,
+                  std::shared_ptr<RelationalSchema const> const& schema) {
+        Register(lhs.GetColumnIndices(), rhs.GetIndex(), schema);
+    }
+
+    void Register(FD const& fd) {
+        Register(fd.GetLhs(), fd.GetRhs(), fd.GetSchema());
+    }
+
+    void Clear();
+
+    std::size_t Size() const;
+
+    /* Calls func(lhs, rhs_index) for every FD in the order AsList() lists them. lhs is only valid
+     * during the call.
+     */
+    template <typename Func>
+    void ForEach(Func func) const {
+        std::scoped_lock lock(mutex_);
+        if (schema_ == nullptr) return;
+        boost::dynamic_bitset<> lhs(schema_->GetNumColumns());
+        for (auto const& shard : shards_) {
+            auto lhs_begin = shard->lhs_blocks.begin();
+            for (model::ColumnIndex rhs : shard->rhs_indices) {
+                auto const lhs_end = lhs_begin + blocks_per_lhs_;
+                boost::from_block_range(lhs_begin, lhs_end, lhs);
+                func(std::as_const(lhs), rhs);
+                lhs_begin = lhs_end;
+            }
+        }
+    }
+
+    /* JSON representations of the FDs as returned by FD::ToJSONString, built without
+     * materializing the FDs.
+     */
+    std::vector<std::string> ToJsonStrings() const;
+
+    /* Calling code MUST guarantee that the methods below won't interfere with the registering of
+     * new FDs or clearing (for the entire time the returned reference is held). Changes to the
+     * returned list are kept until the collection changes.
+     */
+    std::list<FD> const& AsList() const;
+
+    std::list<FD>& AsList() {
+        return const_cast<std::list<FD>&>(std::as_const(*this).AsList());
+    }
+};
+
+}  // namespace algos
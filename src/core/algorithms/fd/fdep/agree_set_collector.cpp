@@ -0,0 +1,117 @@
+#include "core/algorithms/fd/fdep/agree_set_collector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "core/util/worker_thread_pool.h"
+
+namespace {
+
+using algos::fdep::ValueCode;
+
+// Bit k is set if codes[k] == value, size is at most 64
+std::uint64_t EqualMask(ValueCode const* codes, std::size_t size, ValueCode value) {
+    std::uint64_t mask = 0;
+    std::size_t k = 0;
+#ifdef __AVX2__
+    __m256i const value_vect = _mm256_set1_epi32(static_cast<int>(value));
+    for (; k + 8 <= size; k += 8) {
+        __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(codes + k));
+        __m256i const hits = _mm256_cmpeq_epi32(chunk, value_vect);
+        auto const hits_mask =
+                static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hits)));
+        mask |= std::uint64_t{hits_mask} << k;
+    }
+#endif
+    for (; k < size; ++k) {
+        mask |= std::uint64_t{codes[k] == value} << k;
+    }
+    return mask;
+}
+
+}  // namespace
+
+namespace algos::fdep {
+
+template <typename AgreeSet>
+void AgreeSetCollector<AgreeSet>::CollectBlock(std::size_t block, AgreeSets& agree_sets) const {
+    std::size_t const num_columns = columns_.size();
+    std::size_t const block_begin = block * kTileSize;
+    std::size_t const block_end = std::min(block_begin + kTileSize, num_rows_);
+    std::vector<AgreeSet> tile_agree_sets(kTileSize, CreateAttrSet<AgreeSet>(num_columns + 1));
+    std::vector<std::uint64_t> equal_masks(num_columns);
+
+    // The tile of the right tuples stays in cache while the tuples of the block are compared
+    // with it
+    for (std::size_t tile_begin = block_begin; tile_begin < num_rows_; tile_begin += kTileSize) {
+        std::size_t const tile_end = std::min(tile_begin + kTileSize, num_rows_);
+        for (std::size_t left = block_begin; left < block_end; ++left) {
+            std::size_t const right_begin = std::max(tile_begin, left + 1);
+            if (right_begin >= tile_end) break;
+            std::size_t const tile_size = tile_end - right_begin;
+
+            std::uint64_t all_equal = tile_size == kTileSize ? ~std::uint64_t{0}
+                                                             : (std::uint64_t{1} << tile_size) - 1;
+            for (std::size_t column = 0; column < num_columns; ++column) {
+                std::vector<ValueCode> const& codes = columns_[column];
+                equal_masks[column] = EqualMask(codes.data() + right_begin, tile_size, codes[left]);
+                all_equal &= equal_masks[column];
+            }
+
+            for (std::size_t k = 0; k < tile_size; ++k) {
+                tile_agree_sets[k].reset();
+            }
+            for (std::size_t column = 0; column < num_columns; ++column) {
+                for (std::uint64_t mask = equal_masks[column]; mask != 0; mask &= mask - 1) {
+                    tile_agree_sets[std::countr_zero(mask)].set(column + 1);
+                }
+            }
+            for (std::size_t k = 0; k < tile_size; ++k) {
+                if (((all_equal >> k) & 1) == 0) {
+                    agree_sets.insert(tile_agree_sets[k]);
+                }
+            }
+        }
+    }
+}
+
+template <typename AgreeSet>
+std::vector<AgreeSet> AgreeSetCollector<AgreeSet>::Collect(config::ThreadNumType threads) const {
+    std::size_t const num_blocks = (num_rows_ + kTileSize - 1) / kTileSize;
+    AgreeSets agree_sets;
+    if (threads > 1 && num_blocks > 1) {
+        util::WorkerThreadPool pool{threads};
+        std::vector<AgreeSets> thread_agree_sets(pool.ThreadNum());
+        std::atomic<AgreeSets*> next_thread_agree_sets = thread_agree_sets.data();
+        // Blocks near the start compare their tuples with more others, the pool hands them out
+        // one at a time
+        pool.ExecIndexWithResource(
+                [this](std::size_t block, AgreeSets* agree_sets) {
+                    CollectBlock(block, *agree_sets);
+                },
+                [&next_thread_agree_sets]() {
+                    return next_thread_agree_sets.fetch_add(1, std::memory_order::relaxed);
+                },
+                num_blocks);
+        for (AgreeSets& sets : thread_agree_sets) {
+            agree_sets.merge(sets);
+        }
+    } else {
+        for (std::size_t block = 0; block < num_blocks; ++block) {
+            CollectBlock(block, agree_sets);
+        }
+    }
+    return {agree_sets.begin(), agree_sets.end()};
+}
+
+template class AgreeSetCollector<model::Bitset<64>>;
+template class AgreeSetCollector<model::Bitset<128>>;
+template class AgreeSetCollector<model::Bitset<256>>;
+template class AgreeSetCollector<DynamicAttrSet>;
+
+}  // namespace algos::fdep
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "core/algorithms/fd/fdep/attribute_set.h"
+#include "core/config/thread_number/type.h"
+
+namespace algos::fdep {
+
+/// Code of a value among the values of its column.
+using ValueCode = std::uint32_t;
+
+/// @brief Collects the distinct agree sets of all pairs of tuples of a relation.
+///
+/// The relation is stored column-major, every value is replaced by a 32-bit code of its column.
+/// Tuples are compared in tiles: one tuple is compared with kTileSize others a column at a time,
+/// which gives a bitmask of the agreeing pairs per column that is computed with vector compares.
+/// Agree sets are deduplicated in a set per thread before they are merged.
+///
+/// Attributes are numbered from 1 in the agree sets, as in FDTreeElement, AgreeSet is one of the
+/// sets of attribute_set.h.
+template <typename AgreeSet>
+class AgreeSetCollector {
+public:
+    static constexpr std::size_t kTileSize = 64;
+
+private:
+    using AgreeSets = std::unordered_set<AgreeSet>;
+
+    std::vector<std::vector<ValueCode>> const& columns_;
+    std::size_t num_rows_;
+
+    // Compare the tuples of a block of kTileSize rows with the following tuples.
+    void CollectBlock(std::size_t block, AgreeSets& agree_sets) const;
+
+public:
+    /// `columns` holds the codes of each column, all of them `num_rows` long.
+    AgreeSetCollector(std::vector<std::vector<ValueCode>> const& columns, std::size_t num_rows)
+        : columns_(columns), num_rows_(num_rows) {}
+
+    /// Agree sets of the pairs of tuples that differ in some attribute, pairs of equal tuples
+    /// violate no FD.
+    std::vector<AgreeSet> Collect(config::ThreadNumType threads) const;
+};
+
+extern template class AgreeSetCollector<model::Bitset<64>>;
+extern template class AgreeSetCollector<model::Bitset<128>>;
+extern template class AgreeSetCollector<model::Bitset<256>>;
+extern template class AgreeSetCollector<DynamicAttrSet>;
+
+}  // namespace algos::fdep
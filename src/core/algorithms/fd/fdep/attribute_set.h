@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "core/model/types/bitset.h"
+
+namespace algos::fdep {
+
+/* Sets of attributes of FDep. Narrow tables use model::Bitset of the smallest of the fixed widths
+ * that fits, wider ones use boost::dynamic_bitset. Attributes are numbered from 1, so a table with
+ * n columns needs n + 1 bits. For both kinds FindFirst and FindNext return a position not less
+ * than size() when there is no set bit left.
+ */
+using DynamicAttrSet = boost::dynamic_bitset<>;
+
+template <typename AttrSet>
+AttrSet CreateAttrSet(std::size_t num_bits) {
+    if constexpr (std::is_same_v<AttrSet, DynamicAttrSet>) {
+        return AttrSet(num_bits);
+    } else {
+        return AttrSet{};
+    }
+}
+
+template <typename AttrSet>
+std::size_t FindFirst(AttrSet const& set) noexcept {
+    if constexpr (std::is_same_v<AttrSet, DynamicAttrSet>) {
+        return set.find_first();
+    } else {
+        return set._Find_first();
+    }
+}
+
+template <typename AttrSet>
+std::size_t FindNext(AttrSet const& set, std::size_t pos) noexcept {
+    if constexpr (std::is_same_v<AttrSet, DynamicAttrSet>) {
+        return set.find_next(pos);
+    } else {
+        return set._Find_next(pos);
+    }
+}
+
+// Calls func.template operator()<AttrSet>() with the narrowest set that holds num_bits bits
+template <typename Func>
+decltype(auto) DispatchAttrSet(std::size_t num_bits, Func&& func) {
+    if (num_bits <= 64) {
+        return func.template operator()<model::Bitset<64>>();
+    } else if (num_bits <= 128) {
+        return func.template operator()<model::Bitset<128>>();
+    } else if (num_bits <= 256) {
+        return func.template operator()<model::Bitset<256>>();
+    }
+    return func.template operator()<DynamicAttrSet>();
+}
+
+}  // namespace algos::fdep
@@ -1,33 +1,49 @@
 #include "core/algorithms/fd/fdep/fd_tree_element.h"
 
-#include "core/model/types/bitset.h"
+#include <cctype>
 
-FDTreeElement::FDTreeElement(size_t max_attribute_number)
-    : max_attribute_number_(max_attribute_number) {
+using algos::fdep::FindFirst, algos::fdep::FindNext;
+
+template <typename AttrSet>
+FDTreeElement<AttrSet>::FDTreeElement(size_t max_attribute_number)
+    : rhs_attributes_(algos::fdep::CreateAttrSet<AttrSet>(max_attribute_number + 1)),
+      max_attribute_number_(max_attribute_number),
+      is_fd_(algos::fdep::CreateAttrSet<AttrSet>(max_attribute_number + 1)) {
     children_.resize(max_attribute_number);
 }
 
-bool FDTreeElement::CheckFd(size_t index) const {
+template <typename AttrSet>
+AttrSet FDTreeElement<AttrSet>::CreateAttrSet() const {
+    return algos::fdep::CreateAttrSet<AttrSet>(max_attribute_number_ + 1);
+}
+
+template <typename AttrSet>
+bool FDTreeElement<AttrSet>::CheckFd(size_t index) const {
     return this->is_fd_[index];
 }
 
-FDTreeElement* FDTreeElement::GetChild(size_t index) const {
+template <typename AttrSet>
+FDTreeElement<AttrSet>* FDTreeElement<AttrSet>::GetChild(size_t index) const {
     return this->children_[index].get();
 }
 
-void FDTreeElement::AddRhsAttribute(size_t index) {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::AddRhsAttribute(size_t index) {
     this->rhs_attributes_.set(index);
 }
 
-model::Bitset<FDTreeElement::kMaxAttrNum> const& FDTreeElement::GetRhsAttributes() const {
+template <typename AttrSet>
+AttrSet const& FDTreeElement<AttrSet>::GetRhsAttributes() const {
     return this->rhs_attributes_;
 }
 
-void FDTreeElement::MarkAsLast(size_t index) {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::MarkAsLast(size_t index) {
     this->is_fd_.set(index);
 }
 
-bool FDTreeElement::IsFinalNode(size_t attr_num) const {
+template <typename AttrSet>
+bool FDTreeElement<AttrSet>::IsFinalNode(size_t attr_num) const {
     if (!this->rhs_attributes_[attr_num]) {
         return false;
     }
@@ -39,14 +55,15 @@ bool FDTreeElement::IsFinalNode(size_t attr_num) const {
     return true;
 }
 
-bool FDTreeElement::ContainsGeneralization(model::Bitset<FDTreeElement::kMaxAttrNum> const& lhs,
-                                           size_t attr_num, size_t current_attr) const {
+template <typename AttrSet>
+bool FDTreeElement<AttrSet>::ContainsGeneralization(AttrSet const& lhs, size_t attr_num,
+                                                    size_t current_attr) const {
     if (this->is_fd_[attr_num - 1]) {
         return true;
     }
 
-    size_t next_set_attr = lhs._Find_next(current_attr);
-    if (next_set_attr == kMaxAttrNum) {
+    size_t next_set_attr = FindNext(lhs, current_attr);
+    if (next_set_attr >= lhs.size()) {
         return false;
     }
     bool found = false;
@@ -62,17 +79,17 @@ bool FDTreeElement::ContainsGeneralization(model::Bitset<FDTreeElement::kMaxAttr
     return this->ContainsGeneralization(lhs, attr_num, next_set_attr);
 }
 
-bool FDTreeElement::GetGeneralizationAndDelete(
-        model::Bitset<FDTreeElement::kMaxAttrNum> const& lhs, size_t attr_num, size_t current_attr,
-        model::Bitset<FDTreeElement::kMaxAttrNum>& spec_lhs) {
+template <typename AttrSet>
+bool FDTreeElement<AttrSet>::GetGeneralizationAndDelete(AttrSet const& lhs, size_t attr_num,
+                                                        size_t current_attr, AttrSet& spec_lhs) {
     if (this->is_fd_[attr_num - 1]) {
         this->is_fd_.reset(attr_num - 1);
         this->rhs_attributes_.reset(attr_num);
         return true;
     }
 
-    size_t next_set_attr = lhs._Find_next(current_attr);
-    if (next_set_attr == kMaxAttrNum) {
+    size_t next_set_attr = FindNext(lhs, current_attr);
+    if (next_set_attr >= lhs.size()) {
         return false;
     }
 
@@ -95,18 +112,18 @@ bool FDTreeElement::GetGeneralizationAndDelete(
     return found;
 }
 
-bool FDTreeElement::GetSpecialization(
-        model::Bitset<FDTreeElement::kMaxAttrNum> const& lhs, size_t attr_num, size_t current_attr,
-        model::Bitset<FDTreeElement::kMaxAttrNum>& spec_lhs_out) const {
+template <typename AttrSet>
+bool FDTreeElement<AttrSet>::GetSpecialization(AttrSet const& lhs, size_t attr_num,
+                                               size_t current_attr, AttrSet& spec_lhs_out) const {
     if (!this->rhs_attributes_[attr_num]) {
         return false;
     }
 
     bool found = false;
     size_t attr = (current_attr > 1 ? current_attr : 1);
-    size_t next_set_attr = lhs._Find_next(current_attr);
+    size_t next_set_attr = FindNext(lhs, current_attr);
 
-    if (next_set_attr == kMaxAttrNum) {
+    if (next_set_attr >= lhs.size()) {
         while (!found && attr <= this->max_attribute_number_) {
             if (this->children_[attr - 1] &&
                 this->children_[attr - 1]->GetRhsAttributes()[attr_num]) {
@@ -139,7 +156,8 @@ bool FDTreeElement::GetSpecialization(
     return found;
 }
 
-void FDTreeElement::AddMostGeneralDependencies() {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::AddMostGeneralDependencies() {
     for (size_t i = 1; i <= this->max_attribute_number_; ++i) {
         this->rhs_attributes_.set(i);
     }
@@ -149,12 +167,12 @@ void FDTreeElement::AddMostGeneralDependencies() {
     }
 }
 
-void FDTreeElement::AddFunctionalDependency(model::Bitset<FDTreeElement::kMaxAttrNum> const& lhs,
-                                            size_t attr_num) {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::AddFunctionalDependency(AttrSet const& lhs, size_t attr_num) {
     FDTreeElement* current_node = this;
     this->AddRhsAttribute(attr_num);
 
-    for (size_t i = lhs._Find_first(); i != kMaxAttrNum; i = lhs._Find_next(i)) {
+    for (size_t i = FindFirst(lhs); i < lhs.size(); i = FindNext(lhs, i)) {
         if (current_node->children_[i - 1] == nullptr) {
             current_node->children_[i - 1] =
                     std::make_unique<FDTreeElement>(this->max_attribute_number_);
@@ -167,8 +185,9 @@ void FDTreeElement::AddFunctionalDependency(model::Bitset<FDTreeElement::kMaxAtt
     current_node->MarkAsLast(attr_num - 1);
 }
 
-void FDTreeElement::FilterSpecializations() {
-    model::Bitset<kMaxAttrNum> active_path;
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::FilterSpecializations() {
+    AttrSet active_path = CreateAttrSet();
     auto filtered_tree = std::make_unique<FDTreeElement>(this->max_attribute_number_);
 
     this->FilterSpecializationsHelper(*filtered_tree, active_path);
@@ -177,8 +196,9 @@ void FDTreeElement::FilterSpecializations() {
     this->is_fd_ = filtered_tree->is_fd_;
 }
 
-void FDTreeElement::FilterSpecializationsHelper(
-        FDTreeElement& filtered_tree, model::Bitset<FDTreeElement::kMaxAttrNum>& active_path) {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::FilterSpecializationsHelper(FDTreeElement& filtered_tree,
+                                                         AttrSet& active_path) {
     for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
         if (this->children_[attr - 1]) {
             active_path.set(attr);
@@ -188,7 +208,7 @@ void FDTreeElement::FilterSpecializationsHelper(
     }
 
     for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
-        model::Bitset<kMaxAttrNum> spec_lhs_out;
+        AttrSet spec_lhs_out = CreateAttrSet();
         if (this->is_fd_[attr - 1] &&
             !filtered_tree.GetSpecialization(active_path, attr, 0, spec_lhs_out)) {
             filtered_tree.AddFunctionalDependency(active_path, attr);
@@ -196,18 +216,19 @@ void FDTreeElement::FilterSpecializationsHelper(
     }
 }
 
-void FDTreeElement::PrintDep(std::string const& file_name,
-                             std::vector<std::string>& column_names) const {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::PrintDep(std::string const& file_name,
+                                      std::vector<std::string>& column_names) const {
     std::ofstream file;
     file.open(file_name);
-    model::Bitset<kMaxAttrNum> active_path;
+    AttrSet active_path = CreateAttrSet();
     PrintDependencies(active_path, file, column_names);
     file.close();
 }
 
-void FDTreeElement::PrintDependencies(model::Bitset<FDTreeElement::kMaxAttrNum>& active_path,
-                                      std::ofstream& file,
-                                      std::vector<std::string>& column_names) const {
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::PrintDependencies(AttrSet& active_path, std::ofstream& file,
+                                               std::vector<std::string>& column_names) const {
     std::string column_id;
     if (std::isdigit(column_names[0][0])) {
         column_id = "column";
@@ -217,8 +238,8 @@ void FDTreeElement::PrintDependencies(model::Bitset<FDTreeElement::kMaxAttrNum>&
         if (this->is_fd_[attr - 1]) {
             out = "{";
 
-            for (size_t i = active_path._Find_first(); i != kMaxAttrNum;
-                 i = active_path._Find_next(i)) {
+            for (size_t i = FindFirst(active_path); i < active_path.size();
+                 i = FindNext(active_path, i)) {
                 if (!column_id.empty())
                     out += column_id + std::to_string(std::stoi(column_names[i - 1]) + 1) + ",";
                 else
@@ -245,22 +266,25 @@ void FDTreeElement::PrintDependencies(model::Bitset<FDTreeElement::kMaxAttrNum>&
     }
 }
 
-void FDTreeElement::FillFdCollection(std::shared_ptr<RelationalSchema> const& scheme,
-                                     std::list<FD>& fd_collection, unsigned int max_lhs) const {
-    model::Bitset<kMaxAttrNum> active_path;
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::FillFdCollection(std::shared_ptr<RelationalSchema> const& scheme,
+                                              std::list<FD>& fd_collection,
+                                              unsigned int max_lhs) const {
+    AttrSet active_path = CreateAttrSet();
     this->TransformTreeFdCollection(active_path, fd_collection, scheme, max_lhs);
 }
 
-void FDTreeElement::TransformTreeFdCollection(
-        model::Bitset<FDTreeElement::kMaxAttrNum>& active_path, std::list<FD>& fd_collection,
+template <typename AttrSet>
+void FDTreeElement<AttrSet>::TransformTreeFdCollection(
+        AttrSet& active_path, std::list<FD>& fd_collection,
         std::shared_ptr<RelationalSchema> const& scheme, unsigned int max_lhs) const {
     if (active_path.count() > max_lhs) return;
 
     for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
         if (this->is_fd_[attr - 1]) {
-            boost::dynamic_bitset<> lhs_bitset(kMaxAttrNum);
-            for (size_t i = active_path._Find_first(); i != kMaxAttrNum;
-                 i = active_path._Find_next(i)) {
+            boost::dynamic_bitset<> lhs_bitset(scheme->GetNumColumns());
+            for (size_t i = FindFirst(active_path); i < active_path.size();
+                 i = FindNext(active_path, i)) {
                 if (i > 0) {
                     lhs_bitset.set(i - 1);
                 }
@@ -280,3 +304,8 @@ void FDTreeElement::TransformTreeFdCollection(
         }
     }
 }
+
+template class FDTreeElement<model::Bitset<64>>;
+template class FDTreeElement<model::Bitset<128>>;
+template class FDTreeElement<model::Bitset<256>>;
+template class FDTreeElement<algos::fdep::DynamicAttrSet>;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <list>
 #include <memory>
 #include <vector>
@@ -9,14 +10,14 @@
 #include <string>
 
 #include "core/algorithms/fd/fd.h"
+#include "core/algorithms/fd/fdep/attribute_set.h"
 #include "core/model/table/relational_schema.h"
-#include "core/model/types/bitset.h"
 
+// AttrSet is one of the attribute sets of attribute_set.h, wide enough for max_attribute_number + 1
+// bits.
+template <typename AttrSet>
 class FDTreeElement {
 public:
-    // The maximum number of columns in the dataset. Using in std::bitset template.
-    static constexpr int kMaxAttrNum = 256;
-
     explicit FDTreeElement(size_t max_attribute_number);
 
     FDTreeElement(FDTreeElement const&) = delete;
@@ -32,14 +33,17 @@ public:
 
     [[nodiscard]] FDTreeElement* GetChild(size_t index) const;
 
-    void AddFunctionalDependency(model::Bitset<kMaxAttrNum> const& lhs, size_t attr_num);
+    // An empty attribute set of the tree's width.
+    [[nodiscard]] AttrSet CreateAttrSet() const;
+
+    void AddFunctionalDependency(AttrSet const& lhs, size_t attr_num);
 
     // Searching for generalization of functional dependency in cover-trees.
-    bool GetGeneralizationAndDelete(model::Bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                                    size_t current_attr, model::Bitset<kMaxAttrNum>& spec_lhs);
+    bool GetGeneralizationAndDelete(AttrSet const& lhs, size_t attr_num, size_t current_attr,
+                                    AttrSet& spec_lhs);
 
-    [[nodiscard]] bool ContainsGeneralization(model::Bitset<kMaxAttrNum> const& lhs,
-                                              size_t attr_num, size_t current_attr) const;
+    [[nodiscard]] bool ContainsGeneralization(AttrSet const& lhs, size_t attr_num,
+                                              size_t current_attr) const;
 
     // Printing found dependencies in output file.
     void PrintDep(std::string const& file, std::vector<std::string>& column_names) const;
@@ -50,13 +54,13 @@ public:
 
 private:
     std::vector<std::unique_ptr<FDTreeElement>> children_;
-    model::Bitset<kMaxAttrNum> rhs_attributes_;
+    AttrSet rhs_attributes_;
     size_t max_attribute_number_;
-    model::Bitset<kMaxAttrNum> is_fd_;
+    AttrSet is_fd_;
 
     void AddRhsAttribute(size_t index);
 
-    [[nodiscard]] model::Bitset<kMaxAttrNum> const& GetRhsAttributes() const;
+    [[nodiscard]] AttrSet const& GetRhsAttributes() const;
 
     void MarkAsLast(size_t index);
 
@@ -64,18 +68,22 @@ private:
     [[nodiscard]] bool IsFinalNode(size_t attr_num) const;
 
     // Searching for specialization of functional dependency in cover-trees.
-    bool GetSpecialization(model::Bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                           size_t current_attr, model::Bitset<kMaxAttrNum>& spec_lhs_out) const;
+    bool GetSpecialization(AttrSet const& lhs, size_t attr_num, size_t current_attr,
+                           AttrSet& spec_lhs_out) const;
 
-    void FilterSpecializationsHelper(FDTreeElement& filtered_tree,
-                                     model::Bitset<kMaxAttrNum>& active_path);
+    void FilterSpecializationsHelper(FDTreeElement& filtered_tree, AttrSet& active_path);
 
     // Helper function for PrintDep.
-    void PrintDependencies(model::Bitset<kMaxAttrNum>& active_path, std::ofstream& file,
+    void PrintDependencies(AttrSet& active_path, std::ofstream& file,
                            std::vector<std::string>& column_names) const;
 
     void TransformTreeFdCollection(
-            model::Bitset<kMaxAttrNum>& active_path, std::list<FD>& fd_collection,
+            AttrSet& active_path, std::list<FD>& fd_collection,
             std::shared_ptr<RelationalSchema> const& scheme,
             unsigned int max_lhs = std::numeric_limits<unsigned int>::max()) const;
 };
+
+extern template class FDTreeElement<model::Bitset<64>>;
+extern template class FDTreeElement<model::Bitset<128>>;
+extern template class FDTreeElement<model::Bitset<256>>;
+extern template class FDTreeElement<algos::fdep::DynamicAttrSet>;
@@ -1,11 +1,18 @@
 #include "core/algorithms/fd/fdep/fdep.h"
 
 #include <chrono>
+#include <limits>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 #include "core/config/equal_nulls/option.h"
+#include "core/config/names.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_layout_relation_data.h"
-#include "core/model/types/bitset.h"
 
 // #ifndef PRINT_FDS
 // #define PRINT_FDS
@@ -20,6 +27,11 @@ FDep::FDep() : FDAlgorithm() {
 
 void FDep::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void FDep::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::names::kThreads});
 }
 
 void FDep::LoadDataInternal() {
@@ -36,100 +48,114 @@ void FDep::LoadDataInternal() {
         schema_->AppendColumn(column_names_[i]);
     }
 
+    using fdep::ValueCode;
+    columns_.assign(number_attributes_, {});
+    std::vector<std::unordered_map<std::string, ValueCode>> value_codes(number_attributes_);
     std::vector<std::string> next_line;
     while (input_table_->HasNextRow()) {
         next_line = input_table_->GetNextRow();
         if (next_line.empty()) break;
-        tuples_.emplace_back(std::vector<size_t>(number_attributes_));
+        if (number_tuples_ == std::numeric_limits<ValueCode>::max()) {
+            throw std::runtime_error("FDep: too many rows in the dataset.");
+        }
         for (size_t i = 0; i < number_attributes_; ++i) {
-            tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
+            auto const [it, _] = value_codes[i].try_emplace(std::move(next_line[i]),
+                                                            value_codes[i].size());
+            columns_[i].push_back(it->second);
         }
+        ++number_tuples_;
     }
 }
 
-void FDep::ResetStateFd() {
-    // Consider creating them here instead.
-    neg_cover_tree_.reset();
-    pos_cover_tree_.reset();
-}
+void FDep::ResetStateFd() {}
 
 unsigned long long FDep::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
-    BuildNegativeCover();
+    // Attributes are numbered from 1 in the trees
+    fdep::DispatchAttrSet(this->number_attributes_ + 1,
+                          [this]<typename AttrSet>() { DiscoverFds<AttrSet>(); });
 
-    this->tuples_.shrink_to_fit();
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
 
-    this->pos_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    this->pos_cover_tree_->AddMostGeneralDependencies();
+    return elapsed_milliseconds.count();
+}
 
-    model::Bitset<FDTreeElement::kMaxAttrNum> active_path;
-    CalculatePositiveCover(*this->neg_cover_tree_, active_path);
+template <typename AttrSet>
+void FDep::DiscoverFds() {
+    std::unique_ptr<FDTreeElement<AttrSet>> neg_cover_tree = BuildNegativeCover<AttrSet>();
 
-    pos_cover_tree_->FillFdCollection(this->schema_, FdList(), max_lhs_);
+    auto pos_cover_tree = std::make_unique<FDTreeElement<AttrSet>>(this->number_attributes_);
+    pos_cover_tree->AddMostGeneralDependencies();
 
-    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now() - start_time);
+    AttrSet active_path = pos_cover_tree->CreateAttrSet();
+    CalculatePositiveCover(*neg_cover_tree, active_path, *pos_cover_tree);
+
+    std::list<FD> fds;
+    pos_cover_tree->FillFdCollection(this->schema_, fds, max_lhs_);
+    for (FD& fd : fds) {
+        RegisterFd(std::move(fd));
+    }
 
 #ifdef PRINT_FDS
-    pos_cover_tree_->printDep("recent_call_result.txt", this->column_names_);
+    pos_cover_tree->PrintDep("recent_call_result.txt", this->column_names_);
 #endif
-
-    return elapsed_milliseconds.count();
 }
 
-void FDep::BuildNegativeCover() {
-    this->neg_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    for (auto i = this->tuples_.begin(); i != this->tuples_.end(); ++i) {
-        for (auto j = i + 1; j != this->tuples_.end(); ++j) AddViolatedFDs(*i, *j);
+template <typename AttrSet>
+std::unique_ptr<FDTreeElement<AttrSet>> FDep::BuildNegativeCover() const {
+    auto neg_cover_tree = std::make_unique<FDTreeElement<AttrSet>>(this->number_attributes_);
+    // Many pairs of tuples share an agree set, each one is added to the tree once
+    fdep::AgreeSetCollector<AttrSet> const collector{this->columns_, this->number_tuples_};
+    for (AttrSet const& agree_set : collector.Collect(this->threads_num_)) {
+        AddViolatedFDs(*neg_cover_tree, agree_set);
     }
 
-    this->neg_cover_tree_->FilterSpecializations();
+    neg_cover_tree->FilterSpecializations();
+    return neg_cover_tree;
 }
 
-void FDep::AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2) {
-    model::Bitset<FDTreeElement::kMaxAttrNum> equal_attr((2 << this->number_attributes_) - 1);
-    equal_attr.reset(0);
-    model::Bitset<FDTreeElement::kMaxAttrNum> diff_attr;
-
-    for (size_t attr = 0; attr < this->number_attributes_; ++attr) {
-        diff_attr[attr + 1] = (t1[attr] != t2[attr]);
-    }
-
-    equal_attr &= (~diff_attr);
-    for (size_t attr = diff_attr._Find_first(); attr != FDTreeElement::kMaxAttrNum;
-         attr = diff_attr._Find_next(attr)) {
-        this->neg_cover_tree_->AddFunctionalDependency(equal_attr, attr);
+template <typename AttrSet>
+void FDep::AddViolatedFDs(FDTreeElement<AttrSet>& neg_cover_tree, AttrSet const& agree_set) const {
+    for (size_t attr = 1; attr <= this->number_attributes_; ++attr) {
+        if (!agree_set.test(attr)) {
+            neg_cover_tree.AddFunctionalDependency(agree_set, attr);
+        }
     }
 }
 
-void FDep::CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
-                                  model::Bitset<FDTreeElement::kMaxAttrNum>& active_path) {
+template <typename AttrSet>
+void FDep::CalculatePositiveCover(FDTreeElement<AttrSet> const& neg_cover_subtree,
+                                  AttrSet& active_path,
+                                  FDTreeElement<AttrSet>& pos_cover_tree) const {
     for (size_t attr = 1; attr <= this->number_attributes_; ++attr) {
         if (neg_cover_subtree.CheckFd(attr - 1)) {
-            this->SpecializePositiveCover(active_path, attr);
+            this->SpecializePositiveCover(active_path, attr, pos_cover_tree);
         }
     }
 
     for (size_t attr = 1; attr <= this->number_attributes_; ++attr) {
         if (neg_cover_subtree.GetChild(attr - 1)) {
             active_path.set(attr);
-            this->CalculatePositiveCover(*neg_cover_subtree.GetChild(attr - 1), active_path);
+            this->CalculatePositiveCover(*neg_cover_subtree.GetChild(attr - 1), active_path,
+                                         pos_cover_tree);
             active_path.reset(attr);
         }
     }
 }
 
-void FDep::SpecializePositiveCover(model::Bitset<FDTreeElement::kMaxAttrNum> const& lhs,
-                                   size_t const& a) {
-    model::Bitset<FDTreeElement::kMaxAttrNum> spec_lhs;
+template <typename AttrSet>
+void FDep::SpecializePositiveCover(AttrSet const& lhs, size_t const& a,
+                                   FDTreeElement<AttrSet>& pos_cover_tree) const {
+    AttrSet spec_lhs = pos_cover_tree.CreateAttrSet();
 
-    while (this->pos_cover_tree_->GetGeneralizationAndDelete(lhs, a, 0, spec_lhs)) {
+    while (pos_cover_tree.GetGeneralizationAndDelete(lhs, a, 0, spec_lhs)) {
         for (size_t attr = this->number_attributes_; attr > 0; --attr) {
             if (!lhs.test(attr) && (attr != a)) {
                 spec_lhs.set(attr);
-                if (!this->pos_cover_tree_->ContainsGeneralization(spec_lhs, a, 0)) {
-                    this->pos_cover_tree_->AddFunctionalDependency(spec_lhs, a);
+                if (!pos_cover_tree.ContainsGeneralization(spec_lhs, a, 0)) {
+                    pos_cover_tree.AddFunctionalDependency(spec_lhs, a);
                 }
                 spec_lhs.reset(attr);
             }
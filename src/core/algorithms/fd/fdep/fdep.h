@@ -4,12 +4,13 @@
 #include <vector>
 
 #include "core/algorithms/fd/fd_algorithm.h"
+#include "core/algorithms/fd/fdep/agree_set_collector.h"
 #include "core/algorithms/fd/fdep/fd_tree_element.h"
 #include "core/config/equal_nulls/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/relation_data.h"
 #include "core/model/table/relational_schema.h"
-#include "core/model/types/bitset.h"
 
 namespace algos {
 
@@ -21,39 +22,48 @@ public:
 
 private:
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_ = 1;
 
     std::shared_ptr<RelationalSchema> schema_{};
 
     std::vector<std::string> column_names_;
     size_t number_attributes_{};
 
-    std::unique_ptr<FDTreeElement> neg_cover_tree_{};
-    std::unique_ptr<FDTreeElement> pos_cover_tree_{};
-
-    std::vector<std::vector<size_t>> tuples_;
+    // Column-major, every value is replaced by its code in the column
+    std::vector<std::vector<fdep::ValueCode>> columns_;
+    size_t number_tuples_{};
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void LoadDataInternal() final;
 
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() final;
 
+    // Discovering FDs with attribute sets of the given type, the narrowest one that fits the
+    // table is chosen at runtime
+    template <typename AttrSet>
+    void DiscoverFds();
+
     // Building negative cover via violated dependencies
-    void BuildNegativeCover();
+    template <typename AttrSet>
+    std::unique_ptr<FDTreeElement<AttrSet>> BuildNegativeCover() const;
 
-    // Iterating over all pairs t1 and t2 of the relation
-    // Adding violated FDs to negative cover tree.
-    void AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2);
+    // Adding FDs violated by a pair of tuples with the given agree set to negative cover tree.
+    template <typename AttrSet>
+    void AddViolatedFDs(FDTreeElement<AttrSet>& neg_cover_tree, AttrSet const& agree_set) const;
 
     // Converting negative cover tree into positive cover tree
-    void CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
-                                model::Bitset<FDTreeElement::kMaxAttrNum>& active_path);
+    template <typename AttrSet>
+    void CalculatePositiveCover(FDTreeElement<AttrSet> const& neg_cover_subtree,
+                                AttrSet& active_path, FDTreeElement<AttrSet>& pos_cover_tree) const;
 
     // Specializing general dependencies for not to be followed from violated dependencies of
     // negative cover tree.
-    void SpecializePositiveCover(model::Bitset<FDTreeElement::kMaxAttrNum> const& lhs,
-                                 size_t const& a);
+    template <typename AttrSet>
+    void SpecializePositiveCover(AttrSet const& lhs, size_t const& a,
+                                 FDTreeElement<AttrSet>& pos_cover_tree) const;
 };
 
 }  // namespace algos
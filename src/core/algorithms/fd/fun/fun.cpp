@@ -1,5 +1,9 @@
 #include "core/algorithms/fd/fun/fun.h"
 
+#include <optional>
+#include <vector>
+
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
 
 namespace algos {
@@ -20,6 +24,15 @@ bool FunQuadruple::Contains(Vertical const& that) const {
     return candidate_.Contains(that);
 }
 
+FUN::FUN() : PliBasedFDAlgorithm() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    UseThreadsForLoading(&threads_num_);
+}
+
+void FUN::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
 void FUN::ResetStateFd() {
     fds_.clear();
 }
@@ -65,18 +78,25 @@ void FUN::PurePrune(Level const& l_k_minus_1, Level& l_k) const {
     }
 }
 
-void FUN::ComputeClosure(Level& l_k_minus_1, Level const& l_k) const {
+void FUN::ComputeClosure(Level& l_k_minus_1, Level const& l_k,
+                         util::WorkerThreadPool* pool) const {
+    // Only the closure of an element is written, FastCount reads candidates and counts
+    std::vector<FunQuadruple*> non_keys;
     for (FunQuadruple& l : l_k_minus_1) {
-        if (IsKey(l)) {
-            continue;
+        if (!IsKey(l)) {
+            non_keys.push_back(&l);
         }
-        l.SetClosure(l.GetQuasiclosure());
+    }
+    ExecIndex(pool, non_keys.size(), [&](std::size_t i) {
+        FunQuadruple& l = *non_keys[i];
+        Vertical closure = l.GetQuasiclosure();
         for (Column const* a : r_prime_.Without(l.GetQuasiclosure()).GetColumns()) {
             if (FastCount(l_k_minus_1, l_k, l.Union(*a)) == l.GetCount()) {
-                l.SetClosure(l.GetClosure().Union(*a));
+                closure = closure.Union(*a);
             }
         }
-    }
+        l.SetClosure(closure);
+    });
 }
 
 void FUN::ComputeQuasiClosure(Level const& l_k_minus_1, Level& l_k) const {
@@ -130,26 +150,33 @@ unsigned long FUN::FastCount(Level const& l_k_minus_1, Level const& l_k,
     return max;
 }
 
-std::list<FunQuadruple> FUN::GenerateCandidate(Level const& l_k) const {
+std::list<FunQuadruple> FUN::GenerateCandidate(Level const& l_k,
+                                               util::WorkerThreadPool* pool) const {
     std::set<FunQuadruple> l_k_plus_1;
     for (FunQuadruple const& l_prime : l_k) {
         if (IsKey(l_prime)) {
             continue;
         }
         for (Column const* a : r_prime_.Without(l_prime.GetCandidate()).GetColumns()) {
-            FunQuadruple l = l_prime.Union(*a);
-            if (l_k_plus_1.find(l) == l_k_plus_1.end()) {
-                l.SetCount(Count(l.GetCandidate()));
-                l_k_plus_1.emplace(l);
-            }
+            l_k_plus_1.emplace(l_prime.Union(*a));
         }
     }
-    return {l_k_plus_1.begin(), l_k_plus_1.end()};
+    // The set only orders the candidates, counting them is independent
+    std::vector<FunQuadruple> candidates(l_k_plus_1.begin(), l_k_plus_1.end());
+    ExecIndex(pool, candidates.size(), [this, &candidates](std::size_t i) {
+        candidates[i].SetCount(Count(candidates[i].GetCandidate()));
+    });
+    return {candidates.begin(), candidates.end()};
 }
 
 unsigned long long FUN::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
     schema_ = relation_->GetSchema();
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool.emplace(threads_num_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? &*pool : nullptr;
     Vertical empty_vertical = schema_->CreateEmptyVertical();
 
     r_ = empty_vertical;
@@ -170,12 +197,12 @@ unsigned long long FUN::ExecuteInternal() {
     }
 
     while (!l_k.empty()) {
-        ComputeClosure(l_k_minus_1, l_k);
+        ComputeClosure(l_k_minus_1, l_k, pool_ptr);
         ComputeQuasiClosure(l_k_minus_1, l_k);
         DisplayFD(l_k_minus_1);
         PurePrune(l_k_minus_1, l_k);
         l_k_minus_1 = l_k;
-        l_k = GenerateCandidate(l_k);
+        l_k = GenerateCandidate(l_k, pool_ptr);
     }
     DisplayFD(l_k_minus_1);
 
@@ -3,7 +3,9 @@
 #include <set>
 
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
+#include "core/config/thread_number/type.h"
 #include "core/util/custom_hashes.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -84,12 +86,16 @@ private:
 
     using Level = std::list<FunQuadruple>;
 
+    config::ThreadNumType threads_num_ = 1;
+
+    void MakeExecuteOptsAvailableFDInternal() final;
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() final;
 
-    Level GenerateCandidate(Level const& l_k) const;
+    // Candidates and closures are computed by the pool if it is not null
+    Level GenerateCandidate(Level const& l_k, util::WorkerThreadPool* pool) const;
 
-    void ComputeClosure(Level& l_k_minus_1, Level const& l_k) const;
+    void ComputeClosure(Level& l_k_minus_1, Level const& l_k, util::WorkerThreadPool* pool) const;
 
     unsigned long Count(Vertical const& l) const;
 
@@ -108,6 +114,19 @@ private:
     std::unordered_map<Column, std::set<Vertical>> fds_;
 
     bool IsKey(FunQuadruple const& l) const;
+
+    static void ExecIndex(util::WorkerThreadPool* pool, std::size_t size, auto func) {
+        if (pool == nullptr) {
+            for (std::size_t i = 0; i < size; ++i) {
+                func(i);
+            }
+        } else {
+            pool->ExecIndex(func, size);
+        }
+    }
+
+public:
+    FUN();
 };
 
 }  // namespace algos
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
@@ -32,6 +33,14 @@ public:
     void Add(boost::dynamic_bitset<>&& column_set);
     void Add(boost::dynamic_bitset<> const& column_set);
 
+    /**
+     * Adds given column combination to the lifetime storage only, e.g. a combination that was
+     * found by an earlier execution and was processed already.
+     */
+    void AddKnown(boost::dynamic_bitset<> column_set) {
+        total_ccs_.insert(std::move(column_set));
+    }
+
     /**
      * @return Number of column sets stored in the last-access storage.
      */
@@ -15,6 +15,13 @@ private:
 public:
     explicit Efficiency(size_t column_id) noexcept : column_id_(column_id) {}
 
+    Efficiency(size_t column_id, unsigned num_violations, unsigned num_comparisons,
+               unsigned window) noexcept
+        : column_id_(column_id),
+          num_violations_(num_violations),
+          num_comparisons_(num_comparisons),
+          window_(window) {}
+
     [[nodiscard]] double CalcEfficiency() const noexcept {
         if (num_comparisons_ == 0) {
             return 0.0;
@@ -43,6 +50,14 @@ public:
         return window_;
     }
 
+    [[nodiscard]] unsigned GetViolations() const noexcept {
+        return num_violations_;
+    }
+
+    [[nodiscard]] unsigned GetComparisons() const noexcept {
+        return num_comparisons_;
+    }
+
     bool operator<(Efficiency const& other) const noexcept {
         return CalcEfficiency() < other.CalcEfficiency();
     }
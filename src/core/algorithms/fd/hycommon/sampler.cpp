@@ -1,16 +1,16 @@
 #include "core/algorithms/fd/hycommon/sampler.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
 #include <boost/dynamic_bitset.hpp>
-#include <boost/thread/future.hpp>
 
 #include "core/algorithms/fd/hycommon/efficiency.h"
 #include "core/algorithms/fd/hycommon/util/pli_util.h"
+#include "core/util/parallel_for.h"
 
 namespace {
 
@@ -135,22 +135,20 @@ void Sampler::ProcessComparisonSuggestions(IdPairs const& comparison_suggestions
 
 void Sampler::SortClustersParallel() {
     ColumnSlider column_slider(plis_->size());
-    std::vector<boost::unique_future<void>> sort_futures;
+    std::vector<std::pair<model::PLI*, ClusterComparator>> sorts;
+    sorts.reserve(plis_->size());
     for (model::PLI* pli : *plis_) {
-        ClusterComparator cluster_comparator(compressed_records_.get(),
-                                             column_slider.GetLeftNeighbor(),
-                                             column_slider.GetRightNeighbor());
-        auto sort = [pli, cluster_comparator]() {
-            for (model::PLI::Cluster& cluster : pli->GetIndex()) {
-                std::sort(cluster.begin(), cluster.end(), cluster_comparator);
-            }
-        };
-        boost::packaged_task<void> task(std::move(sort));
-        sort_futures.push_back(task.get_future());
-        boost::asio::post(*pool_, std::move(task));
+        sorts.emplace_back(pli, ClusterComparator(compressed_records_.get(),
+                                                  column_slider.GetLeftNeighbor(),
+                                                  column_slider.GetRightNeighbor()));
         column_slider.ToNextColumn();
     }
-    boost::wait_for_all(sort_futures.begin(), sort_futures.end());
+    util::ParallelForeach(sorts.begin(), sorts.end(), threads_num_, [](auto& pli_and_comparator) {
+        auto& [pli, cluster_comparator] = pli_and_comparator;
+        for (model::PLI::Cluster& cluster : pli->GetIndex()) {
+            std::sort(cluster.begin(), cluster.end(), cluster_comparator);
+        }
+    });
 }
 
 void Sampler::SortClustersSeq() {
@@ -176,35 +174,27 @@ void Sampler::SortClusters() {
 }
 
 void Sampler::InitializeEfficiencyQueueParallel() {
-    using EfficiencyAndMatches = std::pair<Efficiency, std::vector<boost::dynamic_bitset<>>>;
-    std::vector<boost::unique_future<EfficiencyAndMatches>> futures;
-    for (size_t attr = 0; attr < plis_->size(); ++attr) {
-        auto run_window = [attr, this]() {
-            Efficiency efficiency(attr);
-            return std::make_pair(efficiency, RunWindowRet(efficiency, *(*plis_)[attr]));
-        };
-        boost::packaged_task<EfficiencyAndMatches> task(std::move(run_window));
-        futures.push_back(task.get_future());
-        boost::asio::post(*pool_, std::move(task));
+    size_t const num_attributes = plis_->size();
+    std::vector<Efficiency> efficiencies;
+    efficiencies.reserve(num_attributes);
+    for (size_t attr = 0; attr < num_attributes; ++attr) {
+        efficiencies.emplace_back(attr);
     }
-
-    // TODO(polyntsov): this waiting causes significant overhead on some datasets (on flight_1k
-    // it's probably the highest one). However removing this waiting fully removes overhead on
-    // these problematic datasets, it adds overhead on all other datasets :/
-    // It seems that all problematic datasets spend most of the time on the validation phase, so
-    // multithreading here may add some overhead, but I don't really understand how the explicit
-    // waiting causes it. Further investigation is needed.
-    boost::wait_for_all(futures.begin(), futures.end());
-
-    for (auto& future : futures) {
-        auto [efficiency, matches] = future.get();
-
-        for (auto& match : matches) {
+    std::vector<std::vector<boost::dynamic_bitset<>>> matches(num_attributes);
+    util::ParallelForeach(efficiencies.begin(), efficiencies.end(), threads_num_,
+                          [this, &matches](Efficiency& efficiency) {
+                              size_t const attr = efficiency.GetAttr();
+                              matches[attr] = RunWindowRet(efficiency, *(*plis_)[attr]);
+                          });
+
+    // Merged in the order of the attributes, so the result does not depend on the scheduling
+    for (size_t attr = 0; attr < num_attributes; ++attr) {
+        for (auto& match : matches[attr]) {
             agree_sets_->Add(std::move(match));
         }
 
-        if (efficiency.CalcEfficiency() > 0) {
-            efficiency_queue_.push(efficiency);
+        if (efficiencies[attr].CalcEfficiency() > 0) {
+            efficiency_queue_.push(efficiencies[attr]);
         }
     }
 }
@@ -247,11 +237,6 @@ ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestion
     ProcessComparisonSuggestions(comparison_suggestions);
 
     if (efficiency_queue_.empty()) {
-        if (threads_num_ > 1) {
-            assert(pool_ == nullptr);
-            pool_ = std::make_unique<boost::asio::thread_pool>(threads_num_);
-        }
-
         InitializeEfficiencyQueue();
     } else {
         double const threshold_decrease = 0.9;
@@ -275,6 +260,35 @@ ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestion
     return agree_sets_->MoveOutNewColumnCombinations();
 }
 
+void Sampler::SaveState(util::CheckpointEncoder& encoder) const {
+    encoder.Write(efficiency_threshold_);
+    std::priority_queue<Efficiency> queue = efficiency_queue_;
+    encoder.Write<std::uint64_t>(queue.size());
+    for (; !queue.empty(); queue.pop()) {
+        Efficiency const& efficiency = queue.top();
+        encoder.Write<std::uint64_t>(efficiency.GetAttr());
+        encoder.Write(efficiency.GetViolations());
+        encoder.Write(efficiency.GetComparisons());
+        encoder.Write(efficiency.GetWindow());
+    }
+}
+
+void Sampler::RestoreState(util::CheckpointDecoder& decoder) {
+    efficiency_threshold_ = decoder.Read<double>();
+    auto const queue_size = decoder.Read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < queue_size; ++i) {
+        auto const attr = decoder.Read<std::uint64_t>();
+        auto const num_violations = decoder.Read<unsigned>();
+        auto const num_comparisons = decoder.Read<unsigned>();
+        auto const window = decoder.Read<unsigned>();
+        efficiency_queue_.emplace(attr, num_violations, num_comparisons, window);
+    }
+    // The windows were run over the sorted clusters
+    if (plis_->size() >= 3) {
+        SortClusters();
+    }
+}
+
 void Sampler::Match(boost::dynamic_bitset<>& attributes, size_t first_record_id,
                     size_t second_record_id) {
     assert(first_record_id < compressed_records_->size() &&
@@ -296,11 +310,6 @@ Sampler::Sampler(PLIsPtr plis, RowsPtr pli_records, config::ThreadNumType thread
       agree_sets_(std::make_unique<AllColumnCombinations>(plis_->size())),
       threads_num_(threads) {}
 
-Sampler::~Sampler() {
-    assert(threads_num_ != 0);
-    if (threads_num_ != 1 && pool_ != nullptr) {
-        pool_->join();
-    }
-}
+Sampler::~Sampler() = default;
 
 }  // namespace algos::hy
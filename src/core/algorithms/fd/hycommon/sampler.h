@@ -11,12 +11,7 @@
 #include "core/algorithms/fd/hycommon/types.h"
 #include "core/config/thread_number/type.h"
 #include "core/model/table/position_list_index.h"
-
-namespace boost::asio {
-// Forward declare thread_pool to avoid including boost::asio::thread_pool implementation since
-// it's not needed here and to avoid transitevly pollute all other files with it
-class thread_pool;
-}  // namespace boost::asio
+#include "core/util/checkpoint_file.h"
 
 namespace algos::hy {
 
@@ -30,7 +25,6 @@ private:
     std::priority_queue<Efficiency> efficiency_queue_;
     std::unique_ptr<AllColumnCombinations> agree_sets_;
     config::ThreadNumType threads_num_;
-    std::unique_ptr<boost::asio::thread_pool> pool_;
 
     void ProcessComparisonSuggestions(IdPairs const& comparison_suggestions);
     void SortClustersSeq();
@@ -59,6 +53,22 @@ public:
     ~Sampler();
 
     ColumnCombinationList GetAgreeSets(IdPairs const& comparison_suggestions);
+
+    /**
+     * Saves the progress of the sampling, i.e. the threshold and the windows of the columns. The
+     * agree sets found so far are not saved, they are passed to AddKnownAgreeSet on restore.
+     */
+    void SaveState(::util::CheckpointEncoder& encoder) const;
+    /**
+     * Continues the sampling saved by SaveState, must be called before the first GetAgreeSets.
+     */
+    void RestoreState(::util::CheckpointDecoder& decoder);
+    /**
+     * Makes GetAgreeSets skip the agree set, which was returned by an earlier execution.
+     */
+    void AddKnownAgreeSet(boost::dynamic_bitset<> agree_set) {
+        agree_sets_->AddKnown(std::move(agree_set));
+    }
 };
 
 }  // namespace algos::hy
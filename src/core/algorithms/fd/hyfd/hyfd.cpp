@@ -14,24 +14,37 @@
 #include "core/algorithms/fd/hyfd/inductor.h"
 #include "core/algorithms/fd/hyfd/sampler.h"
 #include "core/algorithms/fd/hyfd/validator.h"
+#include "core/config/checkpoint/option.h"
+#include "core/config/memory_budget/option.h"
 #include "core/config/names.h"
 #include "core/config/thread_number/option.h"
+#include "core/config/time_limit/option.h"
 #include "core/util/logger.h"
 
 namespace algos::hyfd {
 
 HyFD::HyFD() : PliBasedFDAlgorithm() {
     RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterOption(config::kMemoryBudgetMbOpt(&memory_budget_mb_));
+    RegisterOption(config::kCheckpointPathOpt(&checkpoint_path_));
+    RegisterOption(config::kCheckpointIntervalOpt(&checkpoint_interval_));
+    UseThreadsForLoading(&threads_num_);
 }
 
 void HyFD::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::names::kThreads});
+    MakeOptionsAvailable({config::names::kThreads, config::names::kTimeLimitSeconds,
+                          config::names::kMemoryBudgetMB, config::names::kCheckpointPath,
+                          config::names::kCheckpointInterval});
 }
 
 unsigned long long HyFD::ExecuteInternal() {
     using namespace hy;
     LOG_TRACE("Executing");
     auto const start_time = std::chrono::system_clock::now();
+    auto& cancellation_token = GetCancellationToken();
+    cancellation_token.Start(std::chrono::seconds(time_limit_seconds_),
+                             static_cast<std::size_t>(memory_budget_mb_) << 20);
 
     auto [plis, pli_records, og_mapping] = Preprocess(relation_.get());
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
@@ -39,15 +52,29 @@ unsigned long long HyFD::ExecuteInternal() {
 
     Sampler sampler(plis_shared, pli_records_shared, threads_num_);
 
-    auto const positive_cover_tree =
-            std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns());
-    Inductor inductor(positive_cover_tree);
-    Validator validator(positive_cover_tree, plis_shared, pli_records_shared, threads_num_);
-
+    auto const checkpoint = OpenCheckpoint(checkpoint_path_, checkpoint_interval_, "hyfd");
+    std::shared_ptr<fd_tree::FDTree> positive_cover_tree;
+    unsigned level_num = 0;
     IdPairs comparison_suggestions;
+    if (checkpoint != nullptr) {
+        positive_cover_tree = Resume(*checkpoint, sampler, level_num, comparison_suggestions);
+    }
+    if (positive_cover_tree == nullptr) {
+        positive_cover_tree = std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns());
+    }
+    Inductor inductor(positive_cover_tree, threads_num_);
+    Validator validator(positive_cover_tree, plis_shared, pli_records_shared, threads_num_,
+                        cancellation_token);
+    validator.SetLevelNum(level_num);
 
-    while (true) {
+    while (!cancellation_token.IsCancelled()) {
         auto non_fds = sampler.GetNonFDs(comparison_suggestions);
+        if (cancellation_token.IsCancelled()) {
+            break;
+        }
+        if (checkpoint != nullptr) {
+            SaveNonFds(*checkpoint, non_fds);
+        }
 
         inductor.UpdateFdTree(std::move(non_fds));
 
@@ -56,11 +83,24 @@ unsigned long long HyFD::ExecuteInternal() {
         if (comparison_suggestions.empty()) {
             break;
         }
+        if (checkpoint != nullptr && checkpoint->IsSnapshotDue()) {
+            SaveState(*checkpoint, sampler, *positive_cover_tree, validator.GetLevelNum(),
+                      comparison_suggestions);
+        }
 
         LOG_TRACE("Cycle done");
     }
+    if (checkpoint != nullptr && IsComplete()) {
+        checkpoint->Remove();
+    }
 
     auto fds = positive_cover_tree->FillFDs();
+    if (cancellation_token.WasCancelled()) {
+        // Only the candidates of the levels the validator has gone through are known to hold
+        std::erase_if(fds, [level = validator.GetLevelNum()](RawFD const& fd) {
+            return fd.lhs_.count() >= level;
+        });
+    }
     RegisterFDs(std::move(fds), og_mapping);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -68,17 +108,80 @@ unsigned long long HyFD::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
+std::shared_ptr<fd_tree::FDTree> HyFD::Resume(util::CheckpointFile& checkpoint, Sampler& sampler,
+                                              unsigned& level_num,
+                                              hy::IdPairs& comparison_suggestions) {
+    std::vector<util::CheckpointFile::Record> const& records = checkpoint.GetRecords();
+    auto const snapshot = std::find_if(records.rbegin(), records.rend(),
+                                       [](auto const& record) { return record.kind == kState; });
+    // The non-FDs sampled after the snapshot will be sampled again
+    std::size_t const num_kept = records.rend() - snapshot;
+    if (snapshot == records.rend()) {
+        checkpoint.DiscardAfter(0);
+        return nullptr;
+    }
+    for (std::size_t i = 0; i + 1 < num_kept; ++i) {
+        if (records[i].kind != kNonFds) continue;
+        util::CheckpointDecoder decoder{records[i].payload};
+        while (!decoder.AtEnd()) {
+            sampler.AddKnownNonFd(decoder.ReadBitset());
+        }
+    }
+
+    util::CheckpointDecoder decoder{snapshot->payload};
+    level_num = decoder.Read<std::uint32_t>();
+    sampler.RestoreState(decoder);
+    auto const num_suggestions = decoder.Read<std::uint64_t>();
+    comparison_suggestions.clear();
+    for (std::uint64_t i = 0; i < num_suggestions; ++i) {
+        auto const first_id = decoder.Read<hy::TablePos>();
+        auto const second_id = decoder.Read<hy::TablePos>();
+        comparison_suggestions.emplace_back(first_id, second_id);
+    }
+    std::vector<RawFD> fds;
+    while (!decoder.AtEnd()) {
+        boost::dynamic_bitset<> lhs = decoder.ReadBitset();
+        fds.emplace_back(std::move(lhs), decoder.Read<std::uint32_t>());
+    }
+    checkpoint.DiscardAfter(num_kept);
+    LOG_INFO("Resuming from validator level {} with {} candidate FDs", level_num, fds.size());
+    return std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns(), fds);
+}
+
+void HyFD::SaveNonFds(util::CheckpointFile& checkpoint, NonFDList const& non_fds) {
+    util::CheckpointEncoder encoder;
+    for (std::size_t level = 0; level <= non_fds.GetNumAttributes(); ++level) {
+        for (boost::dynamic_bitset<> const& non_fd : non_fds.GetLevel(level)) {
+            encoder.Write(non_fd);
+        }
+    }
+    checkpoint.Append(kNonFds, encoder.Release());
+}
+
+void HyFD::SaveState(util::CheckpointFile& checkpoint, Sampler const& sampler,
+                     fd_tree::FDTree const& tree, unsigned level_num,
+                     hy::IdPairs const& comparison_suggestions) {
+    util::CheckpointEncoder encoder;
+    encoder.Write<std::uint32_t>(level_num);
+    sampler.SaveState(encoder);
+    encoder.Write<std::uint64_t>(comparison_suggestions.size());
+    for (auto const& [first_id, second_id] : comparison_suggestions) {
+        encoder.Write(first_id);
+        encoder.Write(second_id);
+    }
+    for (RawFD const& fd : tree.FillFDs()) {
+        encoder.Write(fd.lhs_);
+        encoder.Write<std::uint32_t>(fd.rhs_);
+    }
+    checkpoint.AppendSnapshot(kState, encoder.Release());
+}
+
 void HyFD::RegisterFDs(std::vector<RawFD>&& fds, std::vector<hy::ClusterId> const& og_mapping) {
     auto const* const schema = GetRelation().GetSchema();
     for (auto&& [lhs, rhs] : fds) {
         boost::dynamic_bitset<> mapped_lhs =
                 hy::RestoreAgreeSet(lhs, og_mapping, schema->GetNumColumns());
-        Vertical lhs_v(schema, std::move(mapped_lhs));
-
-        auto const mapped_rhs = og_mapping[rhs];
-        Column rhs_c(schema, schema->GetColumn(mapped_rhs)->GetName(), mapped_rhs);
-
-        RegisterFd(std::move(lhs_v), std::move(rhs_c), relation_->GetSharedPtrSchema());
+        RegisterFd(mapped_lhs, og_mapping[rhs], relation_->GetSharedPtrSchema());
     }
 }
 
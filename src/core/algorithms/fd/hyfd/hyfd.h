@@ -1,18 +1,27 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "core/algorithms/fd/hycommon/types.h"
+#include "core/algorithms/fd/hyfd/model/fd_tree.h"
+#include "core/algorithms/fd/hyfd/model/non_fd_list.h"
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/raw_fd.h"
+#include "core/config/checkpoint/type.h"
+#include "core/config/memory_budget/type.h"
 #include "core/config/thread_number/type.h"
+#include "core/config/time_limit/type.h"
 #include "core/model/table/position_list_index.h"
+#include "core/util/checkpoint_file.h"
 
 namespace algos::hyfd {
 
+class Sampler;
+
 /**
  * HyFD is a hybrid functional dependency discovery algorithm, employing both row-efficient
  * sample-based agree set generation and column-efficient lattice traversal.
@@ -38,8 +47,22 @@ namespace algos::hyfd {
  */
 class HyFD : public PliBasedFDAlgorithm {
 private:
+    // Kinds of the checkpoint records: the non-FDs sampled in a cycle and a snapshot of the
+    // validator level, the sampler, the comparison suggestions and the candidate FDs
+    enum CheckpointRecordKind : std::uint32_t { kNonFds, kState };
+
     void ResetStateFd() final {}
 
+    // Returns the tree of the last snapshot of the checkpoint and restores the rest of it, nullptr
+    // if there is nothing to resume from
+    std::shared_ptr<fd_tree::FDTree> Resume(util::CheckpointFile& checkpoint, Sampler& sampler,
+                                            unsigned& level_num,
+                                            hy::IdPairs& comparison_suggestions);
+    static void SaveNonFds(util::CheckpointFile& checkpoint, NonFDList const& non_fds);
+    static void SaveState(util::CheckpointFile& checkpoint, Sampler const& sampler,
+                          fd_tree::FDTree const& tree, unsigned level_num,
+                          hy::IdPairs const& comparison_suggestions);
+
     unsigned long long ExecuteInternal() override;
 
     void RegisterFDs(std::vector<RawFD>&& fds, std::vector<algos::hy::ClusterId> const& og_mapping);
@@ -47,6 +70,10 @@ private:
     void MakeExecuteOptsAvailableFDInternal() override;
 
     config::ThreadNumType threads_num_ = 1;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::MemoryBudgetMBType memory_budget_mb_ = 0;
+    config::CheckpointPathType checkpoint_path_;
+    config::CheckpointIntervalType checkpoint_interval_;
 
 public:
     HyFD();
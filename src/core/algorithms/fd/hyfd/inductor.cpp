@@ -1,10 +1,25 @@
 #include "core/algorithms/fd/hyfd/inductor.h"
 
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
+#include "core/util/parallel_for.h"
+
 namespace algos::hyfd {
 
 void Inductor::UpdateFdTree(NonFDList&& non_fds) {
+    if (threads_num_ > 1) {
+        UpdateFdTreePar(non_fds);
+    } else {
+        UpdateFdTreeSeq(non_fds);
+    }
+}
+
+void Inductor::UpdateFdTreeSeq(NonFDList const& non_fds) {
     unsigned const max_level = non_fds.GetDepth();
 
     for (unsigned level = max_level; level != 0; level--) {
@@ -14,31 +29,77 @@ void Inductor::UpdateFdTree(NonFDList&& non_fds) {
 
             for (size_t rhs_id = rhs_bits.find_first(); rhs_id != boost::dynamic_bitset<>::npos;
                  rhs_id = rhs_bits.find_next(rhs_id)) {
-                SpecializeTreeForNonFd(lhs_bits, rhs_id);
+                SpecializeTreeForNonFd(*tree_, lhs_bits, rhs_id);
+            }
+        }
+    }
+}
+
+void Inductor::UpdateFdTreePar(NonFDList const& non_fds) {
+    size_t const num_attributes = tree_->GetNumAttributes();
+    unsigned const max_level = non_fds.GetDepth();
+    boost::dynamic_bitset<> all_attributes(num_attributes);
+    all_attributes.set();
+
+    // Specialization for an RHS only reads and changes FDs with this RHS, so specializing the RHSs
+    // one by one in the order of UpdateFdTreeSeq yields the same FDs as the sequential version
+    std::vector<std::vector<boost::dynamic_bitset<>>> removed_lhss(num_attributes);
+    std::vector<std::vector<boost::dynamic_bitset<>>> added_lhss(num_attributes);
+    std::vector<size_t> rhss(num_attributes);
+    std::iota(rhss.begin(), rhss.end(), 0);
+    util::ParallelForeach(rhss.begin(), rhss.end(), threads_num_, [&](size_t rhs_id) {
+        // The shared tree is not changed until every RHS is specialized
+        std::vector<boost::dynamic_bitset<>> old_lhss =
+                tree_->GetFdAndGenerals(all_attributes, rhs_id);
+        fd_tree::FDTree rhs_tree(num_attributes, old_lhss, rhs_id);
+        for (unsigned level = max_level; level != 0; level--) {
+            for (auto const& lhs_bits : non_fds.GetLevel(level)) {
+                if (!lhs_bits.test(rhs_id)) {
+                    SpecializeTreeForNonFd(rhs_tree, lhs_bits, rhs_id);
+                }
             }
         }
+        std::vector<boost::dynamic_bitset<>> new_lhss =
+                rhs_tree.GetFdAndGenerals(all_attributes, rhs_id);
+
+        std::sort(old_lhss.begin(), old_lhss.end());
+        std::sort(new_lhss.begin(), new_lhss.end());
+        std::set_difference(old_lhss.begin(), old_lhss.end(), new_lhss.begin(), new_lhss.end(),
+                            std::back_inserter(removed_lhss[rhs_id]));
+        std::set_difference(new_lhss.begin(), new_lhss.end(), old_lhss.begin(), old_lhss.end(),
+                            std::back_inserter(added_lhss[rhs_id]));
+    });
+
+    for (size_t rhs_id = 0; rhs_id < num_attributes; ++rhs_id) {
+        for (auto const& lhs_bits : removed_lhss[rhs_id]) {
+            tree_->Remove(lhs_bits, rhs_id);
+        }
+        for (auto const& lhs_bits : added_lhss[rhs_id]) {
+            tree_->AddFD(lhs_bits, rhs_id);
+        }
     }
 }
 
-void Inductor::SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id) {
-    auto invalid_lhss = tree_->GetFdAndGenerals(lhs_bits, rhs_id);
+void Inductor::SpecializeTreeForNonFd(fd_tree::FDTree& tree,
+                                      boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id) {
+    auto invalid_lhss = tree.GetFdAndGenerals(lhs_bits, rhs_id);
 
     for (auto& invalid_lhs_bits : invalid_lhss) {
-        tree_->Remove(invalid_lhs_bits, rhs_id);
+        tree.Remove(invalid_lhs_bits, rhs_id);
 
-        for (size_t i = 0; i < tree_->GetNumAttributes(); ++i) {
+        for (size_t i = 0; i < tree.GetNumAttributes(); ++i) {
             if (i == rhs_id || lhs_bits.test(i)) {
                 continue;
             }
 
             invalid_lhs_bits.set(i);
 
-            if (tree_->FindFdOrGeneral(invalid_lhs_bits, rhs_id)) {
+            if (tree.FindFdOrGeneral(invalid_lhs_bits, rhs_id)) {
                 invalid_lhs_bits.reset(i);
                 continue;
             }
 
-            tree_->AddFD(invalid_lhs_bits, rhs_id);
+            tree.AddFD(invalid_lhs_bits, rhs_id);
             invalid_lhs_bits.reset(i);
         }
     }
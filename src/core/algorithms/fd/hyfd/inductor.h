@@ -1,20 +1,35 @@
 #pragma once
 
+#include <memory>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "core/algorithms/fd/hyfd/model/fd_tree.h"
 #include "core/algorithms/fd/hyfd/model/non_fd_list.h"
+#include "core/config/thread_number/type.h"
 
 namespace algos::hyfd {
 
 class Inductor {
 private:
     std::shared_ptr<fd_tree::FDTree> tree_;
+    config::ThreadNumType threads_num_;
+
+    static void SpecializeTreeForNonFd(fd_tree::FDTree& tree,
+                                       boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
+
+    void UpdateFdTreeSeq(NonFDList const& non_fds);
 
-    void SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
+    /**
+     * Specializes the FDs of every RHS in a separate tree on its own thread, then replaces the
+     * changed FDs in the shared tree.
+     */
+    void UpdateFdTreePar(NonFDList const& non_fds);
 
 public:
-    explicit Inductor(std::shared_ptr<fd_tree::FDTree> tree) noexcept : tree_(std::move(tree)) {}
+    explicit Inductor(std::shared_ptr<fd_tree::FDTree> tree,
+                      config::ThreadNumType threads_num = 1) noexcept
+        : tree_(std::move(tree)), threads_num_(threads_num) {}
 
     void UpdateFdTree(NonFDList&& non_fds);
 };
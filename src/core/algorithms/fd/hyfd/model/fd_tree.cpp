@@ -1,22 +1,21 @@
 #include "core/algorithms/fd/hyfd/model/fd_tree.h"
 
-#include <memory>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 namespace algos::hyfd::fd_tree {
 
-std::shared_ptr<FDTreeVertex> FDTree::AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
-    FDTreeVertex* cur_node = root_.get();
+FDTreeVertex* FDTree::AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
+    FDTreeVertex* cur_node = root_;
     cur_node->SetAttribute(rhs);
 
     for (size_t bit = lhs.find_first(); bit != boost::dynamic_bitset<>::npos;
          bit = lhs.find_next(bit)) {
-        bool is_new = cur_node->AddChild(bit);
+        bool is_new = cur_node->AddChild(bit, pool_);
 
         if (is_new && lhs.find_next(bit) == boost::dynamic_bitset<>::npos) {
-            auto added_node = cur_node->GetChildPtr(bit);
+            FDTreeVertex* added_node = cur_node->GetChild(bit);
             added_node->SetAttribute(rhs);
             added_node->SetFd(rhs);
             return added_node;
@@ -30,7 +29,7 @@ std::shared_ptr<FDTreeVertex> FDTree::AddFD(boost::dynamic_bitset<> const& lhs,
 }
 
 bool FDTree::ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
-    FDTreeVertex const* cur_node = root_.get();
+    FDTreeVertex const* cur_node = root_;
 
     for (size_t bit = lhs.find_first(); bit != boost::dynamic_bitset<>::npos;
          bit = lhs.find_next(bit)) {
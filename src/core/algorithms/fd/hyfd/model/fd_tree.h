@@ -1,6 +1,5 @@
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
@@ -19,20 +18,47 @@ namespace algos::hyfd::fd_tree {
  */
 class FDTree {
 private:
-    std::shared_ptr<FDTreeVertex> root_;
+    FDTreeVertexPool pool_;
+    FDTreeVertex* root_;
 
 public:
-    explicit FDTree(size_t num_attributes) : root_(std::make_shared<FDTreeVertex>(num_attributes)) {
+    /**
+     * Constructs the tree of the most general candidates, i.e. FDs with empty LHS.
+     */
+    explicit FDTree(size_t num_attributes) : pool_(num_attributes), root_(pool_.Acquire()) {
         for (size_t id = 0; id < num_attributes; id++) {
             root_->SetFd(id);
         }
     }
 
+    /**
+     * Constructs the tree of FDs with given LHSs and RHS.
+     */
+    FDTree(size_t num_attributes, std::vector<boost::dynamic_bitset<>> const& lhss, size_t rhs)
+        : pool_(num_attributes), root_(pool_.Acquire()) {
+        for (auto const& lhs : lhss) {
+            AddFD(lhs, rhs);
+        }
+    }
+
+    /**
+     * Constructs the tree of the given FDs.
+     */
+    FDTree(size_t num_attributes, std::vector<RawFD> const& fds)
+        : pool_(num_attributes), root_(pool_.Acquire()) {
+        for (auto const& [lhs, rhs] : fds) {
+            AddFD(lhs, rhs);
+        }
+    }
+
+    FDTree(FDTree const&) = delete;
+    FDTree& operator=(FDTree const&) = delete;
+
     [[nodiscard]] size_t GetNumAttributes() const noexcept {
         return root_->GetNumAttributes();
     }
 
-    std::shared_ptr<FDTreeVertex> GetRootPtr() noexcept {
+    FDTreeVertex* GetRootPtr() noexcept {
         return root_;
     }
 
@@ -40,7 +66,7 @@ public:
         return *root_;
     }
 
-    std::shared_ptr<FDTreeVertex> AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
+    FDTreeVertex* AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
 
     bool ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
 
@@ -49,7 +75,7 @@ public:
      * Destroys vertices whose children became empty.
      */
     void Remove(boost::dynamic_bitset<> const& lhs, size_t rhs) {
-        root_->RemoveRecursive(lhs, rhs, lhs.find_first());
+        root_->RemoveRecursive(lhs, rhs, lhs.find_first(), pool_);
     }
 
     /**
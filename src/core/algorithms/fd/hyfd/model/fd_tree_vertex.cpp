@@ -11,7 +11,7 @@ void FDTreeVertex::GetLevelRecursive(unsigned target_level, unsigned cur_level,
                                      boost::dynamic_bitset<> lhs, std::vector<LhsPair>& vertices) {
     if (cur_level == target_level) {
         if (fds_.any()) {
-            vertices.emplace_back(shared_from_this(), lhs);
+            vertices.emplace_back(this, lhs);
         }
         return;
     }
@@ -73,8 +73,22 @@ bool FDTreeVertex::FindFdOrGeneralRecursive(boost::dynamic_bitset<> const& lhs,
     return FindFdOrGeneralRecursive(lhs, rhs, lhs.find_next(cur_bit));
 }
 
+bool FDTreeVertex::AddChild(size_t pos, FDTreeVertexPool& pool) {
+    if (children_.empty()) {
+        children_.resize(num_attributes_);
+    }
+
+    if (!ContainsChildAt(pos)) {
+        children_[pos] = pool.Acquire();
+        children_count_++;
+        return true;
+    }
+
+    return false;
+}
+
 bool FDTreeVertex::RemoveRecursive(boost::dynamic_bitset<> const& lhs, size_t rhs,
-                                   size_t current_lhs_attr) {
+                                   size_t current_lhs_attr, FDTreeVertexPool& pool) {
     if (current_lhs_attr == boost::dynamic_bitset<>::npos) {
         RemoveFd(rhs);
         RemoveAttribute(rhs);
@@ -82,12 +96,13 @@ bool FDTreeVertex::RemoveRecursive(boost::dynamic_bitset<> const& lhs, size_t rh
     }
 
     if (HasChildren() && ContainsChildAt(current_lhs_attr)) {
-        if (!children_[current_lhs_attr]->RemoveRecursive(lhs, rhs,
-                                                          lhs.find_next(current_lhs_attr))) {
+        if (!children_[current_lhs_attr]->RemoveRecursive(lhs, rhs, lhs.find_next(current_lhs_attr),
+                                                          pool)) {
             return false;
         }
 
         if (!children_[current_lhs_attr]->GetAttributes().any()) {
+            pool.Release(children_[current_lhs_attr]);
             children_[current_lhs_attr] = nullptr;
             children_count_--;
         }
@@ -109,7 +124,7 @@ bool FDTreeVertex::IsLastNodeOf(size_t rhs) const noexcept {
     });
 }
 
-std::shared_ptr<FDTreeVertex> FDTreeVertex::GetChildIfExists(size_t pos) const {
+FDTreeVertex* FDTreeVertex::GetChildIfExists(size_t pos) const {
     if (children_.empty()) {
         return nullptr;
     }
@@ -139,4 +154,29 @@ void FDTreeVertex::FillFDs(std::vector<RawFD>& fds, boost::dynamic_bitset<>& lhs
     }
 }
 
+FDTreeVertex* FDTreeVertexPool::Acquire() {
+    if (free_vertices_.empty()) {
+        return &vertices_.emplace_back(num_attributes_);
+    }
+    FDTreeVertex* vertex = free_vertices_.back();
+    free_vertices_.pop_back();
+    return vertex;
+}
+
+void FDTreeVertexPool::Release(FDTreeVertex* vertex) {
+    if (vertex->HasChildren()) {
+        for (FDTreeVertex*& child : vertex->children_) {
+            if (child != nullptr) {
+                Release(child);
+                child = nullptr;
+            }
+        }
+    }
+    // The storage of the vertex is kept for its next use
+    vertex->children_count_ = 0;
+    vertex->fds_.reset();
+    vertex->attributes_.reset();
+    free_vertices_.push_back(vertex);
+}
+
 }  // namespace algos::hyfd::fd_tree
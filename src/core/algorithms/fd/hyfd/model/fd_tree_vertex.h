@@ -1,6 +1,7 @@
 #pragma once
 
-#include <memory>
+#include <cstddef>
+#include <deque>
 #include <utility>
 #include <vector>
 
@@ -11,11 +12,12 @@
 namespace algos::hyfd::fd_tree {
 
 class FDTreeVertex;
+class FDTreeVertexPool;
 
 /**
  * Pair of pointer to FD tree node and the corresponding LHS.
  */
-using LhsPair = std::pair<std::shared_ptr<FDTreeVertex>, boost::dynamic_bitset<>>;
+using LhsPair = std::pair<FDTreeVertex*, boost::dynamic_bitset<>>;
 
 /**
  * Node of FD prefix tree.
@@ -25,10 +27,13 @@ using LhsPair = std::pair<std::shared_ptr<FDTreeVertex>, boost::dynamic_bitset<>
  * position 1. If we go first to child 1, it will not contain child 0.
  *
  * RHS of the FD is represented by the fds attribute of the node.
+ *
+ * Vertices are owned by the FDTreeVertexPool of their tree, children are referenced by raw
+ * pointers.
  */
-class FDTreeVertex : public std::enable_shared_from_this<FDTreeVertex> {
+class FDTreeVertex {
 private:
-    std::vector<std::shared_ptr<FDTreeVertex>> children_;
+    std::vector<FDTreeVertex*> children_;
     boost::dynamic_bitset<> fds_;
 
     /**
@@ -47,9 +52,10 @@ private:
     size_t children_count_ = 0;
 
     friend class FDTree;
+    friend class FDTreeVertexPool;
 
     FDTreeVertex* GetChild(size_t pos) {
-        return children_.at(pos).get();
+        return children_.at(pos);
     }
 
     void SetFd(size_t pos) {
@@ -76,21 +82,10 @@ private:
      * Constructs empty child node at the given position. Does nothing if the child already exists.
      *
      * @param pos child position
+     * @param pool pool of the tree to take the child from
      * @return whether a child was constructed
      */
-    bool AddChild(size_t pos) {
-        if (children_.empty()) {
-            children_.resize(num_attributes_);
-        }
-
-        if (!ContainsChildAt(pos)) {
-            children_[pos] = std::make_shared<FDTreeVertex>(num_attributes_);
-            children_count_++;
-            return true;
-        }
-
-        return false;
-    }
+    bool AddChild(size_t pos, FDTreeVertexPool& pool);
 
     void GetLevelRecursive(unsigned target_level, unsigned cur_level, boost::dynamic_bitset<> lhs,
                            std::vector<LhsPair>& vertices);
@@ -102,7 +97,8 @@ private:
     bool FindFdOrGeneralRecursive(boost::dynamic_bitset<> const& lhs, size_t rhs,
                                   size_t cur_bit) const;
 
-    bool RemoveRecursive(boost::dynamic_bitset<> const& lhs, size_t rhs, size_t current_lhs_attr);
+    bool RemoveRecursive(boost::dynamic_bitset<> const& lhs, size_t rhs, size_t current_lhs_attr,
+                         FDTreeVertexPool& pool);
 
     bool IsLastNodeOf(size_t rhs) const noexcept;
 
@@ -136,15 +132,11 @@ public:
         return fds_.test(pos);
     }
 
-    std::shared_ptr<FDTreeVertex> GetChildPtr(size_t pos) {
-        return children_.at(pos);
-    }
-
     FDTreeVertex const* GetChild(size_t pos) const {
-        return children_.at(pos).get();
+        return children_.at(pos);
     }
 
-    std::shared_ptr<FDTreeVertex> GetChildIfExists(size_t pos) const;
+    FDTreeVertex* GetChildIfExists(size_t pos) const;
 
     bool ContainsChildAt(size_t pos) const {
         return children_.at(pos) != nullptr;
@@ -155,4 +147,34 @@ public:
     }
 };
 
+/**
+ * Storage of the vertices of one FDTree.
+ *
+ * Specialization of the tree constantly destroys and creates vertices. Instead of allocating each
+ * of them separately, the pool keeps them in chunks and reuses the released ones.
+ */
+class FDTreeVertexPool {
+private:
+    // Elements of a deque are not relocated when it grows
+    std::deque<FDTreeVertex> vertices_;
+    std::vector<FDTreeVertex*> free_vertices_;
+    size_t num_attributes_;
+
+public:
+    explicit FDTreeVertexPool(size_t num_attributes) noexcept : num_attributes_(num_attributes) {}
+
+    FDTreeVertexPool(FDTreeVertexPool const&) = delete;
+    FDTreeVertexPool& operator=(FDTreeVertexPool const&) = delete;
+
+    /**
+     * @return empty vertex
+     */
+    FDTreeVertex* Acquire();
+
+    /**
+     * Returns the vertex and all its descendants to the pool.
+     */
+    void Release(FDTreeVertex* vertex);
+};
+
 }  // namespace algos::hyfd::fd_tree
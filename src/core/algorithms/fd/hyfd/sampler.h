@@ -15,6 +15,18 @@ public:
     NonFDList GetNonFDs(hy::IdPairs const& comparison_suggestions) {
         return sampler_.GetAgreeSets(comparison_suggestions);
     }
+
+    void SaveState(util::CheckpointEncoder& encoder) const {
+        sampler_.SaveState(encoder);
+    }
+
+    void RestoreState(util::CheckpointDecoder& decoder) {
+        sampler_.RestoreState(decoder);
+    }
+
+    void AddKnownNonFd(boost::dynamic_bitset<> non_fd) {
+        sampler_.AddKnownAgreeSet(std::move(non_fd));
+    }
 };
 
 }  // namespace algos::hyfd
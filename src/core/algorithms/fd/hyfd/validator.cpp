@@ -1,17 +1,16 @@
 #include "core/algorithms/fd/hyfd/validator.h"
 
 #include <algorithm>
-#include <future>
+#include <numeric>
 #include <utility>
 #include <vector>
 
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
 #include <boost/dynamic_bitset.hpp>
 
 #include "core/algorithms/fd/hycommon/util/pli_util.h"
 #include "core/algorithms/fd/hycommon/validator_helpers.h"
 #include "core/algorithms/fd/hyfd/hyfd_config.h"
+#include "core/util/parallel_for.h"
 
 namespace {
 
@@ -131,7 +130,7 @@ size_t AddExtendedCandidatesFromInvalid(std::vector<algos::hyfd::LhsPair>& next_
             if (child == nullptr) {
                 continue;
             }
-            next_level.emplace_back(std::move(child), std::move(lhs_ext));
+            next_level.emplace_back(child, std::move(lhs_ext));
             candidates++;
         }
     }
@@ -243,6 +242,9 @@ Validator::FDValidations Validator::GetValidations(LhsPair const& lhsPair) {
 Validator::FDValidations Validator::ValidateAndExtendSeq(std::vector<LhsPair> const& vertices) {
     FDValidations result;
     for (auto const& vertex : vertices) {
+        if (cancellation_token_.IsCancelled()) {
+            break;
+        }
         result.Add(GetValidations(vertex));
     }
 
@@ -250,23 +252,20 @@ Validator::FDValidations Validator::ValidateAndExtendSeq(std::vector<LhsPair> co
 }
 
 Validator::FDValidations Validator::ValidateAndExtendPar(std::vector<LhsPair> const& vertices) {
-    FDValidations result;
-    boost::asio::thread_pool pool(threads_num_);
-    std::vector<std::future<FDValidations>> validation_futures;
-    validation_futures.reserve(vertices.size());
+    // Collected per vertex and merged in order, so the result does not depend on the scheduling
+    std::vector<FDValidations> validations(vertices.size());
+    std::vector<std::size_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_,
+                          [this, &vertices, &validations](std::size_t i) {
+                              if (!cancellation_token_.IsCancelled()) {
+                                  validations[i] = GetValidations(vertices[i]);
+                              }
+                          });
 
-    for (auto const& vertex : vertices) {
-        std::packaged_task<FDValidations()> task(
-                [this, &vertex]() { return GetValidations(vertex); });
-        validation_futures.push_back(task.get_future());
-        boost::asio::post(pool, std::move(task));
-    }
-
-    pool.join();
-
-    for (auto&& future : validation_futures) {
-        assert(future.valid());
-        result.Add(future.get());
+    FDValidations result;
+    for (FDValidations const& vertex_validations : validations) {
+        result.Add(vertex_validations);
     }
 
     return result;
@@ -292,6 +291,10 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
         } else {
             result = ValidateAndExtendSeq(cur_level_vertices);
         }
+        // The level is validated only partially, its candidates are not specialized
+        if (cancellation_token_.WasCancelled()) {
+            return {};
+        }
 
         comparison_suggestions.insert(comparison_suggestions.end(),
                                       result.ComparisonSuggestions().begin(),
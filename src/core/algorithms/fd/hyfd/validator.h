@@ -10,6 +10,7 @@
 #include "core/config/thread_number/type.h"
 #include "core/model/table/position_list_index.h"
 #include "core/model/types/types.h"
+#include "core/util/cancellation_token.h"
 
 namespace algos::hyfd {
 
@@ -36,21 +37,38 @@ private:
 
     FDValidations ValidateAndExtendPar(std::vector<LhsPair> const& vertices);
 
-    [[nodiscard]] unsigned GetLevelNum() const {
-        return current_level_number_;
-    }
-
     config::ThreadNumType threads_num_ = 1;
+    util::CancellationToken& cancellation_token_;
 
 public:
     Validator(std::shared_ptr<fd_tree::FDTree> fds, hy::PLIsPtr plis,
-              hy::RowsPtr compressed_records, config::ThreadNumType threads_num) noexcept
+              hy::RowsPtr compressed_records, config::ThreadNumType threads_num,
+              util::CancellationToken& cancellation_token) noexcept
         : fds_(std::move(fds)),
           plis_(std::move(plis)),
           compressed_records_(std::move(compressed_records)),
-          threads_num_(threads_num) {}
+          threads_num_(threads_num),
+          cancellation_token_(cancellation_token) {}
 
+    /**
+     * Validates the candidates level by level. Returns no suggestions if the token is cancelled,
+     * the level it was validating is left unfinished then.
+     */
     hy::IdPairs ValidateAndExtendCandidates();
+
+    /**
+     * @return the level to be validated next, the candidates of the lower levels are FDs
+     */
+    [[nodiscard]] unsigned GetLevelNum() const {
+        return current_level_number_;
+    }
+
+    /**
+     * Continues the validation from the given level, e.g. the one saved in a checkpoint
+     */
+    void SetLevelNum(unsigned level_num) noexcept {
+        current_level_number_ = level_num;
+    }
 };
 
 }  // namespace algos::hyfd
@@ -1,7 +1,13 @@
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 
+#include <chrono>
+#include <cstdint>
+
+#include <boost/container_hash/hash.hpp>
+
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 
 namespace algos {
 
@@ -14,8 +20,37 @@ void PliBasedFDAlgorithm::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
 }
 
+void PliBasedFDAlgorithm::UseThreadsForLoading(config::ThreadNumType const* threads_num) {
+    load_threads_num_ = threads_num;
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+std::unique_ptr<util::CheckpointFile> PliBasedFDAlgorithm::OpenCheckpoint(
+        config::CheckpointPathType const& path, config::CheckpointIntervalType interval,
+        std::string_view options) const {
+    if (path.empty()) return nullptr;
+    util::CheckpointEncoder fingerprint;
+    fingerprint.Write(options);
+    fingerprint.Write<std::uint64_t>(max_lhs_);
+    fingerprint.Write<std::uint64_t>(relation_->GetNumRows());
+    for (auto const& column : relation_->GetSchema()->GetColumns()) {
+        fingerprint.Write(column->GetName());
+    }
+    for (ColumnData const& column_data : relation_->GetColumnData()) {
+        std::vector<int> const& probing_table = column_data.GetProbingTable();
+        fingerprint.Write<std::uint64_t>(
+                boost::hash_range(probing_table.begin(), probing_table.end()));
+    }
+    return std::make_unique<util::CheckpointFile>(path, fingerprint.Release(),
+                                                  std::chrono::seconds(interval));
+}
+
 void PliBasedFDAlgorithm::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    config::ThreadNumType threads_num = 1;
+    if (load_threads_num_ != nullptr) {
+        threads_num = *load_threads_num_;
+    }
+    relation_ = ColumnLayoutRelationData::CreateCachedFrom(*input_table_, threads_num);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: FD mining is meaningless.");
@@ -1,16 +1,22 @@
 #pragma once
 
+#include <memory>
 #include <optional>
+#include <string_view>
 
 #include "core/algorithms/fd/fd_algorithm.h"
+#include "core/config/checkpoint/type.h"
 #include "core/config/equal_nulls/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/util/checkpoint_file.h"
 
 namespace algos {
 
 class PliBasedFDAlgorithm : public FDAlgorithm {
     config::InputTable input_table_;
+    config::ThreadNumType const* load_threads_num_ = nullptr;
 
     void RegisterOptions();
     void LoadDataInternal() final;
@@ -25,6 +31,17 @@ protected:
         return *relation_;
     }
 
+    /* Makes the threads option, registered with `threads_num`, available for loading as well, so
+     * that the table is encoded in parallel. The execution keeps the value set for loading. */
+    void UseThreadsForLoading(config::ThreadNumType const* threads_num);
+
+    /* Opens the checkpoint to save the progress to, nullptr if `path` is empty. The checkpoint of
+     * a previous execution is resumed from only if it was made on the same table with the same
+     * maximum LHS arity and the same `options`, the other options that change the result. */
+    std::unique_ptr<util::CheckpointFile> OpenCheckpoint(config::CheckpointPathType const& path,
+                                                         config::CheckpointIntervalType interval,
+                                                         std::string_view options) const;
+
 public:
     PliBasedFDAlgorithm();
 };
@@ -6,10 +6,13 @@
 
 #include "core/algorithms/fd/pyrocommon/core/fd_g1_strategy.h"
 #include "core/config/error/option.h"
+#include "core/config/flat_pli/option.h"
 #include "core/config/max_lhs/option.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/thread_number/option.h"
+#include "core/config/time_limit/option.h"
 #include "core/util/logger.h"
 
 namespace algos {
@@ -18,6 +21,7 @@ std::mutex search_spaces_mutex;
 
 Pyro::Pyro() : PliBasedFDAlgorithm() {
     RegisterOptions();
+    UseThreadsForLoading(&parameters_.parallelism);
     fd_consumer_ = [this](auto const& fd) {
         this->DiscoverFd(fd);
         this->FDAlgorithm::RegisterFd(fd.lhs_, fd.rhs_, relation_->GetSharedPtrSchema());
@@ -31,11 +35,16 @@ void Pyro::RegisterOptions() {
     RegisterOption(config::kErrorOpt(&parameters_.max_ucc_error));
     RegisterOption(config::kThreadNumberOpt(&parameters_.parallelism));
     RegisterOption(Option{&parameters_.seed, kSeed, kDSeed, 0});
+    RegisterOption(config::kFlatPliOpt(&parameters_.flat_pli));
+    RegisterOption(config::kMemLimitMbOpt(&parameters_.mem_limit_mb));
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
 }
 
 void Pyro::MakeExecuteOptsAvailableFDInternal() {
     using namespace config::names;
-    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kThreadNumberOpt.GetName(), kSeed});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kThreadNumberOpt.GetName(), kSeed,
+                          config::kFlatPliOpt.GetName(), config::kMemLimitMbOpt.GetName(),
+                          config::kTimeLimitSecondsOpt.GetName()});
 }
 
 void Pyro::ResetStateFd() {
@@ -50,6 +59,9 @@ unsigned long long Pyro::ExecuteInternal() {
     auto profiling_context = std::make_unique<ProfilingContext>(
             parameters_, relation_.get(), ucc_consumer_, fd_consumer_, caching_method_,
             eviction_method_, caching_method_value_);
+    // The PLI cache is kept within mem_limit by evicting partitions, so only the time is limited
+    GetCancellationToken().Start(std::chrono::seconds(time_limit_seconds_));
+    profiling_context->SetCancellationToken(&GetCancellationToken());
 
     std::function<bool(DependencyCandidate const&, DependencyCandidate const&)> launch_pad_order;
     if (parameters_.launch_pad_order == "arity") {
@@ -121,6 +133,8 @@ unsigned long long Pyro::ExecuteInternal() {
     LOG_INFO("Total ascension time: {} ms", total_ascension);
     LOG_INFO("Total trickle time: {} ms", total_trickle);
     LOG_INFO("Total intersection time: {} ms", model::PositionListIndex::micros_ / 1000);
+    LOG_INFO("PLI cache: {} hits, {} misses, {} evictions", profiling_context->GetPliCacheHits(),
+             profiling_context->GetPliCacheMisses(), profiling_context->GetPliCacheEvictions());
     LOG_INFO("HASH: {}", PliBasedFDAlgorithm::Fletcher16());
     return elapsed_milliseconds.count();
 }
@@ -6,6 +6,7 @@
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/pyrocommon/core/dependency_consumer.h"
 #include "core/algorithms/fd/pyrocommon/core/search_space.h"
+#include "core/config/time_limit/type.h"
 
 namespace algos {
 
@@ -19,6 +20,7 @@ private:
     double caching_method_value_;
 
     pyro::Parameters parameters_;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
 
     void RegisterOptions();
     void MakeExecuteOptsAvailableFDInternal() final;
@@ -10,11 +10,14 @@ bool DependencyStrategy::ShouldResample(Vertical const& vertical, double boost_f
     if (current_sample->IsExact()) return false;
 
     // Get an estimate of the number of equality pairs in the vertical
-    model::PositionListIndex* pli = context_->GetPliCache()->Get(vertical);
-    double nep = pli != nullptr
-                         ? pli->GetNepAsLong()
-                         : current_sample->EstimateAgreements(vertical) *
-                                   context_->GetColumnLayoutRelationData()->GetNumTuplePairs();
+    model::PLICache* pli_cache = context_->GetPliCache();
+    auto const get_nep = [&](auto const* pli) -> double {
+        return pli != nullptr ? pli->GetNepAsLong()
+                              : current_sample->EstimateAgreements(vertical) *
+                                        context_->GetColumnLayoutRelationData()->GetNumTuplePairs();
+    };
+    double nep = pli_cache->IsFlat() ? get_nep(pli_cache->GetFlat(vertical).get())
+                                     : get_nep(pli_cache->Get(vertical).get());
 
     // Should the new sample be exact?
     if (nep <= context_->GetParameters().sample_size * boost_factor) return true;
@@ -8,7 +8,8 @@
 
 unsigned long long FdG1Strategy::nanos_ = 0;
 
-double FdG1Strategy::CalculateG1(model::PositionListIndex* lhs_pli) const {
+template <typename Pli>
+double FdG1Strategy::CalculateG1(Pli const* lhs_pli) const {
     unsigned long long num_violations = 0;
     std::unordered_map<int, int> value_counts;
     std::vector<int> const& probing_table = context_->GetColumnLayoutRelationData()
@@ -39,6 +40,12 @@ double FdG1Strategy::CalculateG1(model::PositionListIndex* lhs_pli) const {
     return CalculateG1(num_violations);
 }
 
+template <typename Pli>
+double FdG1Strategy::CalculateG1(Pli const* lhs_pli, Pli const* joint_pli) const {
+    return joint_pli == nullptr ? CalculateG1(lhs_pli)
+                                : CalculateG1(lhs_pli->GetNepAsLong() - joint_pli->GetNepAsLong());
+}
+
 double FdG1Strategy::CalculateG1(double num_violating_tuple_pairs) const {
     unsigned long long num_tuple_pairs =
             context_->GetColumnLayoutRelationData()->GetNumTuplePairs();
@@ -61,23 +68,26 @@ void FdG1Strategy::EnsureInitialized(SearchSpace* search_space) const {
 
 double FdG1Strategy::CalculateError(Vertical const& lhs) const {
     double error = 0;
+    model::PLICache* pli_cache = context_->GetPliCache();
+    Vertical const rhs = static_cast<Vertical>(*rhs_);
     if (lhs.GetArity() == 0) {
-        auto rhs_pli = context_->GetPliCache()->Get(static_cast<Vertical>(*rhs_));
-        if (rhs_pli == nullptr) {
-            throw std::runtime_error(
-                    "Couldn't get rhsPLI from PLICache while calculating FD error");
-        }
-        error = CalculateG1(rhs_pli->GetNip());
+        auto const get_nip = [](auto const* rhs_pli) {
+            if (rhs_pli == nullptr) {
+                throw std::runtime_error(
+                        "Couldn't get rhsPLI from PLICache while calculating FD error");
+            }
+            return rhs_pli->GetNip();
+        };
+        error = CalculateG1(pli_cache->IsFlat() ? get_nip(pli_cache->GetFlat(rhs).get())
+                                                : get_nip(pli_cache->Get(rhs).get()));
+    } else if (pli_cache->IsFlat()) {
+        auto lhs_pli = pli_cache->GetOrCreateFlatFor(lhs, context_);
+        error = CalculateG1<model::FlatPositionListIndex>(model::PLICache::GetPointer(lhs_pli),
+                                                          pli_cache->GetFlat(lhs.Union(rhs)).get());
     } else {
-        auto lhs_pli = context_->GetPliCache()->GetOrCreateFor(lhs, context_);
-        auto lhs_pli_pointer =
-                std::holds_alternative<model::PositionListIndex*>(lhs_pli)
-                        ? std::get<model::PositionListIndex*>(lhs_pli)
-                        : std::get<std::unique_ptr<model::PositionListIndex>>(lhs_pli).get();
-        auto joint_pli = context_->GetPliCache()->Get(lhs.Union(static_cast<Vertical>(*rhs_)));
-        error = joint_pli == nullptr
-                        ? CalculateG1(lhs_pli_pointer)
-                        : CalculateG1(lhs_pli_pointer->GetNepAsLong() - joint_pli->GetNepAsLong());
+        auto lhs_pli = pli_cache->GetOrCreateFor(lhs, context_);
+        error = CalculateG1<model::PositionListIndex>(model::PLICache::GetPointer(lhs_pli),
+                                                      pli_cache->Get(lhs.Union(rhs)).get());
     }
     calc_count_++;
     return error;
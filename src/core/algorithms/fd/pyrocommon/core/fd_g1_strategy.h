@@ -8,7 +8,10 @@ class FdG1Strategy : public DependencyStrategy {
 private:
     Column const* rhs_;
 
-    double CalculateG1(model::PositionListIndex* lhs_pli) const;
+    template <typename Pli>
+    double CalculateG1(Pli const* lhs_pli) const;
+    template <typename Pli>
+    double CalculateG1(Pli const* lhs_pli, Pli const* joint_pli) const;
     double CalculateG1(double num_violating_tuple_pairs) const;
     model::ConfidenceInterval CalculateG1(model::ConfidenceInterval const& num_violations) const;
 
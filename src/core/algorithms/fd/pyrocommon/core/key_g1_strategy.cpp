@@ -5,10 +5,6 @@
 #include "core/algorithms/fd/pyrocommon/core/search_space.h"
 #include "core/algorithms/fd/pyrocommon/model/pli_cache.h"
 
-double KeyG1Strategy::CalculateKeyError(model::PositionListIndex* pli) const {
-    return CalculateKeyError(pli->GetNepAsLong());
-}
-
 double KeyG1Strategy::CalculateKeyError(double num_violating_tuple_pairs) const {
     unsigned long long num_tuple_pairs =
             context_->GetColumnLayoutRelationData()->GetNumTuplePairs();
@@ -30,11 +26,8 @@ void KeyG1Strategy::EnsureInitialized(SearchSpace* search_space) const {
 }
 
 double KeyG1Strategy::CalculateError(Vertical const& key_candidate) const {
-    auto pli = context_->GetPliCache()->GetOrCreateFor(key_candidate, context_);
-    auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
-                               ? std::get<model::PositionListIndex*>(pli)
-                               : std::get<std::unique_ptr<model::PositionListIndex>>(pli).get();
-    double error = CalculateKeyError(pli_pointer);
+    double error = CalculateKeyError(
+            context_->GetPliCache()->GetOrCreateNepFor(key_candidate, context_));
     calc_count_++;
     return error;
 }
@@ -48,11 +41,8 @@ model::ConfidenceInterval KeyG1Strategy::CalculateKeyError(
 
 DependencyCandidate KeyG1Strategy::CreateDependencyCandidate(Vertical const& vertical) const {
     if (vertical.GetArity() == 1) {
-        auto pli = context_->GetPliCache()->GetOrCreateFor(vertical, context_);
-        auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
-                                   ? std::get<model::PositionListIndex*>(pli)
-                                   : std::get<std::unique_ptr<model::PositionListIndex>>(pli).get();
-        double key_error = CalculateKeyError(pli_pointer->GetNepAsLong());
+        double key_error =
+                CalculateKeyError(context_->GetPliCache()->GetOrCreateNepFor(vertical, context_));
         return DependencyCandidate(vertical, model::ConfidenceInterval(key_error), true);
     }
 
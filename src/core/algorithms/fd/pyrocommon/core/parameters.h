@@ -4,7 +4,9 @@
 
 #include "core/config/equal_nulls/type.h"
 #include "core/config/error/type.h"
+#include "core/config/flat_pli/type.h"
 #include "core/config/max_lhs/type.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/thread_number/type.h"
 
 namespace algos::pyro {
@@ -35,6 +37,9 @@ struct Parameters {
     // Cache settings
     double caching_probability = 0.5;
     unsigned int nary_intersection_size = 4;
+    config::FlatPliType flat_pli = false;
+    // Budget of the multi-column partitions in the PLI cache
+    config::MemLimitMBType mem_limit_mb = 2 * 1024;
 
     // Miscellaneous settings
     bool is_check_estimates = false;
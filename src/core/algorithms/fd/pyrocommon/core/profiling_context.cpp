@@ -45,13 +45,26 @@ ProfilingContext::ProfilingContext(algos::pyro::Parameters parameters,
             relation_data_, caching_method, eviction_method, caching_method_value,
             GetMinEntropy(relation_data_), GetMeanEntropy(relation_data_),
             GetMedianEntropy(relation_data_), SetMaximumEntropy(relation_data_, caching_method),
-            GetMedianGini(relation_data_), GetMedianInvertedEntropy(relation_data_));
+            GetMedianGini(relation_data_), GetMedianInvertedEntropy(relation_data_),
+            parameters_.flat_pli, static_cast<std::size_t>(parameters_.mem_limit_mb) << 20);
     pli_cache_->SetMaximumEntropy(max_entropy);
     // TODO: partialFDScoring - for FD registration
 }
 
 ProfilingContext::~ProfilingContext() = default;
 
+std::size_t ProfilingContext::GetPliCacheHits() const {
+    return pli_cache_->GetStats().hits;
+}
+
+std::size_t ProfilingContext::GetPliCacheMisses() const {
+    return pli_cache_->GetStats().misses;
+}
+
+std::size_t ProfilingContext::GetPliCacheEvictions() const {
+    return pli_cache_->GetStats().evictions;
+}
+
 double ProfilingContext::GetMaximumEntropy(ColumnLayoutRelationData const* relation_data) {
     auto& columns = relation_data->GetColumnData();
     auto max_column = std::max_element(columns.begin(), columns.end(), [](auto& cd1, auto& cd2) {
@@ -137,13 +150,19 @@ double ProfilingContext::SetMaximumEntropy(ColumnLayoutRelationData const* relat
 
 model::AgreeSetSample const* ProfilingContext::CreateFocusedSample(Vertical const& focus,
                                                                    double boost_factor) {
-    auto pli = pli_cache_->GetOrCreateFor(focus, this);
-    auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
-                               ? std::get<model::PositionListIndex*>(pli)
-                               : std::get<std::unique_ptr<model::PositionListIndex>>(pli).get();
-    std::unique_ptr<model::ListAgreeSetSample> sample = model::ListAgreeSetSample::CreateFocusedFor(
-            relation_data_, focus, pli_pointer, parameters_.sample_size * boost_factor,
-            custom_random_);
+    unsigned int const sample_size = parameters_.sample_size * boost_factor;
+    std::unique_ptr<model::ListAgreeSetSample> sample;
+    if (pli_cache_->IsFlat()) {
+        auto pli = pli_cache_->GetOrCreateFlatFor(focus, this);
+        sample = model::ListAgreeSetSample::CreateFocusedFor(
+                relation_data_, focus, model::PLICache::GetPointer(pli), sample_size,
+                custom_random_);
+    } else {
+        auto pli = pli_cache_->GetOrCreateFor(focus, this);
+        sample = model::ListAgreeSetSample::CreateFocusedFor(
+                relation_data_, focus, model::PLICache::GetPointer(pli), sample_size,
+                custom_random_);
+    }
     LOG_TRACE("Creating sample focused on: {}", focus.ToString());
     auto sample_ptr = sample.get();
     agree_set_samples_->Put(focus, std::move(sample));
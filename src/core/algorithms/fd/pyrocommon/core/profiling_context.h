@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <random>
 #include <string>
 
@@ -9,6 +10,7 @@
 #include "core/algorithms/fd/pyrocommon/model/partial_fd.h"
 #include "core/algorithms/fd/pyrocommon/model/partial_key.h"
 #include "core/util/cache_eviction_method.h"
+#include "core/util/cancellation_token.h"
 #include "core/util/caching_method.h"
 #include "core/util/custom_random.h"
 
@@ -31,6 +33,7 @@ private:
     ColumnLayoutRelationData* relation_data_;
     std::mt19937 random_;
     CustomRandom custom_random_;
+    util::CancellationToken* cancellation_token_ = nullptr;
 
     model::AgreeSetSample const* CreateColumnFocusedSample(
             Vertical const& focus, model::PositionListIndex const* restriction_pli,
@@ -49,6 +52,15 @@ public:
     model::AgreeSetSample const* CreateFocusedSample(Vertical const& focus, double boost_factor);
     std::shared_ptr<model::AgreeSetSample const> GetAgreeSetSample(Vertical const& focus) const;
 
+    // Search spaces stop taking new launch pads once the token is cancelled
+    void SetCancellationToken(util::CancellationToken* cancellation_token) noexcept {
+        cancellation_token_ = cancellation_token;
+    }
+
+    bool IsCancelled() const noexcept {
+        return cancellation_token_ != nullptr && cancellation_token_->IsCancelled();
+    }
+
     model::PLICache* GetPliCache() {
         return pli_cache_.get();
     }
@@ -73,6 +85,11 @@ public:
         return pli_cache_.get();
     }
 
+    // Counters of the PLI cache
+    std::size_t GetPliCacheHits() const;
+    std::size_t GetPliCacheMisses() const;
+    std::size_t GetPliCacheEvictions() const;
+
     // get int in range [0, upper_bound) from the uniform distribution
     // int NextInt(int upper_bound) { return std::uniform_int_distribution<int>{0,
     // upper_bound}(random_); }
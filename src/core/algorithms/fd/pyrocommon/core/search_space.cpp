@@ -11,6 +11,9 @@
 void SearchSpace::Discover() {
     LOG_TRACE("Discovering in: {}", static_cast<std::string>(*strategy_));
     while (true) {  // на второй итерации дропается
+        // Nested search spaces are a part of trickling down to the minimal dependencies of an
+        // outer one, so they are not interrupted
+        if (recursion_depth_ == 0 && context_->IsCancelled()) break;
         auto now = std::chrono::system_clock::now();
         std::optional<DependencyCandidate> launch_pad = PollLaunchPad();
         if (!launch_pad.has_value()) break;
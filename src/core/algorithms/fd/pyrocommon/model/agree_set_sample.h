@@ -46,11 +46,12 @@ protected:
     AgreeSetSample(ColumnLayoutRelationData const* relation_data, Vertical focus,
                    unsigned int sample_size, unsigned long long population_size);
 
-    template <typename T>
+    /// Pli is PositionListIndex or FlatPositionListIndex
+    template <typename T, typename Pli>
     static std::unique_ptr<T> CreateFocusedFor(ColumnLayoutRelationData const* relation,
                                                Vertical const& restriction_vertical,
-                                               PositionListIndex const* restriction_pli,
-                                               unsigned int sample_size, CustomRandom& random);
+                                               Pli const* restriction_pli, unsigned int sample_size,
+                                               CustomRandom& random);
 
 private:
     static double std_dev_smoothing_;
@@ -8,10 +8,10 @@
 
 namespace model {
 
-template <typename T>
+template <typename T, typename Pli>
 std::unique_ptr<T> AgreeSetSample::CreateFocusedFor(ColumnLayoutRelationData const* relation,
                                                     Vertical const& restriction_vertical,
-                                                    PositionListIndex const* restriction_pli,
+                                                    Pli const* restriction_pli,
                                                     unsigned int sample_size,
                                                     CustomRandom& random) {
     static_assert(std::is_base_of<AgreeSetSample, T>::value);
@@ -34,7 +34,7 @@ std::unique_ptr<T> AgreeSetSample::CreateFocusedFor(ColumnLayoutRelationData con
     unsigned long long restriction_nep = restriction_pli->GetNepAsLong();
     sample_size = std::min(static_cast<unsigned long long>(sample_size), restriction_nep);
     if (sample_size >= restriction_nep) {
-        for (auto& cluster : restriction_pli->GetIndex()) {
+        for (auto const& cluster : restriction_pli->GetIndex()) {
             for (unsigned int i = 0; i < cluster.size(); i++) {
                 int tuple_index_1 = cluster[i];
                 for (unsigned int j = i + 1; j < cluster.size(); j++) {
@@ -77,7 +77,7 @@ std::unique_ptr<T> AgreeSetSample::CreateFocusedFor(ColumnLayoutRelationData con
             /*if (cluster_index >= cluster_sizes.size()) {
                 cluster_index = cluster_sizes.size() - 1;
             }*/
-            auto& cluster = restriction_pli->GetIndex()[cluster_index];
+            auto const& cluster = restriction_pli->GetIndex()[cluster_index];
 
             int tuple_index_1 = random.NextInt(cluster.size());
             int tuple_index_2 = random.NextInt(cluster.size());
@@ -11,6 +11,14 @@ std::unique_ptr<ListAgreeSetSample> ListAgreeSetSample::CreateFocusedFor(
             relation, restriction_vertical, restriction_p_li, sample_size, random);
 }
 
+std::unique_ptr<ListAgreeSetSample> ListAgreeSetSample::CreateFocusedFor(
+        ColumnLayoutRelationData const* relation, Vertical const& restriction_vertical,
+        FlatPositionListIndex const* restriction_pli, unsigned int sample_size,
+        CustomRandom& random) {
+    return AgreeSetSample::CreateFocusedFor<ListAgreeSetSample>(
+            relation, restriction_vertical, restriction_pli, sample_size, random);
+}
+
 std::unique_ptr<std::vector<unsigned long long>> ListAgreeSetSample::BitSetToLongLongVector(
         boost::dynamic_bitset<> const& bitset) {
     auto result = std::make_unique<std::vector<unsigned long long>>(
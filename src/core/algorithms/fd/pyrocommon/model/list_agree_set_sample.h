@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "core/algorithms/fd/pyrocommon/model/agree_set_sample.h"
+#include "core/model/table/flat_position_list_index.h"
 
 namespace model {
 
@@ -29,6 +30,10 @@ public:
             ColumnLayoutRelationData const* relation, Vertical const& restriction_vertical,
             PositionListIndex const* restriction_p_li, unsigned int sample_size,
             CustomRandom& random);
+    static std::unique_ptr<ListAgreeSetSample> CreateFocusedFor(
+            ColumnLayoutRelationData const* relation, Vertical const& restriction_vertical,
+            FlatPositionListIndex const* restriction_pli, unsigned int sample_size,
+            CustomRandom& random);
 
     ListAgreeSetSample(ColumnLayoutRelationData const* relation, Vertical const& focus,
                        unsigned int sample_size, unsigned long long population_size,
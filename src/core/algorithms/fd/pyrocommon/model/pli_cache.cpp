@@ -1,5 +1,10 @@
 #include "core/algorithms/fd/pyrocommon/model/pli_cache.h"
 
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
 #include <boost/optional.hpp>
 
 #include "core/model/table/vertical_map.h"
@@ -7,19 +12,21 @@
 
 namespace model {
 
-PositionListIndex* PLICache::Get(Vertical const& vertical) {
-    return index_->Get(vertical).get();
+std::shared_ptr<PositionListIndex> PLICache::Get(Vertical const& vertical) {
+    return index_->Get(vertical);
+}
+
+std::shared_ptr<FlatPositionListIndex> PLICache::GetFlat(Vertical const& vertical) {
+    return flat_index_->Get(vertical);
 }
 
 PLICache::PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
                    CacheEvictionMethod eviction_method, double caching_method_value,
                    double min_entropy, double mean_entropy, double median_entropy,
-                   double maximum_entropy, double median_gini, double median_inverted_entropy)
+                   double maximum_entropy, double median_gini, double median_inverted_entropy,
+                   bool flat_pli, std::size_t budget_bytes)
     : relation_data_(relation_data),
-      // TODO: сделать
-      // index_(std::make_unique<VerticalMap<PositionListIndex>>(relation_data->GetSchema())) при
-      // одном потоке
-      index_(std::make_unique<BlockingVerticalMap<PositionListIndex>>(relation_data->GetSchema())),
+      budget_(budget_bytes),
       caching_method_(caching_method),
       eviction_method_(eviction_method),
       caching_method_value_(caching_method_value),
@@ -29,6 +36,22 @@ PLICache::PLICache(ColumnLayoutRelationData* relation_data, CachingMethod cachin
       median_entropy_(median_entropy),
       median_gini_(median_gini),
       median_inverted_entropy_(median_inverted_entropy) {
+    if (flat_pli) {
+        flat_arena_ = std::make_unique<std::pmr::synchronized_pool_resource>();
+        flat_index_ = std::make_unique<BlockingVerticalMap<FlatPositionListIndex>>(
+                relation_data->GetSchema());
+        for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
+            PositionListIndex const* column_pli =
+                    relation_data->GetColumnData(column_ptr->GetIndex()).GetPositionListIndex();
+            flat_index_->Put(static_cast<Vertical>(*column_ptr),
+                             FlatPositionListIndex::CreateFrom(*column_pli, flat_arena_.get()));
+        }
+        return;
+    }
+    // TODO: сделать
+    // index_(std::make_unique<VerticalMap<PositionListIndex>>(relation_data->GetSchema())) при
+    // одном потоке
+    index_ = std::make_unique<BlockingVerticalMap<PositionListIndex>>(relation_data->GetSchema());
     for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
         index_->Put(static_cast<Vertical>(*column_ptr),
                     relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
@@ -36,6 +59,11 @@ PLICache::PLICache(ColumnLayoutRelationData* relation_data, CachingMethod cachin
 }
 
 PLICache::~PLICache() {
+    if (IsFlat()) {
+        // The partitions have to go before the arena they are allocated from
+        flat_index_.reset();
+        return;
+    }
     for (auto& column_ptr : relation_data_->GetSchema()->GetColumns()) {
         // auto PLI =
         index_->Remove(static_cast<Vertical>(*column_ptr));
@@ -44,29 +72,32 @@ PLICache::~PLICache() {
 }
 
 // obtains or calculates a PositionListIndex using cache
-std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::GetOrCreateFor(
-        Vertical const& vertical, ProfilingContext* profiling_context) {
+template <typename Pli>
+PLICache::PliPointer<Pli> PLICache::GetOrCreateIn(VerticalMap<Pli>& index, Vertical const& vertical,
+                                                  ProfilingContext* profiling_context) {
     std::scoped_lock lock(getting_pli_mutex_);
     LOG_DEBUG("PLI for {} requested: ", vertical.ToString());
 
     // is PLI already cached?
-    PositionListIndex* pli = Get(vertical);
+    std::shared_ptr<Pli> pli = index.Get(vertical);
     if (pli != nullptr) {
         pli->IncFreq();
+        Touch(vertical);
+        budget_.CountHit();
         LOG_DEBUG("Served from PLI cache.");
-        // addToUsageCounter
         return pli;
     }
+    budget_.CountMiss();
     // look for cached PLIs to construct the requested one
-    auto subset_entries = index_->GetSubsetEntries(vertical);
-    boost::optional<PositionListIndexRank> smallest_pli_rank;
-    std::vector<PositionListIndexRank> ranks;
+    auto subset_entries = index.GetSubsetEntries(vertical);
+    boost::optional<PositionListIndexRank<Pli>> smallest_pli_rank;
+    std::vector<PositionListIndexRank<Pli>> ranks;
     ranks.reserve(subset_entries.size());
     for (auto& [sub_vertical, sub_pli_ptr] : subset_entries) {
         // TODO: избавиться от таких const_cast, которые сбрасывают константность
-        PositionListIndexRank pli_rank(&sub_vertical,
-                                       std::const_pointer_cast<PositionListIndex>(sub_pli_ptr),
-                                       sub_vertical.GetArity());
+        PositionListIndexRank<Pli> pli_rank(&sub_vertical,
+                                            std::const_pointer_cast<Pli>(sub_pli_ptr),
+                                            sub_vertical.GetArity());
         ranks.push_back(pli_rank);
         if (!smallest_pli_rank || smallest_pli_rank->pli_->GetSize() > pli_rank.pli_->GetSize() ||
             (smallest_pli_rank->pli_->GetSize() == pli_rank.pli_->GetSize() &&
@@ -76,16 +107,17 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     }
     assert(smallest_pli_rank);  // check if smallest_pli_rank is initialized
 
-    std::vector<PositionListIndexRank> operands;
+    std::vector<PositionListIndexRank<Pli>> operands;
     boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
     boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
     if (smallest_pli_rank) {
         smallest_pli_rank->pli_->IncFreq();
+        Touch(*smallest_pli_rank->vertical_);
         operands.push_back(*smallest_pli_rank);
         cover |= smallest_pli_rank->vertical_->GetColumnIndices();
 
         while (cover.count() < vertical.GetArity() && !ranks.empty()) {
-            boost::optional<PositionListIndexRank> best_rank;
+            boost::optional<PositionListIndexRank<Pli>> best_rank;
             // erase ranks with low added_arity_
             ranks.erase(std::remove_if(ranks.begin(), ranks.end(),
                                        [&cover_tester, &cover](auto& rank) {
@@ -107,6 +139,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
 
             if (best_rank) {
                 best_rank->pli_->IncFreq();
+                Touch(*best_rank->vertical_);
                 operands.push_back(*best_rank);
                 cover |= best_rank->vertical_->GetColumnIndices();
             }
@@ -119,7 +152,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     for (auto& column : vertical.GetColumns()) {
         if (!cover[column->GetIndex()]) {
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
-            auto column_pli = index_->Get(**vertical_columns.rbegin());
+            auto column_pli = index.Get(**vertical_columns.rbegin());
             operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
             column_pli->IncFreq();
         }
@@ -138,30 +171,24 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     // TODO: тут не очень понятно: CachingProcess может забрать себе PLI, а может и отдать обратно,
     //  поэтому приходится через variant разбирать. Проверить, насколько много платим за обёртку.
     // Intersect and cache
-    std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> variant_intersection_pli;
+    PliPointer<Pli> variant_intersection_pli;
     if (operands.size() >= profiling_context->GetParameters().nary_intersection_size) {
-        PositionListIndexRank base_pli_rank = operands[0];
-        auto intersection_pli = base_pli_rank.pli_->ProbeAll(
-                vertical.Without(*base_pli_rank.vertical_), *relation_data_);
+        PositionListIndexRank<Pli> base_pli_rank = operands[0];
+        auto intersection_pli =
+                ProbeAll(*base_pli_rank.pli_, vertical.Without(*base_pli_rank.vertical_));
         variant_intersection_pli =
-                CachingProcess(vertical, std::move(intersection_pli), profiling_context);
+                CachingProcess(index, vertical, std::move(intersection_pli), profiling_context);
     } else {
         Vertical current_vertical = *operands.begin()->vertical_;
-        variant_intersection_pli = operands.begin()->pli_.get();
+        variant_intersection_pli = operands.begin()->pli_;
 
         for (size_t i = 1; i < operands.size(); i++) {
             current_vertical = current_vertical.Union(*operands[i].vertical_);
+            Pli const* intersection_pli = GetPointer(variant_intersection_pli);
             variant_intersection_pli =
-                    std::holds_alternative<PositionListIndex*>(variant_intersection_pli)
-                            ? std::get<PositionListIndex*>(variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get())
-                            : std::get<std::unique_ptr<PositionListIndex>>(variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get());
-            variant_intersection_pli = CachingProcess(
-                    current_vertical,
-                    std::move(
-                            std::get<std::unique_ptr<PositionListIndex>>(variant_intersection_pli)),
-                    profiling_context);
+                    CachingProcess(index, current_vertical,
+                                   Intersect(*intersection_pli, *operands[i].pli_),
+                                   profiling_context);
         }
     }
 
@@ -171,28 +198,154 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     return variant_intersection_pli;
 }
 
+PLICache::PliPointer<PositionListIndex> PLICache::GetOrCreateFor(
+        Vertical const& vertical, ProfilingContext* profiling_context) {
+    assert(!IsFlat());
+    return GetOrCreateIn(*index_, vertical, profiling_context);
+}
+
+PLICache::PliPointer<FlatPositionListIndex> PLICache::GetOrCreateFlatFor(
+        Vertical const& vertical, ProfilingContext* profiling_context) {
+    assert(IsFlat());
+    return GetOrCreateIn(*flat_index_, vertical, profiling_context);
+}
+
+unsigned long long PLICache::GetOrCreateNepFor(Vertical const& vertical,
+                                               ProfilingContext* profiling_context) {
+    if (IsFlat()) {
+        return GetPointer(GetOrCreateFlatFor(vertical, profiling_context))->GetNepAsLong();
+    }
+    return GetPointer(GetOrCreateFor(vertical, profiling_context))->GetNepAsLong();
+}
+
+std::unique_ptr<PositionListIndex> PLICache::Intersect(PositionListIndex const& pli,
+                                                       PositionListIndex const& that) {
+    return pli.Intersect(&that);
+}
+
+std::unique_ptr<FlatPositionListIndex> PLICache::Intersect(FlatPositionListIndex const& pli,
+                                                           FlatPositionListIndex const& that) {
+    return pli.Intersect(that, flat_arena_.get());
+}
+
+std::unique_ptr<PositionListIndex> PLICache::ProbeAll(PositionListIndex& pli,
+                                                      Vertical const& probing_columns) {
+    return pli.ProbeAll(probing_columns, *relation_data_);
+}
+
+std::unique_ptr<FlatPositionListIndex> PLICache::ProbeAll(FlatPositionListIndex& pli,
+                                                          Vertical const& probing_columns) {
+    return pli.ProbeAll(probing_columns, *relation_data_, flat_arena_.get());
+}
+
 size_t PLICache::Size() const {
-    return index_->GetSize();
+    return IsFlat() ? flat_index_->GetSize() : index_->GetSize();
+}
+
+PLICache::Stats PLICache::GetStats() const {
+    return budget_.GetStats();
+}
+
+void PLICache::Touch(Vertical const& vertical) {
+    auto it = cached_positions_.find(vertical);
+    if (it == cached_positions_.end()) return;
+    cached_.splice(cached_.end(), cached_, it->second);
+}
+
+template <typename Pli>
+void PLICache::Admit(VerticalMap<Pli>& index, Vertical const& vertical, Pli const& pli) {
+    if (vertical.GetArity() <= 1) return;
+    if (auto it = cached_positions_.find(vertical); it != cached_positions_.end()) {
+        // Put has replaced the partition
+        budget_.Release(it->second->bytes);
+        cached_.erase(it->second);
+        cached_positions_.erase(it);
+    }
+    std::size_t const bytes = pli.EstimateBytes();
+    auto const position =
+            cached_.insert(cached_.end(), CachedEntry{vertical, bytes, pli.GetEntropy()});
+    cached_positions_.emplace(vertical, position);
+    if (budget_.Admit(bytes)) {
+        EvictOverBudget(index);
+    }
+}
+
+template <typename Pli>
+void PLICache::EvictOverBudget(VerticalMap<Pli>& index) {
+    struct Candidate {
+        std::list<CachedEntry>::iterator entry;
+        unsigned int freq;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(cached_.size());
+    for (auto it = cached_.begin(); it != cached_.end(); ++it) {
+        std::shared_ptr<Pli> pli = index.Get(it->vertical);
+        candidates.push_back({it, pli == nullptr ? 0 : pli->GetFreq()});
+    }
+    // Candidates are in LRU order, stable orderings keep it among equal ones
+    switch (eviction_method_) {
+        case CacheEvictionMethod::kDefault:
+            break;
+        case CacheEvictionMethod::kMedainUsage: {
+            std::vector<unsigned int> freqs;
+            freqs.reserve(candidates.size());
+            for (Candidate const& candidate : candidates) freqs.push_back(candidate.freq);
+            auto const median = freqs.begin() + freqs.size() / 2;
+            std::nth_element(freqs.begin(), median, freqs.end());
+            std::ranges::stable_partition(candidates, [median_freq = *median](auto const& c) {
+                return c.freq < median_freq;
+            });
+            break;
+        }
+        case CacheEvictionMethod::kHottoRemain:
+            std::ranges::stable_sort(candidates, std::less<>{}, &Candidate::freq);
+            break;
+        case CacheEvictionMethod::kLowEntropyFirst:
+            std::ranges::stable_sort(candidates, std::less<>{},
+                                     [](Candidate const& c) { return c.entry->entropy; });
+            break;
+        case CacheEvictionMethod::kSizeWeighted:
+            std::ranges::stable_sort(candidates, std::greater<>{}, [](Candidate const& c) {
+                return static_cast<double>(c.entry->bytes) / (c.freq + 1);
+            });
+            break;
+    }
+
+    budget_.Evict(candidates, [&](Candidate const& candidate) -> std::optional<std::size_t> {
+        CachedEntry const& entry = *candidate.entry;
+        std::size_t const bytes = entry.bytes;
+        LOG_DEBUG("Evicting PLI for {} from the cache.", entry.vertical.ToString());
+        // Users of the partition keep it alive through their shared pointers
+        index.Remove(entry.vertical);
+        cached_positions_.erase(entry.vertical);
+        cached_.erase(candidate.entry);
+        return bytes;
+    });
 }
 
-std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::CachingProcess(
-        Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
-        ProfilingContext* profiling_context) {
-    auto pli_pointer = pli.get();
+template <typename Pli>
+PLICache::PliPointer<Pli> PLICache::CachingProcess(VerticalMap<Pli>& index,
+                                                   Vertical const& vertical,
+                                                   std::unique_ptr<Pli> pli,
+                                                   ProfilingContext* profiling_context) {
+    auto const put = [&]() -> PliPointer<Pli> {
+        std::shared_ptr<Pli> cached_pli = std::move(pli);
+        index.Put(vertical, cached_pli);
+        Admit(index, vertical, *cached_pli);
+        return cached_pli;
+    };
     switch (caching_method_) {
         case CachingMethod::kCoin:
             if (profiling_context->NextDouble() <
                 profiling_context->GetParameters().caching_probability) {
-                index_->Put(vertical, std::move(pli));
-                return pli_pointer;
+                return put();
             } else {
                 return pli;
             }
         case CachingMethod::kNoCaching:
             return pli;
         case CachingMethod::kAllCaching:
-            index_->Put(vertical, std::move(pli));
-            return pli_pointer;
+            return put();
         default:
             throw std::runtime_error(
                     "Only kNoCaching and kAllCaching strategies are currently available");
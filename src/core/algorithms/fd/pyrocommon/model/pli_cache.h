@@ -2,32 +2,59 @@
 
 class ProfilingContext;
 
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <memory_resource>
 #include <mutex>
+#include <unordered_map>
 
 #include "core/algorithms/fd/pyrocommon/core/profiling_context.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/flat_position_list_index.h"
+#include "core/util/cache_budget.h"
 #include "core/util/cache_eviction_method.h"
 #include "core/util/caching_method.h"
+#include "core/util/custom_hashes.h"
 #include "core/util/maybe_unused_private_field.h"
 
 namespace model {
 
 class PLICache {
+public:
+    /// Cached partitions are shared, so that evicting one does not free it under its users.
+    template <typename Pli>
+    using PliPointer = std::variant<std::shared_ptr<Pli>, std::unique_ptr<Pli>>;
+
+    /// Sizes are those of the cached multi-column partitions
+    using Stats = util::CacheBudget::Stats;
+
 private:
+    template <typename Pli>
     class PositionListIndexRank {
     public:
         Vertical const* vertical_;
-        std::shared_ptr<PositionListIndex> pli_;
+        std::shared_ptr<Pli> pli_;
         int added_arity_;
 
-        PositionListIndexRank(Vertical const* vertical, std::shared_ptr<PositionListIndex> pli,
+        PositionListIndexRank(Vertical const* vertical, std::shared_ptr<Pli> pli,
                               int initial_arity)
             : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
     };
 
+    // Multi-column partitions put into the cache, single-column ones are never evicted
+    struct CachedEntry {
+        Vertical vertical;
+        std::size_t bytes;
+        double entropy;
+    };
+
     // using CacheMap = VerticalMap<PositionListIndex>;
     ColumnLayoutRelationData* relation_data_;
     std::unique_ptr<VerticalMap<PositionListIndex>> index_;
+    // Used instead of index_ if the partitions are stored in the flat layout
+    std::unique_ptr<std::pmr::synchronized_pool_resource> flat_arena_;
+    std::unique_ptr<VerticalMap<FlatPositionListIndex>> flat_index_;
     // usageCounter - for parallelism
 
     // All these MAYBE_UNUSED_PRIVATE_FIELD variables are required to support Pyro's caching
@@ -38,8 +65,13 @@ private:
 
     mutable std::mutex getting_pli_mutex_;
 
+    // The least recently used entry first, guarded by getting_pli_mutex_
+    std::list<CachedEntry> cached_;
+    std::unordered_map<Vertical, std::list<CachedEntry>::iterator> cached_positions_;
+    util::CacheBudget budget_;
+
     CachingMethod caching_method_;
-    MAYBE_UNUSED_PRIVATE_FIELD CacheEvictionMethod eviction_method_;
+    CacheEvictionMethod eviction_method_;
     MAYBE_UNUSED_PRIVATE_FIELD double caching_method_value_;
     // long long maximumAvailableMemory_ = 0;
     double maximum_entropy_;
@@ -49,19 +81,60 @@ private:
     MAYBE_UNUSED_PRIVATE_FIELD double median_gini_;
     MAYBE_UNUSED_PRIVATE_FIELD double median_inverted_entropy_;
 
-    std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> CachingProcess(
-            Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
-            ProfilingContext* profiling_context);
+    template <typename Pli>
+    PliPointer<Pli> GetOrCreateIn(VerticalMap<Pli>& index, Vertical const& vertical,
+                                  ProfilingContext* profiling_context);
+
+    std::unique_ptr<PositionListIndex> Intersect(PositionListIndex const& pli,
+                                                 PositionListIndex const& that);
+    std::unique_ptr<FlatPositionListIndex> Intersect(FlatPositionListIndex const& pli,
+                                                     FlatPositionListIndex const& that);
+    std::unique_ptr<PositionListIndex> ProbeAll(PositionListIndex& pli,
+                                                Vertical const& probing_columns);
+    std::unique_ptr<FlatPositionListIndex> ProbeAll(FlatPositionListIndex& pli,
+                                                    Vertical const& probing_columns);
+
+    void Touch(Vertical const& vertical);
+    template <typename Pli>
+    void Admit(VerticalMap<Pli>& index, Vertical const& vertical, Pli const& pli);
+    template <typename Pli>
+    void EvictOverBudget(VerticalMap<Pli>& index);
+
+    template <typename Pli>
+    PliPointer<Pli> CachingProcess(VerticalMap<Pli>& index, Vertical const& vertical,
+                                   std::unique_ptr<Pli> pli, ProfilingContext* profiling_context);
 
 public:
+    /// With `flat_pli` the partitions are kept as FlatPositionListIndex allocated from an arena
+    /// of the cache, only GetFlat and GetOrCreateFlatFor can be used then.
+    /// While the estimated size of the cached multi-column partitions exceeds `budget_bytes`,
+    /// partitions are evicted in the order `eviction_method` defines.
     PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
              CacheEvictionMethod eviction_method, double caching_method_value, double min_entropy,
              double mean_entropy, double median_entropy, double maximum_entropy, double median_gini,
-             double median_inverted_entropy);
+             double median_inverted_entropy, bool flat_pli = false,
+             std::size_t budget_bytes = std::numeric_limits<std::size_t>::max());
+
+    std::shared_ptr<PositionListIndex> Get(Vertical const& vertical);
+    PliPointer<PositionListIndex> GetOrCreateFor(Vertical const& vertical,
+                                                 ProfilingContext* profiling_context);
 
-    PositionListIndex* Get(Vertical const& vertical);
-    std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> GetOrCreateFor(
-            Vertical const& vertical, ProfilingContext* profiling_context);
+    std::shared_ptr<FlatPositionListIndex> GetFlat(Vertical const& vertical);
+    PliPointer<FlatPositionListIndex> GetOrCreateFlatFor(Vertical const& vertical,
+                                                         ProfilingContext* profiling_context);
+
+    /// Number of equal pairs of the partition of `vertical`, works with both layouts.
+    unsigned long long GetOrCreateNepFor(Vertical const& vertical,
+                                         ProfilingContext* profiling_context);
+
+    bool IsFlat() const noexcept {
+        return flat_index_ != nullptr;
+    }
+
+    template <typename Pli>
+    static Pli* GetPointer(PliPointer<Pli> const& pli) {
+        return std::visit([](auto const& pointer) -> Pli* { return &*pointer; }, pli);
+    }
 
     void SetMaximumEntropy(double e) {
         maximum_entropy_ = e;
@@ -69,6 +142,8 @@ public:
 
     size_t Size() const;
 
+    Stats GetStats() const;
+
     // returns ownership of single column PLIs back to ColumnLayoutRelationData
     virtual ~PLICache();
 };
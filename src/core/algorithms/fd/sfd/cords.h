@@ -15,6 +15,7 @@
 #include "core/model/table/column.h"
 #include "core/model/table/column_index.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/util/primitive_collection.h"
 
 namespace algos {
 class Cords : public FDAlgorithm {
@@ -8,12 +8,17 @@ config::ErrorType CalculateZeroAryG1(ColumnData const* rhs, unsigned long long n
                        static_cast<config::ErrorType>(num_tuple_pairs);
 }
 
-config::ErrorType CalculateG1Error(model::PLIWS const* lhs_pli, model::PLIWS const* joint_pli,
+config::ErrorType CalculateG1Error(unsigned long long lhs_nep, unsigned long long joint_nep,
                                    unsigned long long num_tuple_pairs) {
-    return static_cast<config::ErrorType>((lhs_pli->GetNepAsLong() - joint_pli->GetNepAsLong()) /
+    return static_cast<config::ErrorType>((lhs_nep - joint_nep) /
                                           static_cast<config::ErrorType>(num_tuple_pairs));
 }
 
+config::ErrorType CalculateG1Error(model::PLIWS const* lhs_pli, model::PLIWS const* joint_pli,
+                                   unsigned long long num_tuple_pairs) {
+    return CalculateG1Error(lhs_pli->GetNepAsLong(), joint_pli->GetNepAsLong(), num_tuple_pairs);
+}
+
 config::ErrorType PdepSelf(model::PLI const* x_pli) {
     size_t n = x_pli->GetRelationSize();
     config::ErrorType sum = 0;
@@ -7,6 +7,9 @@
 namespace algos {
 config::ErrorType CalculateZeroAryG1(ColumnData const* rhs, unsigned long long num_tuple_pairs);
 
+config::ErrorType CalculateG1Error(unsigned long long lhs_nep, unsigned long long joint_nep,
+                                   unsigned long long num_tuple_pairs);
+
 config::ErrorType CalculateG1Error(model::PLIWS const* lhs_pli, model::PLIWS const* joint_pli,
                                    unsigned long long num_tuple_pairs);
 
@@ -119,7 +119,10 @@ void LatticeLevel::ClearLevelsBelow(std::vector<std::unique_ptr<LatticeLevel>>&
     auto it = levels.begin();
 
     for (unsigned int i = 0; i < std::min((unsigned int)levels.size(), arity); i++) {
-        (*(it++))->GetVertices().clear();
+        LatticeLevel& level = **(it++);
+        level.GetVertices().clear();
+        level.pool_.release();
+        level.arena_.release();
     }
 
     // Clear child references
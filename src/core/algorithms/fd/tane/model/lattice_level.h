@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <memory_resource>
 #include <vector>
 
 #include "core/algorithms/fd/tane/model/lattice_vertex.h"
@@ -10,6 +11,10 @@ namespace model {
 class LatticeLevel {
 private:
     unsigned int arity_;
+    // Flat partitions of the vertices are allocated here, must outlive the vertices. The vertices
+    // of a level may be processed by several threads, so the arena is accessed through a pool
+    std::pmr::monotonic_buffer_resource arena_;
+    std::pmr::synchronized_pool_resource pool_{&arena_};
     std::map<boost::dynamic_bitset<>, std::unique_ptr<LatticeVertex>> vertices_;
 
 public:
@@ -23,6 +28,10 @@ public:
         return vertices_;
     }
 
+    std::pmr::memory_resource* GetArena() {
+        return &pool_;
+    }
+
     LatticeVertex const* GetLatticeVertex(boost::dynamic_bitset<> const& column_indices) const;
     void Add(std::unique_ptr<LatticeVertex> vertex);
 
@@ -1,5 +1,7 @@
 #include "core/algorithms/fd/tane/model/lattice_vertex.h"
 
+#include <cassert>
+
 #include "core/util/getting_ptr.h"
 
 namespace model {
@@ -86,4 +88,28 @@ PLIWithSingletons const* LatticeVertex::GetPositionListIndexWithSingletons() con
             position_list_index_);
 }
 
+unsigned long long LatticeVertex::GetNepAsLong() const {
+    if (flat_position_list_index_ != nullptr) {
+        return flat_position_list_index_->GetNepAsLong();
+    }
+    if (PositionListIndex const* pli = GetPositionListIndex(); pli != nullptr) {
+        return pli->GetNepAsLong();
+    }
+    assert(released_nep_.has_value());
+    return *released_nep_;
+}
+
+std::unique_ptr<PLIWithSingletons> LatticeVertex::ReleasePLIWithSingletons() {
+    auto* owned = std::get_if<std::unique_ptr<PLIWS>>(&position_list_index_);
+    if (owned == nullptr || *owned == nullptr) return nullptr;
+    released_nep_ = (*owned)->GetNepAsLong();
+    return std::move(*owned);
+}
+
+std::unique_ptr<FlatPositionListIndex> LatticeVertex::ReleaseFlatPositionListIndex() {
+    if (flat_position_list_index_ == nullptr) return nullptr;
+    released_nep_ = flat_position_list_index_->GetNepAsLong();
+    return std::move(flat_position_list_index_);
+}
+
 }  // namespace model
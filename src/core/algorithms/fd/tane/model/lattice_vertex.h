@@ -1,12 +1,14 @@
 #pragma once
 
 #include <list>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "core/model/table/flat_position_list_index.h"
 #include "core/model/table/position_list_index.h"
 #include "core/model/table/position_list_index_with_singletons.h"
 #include "core/model/table/relational_schema.h"
@@ -21,6 +23,10 @@ private:
     std::variant<std::unique_ptr<PositionListIndex>, PositionListIndex const*,
                  std::unique_ptr<PLIWS>, PLIWS const*>
             position_list_index_;
+    // used instead of position_list_index_ by TANE with flat partitions
+    std::unique_ptr<FlatPositionListIndex> flat_position_list_index_;
+    // number of equal pairs of a partition taken away by one of the Release methods
+    std::optional<unsigned long long> released_nep_;
     boost::dynamic_bitset<> rhs_candidates_;
     bool is_key_candidate_ = false;
     std::vector<LatticeVertex const*> parents_;
@@ -70,6 +76,17 @@ public:
 
     PLIWithSingletons const* GetPositionListIndexWithSingletons() const;
 
+    FlatPositionListIndex const* GetFlatPositionListIndex() const {
+        return flat_position_list_index_.get();
+    }
+
+    bool HasPositionListIndex() const {
+        return flat_position_list_index_ != nullptr || GetPositionListIndex() != nullptr;
+    }
+
+    // number of equal pairs of the vertex partition, whichever layout it is stored in
+    unsigned long long GetNepAsLong() const;
+
     void SetPositionListIndex(PositionListIndex const* position_list_index) {
         position_list_index_ = position_list_index;
     }
@@ -86,6 +103,15 @@ public:
         position_list_index_ = std::move(position_list_index);
     }
 
+    void AcquireFlatPositionListIndex(std::unique_ptr<FlatPositionListIndex> position_list_index) {
+        flat_position_list_index_ = std::move(position_list_index);
+    }
+
+    // Take an owned partition away from the vertex, GetNepAsLong keeps working after that.
+    // Return nullptr if the vertex does not own a partition of this layout.
+    std::unique_ptr<PLIWithSingletons> ReleasePLIWithSingletons();
+    std::unique_ptr<FlatPositionListIndex> ReleaseFlatPositionListIndex();
+
     bool operator>(LatticeVertex const& that) const;
 
     std::string ToString();
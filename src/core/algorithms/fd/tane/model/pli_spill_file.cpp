@@ -0,0 +1,199 @@
+#include "core/algorithms/fd/tane/model/pli_spill_file.h"
+
+#include <cstring>
+#include <deque>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace model {
+
+namespace {
+
+class Encoder {
+private:
+    std::vector<unsigned char>& buffer_;
+
+public:
+    explicit Encoder(std::vector<unsigned char>& buffer) : buffer_(buffer) {
+        buffer_.clear();
+    }
+
+    void PutVarint(std::uint64_t value) {
+        while (value >= 0x80) {
+            buffer_.push_back(static_cast<unsigned char>(value) | 0x80);
+            value >>= 7;
+        }
+        buffer_.push_back(static_cast<unsigned char>(value));
+    }
+
+    void PutDouble(double value) {
+        unsigned char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(value));
+    }
+
+    // Positions are ascending in a cluster, but zigzag keeps the encoding correct for any order
+    template <typename Clusters>
+    void PutClusters(Clusters const& clusters) {
+        PutVarint(std::size(clusters));
+        for (auto const& cluster : clusters) {
+            PutVarint(std::size(cluster));
+            long long previous = 0;
+            for (int position : cluster) {
+                long long const delta = position - previous;
+                PutVarint((static_cast<std::uint64_t>(delta) << 1) ^
+                          static_cast<std::uint64_t>(delta >> 63));
+                previous = position;
+            }
+        }
+    }
+};
+
+class Decoder {
+private:
+    std::span<unsigned char const> data_;
+    std::size_t offset_ = 0;
+
+    [[noreturn]] static void ThrowCorrupted() {
+        throw std::runtime_error("Corrupted record in the partition spill file");
+    }
+
+public:
+    explicit Decoder(std::span<unsigned char const> data) : data_(data) {}
+
+    std::uint64_t GetVarint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (offset_ == data_.size()) ThrowCorrupted();
+            unsigned char const byte = data_[offset_++];
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        ThrowCorrupted();
+    }
+
+    double GetDouble() {
+        double value;
+        if (data_.size() - offset_ < sizeof(value)) ThrowCorrupted();
+        std::memcpy(&value, data_.data() + offset_, sizeof(value));
+        offset_ += sizeof(value);
+        return value;
+    }
+
+    /// Calls `on_cluster(size)` before the positions of every cluster, `on_position(position)`
+    /// for every position.
+    void GetClusters(auto on_cluster, auto on_position) {
+        std::uint64_t const num_clusters = GetVarint();
+        for (std::uint64_t i = 0; i < num_clusters; ++i) {
+            std::uint64_t const size = GetVarint();
+            on_cluster(size);
+            long long position = 0;
+            for (std::uint64_t j = 0; j < size; ++j) {
+                std::uint64_t const zigzag = GetVarint();
+                position += static_cast<long long>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+                on_position(static_cast<int>(position));
+            }
+        }
+    }
+
+    bool IsAtEnd() const noexcept {
+        return offset_ == data_.size();
+    }
+};
+
+std::deque<PositionListIndex::Cluster> DecodeClusters(Decoder& decoder) {
+    std::deque<PositionListIndex::Cluster> clusters;
+    decoder.GetClusters(
+            [&clusters](std::uint64_t size) {
+                clusters.emplace_back();
+                clusters.back().reserve(size);
+            },
+            [&clusters](int position) { clusters.back().push_back(position); });
+    return clusters;
+}
+
+}  // namespace
+
+PliSpillFile::PliSpillFile() : file_(std::tmpfile(), &std::fclose) {
+    if (file_ == nullptr) {
+        throw std::runtime_error("Cannot create a temporary file to spill partitions to");
+    }
+}
+
+PliSpillFile::Record PliSpillFile::Append() {
+    if (std::fseek(file_.get(), static_cast<long>(end_), SEEK_SET) != 0 ||
+        std::fwrite(buffer_.data(), 1, buffer_.size(), file_.get()) != buffer_.size()) {
+        throw std::runtime_error("Failed to write to the partition spill file");
+    }
+    Record const record{end_, buffer_.size()};
+    end_ += buffer_.size();
+    return record;
+}
+
+void PliSpillFile::Load(Record record) {
+    buffer_.resize(record.size);
+    if (std::fseek(file_.get(), static_cast<long>(record.offset), SEEK_SET) != 0 ||
+        std::fread(buffer_.data(), 1, buffer_.size(), file_.get()) != buffer_.size()) {
+        throw std::runtime_error("Failed to read from the partition spill file");
+    }
+}
+
+PliSpillFile::Record PliSpillFile::Write(PLIWithSingletons const& pli) {
+    Encoder encoder{buffer_};
+    encoder.PutVarint(pli.GetRelationSize());
+    encoder.PutVarint(pli.GetSize());
+    encoder.PutVarint(pli.GetNepAsLong());
+    encoder.PutDouble(pli.GetEntropy());
+    encoder.PutDouble(pli.GetInvertedEntropy());
+    encoder.PutDouble(pli.GetGiniImpurity());
+    encoder.PutClusters(pli.GetIndex());
+    encoder.PutClusters(pli.GetSingletons());
+    return Append();
+}
+
+PliSpillFile::Record PliSpillFile::Write(FlatPositionListIndex const& pli) {
+    Encoder encoder{buffer_};
+    encoder.PutVarint(pli.GetRelationSize());
+    encoder.PutClusters(pli.GetIndex());
+    return Append();
+}
+
+std::unique_ptr<PLIWithSingletons> PliSpillFile::ReadPLIWithSingletons(Record record) {
+    Load(record);
+    Decoder decoder{buffer_};
+    auto const relation_size = static_cast<unsigned int>(decoder.GetVarint());
+    auto const size = static_cast<unsigned int>(decoder.GetVarint());
+    unsigned long long const nep = decoder.GetVarint();
+    double const entropy = decoder.GetDouble();
+    double const inverted_entropy = decoder.GetDouble();
+    double const gini_impurity = decoder.GetDouble();
+    std::deque<PositionListIndex::Cluster> index = DecodeClusters(decoder);
+    std::deque<PositionListIndex::Cluster> singletons = DecodeClusters(decoder);
+    if (!decoder.IsAtEnd()) {
+        throw std::runtime_error("Corrupted record in the partition spill file");
+    }
+    return std::make_unique<PLIWithSingletons>(std::move(index), std::move(singletons), size,
+                                               entropy, nep, relation_size, inverted_entropy,
+                                               gini_impurity);
+}
+
+std::unique_ptr<FlatPositionListIndex> PliSpillFile::ReadFlat(Record record,
+                                                              std::pmr::memory_resource* arena) {
+    Load(record);
+    Decoder decoder{buffer_};
+    auto const relation_size = static_cast<unsigned int>(decoder.GetVarint());
+    std::pmr::vector<int> positions(arena);
+    std::pmr::vector<unsigned int> offsets(arena);
+    offsets.push_back(0);
+    decoder.GetClusters(
+            [&offsets](std::uint64_t size) { offsets.push_back(offsets.back() + size); },
+            [&positions](int position) { positions.push_back(position); });
+    if (!decoder.IsAtEnd() || positions.size() != offsets.back()) {
+        throw std::runtime_error("Corrupted record in the partition spill file");
+    }
+    return std::make_unique<FlatPositionListIndex>(std::move(positions), std::move(offsets),
+                                                   relation_size);
+}
+
+}  // namespace model
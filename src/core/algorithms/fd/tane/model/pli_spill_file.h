@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "core/model/table/flat_position_list_index.h"
+#include "core/model/table/position_list_index_with_singletons.h"
+
+namespace model {
+
+/// @brief Temporary file partitions are written to when they do not fit into memory.
+///
+/// Every partition is appended as one record and can be read back any number of times. Positions
+/// of a cluster are stored as varint-encoded deltas from the previous position, so a record is
+/// usually several times smaller than the partition in memory. The statistics of a partition are
+/// stored as they are, a partition read back is identical to the one written. The file is
+/// removed when the object is destroyed.
+class PliSpillFile {
+public:
+    struct Record {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+private:
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file_;
+    std::uint64_t end_ = 0;
+    std::vector<unsigned char> buffer_;
+
+    Record Append();
+    void Load(Record record);
+
+public:
+    /// Throws std::runtime_error if a temporary file cannot be created.
+    PliSpillFile();
+
+    Record Write(PLIWithSingletons const& pli);
+    Record Write(FlatPositionListIndex const& pli);
+
+    std::unique_ptr<PLIWithSingletons> ReadPLIWithSingletons(Record record);
+    std::unique_ptr<FlatPositionListIndex> ReadFlat(
+            Record record, std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+    /// Total size of the records written.
+    std::uint64_t GetSize() const noexcept {
+        return end_;
+    }
+};
+
+}  // namespace model
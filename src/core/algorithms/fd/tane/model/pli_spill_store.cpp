@@ -0,0 +1,112 @@
+#include "core/algorithms/fd/tane/model/pli_spill_store.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace model {
+
+std::size_t PliSpillStore::EstimateBytes(PLIWithSingletons const& pli) {
+    // Every cluster, singletons included, is a vector with a heap block of its own
+    constexpr std::size_t kClusterOverhead = sizeof(PositionListIndex::Cluster) + 2 * sizeof(void*);
+    std::size_t const num_clusters = pli.GetNumNonSingletonCluster() + pli.GetSngltnSize();
+    return sizeof(pli) + pli.GetRelationSize() * sizeof(int) + num_clusters * kClusterOverhead;
+}
+
+void PliSpillStore::Admit(LatticeVertex* vertex) {
+    std::size_t bytes;
+    if (flat_) {
+        if (vertex->GetFlatPositionListIndex() == nullptr) return;
+        bytes = vertex->GetFlatPositionListIndex()->EstimateBytes();
+    } else {
+        if (vertex->GetPositionListIndex() == nullptr) return;
+        bytes = EstimateBytes(*vertex->GetPositionListIndexWithSingletons());
+    }
+    assert(!entries_.contains(vertex));
+    entries_.emplace(vertex, Entry{.vertex = vertex,
+                                   .bytes = bytes,
+                                   .record = std::nullopt,
+                                   .lru_position = lru_.insert(lru_.end(), vertex)});
+    resident_bytes_ += bytes;
+    peak_resident_bytes_ = std::max(peak_resident_bytes_, resident_bytes_);
+    EvictOverBudget();
+}
+
+void PliSpillStore::Pin(LatticeVertex const* vertex) {
+    auto it = entries_.find(vertex);
+    if (it == entries_.end()) return;
+    Entry& entry = it->second;
+    if (!entry.is_resident) {
+        assert(entry.record.has_value());
+        if (flat_) {
+            entry.vertex->AcquireFlatPositionListIndex(
+                    file_->ReadFlat(*entry.record, std::pmr::new_delete_resource()));
+        } else {
+            entry.vertex->AcquirePLIWithSingletons(file_->ReadPLIWithSingletons(*entry.record));
+        }
+        entry.is_resident = true;
+        ++num_reloaded_;
+        resident_bytes_ += entry.bytes;
+        peak_resident_bytes_ = std::max(peak_resident_bytes_, resident_bytes_);
+    } else if (entry.pins == 0) {
+        lru_.erase(entry.lru_position);
+    }
+    ++entry.pins;
+}
+
+void PliSpillStore::Unpin(LatticeVertex const* vertex) {
+    auto it = entries_.find(vertex);
+    if (it == entries_.end()) return;
+    Entry& entry = it->second;
+    assert(entry.pins > 0 && entry.is_resident);
+    if (--entry.pins == 0) {
+        entry.lru_position = lru_.insert(lru_.end(), vertex);
+        EvictOverBudget();
+    }
+}
+
+void PliSpillStore::Evict(Entry& entry) {
+    assert(entry.is_resident && entry.pins == 0);
+    if (!entry.record.has_value()) {
+        if (file_ == nullptr) {
+            file_ = std::make_unique<PliSpillFile>();
+        }
+        entry.record = flat_ ? file_->Write(*entry.vertex->GetFlatPositionListIndex())
+                             : file_->Write(*entry.vertex->GetPositionListIndexWithSingletons());
+        ++num_spilled_;
+    }
+    if (flat_) {
+        entry.vertex->ReleaseFlatPositionListIndex();
+    } else {
+        entry.vertex->ReleasePLIWithSingletons();
+    }
+    lru_.erase(entry.lru_position);
+    entry.is_resident = false;
+    resident_bytes_ -= entry.bytes;
+}
+
+void PliSpillStore::EvictOverBudget() {
+    while (resident_bytes_ > budget_ && !lru_.empty()) {
+        Evict(entries_.at(lru_.front()));
+    }
+}
+
+void PliSpillStore::Drop(LatticeLevel& level) {
+    for (auto& [key, vertex] : level.GetVertices()) {
+        auto it = entries_.find(vertex.get());
+        if (it == entries_.end()) continue;
+        Entry& entry = it->second;
+        assert(entry.pins == 0);
+        if (entry.is_resident) {
+            lru_.erase(entry.lru_position);
+            resident_bytes_ -= entry.bytes;
+            if (flat_) {
+                vertex->ReleaseFlatPositionListIndex();
+            } else {
+                vertex->ReleasePLIWithSingletons();
+            }
+        }
+        entries_.erase(it);
+    }
+}
+
+}  // namespace model
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <unordered_map>
+
+#include "core/algorithms/fd/tane/model/lattice_level.h"
+#include "core/algorithms/fd/tane/model/lattice_vertex.h"
+#include "core/algorithms/fd/tane/model/pli_spill_file.h"
+
+namespace model {
+
+/// @brief Keeps the partitions of lattice vertices within a memory budget.
+///
+/// Partitions of vertices are registered with Admit once computed. While the estimated size of
+/// the resident partitions exceeds the budget, the least recently used partitions that are not
+/// pinned are taken away from their vertices. A partition is written to a PliSpillFile the first
+/// time it is evicted, after that evicting it only frees the memory. Pin brings the partition of
+/// a vertex back and protects it from eviction until the matching Unpin.
+///
+/// Partitions of level 1 are never registered, they belong to the relation or to the level
+/// arena. Flat partitions are allocated from the level arena until the first spill and from the
+/// global allocator after that, so that evicting them actually returns memory.
+///
+/// Not thread-safe, TaneCommon calls it between the parallel parts of a level.
+class PliSpillStore {
+private:
+    struct Entry {
+        LatticeVertex* vertex;
+        std::size_t bytes;
+        std::optional<PliSpillFile::Record> record;
+        unsigned int pins = 0;
+        bool is_resident = true;
+        // Position in lru_, valid if the partition is resident and not pinned
+        std::list<LatticeVertex const*>::iterator lru_position;
+    };
+
+    std::size_t budget_;
+    bool flat_;
+    std::size_t resident_bytes_ = 0;
+    std::size_t peak_resident_bytes_ = 0;
+    std::size_t num_spilled_ = 0;
+    std::size_t num_reloaded_ = 0;
+    std::unique_ptr<PliSpillFile> file_;
+    std::unordered_map<LatticeVertex const*, Entry> entries_;
+    // Resident partitions that are not pinned, the least recently used first
+    std::list<LatticeVertex const*> lru_;
+
+    void Evict(Entry& entry);
+    void EvictOverBudget();
+
+public:
+    PliSpillStore(std::size_t budget_bytes, bool flat) : budget_(budget_bytes), flat_(flat) {}
+
+    void Admit(LatticeVertex* vertex);
+    /// Does nothing for vertices that were not admitted.
+    void Pin(LatticeVertex const* vertex);
+    void Unpin(LatticeVertex const* vertex);
+    /// Forget the vertices of the level and free their partitions.
+    void Drop(LatticeLevel& level);
+
+    /// Memory resource new flat partitions of the level are allocated from.
+    std::pmr::memory_resource* GetResource(LatticeLevel& level) const {
+        return file_ == nullptr ? level.GetArena() : std::pmr::new_delete_resource();
+    }
+
+    /// Bytes written to the spill file.
+    std::size_t GetSpilledBytes() const noexcept {
+        return file_ == nullptr ? 0 : file_->GetSize();
+    }
+
+    std::size_t GetNumSpilled() const noexcept {
+        return num_spilled_;
+    }
+
+    std::size_t GetNumReloaded() const noexcept {
+        return num_reloaded_;
+    }
+
+    /// Estimated peak size of the registered partitions held in memory.
+    std::size_t GetPeakResidentBytes() const noexcept {
+        return peak_resident_bytes_;
+    }
+
+    static std::size_t EstimateBytes(PLIWithSingletons const& pli);
+};
+
+}  // namespace model
@@ -4,8 +4,13 @@
 
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/tane/enums.h"
+#include "core/config/checkpoint/option.h"
 #include "core/config/error/option.h"
 #include "core/config/error_measure/option.h"
+#include "core/config/flat_pli/option.h"
+#include "core/config/mem_limit/option.h"
+#include "core/config/time_limit/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_data.h"
 
 namespace algos {
@@ -16,7 +21,12 @@ void PFDTane::RegisterOptions() {
 }
 
 void PFDTane::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kPfdErrorMeasureOpt.GetName()});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kPfdErrorMeasureOpt.GetName(),
+                          config::kFlatPliOpt.GetName(), config::kThreadNumberOpt.GetName(),
+                          config::kMemLimitMbOpt.GetName(),
+                          config::kTimeLimitSecondsOpt.GetName(),
+                          config::kCheckpointPathOpt.GetName(),
+                          config::kCheckpointIntervalOpt.GetName()});
 }
 
 PFDTane::PFDTane() : tane::TaneCommon() {
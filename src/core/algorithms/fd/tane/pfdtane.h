@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include "core/algorithms/fd/tane/enums.h"
 #include "core/algorithms/fd/tane/tane_common.h"
 #include "core/config/error/type.h"
@@ -14,6 +16,9 @@ private:
     PfdErrorMeasure pfd_error_measure_ = PfdErrorMeasure::kPerTuple;
     void RegisterOptions();
     void MakeExecuteOptsAvailableFDInternal() final;
+    std::string GetCheckpointOptions() const override {
+        return std::string{magic_enum::enum_name(pfd_error_measure_)};
+    }
     config::ErrorType CalculateZeroAryFdError(ColumnData const* rhs) override;
     config::ErrorType CalculateFdError(model::PLIWS const* lhs_pli, model::PLIWS const* rhs_pli,
                                        model::PLIWS const* joint_pli) override;
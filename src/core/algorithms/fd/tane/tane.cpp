@@ -4,8 +4,13 @@
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/tane/afd_measures.h"
 #include "core/algorithms/fd/tane/enums.h"
+#include "core/config/checkpoint/option.h"
 #include "core/config/error/option.h"
 #include "core/config/error_measure/option.h"
+#include "core/config/flat_pli/option.h"
+#include "core/config/mem_limit/option.h"
+#include "core/config/time_limit/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_data.h"
 
 namespace algos {
@@ -15,7 +20,12 @@ Tane::Tane() : tane::TaneCommon() {
 }
 
 void Tane::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kAfdErrorMeasureOpt.GetName()});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kAfdErrorMeasureOpt.GetName(),
+                          config::kFlatPliOpt.GetName(), config::kThreadNumberOpt.GetName(),
+                          config::kMemLimitMbOpt.GetName(),
+                          config::kTimeLimitSecondsOpt.GetName(),
+                          config::kCheckpointPathOpt.GetName(),
+                          config::kCheckpointIntervalOpt.GetName()});
 }
 
 config::ErrorType Tane::CalculateZeroAryFdError(ColumnData const* rhs) {
@@ -44,4 +54,15 @@ config::ErrorType Tane::CalculateFdError(model::PLIWithSingletons const* lhs_pli
     }
 }
 
+config::ErrorType Tane::CalculateFdError(model::FlatPLI const* lhs_pli,
+                                         model::PLIWithSingletons const* rhs_pli,
+                                         model::FlatPLI const* joint_pli) {
+    if (afd_error_measure_ != AfdErrorMeasure::kG1) {
+        return TaneCommon::CalculateFdError(lhs_pli, rhs_pli, joint_pli);
+    }
+    // g1 only needs the number of equal pairs, no need to materialize the partitions
+    return CalculateG1Error(lhs_pli->GetNepAsLong(), joint_pli->GetNepAsLong(),
+                            relation_.get()->GetNumTuplePairs());
+}
+
 }  // namespace algos
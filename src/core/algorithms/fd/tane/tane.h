@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include "core/algorithms/fd/tane/enums.h"
 #include "core/algorithms/fd/tane/tane_common.h"
 #include "core/config/error/type.h"
@@ -12,10 +14,16 @@ class Tane : public tane::TaneCommon {
 private:
     AfdErrorMeasure afd_error_measure_ = AfdErrorMeasure::kG1;
     void MakeExecuteOptsAvailableFDInternal() override final;
+    std::string GetCheckpointOptions() const override {
+        return std::string{magic_enum::enum_name(afd_error_measure_)};
+    }
     config::ErrorType CalculateZeroAryFdError(ColumnData const* rhs) override;
     config::ErrorType CalculateFdError(model::PLIWithSingletons const* lhs_pli,
                                        model::PLIWithSingletons const* rhs_pli,
                                        model::PLIWithSingletons const* joint_pli) override;
+    config::ErrorType CalculateFdError(model::FlatPLI const* lhs_pli,
+                                       model::PLIWithSingletons const* rhs_pli,
+                                       model::FlatPLI const* joint_pli) override;
 
 public:
     Tane();
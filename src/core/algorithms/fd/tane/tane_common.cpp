@@ -1,18 +1,27 @@
 #include "core/algorithms/fd/tane/tane_common.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <list>
 #include <memory>
+#include <optional>
+#include <span>
 
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/tane/model/lattice_level.h"
 #include "core/algorithms/fd/tane/model/lattice_vertex.h"
+#include "core/config/checkpoint/option.h"
 #include "core/config/error/option.h"
+#include "core/config/flat_pli/option.h"
+#include "core/config/mem_limit/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/config/time_limit/option.h"
 #include "core/model/table/column_data.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/relational_schema.h"
 #include "core/util/logger.h"
+#include "core/util/memory_usage.h"
 
 namespace algos {
 using boost::dynamic_bitset;
@@ -21,14 +30,32 @@ namespace tane {
 
 TaneCommon::TaneCommon() : PliBasedFDAlgorithm() {
     RegisterOption(config::kErrorOpt(&max_ucc_error_));
+    RegisterOption(config::kFlatPliOpt(&flat_pli_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterOption(config::kCheckpointPathOpt(&checkpoint_path_));
+    RegisterOption(config::kCheckpointIntervalOpt(&checkpoint_interval_));
+    UseThreadsForLoading(&threads_num_);
 }
 
-double TaneCommon::CalculateUccError(model::PositionListIndex const* pli,
+config::ErrorType TaneCommon::CalculateFdError(model::FlatPLI const* lhs_pli,
+                                               model::PLIWS const* rhs_pli,
+                                               model::FlatPLI const* joint_pli) {
+    return CalculateFdError(lhs_pli->ToPLIWithSingletons().get(), rhs_pli,
+                            joint_pli->ToPLIWithSingletons().get());
+}
+
+double TaneCommon::CalculateUccError(unsigned long long nep,
                                      ColumnLayoutRelationData const* relation_data) {
-    return pli->GetNepAsLong() / static_cast<double>(relation_data->GetNumTuplePairs());
+    return nep / static_cast<double>(relation_data->GetNumTuplePairs());
 }
 
 void TaneCommon::RegisterAndCountFd(Vertical lhs, Column const* rhs) {
+    if (checkpoint_ != nullptr) {
+        unsaved_fds_.Write(lhs.GetColumnIndices());
+        unsaved_fds_.Write<std::uint32_t>(rhs->GetIndex());
+    }
     RegisterFd(std::move(lhs), *rhs, relation_->GetSharedPtrSchema());
 }
 
@@ -39,7 +66,7 @@ void TaneCommon::Prune(model::LatticeLevel* level) {
         Vertical columns = vertex->GetVertical();  // Originally it's a ColumnCombination
 
         if (vertex->GetIsKeyCandidate()) {
-            double ucc_error = CalculateUccError(vertex->GetPositionListIndex(), relation_.get());
+            double ucc_error = CalculateUccError(vertex->GetNepAsLong(), relation_.get());
             if (ucc_error <= max_ucc_error_) {  // If a key candidate is an approx UCC
 
                 vertex->SetKeyCandidate(false);
@@ -84,67 +111,112 @@ void TaneCommon::Prune(model::LatticeLevel* level) {
     }
 }
 
-void TaneCommon::ComputeDependencies(model::LatticeLevel* level) {
-    RelationalSchema const* schema = relation_->GetSchema();
+void TaneCommon::ComputeDependencies(model::LatticeLevel* level, util::WorkerThreadPool* pool,
+                                     model::PliSpillStore& spill_store) {
+    std::vector<model::LatticeVertex*> xa_vertices;
+    xa_vertices.reserve(level->GetVertices().size());
     for (auto& [key_map, xa_vertex] : level->GetVertices()) {
-        if (xa_vertex->GetIsInvalid()) {
-            continue;
+        if (!xa_vertex->GetIsInvalid()) {
+            xa_vertices.push_back(xa_vertex.get());
         }
-        Vertical xa = xa_vertex->GetVertical();
-        // Calculate XA PLI
-        if (xa_vertex->GetPositionListIndex() == nullptr) {
-            auto parent_pli_1 = xa_vertex->GetParents()[0]->GetPositionListIndexWithSingletons();
-            auto parent_pli_2 = xa_vertex->GetParents()[1]->GetPositionListIndexWithSingletons();
-            xa_vertex->AcquirePLIWithSingletons(parent_pli_1->Intersect(parent_pli_2));
+    }
+
+    // Vertices of a level only read the partitions of their parents, so they are independent.
+    // FDs are registered afterwards in the order of the vertices to make the result the same for
+    // any number of threads.
+    std::size_t const batch_size =
+            kBatchVerticesPerThread * (pool == nullptr ? 1 : pool->ThreadNum());
+    std::vector<std::vector<std::pair<Vertical, Column const*>>> found_fds;
+    for (std::size_t begin = 0; begin < xa_vertices.size(); begin += batch_size) {
+        if (GetCancellationToken().IsCancelled()) {
+            return;
+        }
+        std::span<model::LatticeVertex* const> const batch = std::span{xa_vertices}.subspan(
+                begin, std::min(batch_size, xa_vertices.size() - begin));
+        for (model::LatticeVertex* xa_vertex : batch) {
+            for (model::LatticeVertex const* x_vertex : xa_vertex->GetParents()) {
+                spill_store.Pin(x_vertex);
+            }
         }
 
-        dynamic_bitset<> xa_indices = xa.GetColumnIndices();
-        dynamic_bitset<> a_candidates = xa_vertex->GetRhsCandidates();
-        auto xa_pli = xa_vertex->GetPositionListIndexWithSingletons();
-        for (auto const& x_vertex : xa_vertex->GetParents()) {
-            Vertical const& lhs = x_vertex->GetVertical();
+        std::pmr::memory_resource* arena = spill_store.GetResource(*level);
+        found_fds.assign(batch.size(), {});
+        auto compute = [this, arena, batch, &found_fds](model::Index i) {
+            found_fds[i] = ComputeVertexDependencies(batch[i], arena);
+        };
+        if (pool == nullptr) {
+            for (model::Index i = 0; i < batch.size(); ++i) {
+                compute(i);
+            }
+        } else {
+            pool->ExecIndex(compute, batch.size());
+        }
 
-            // Find index of A in XA.
-            dynamic_bitset<> differing_bits = xa_indices ^ lhs.GetColumnIndices();
-            std::size_t a_index = differing_bits.find_first();
-            if (!a_candidates[a_index]) {
-                continue;
+        for (model::LatticeVertex* xa_vertex : batch) {
+            for (model::LatticeVertex const* x_vertex : xa_vertex->GetParents()) {
+                spill_store.Unpin(x_vertex);
             }
-            auto x_pli = x_vertex->GetPositionListIndexWithSingletons();
-            auto a_pli = relation_->GetColumnData(a_index).GetPLWSIndex();
-            // Check X -> A
-            config::ErrorType error = CalculateFdError(x_pli, a_pli, xa_pli);
-            if (error <= max_fd_error_) {
-                Column const* rhs = schema->GetColumns()[a_index].get();
-
-                RegisterAndCountFd(lhs, rhs);
-                xa_vertex->GetRhsCandidates().set(rhs->GetIndex(), false);
-                if (error == 0) {
-                    xa_vertex->GetRhsCandidates() &= lhs.GetColumnIndices();
-                }
+            spill_store.Admit(xa_vertex);
+        }
+        for (auto& vertex_fds : found_fds) {
+            for (auto& [lhs, rhs] : vertex_fds) {
+                RegisterAndCountFd(std::move(lhs), rhs);
             }
         }
     }
 }
 
-unsigned long long TaneCommon::ExecuteInternal() {
-    long apriori_millis = 0;
-    max_fd_error_ = max_ucc_error_;
+std::vector<std::pair<Vertical, Column const*>> TaneCommon::ComputeVertexDependencies(
+        model::LatticeVertex* xa_vertex, std::pmr::memory_resource* arena) {
     RelationalSchema const* schema = relation_->GetSchema();
+    std::vector<std::pair<Vertical, Column const*>> found_fds;
+    Vertical xa = xa_vertex->GetVertical();
+    // Calculate XA PLI
+    if (!xa_vertex->HasPositionListIndex()) {
+        if (flat_pli_) {
+            auto parent_pli_1 = xa_vertex->GetParents()[0]->GetFlatPositionListIndex();
+            auto parent_pli_2 = xa_vertex->GetParents()[1]->GetFlatPositionListIndex();
+            xa_vertex->AcquireFlatPositionListIndex(parent_pli_1->Intersect(*parent_pli_2, arena));
+        } else {
+            auto parent_pli_1 = xa_vertex->GetParents()[0]->GetPositionListIndexWithSingletons();
+            auto parent_pli_2 = xa_vertex->GetParents()[1]->GetPositionListIndexWithSingletons();
+            xa_vertex->AcquirePLIWithSingletons(parent_pli_1->Intersect(parent_pli_2));
+        }
+    }
 
-    LOG_DEBUG("{} has {} columns, {} rows, and a maximum NIP of {:2}.", schema->GetName(),
-              relation_->GetNumColumns(), relation_->GetNumRows(), relation_->GetMaximumNip());
+    dynamic_bitset<> xa_indices = xa.GetColumnIndices();
+    dynamic_bitset<> a_candidates = xa_vertex->GetRhsCandidates();
+    for (auto const& x_vertex : xa_vertex->GetParents()) {
+        Vertical const& lhs = x_vertex->GetVertical();
 
-    for (auto& column : schema->GetColumns()) {
-        double avg_partners = relation_->GetColumnData(column->GetIndex())
-                                      .GetPositionListIndex()
-                                      ->GetNepAsLong() *
-                              2.0 / relation_->GetNumRows();
-        LOG_DEBUG("*{}: every tuple has {:2} partners on average.", column->ToString(),
-                  avg_partners);
+        // Find index of A in XA.
+        dynamic_bitset<> differing_bits = xa_indices ^ lhs.GetColumnIndices();
+        std::size_t a_index = differing_bits.find_first();
+        if (!a_candidates[a_index]) {
+            continue;
+        }
+        auto a_pli = relation_->GetColumnData(a_index).GetPLWSIndex();
+        // Check X -> A
+        config::ErrorType error =
+                flat_pli_ ? CalculateFdError(x_vertex->GetFlatPositionListIndex(), a_pli,
+                                             xa_vertex->GetFlatPositionListIndex())
+                          : CalculateFdError(x_vertex->GetPositionListIndexWithSingletons(), a_pli,
+                                             xa_vertex->GetPositionListIndexWithSingletons());
+        if (error <= max_fd_error_) {
+            Column const* rhs = schema->GetColumns()[a_index].get();
+
+            found_fds.emplace_back(lhs, rhs);
+            xa_vertex->GetRhsCandidates().set(rhs->GetIndex(), false);
+            if (error == 0) {
+                xa_vertex->GetRhsCandidates() &= lhs.GetColumnIndices();
+            }
+        }
     }
-    auto start_time = std::chrono::system_clock::now();
+    return found_fds;
+}
 
+std::vector<std::unique_ptr<model::LatticeLevel>> TaneCommon::CreateFirstLevels() {
+    RelationalSchema const* schema = relation_->GetSchema();
     // Initialize level 0
     std::vector<std::unique_ptr<model::LatticeLevel>> levels;
     auto level0 = std::make_unique<model::LatticeLevel>(0);
@@ -164,7 +236,12 @@ unsigned long long TaneCommon::ExecuteInternal() {
         vertex->AddRhsCandidates(schema->GetColumns());
         vertex->GetParents().push_back(empty_vertex);
         vertex->SetKeyCandidate(true);
-        vertex->SetPLIWithSingletons(column_data.GetPLWSIndex());
+        if (flat_pli_) {
+            vertex->AcquireFlatPositionListIndex(model::FlatPLI::CreateFrom(
+                    *column_data.GetPositionListIndex(), level1->GetArena()));
+        } else {
+            vertex->SetPLIWithSingletons(column_data.GetPLWSIndex());
+        }
 
         // check FDs: 0->A
         double fd_error = CalculateZeroAryFdError(&column_data);
@@ -189,7 +266,8 @@ unsigned long long TaneCommon::ExecuteInternal() {
         // вот тут костыль, чтобы вытянуть индекс колонки из вершины, в которой только один индекс
         ColumnData const& column_data =
                 relation_->GetColumnData(column.GetColumnIndices().find_first());
-        double ucc_error = CalculateUccError(column_data.GetPositionListIndex(), relation_.get());
+        double ucc_error = CalculateUccError(column_data.GetPositionListIndex()->GetNepAsLong(),
+                                             relation_.get());
         if (ucc_error <= max_ucc_error_) {
             vertex->SetKeyCandidate(false);
             if (ucc_error == 0 && max_lhs_ != 0) {
@@ -209,10 +287,158 @@ unsigned long long TaneCommon::ExecuteInternal() {
         }
     }
     levels.push_back(std::move(level1));
+    return levels;
+}
+
+std::vector<std::unique_ptr<model::LatticeLevel>> TaneCommon::ResumeLevels(
+        util::WorkerThreadPool* pool, model::PliSpillStore& spill_store) {
+    std::vector<util::CheckpointFile::Record> const& records = checkpoint_->GetRecords();
+    auto const snapshot = std::find_if(records.rbegin(), records.rend(),
+                                       [](auto const& record) { return record.kind == kLevel; });
+    if (snapshot == records.rend()) {
+        checkpoint_->DiscardAfter(0);
+        return {};
+    }
+    // FDs registered after the snapshot will be found again
+    std::size_t const num_kept = records.rend() - snapshot;
+    for (std::size_t i = 0; i + 1 < num_kept; ++i) {
+        if (records[i].kind != kFds) continue;
+        util::CheckpointDecoder decoder{records[i].payload};
+        while (!decoder.AtEnd()) {
+            dynamic_bitset<> const lhs = decoder.ReadBitset();
+            auto const rhs = decoder.Read<std::uint32_t>();
+            RegisterFd(lhs, rhs, relation_->GetSharedPtrSchema());
+        }
+    }
+
+    RelationalSchema const* schema = relation_->GetSchema();
+    util::CheckpointDecoder decoder{snapshot->payload};
+    auto const arity = decoder.Read<std::uint32_t>();
+    auto const num_vertices = decoder.Read<std::uint64_t>();
+    // Only the saved level is needed to generate the next one
+    std::vector<std::unique_ptr<model::LatticeLevel>> levels;
+    for (unsigned int i = 0; i < arity; ++i) {
+        levels.push_back(std::make_unique<model::LatticeLevel>(i));
+    }
+    auto level = std::make_unique<model::LatticeLevel>(arity);
+    std::vector<model::LatticeVertex*> valid_vertices;
+    for (std::uint64_t i = 0; i < num_vertices; ++i) {
+        auto vertex =
+                std::make_unique<model::LatticeVertex>(Vertical(schema, decoder.ReadBitset()));
+        vertex->GetRhsCandidates() = decoder.ReadBitset();
+        vertex->SetKeyCandidate(decoder.Read<bool>());
+        vertex->SetInvalid(decoder.Read<bool>());
+        if (!vertex->GetIsInvalid()) {
+            valid_vertices.push_back(vertex.get());
+        }
+        level->Add(std::move(vertex));
+    }
+    LOG_INFO("Resuming from level {} of {} vertices and {} FDs", arity, num_vertices,
+             fd_collection_.Size());
+
+    // Children of the invalid vertices are invalid, so only the valid ones need partitions
+    std::size_t const batch_size =
+            kBatchVerticesPerThread * (pool == nullptr ? 1 : pool->ThreadNum());
+    for (std::size_t begin = 0; begin < valid_vertices.size(); begin += batch_size) {
+        std::span<model::LatticeVertex* const> const batch = std::span{valid_vertices}.subspan(
+                begin, std::min(batch_size, valid_vertices.size() - begin));
+        std::pmr::memory_resource* arena = spill_store.GetResource(*level);
+        auto restore = [this, arena, batch](model::Index i) { RestorePartition(batch[i], arena); };
+        if (pool == nullptr) {
+            for (model::Index i = 0; i < batch.size(); ++i) {
+                restore(i);
+            }
+        } else {
+            pool->ExecIndex(restore, batch.size());
+        }
+        for (model::LatticeVertex* vertex : batch) {
+            spill_store.Admit(vertex);
+        }
+    }
+    levels.push_back(std::move(level));
+    checkpoint_->DiscardAfter(num_kept);
+    return levels;
+}
+
+void TaneCommon::RestorePartition(model::LatticeVertex* vertex,
+                                  std::pmr::memory_resource* arena) const {
+    Vertical const& columns = vertex->GetVertical();
+    dynamic_bitset<> const& indices = columns.GetColumnIndices();
+    std::size_t const first_index = indices.find_first();
+    ColumnData const& first_column = relation_->GetColumnData(first_index);
+    if (flat_pli_) {
+        Vertical const rest = columns.Without(*relation_->GetSchema()->GetColumn(first_index));
+        auto first_pli = model::FlatPLI::CreateFrom(*first_column.GetPositionListIndex());
+        vertex->AcquireFlatPositionListIndex(first_pli->ProbeAll(rest, *relation_, arena));
+        return;
+    }
+    std::unique_ptr<model::PLIWS> pli;
+    model::PLIWS const* current_pli = first_column.GetPLWSIndex();
+    for (std::size_t index = indices.find_next(first_index); index != dynamic_bitset<>::npos;
+         index = indices.find_next(index)) {
+        pli = current_pli->Intersect(relation_->GetColumnData(index).GetPLWSIndex());
+        current_pli = pli.get();
+    }
+    vertex->AcquirePLIWithSingletons(std::move(pli));
+}
+
+void TaneCommon::SaveLevel(model::LatticeLevel& level) {
+    checkpoint_->Append(kFds, unsaved_fds_.Release());
+    util::CheckpointEncoder encoder;
+    encoder.Write<std::uint32_t>(level.GetArity());
+    encoder.Write<std::uint64_t>(level.GetVertices().size());
+    for (auto const& [column_indices, vertex] : level.GetVertices()) {
+        encoder.Write(column_indices);
+        encoder.Write(vertex->GetConstRhsCandidates());
+        encoder.Write(vertex->GetIsKeyCandidate());
+        encoder.Write(vertex->GetIsInvalid());
+    }
+    checkpoint_->AppendSnapshot(kLevel, encoder.Release());
+}
+
+unsigned long long TaneCommon::ExecuteInternal() {
+    long apriori_millis = 0;
+    max_fd_error_ = max_ucc_error_;
+    RelationalSchema const* schema = relation_->GetSchema();
+
+    LOG_DEBUG("{} has {} columns, {} rows, and a maximum NIP of {:2}.", schema->GetName(),
+              relation_->GetNumColumns(), relation_->GetNumRows(), relation_->GetMaximumNip());
+
+    for (auto& column : schema->GetColumns()) {
+        double avg_partners = relation_->GetColumnData(column->GetIndex())
+                                      .GetPositionListIndex()
+                                      ->GetNepAsLong() *
+                              2.0 / relation_->GetNumRows();
+        LOG_DEBUG("*{}: every tuple has {:2} partners on average.", column->ToString(),
+                  avg_partners);
+    }
+    auto start_time = std::chrono::system_clock::now();
+    // The partitions are kept within mem_limit by spilling them, so only the time is limited
+    GetCancellationToken().Start(std::chrono::seconds(time_limit_seconds_));
+
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool.emplace(threads_num_);
+    }
+    model::PliSpillStore spill_store{static_cast<std::size_t>(mem_limit_mb_) << 20, flat_pli_};
+
+    checkpoint_ = OpenCheckpoint(checkpoint_path_, checkpoint_interval_, [this] {
+        util::CheckpointEncoder options;
+        options.Write(GetCheckpointOptions());
+        options.Write(max_ucc_error_);
+        return options.Release();
+    }());
+    std::vector<std::unique_ptr<model::LatticeLevel>> levels;
+    if (checkpoint_ != nullptr) {
+        levels = ResumeLevels(pool ? &*pool : nullptr, spill_store);
+    }
+    if (levels.empty()) {
+        levels = CreateFirstLevels();
+    }
 
     unsigned int max_arity =
             max_lhs_ == std::numeric_limits<unsigned int>::max() ? max_lhs_ : max_lhs_ + 1;
-    for (unsigned int arity = 2; arity <= max_arity; arity++) {
+    for (unsigned int arity = levels.size(); arity <= max_arity; arity++) {
         model::LatticeLevel::ClearLevelsBelow(levels, arity - 1);
         model::LatticeLevel::GenerateNextLevel(levels);
 
@@ -222,15 +448,28 @@ unsigned long long TaneCommon::ExecuteInternal() {
             break;
         }
 
-        ComputeDependencies(level);
+        ComputeDependencies(level, pool ? &*pool : nullptr, spill_store);
+        // Partitions of the previous level have been intersected by all of their children
+        spill_store.Drop(*levels[arity - 1]);
 
-        if (arity == max_arity) {
+        // The FDs found so far hold, but pruning needs the whole level to be processed
+        if (arity == max_arity || GetCancellationToken().WasCancelled()) {
             break;
         }
 
         Prune(level);
+        if (checkpoint_ != nullptr && checkpoint_->IsSnapshotDue()) {
+            SaveLevel(*level);
+        }
         // TODO: printProfilingData
     }
+    if (checkpoint_ != nullptr) {
+        if (IsComplete()) {
+            checkpoint_->Remove();
+        }
+        checkpoint_.reset();
+        unsaved_fds_.Release();
+    }
 
     std::chrono::milliseconds elapsed_milliseconds =
             std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() -
@@ -239,7 +478,13 @@ unsigned long long TaneCommon::ExecuteInternal() {
 
     LOG_DEBUG("Time: {} milliseconds", apriori_millis);
     LOG_DEBUG("Intersection time: {} ms", model::PositionListIndex::micros_ / 1000);
-    LOG_DEBUG("Total intersections: {}", model::PositionListIndex::intersection_count_);
+    LOG_DEBUG("Total intersections: {}", model::PositionListIndex::intersection_count_.load());
+    spilled_bytes_ = spill_store.GetSpilledBytes();
+    peak_rss_bytes_ = util::GetPeakRssBytes();
+    LOG_DEBUG("Partitions spilled: {}, reloaded: {}, {} bytes written", spill_store.GetNumSpilled(),
+              spill_store.GetNumReloaded(), spilled_bytes_);
+    LOG_DEBUG("Peak partition memory: {} bytes, peak RSS: {} bytes",
+              spill_store.GetPeakResidentBytes(), peak_rss_bytes_);
     LOG_DEBUG("Total FD count: {}", fd_collection_.Size());
     LOG_DEBUG("HASH: {}", Fletcher16());
     return apriori_millis;
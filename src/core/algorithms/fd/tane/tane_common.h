@@ -1,11 +1,27 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/tane/model/lattice_level.h"
+#include "core/algorithms/fd/tane/model/pli_spill_store.h"
+#include "core/config/checkpoint/type.h"
 #include "core/config/error/type.h"
+#include "core/config/flat_pli/type.h"
+#include "core/config/mem_limit/type.h"
+#include "core/config/time_limit/type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_data.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/flat_position_list_index.h"
 #include "core/model/table/position_list_index.h"
+#include "core/util/checkpoint_file.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos::tane {
 
@@ -13,23 +29,78 @@ class TaneCommon : public PliBasedFDAlgorithm {
 protected:
     config::ErrorType max_fd_error_;
     config::ErrorType max_ucc_error_;
+    config::FlatPliType flat_pli_ = false;
+    config::ThreadNumType threads_num_ = 1;
+    config::MemLimitMBType mem_limit_mb_;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::CheckpointPathType checkpoint_path_;
+    config::CheckpointIntervalType checkpoint_interval_;
+
+    // Options of the subclass that change the result, a checkpoint made with other values of them
+    // is not resumed from
+    virtual std::string GetCheckpointOptions() const = 0;
+
+    // Used with flat partitions, materializes them with singletons by default
+    virtual config::ErrorType CalculateFdError(model::FlatPLI const* lhs_pli,
+                                               model::PLIWS const* rhs_pli,
+                                               model::FlatPLI const* joint_pli);
 
 private:
-    void ResetStateFd() final {}
+    // Vertices of a level are processed in batches of this many vertices per thread, partitions
+    // of the parents of a batch are kept in memory until the batch is done
+    static constexpr std::size_t kBatchVerticesPerThread = 64;
+
+    // Kinds of the checkpoint records: FDs registered since the previous snapshot and a snapshot
+    // of the pruned level the traversal goes on from
+    enum CheckpointRecordKind : std::uint32_t { kFds, kLevel };
+
+    std::size_t peak_rss_bytes_ = 0;
+    std::size_t spilled_bytes_ = 0;
+    std::unique_ptr<util::CheckpointFile> checkpoint_;
+    // LHS indices and the RHS index of each FD registered since the previous snapshot
+    util::CheckpointEncoder unsaved_fds_;
+
+    void ResetStateFd() final {
+        peak_rss_bytes_ = 0;
+        spilled_bytes_ = 0;
+    }
 
     void Prune(model::LatticeLevel* level);
-    void ComputeDependencies(model::LatticeLevel* level);
+    // Vertices of the level are processed by the pool if it is not null
+    void ComputeDependencies(model::LatticeLevel* level, util::WorkerThreadPool* pool,
+                             model::PliSpillStore& spill_store);
+    // Returns the FDs found, does not touch anything except for the vertex
+    std::vector<std::pair<Vertical, Column const*>> ComputeVertexDependencies(
+            model::LatticeVertex* xa_vertex, std::pmr::memory_resource* arena);
+    // Levels 0 and 1 with the zeroary and unary FDs registered
+    std::vector<std::unique_ptr<model::LatticeLevel>> CreateFirstLevels();
+    // Registers the FDs saved in the checkpoint and returns the levels up to the saved one, whose
+    // partitions are computed again. Returns no levels if there is nothing to resume from
+    std::vector<std::unique_ptr<model::LatticeLevel>> ResumeLevels(
+            util::WorkerThreadPool* pool, model::PliSpillStore& spill_store);
+    void RestorePartition(model::LatticeVertex* vertex, std::pmr::memory_resource* arena) const;
+    void SaveLevel(model::LatticeLevel& level);
     unsigned long long ExecuteInternal() final;
     virtual config::ErrorType CalculateZeroAryFdError(ColumnData const* rhs) = 0;
     virtual config::ErrorType CalculateFdError(model::PLIWS const* lhs_pli,
                                                [[maybe_unused]] model::PLIWS const* rhs_pli,
                                                model::PLIWS const* joint_pli) = 0;
-    static double CalculateUccError(model::PositionListIndex const* pli,
+    static double CalculateUccError(unsigned long long nep,
                                     ColumnLayoutRelationData const* relation_data);
     void RegisterAndCountFd(Vertical lhs, Column const* rhs);
 
 public:
     TaneCommon();
+
+    /// Peak resident set size of the process after the last execution.
+    std::size_t GetPeakRssBytes() const noexcept {
+        return peak_rss_bytes_;
+    }
+
+    /// Bytes of partitions written to disk to stay within mem_limit in the last execution.
+    std::size_t GetSpilledBytes() const noexcept {
+        return spilled_bytes_;
+    }
 };
 
 }  // namespace algos::tane
@@ -1,12 +1,12 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 
 #include "core/algorithms/ind/faida/hashing/murmur_hash_3.h"
 
 namespace algos::faida::hashing {
 
-inline size_t CalcMurmurHash(std::string const& str) {
+inline size_t CalcMurmurHash(std::string_view str) {
     size_t hash_long[2];
     unsigned constexpr seed = 0;
     MurmurHash3_x64_128(str.data(), str.size(), seed, &hash_long);
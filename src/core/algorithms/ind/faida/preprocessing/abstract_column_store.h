@@ -49,7 +49,7 @@ protected:
 
     HashedTableSample ReadSample() const;
 
-    size_t Hash(std::string const& str) const {
+    size_t Hash(std::string_view str) const {
         size_t curr_hash = hashing::CalcMurmurHash(str);
 
         if (curr_hash == null_hash_ && !str.empty()) {
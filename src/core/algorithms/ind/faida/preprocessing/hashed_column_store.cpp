@@ -38,9 +38,11 @@ void HashedColumnStore::WriteColumnsAndSample(model::IDatasetStream& data_stream
     int const bufsize = read_buff_size_;
     std::vector buf(schema_->GetNumColumns(), std::vector<size_t>(bufsize));
 
+    model::IDatasetStream::RowView row;
+    model::IDatasetStream::Row row_buffer;
     int row_counter = 0;
     while (data_stream.HasNextRow()) {
-        std::vector<std::string> row = data_stream.GetNextRow();
+        data_stream.GetNextRowView(row, row_buffer);
         if (row.empty() || row.size() != schema_->GetNumColumns()) {
             continue;
         }
@@ -48,7 +50,7 @@ void HashedColumnStore::WriteColumnsAndSample(model::IDatasetStream& data_stream
         bool is_sample_complete = true;
         bool row_has_unseen_value = false;
         for (ColumnIndex col_idx = 0; col_idx < schema_->GetNumColumns(); col_idx++) {
-            std::string const& value = row.at(col_idx);
+            std::string_view const value = row.at(col_idx);
             size_t value_hash = this->Hash(value);
 
             buf[col_idx][row_counter % bufsize] = value_hash;
@@ -79,7 +81,7 @@ void HashedColumnStore::WriteColumnsAndSample(model::IDatasetStream& data_stream
         }
 
         if (row_has_unseen_value) {
-            rows_to_sample.emplace_back(std::move(row));
+            rows_to_sample.emplace_back(row.begin(), row.end());
         }
 
         row_counter++;
@@ -1,15 +1,61 @@
 #include "core/algorithms/ind/ind_algorithm.h"
 
+#include <cstring>
+#include <utility>
+
 #include "core/config/names_and_descriptions.h"
 #include "core/config/tabular_data/input_tables/option.h"
 
 namespace algos {
 
+namespace {
+
+void WriteJsonColumnCombination(std::ostream& out, model::ColumnCombination const& cc) {
+    out << "{\"table\": " << cc.GetTableIndex() << ", \"columns\": [";
+    bool first = true;
+    for (model::ColumnIndex index : cc.GetColumnIndices()) {
+        if (!first) out << ", ";
+        out << index;
+        first = false;
+    }
+    out << "]}";
+}
+
+void WriteBinaryColumnCombination(std::ostream& out, model::ColumnCombination const& cc) {
+    WriteVarint(out, cc.GetTableIndex());
+    WriteIndices(out, cc.GetColumnIndices());
+}
+
+}  // namespace
+
+void ResultFormat<model::IND>::WriteJson(std::ostream& out, model::IND const& ind) {
+    out << "{\"lhs\": ";
+    WriteJsonColumnCombination(out, ind.GetLhs());
+    out << ", \"rhs\": ";
+    WriteJsonColumnCombination(out, ind.GetRhs());
+    out << ", \"error\": " << ind.GetError() << "}";
+}
+
+void ResultFormat<model::IND>::WriteBinary(std::ostream& out, model::IND const& ind) {
+    WriteBinaryColumnCombination(out, ind.GetLhs());
+    WriteBinaryColumnCombination(out, ind.GetRhs());
+    double const error = ind.GetError();
+    char bytes[sizeof(error)];
+    std::memcpy(bytes, &error, sizeof(error));
+    out.write(bytes, sizeof(bytes));
+}
+
 INDAlgorithm::INDAlgorithm() : Algorithm() {
     RegisterOption(config::kTablesOpt(&input_tables_));
     MakeOptionsAvailable({config::kTablesOpt.GetName()});
 }
 
+void INDAlgorithm::SetResultSink(std::shared_ptr<ResultSink<IND>> sink, bool retain_inds) {
+    SetResultSinkBase(sink);
+    ind_sink_ = std::move(sink);
+    retain_inds_ = retain_inds || ind_sink_ == nullptr;
+}
+
 void INDAlgorithm::LoadDataInternal() {
     schemas_ = std::make_shared<std::vector<std::unique_ptr<RelationalSchema>>>();
     for (auto const& input_table : input_tables_) {
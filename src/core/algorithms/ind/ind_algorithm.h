@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <ostream>
 #include <string_view>
 #include <vector>
 
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/ind/ind.h"
+#include "core/algorithms/result_sink.h"
 #include "core/config/error/type.h"
 #include "core/config/tabular_data/input_tables_type.h"
 #include "core/model/table/relational_schema.h"
@@ -13,6 +16,16 @@
 
 namespace algos {
 
+template <>
+struct ResultFormat<model::IND> {
+    static constexpr std::uint8_t kKind = 2;
+
+    // {"lhs": {"table": ..., "columns": [...]}, "rhs": {...}, "error": ...}
+    static void WriteJson(std::ostream& out, model::IND const& ind);
+    // Table index and column indices of the LHS, the same for the RHS, then the error as 8 bytes
+    static void WriteBinary(std::ostream& out, model::IND const& ind);
+};
+
 class INDAlgorithm : public Algorithm {
 public:
     using IND = model::IND;
@@ -20,6 +33,8 @@ public:
 private:
     util::PrimitiveCollection<IND> ind_collection_;
     std::shared_ptr<std::vector<std::unique_ptr<RelationalSchema>>> schemas_;
+    std::shared_ptr<ResultSink<IND>> ind_sink_;
+    bool retain_inds_ = true;
 
     void LoadDataInternal() final;
 
@@ -40,7 +55,7 @@ protected:
     virtual void RegisterIND(std::shared_ptr<model::ColumnCombination> lhs,
                              std::shared_ptr<model::ColumnCombination> rhs,
                              config::ErrorType error = 0.0) {
-        ind_collection_.Register(std::move(lhs), std::move(rhs), schemas_, error);
+        RegisterIND(IND{std::move(lhs), std::move(rhs), schemas_, error});
     }
 
     void RegisterIND(model::ColumnCombination lhs, model::ColumnCombination rhs,
@@ -50,10 +65,16 @@ protected:
     }
 
     virtual void RegisterIND(IND ind) {
-        ind_collection_.Register(std::move(ind));
+        if (ind_sink_ != nullptr) ind_sink_->Consume(ind);
+        if (retain_inds_) ind_collection_.Register(std::move(ind));
     }
 
 public:
+    /* Passes every IND to sink as soon as it is registered. If retain_inds is false, the INDs are
+     * not kept in memory and INDList() stays empty. nullptr removes the sink.
+     */
+    void SetResultSink(std::shared_ptr<ResultSink<IND>> sink, bool retain_inds = true);
+
     std::list<IND> const& INDList() const noexcept {
         return ind_collection_.AsList();
     }
@@ -5,7 +5,7 @@
  */
 #pragma once
 
-#include <string>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -13,7 +13,7 @@
 
 #include "core/config/error/type.h"
 #include "core/model/table/column_combination.h"
-#include "core/model/table/column_domain_iterator.h"
+#include "core/model/table/column_domain.h"
 #include "core/model/table/column_index.h"
 #include "core/util/bitset_utils.h"
 
@@ -24,44 +24,27 @@ using AttributeIndex = model::ColumnIndex;
 namespace details {
 /// base class for IND attributes
 class Attribute {
-public:
-    using Iterator = model::ColumnDomainIterator;
-
 protected:
-    AttributeIndex id_;         /* attribute unique identifier */
-    AttributeIndex attr_count_; /* attribute unique identifier */
-    Iterator it_;               /* domain iterator */
+    AttributeIndex id_;                                        /* attribute unique identifier */
+    AttributeIndex attr_count_;                                /* attribute unique identifier */
+    std::reference_wrapper<model::ColumnDomain const> domain_; /* attribute values */
 
 public:
     Attribute(AttributeIndex attr_id, AttributeIndex attr_count, model::ColumnDomain const& domain)
-        : id_(attr_id), attr_count_(attr_count), it_(domain) {}
+        : id_(attr_id), attr_count_(attr_count), domain_(domain) {}
 
     /// get unique attribute id
     AttributeIndex GetId() const noexcept {
         return id_;
     }
 
-    /// check whether the attribute has processed
+    /// check whether the rest of the attribute values can be skipped
     virtual bool HasFinished() const noexcept {
-        return !it_.HasNext();
-    }
-
-    std::string const& GetCurrentValue() const noexcept {
-        return it_.GetValue();
-    }
-
-    void MoveToNext() {
-        it_.MoveToNext();
-    }
-
-    /// compare attributes first by their values and then by their ids
-    bool operator>(Attribute const& rhs) const {
-        int const cmp = GetCurrentValue().compare(rhs.GetCurrentValue());
-        return cmp == 0 ? GetId() > rhs.GetId() : cmp > 0;
+        return false;
     }
 
     model::ColumnCombination ToCC() const {
-        model::ColumnDomain const& domain = it_.GetDomain();
+        model::ColumnDomain const& domain = domain_.get();
         return {domain.GetTableId(), std::vector{domain.GetColumnId()}};
     }
 };
@@ -82,6 +65,13 @@ public:
         }
     }
 
+    /// add the occurrences counted by the attribute on another range of values
+    void Merge(AINDAttribute const& other) {
+        for (size_t ref_id = 0; ref_id != occurrences_.size(); ++ref_id) {
+            occurrences_[ref_id] += other.occurrences_[ref_id];
+        }
+    }
+
     /// get referenced attribute indices
     std::vector<AttributeIndex> GetRefIds(config::ErrorType max_error) const;
 
@@ -118,6 +108,11 @@ public:
     ///
     void IntersectRefs(boost::dynamic_bitset<> const& bitset, std::vector<INDAttribute>& attrs);
 
+    /// keep the referenced attributes the attribute has kept on another range of values
+    void Merge(INDAttribute const& other) {
+        refs_ &= other.refs_;
+    }
+
     /// get referenced attribute indices
     std::vector<AttributeIndex> GetRefIds() const {
         return util::BitsetToIndices<AttributeIndex>(refs_);
@@ -129,13 +124,12 @@ public:
     }
 
     ///
-    /// \brief check whether the attribute has processed
+    /// \brief check whether the rest of the attribute values can be skipped
     ///
-    /// processing is completed if all values have been processed
-    /// or there are no more dependent and referenced candidates
+    /// they can if there are no more dependent and referenced candidates
     ///
     bool HasFinished() const noexcept final {
-        return !it_.HasNext() || (refs_.none() && deps_.none());
+        return refs_.none() && deps_.none();
     }
 
     /// get referenced attributes indices
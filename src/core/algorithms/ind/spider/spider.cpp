@@ -5,10 +5,13 @@
  */
 #include "core/algorithms/ind/spider/spider.h"
 
-#include <functional>
-#include <queue>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 #include "core/algorithms/ind/spider/attribute.h"
 #include "core/config/equal_nulls/option.h"
@@ -17,6 +20,8 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/thread_number/option.h"
+#include "core/util/loser_tree.h"
+#include "core/util/parallel_for.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos {
@@ -61,24 +66,74 @@ std::vector<Attribute> InitAttributes(std::vector<model::ColumnDomain> const& do
     return attrs;
 }
 
+/* sorted run of attribute values, one partition of its domain */
+struct Run {
+    std::unique_ptr<model::DomainPartition::PartitionReader> reader;
+    AttributeIndex attr_id;
+    bool exhausted = false;
+};
+
+std::vector<Run> CreateRuns(std::vector<model::ColumnDomain> const& domains,
+                            model::DomainValueRange const& range) {
+    std::vector<Run> runs;
+    for (AttributeIndex attr_id = 0; attr_id != domains.size(); ++attr_id) {
+        for (model::DomainPartition const& partition : domains[attr_id].GetData()) {
+            if (auto reader = partition.GetReader(range)) {
+                runs.push_back({std::move(reader), attr_id});
+            }
+        }
+    }
+    return runs;
+}
+
+///
+/// \brief merge the runs of all attributes at once over a range of values
+///
+/// The runs are merged with a loser tree ordered by the current values of the runs and then by
+/// their attributes, so each group of equal values comes in one piece. The runs of the attributes
+/// that have finished are dropped as soon as they win.
+///
 template <typename Attribute>
 std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> const& domains,
+                                              model::DomainValueRange const& range,
                                               config::EqNullsType is_null_equal_null) {
-    using AttributeRW = std::reference_wrapper<Attribute>;
     std::vector attrs = InitAttributes<Attribute>(domains);
-    std::priority_queue<AttributeRW, std::vector<AttributeRW>, std::greater<Attribute>> attr_pq(
-            attrs.begin(), attrs.end());
+    std::vector<Run> runs = CreateRuns(domains, range);
+    if (runs.empty()) return attrs;
+
+    auto const run_less = [&runs](size_t lhs_id, size_t rhs_id) {
+        Run const& lhs = runs[lhs_id];
+        Run const& rhs = runs[rhs_id];
+        if (lhs.exhausted || rhs.exhausted) return !lhs.exhausted;
+        int const cmp = lhs.reader->GetValue().compare(rhs.reader->GetValue());
+        return cmp == 0 ? lhs.attr_id < rhs.attr_id : cmp < 0;
+    };
+    util::LoserTree tree{runs.size(), run_less};
+    /* get the run with the least value, the runs of finished attributes are dropped */
+    auto const next_run = [&]() -> Run& {
+        Run* run = &runs[tree.Winner()];
+        while (!run->exhausted && attrs[run->attr_id].HasFinished()) {
+            run->exhausted = true;
+            tree.Replay();
+            run = &runs[tree.Winner()];
+        }
+        return *run;
+    };
+
     boost::dynamic_bitset<> ids_bitset(attrs.size());
-    while (!attr_pq.empty()) {
-        AttributeRW attr_rw = attr_pq.top();
-        std::string const& value = attr_rw.get().GetCurrentValue();
+    std::string value;
+    for (Run* run = &next_run(); !run->exhausted; run = &next_run()) {
+        value = run->reader->GetValue();
+        /* null is only equal to the nulls of the same attribute */
+        bool const single_attr = value.empty() && !is_null_equal_null;
+        AttributeIndex const first_id = run->attr_id;
         do {
-            attr_pq.pop();
-            ids_bitset.set(attr_rw.get().GetId());
-            if (attr_pq.empty()) break;
-            attr_rw = attr_pq.top();
-            if (value.empty() && !is_null_equal_null) break;
-        } while (attr_rw.get().GetCurrentValue() == value);
+            ids_bitset.set(run->attr_id);
+            run->exhausted = !run->reader->TryMove();
+            tree.Replay();
+            run = &next_run();
+        } while (!run->exhausted && run->reader->GetValue() == value &&
+                 (!single_attr || run->attr_id == first_id));
 
         auto ids_vec = util::BitsetToIndices<AttributeIndex>(ids_bitset);
         for (auto id : ids_vec) {
@@ -88,14 +143,66 @@ std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> c
                 attrs[id].IntersectRefs(ids_vec);
             }
         }
-        for (auto id : ids_vec) {
-            Attribute& attr = attrs[id];
-            if (!attr.HasFinished()) {
-                attr.MoveToNext();
-                attr_pq.emplace(attr);
+        ids_bitset.reset();
+    }
+    return attrs;
+}
+
+/* split the values into at most `count` ranges with about the same number of sampled values */
+std::vector<model::DomainValueRange> SplitValues(std::vector<model::ColumnDomain> const& domains,
+                                                 size_t count) {
+    std::vector<model::DomainPartition::Value> samples;
+    if (count > 1) {
+        for (model::ColumnDomain const& domain : domains) {
+            for (model::DomainPartition const& partition : domain.GetData()) {
+                auto const partition_samples = partition.GetSampleValues();
+                samples.insert(samples.end(), partition_samples.begin(), partition_samples.end());
             }
         }
-        ids_bitset.reset();
+        std::sort(samples.begin(), samples.end());
+    }
+
+    std::vector<model::DomainValueRange> ranges(1);
+    for (size_t i = 1; i < count && !samples.empty(); ++i) {
+        auto const bound = samples[i * samples.size() / count];
+        std::optional<std::string> const& lower = ranges.back().lower;
+        /* no value is less than the empty one, and the ranges must not be empty */
+        if (bound.empty() || (lower && *lower == bound)) continue;
+        ranges.back().upper = std::string{bound};
+        ranges.push_back({std::string{bound}, std::nullopt});
+    }
+    return ranges;
+}
+
+///
+/// \brief process the attributes on several threads
+///
+/// The values are split into ranges by sampling the runs, and each range is merged on its own.
+/// The values of different ranges are different, so the results of the ranges are combined
+/// attribute by attribute.
+///
+template <typename Attribute>
+std::vector<Attribute> ProcessAttributes(std::vector<model::ColumnDomain> const& domains,
+                                         config::EqNullsType is_null_equal_null,
+                                         config::ThreadNumType threads_num) {
+    /* several ranges per thread even out ranges of different cost */
+    static constexpr size_t kRangesPerThread = 4;
+
+    size_t const range_count = threads_num == 1 ? 1 : threads_num * kRangesPerThread;
+    std::vector<model::DomainValueRange> const ranges = SplitValues(domains, range_count);
+    std::vector<std::vector<Attribute>> range_attrs(ranges.size());
+    std::vector<size_t> range_ids(ranges.size());
+    std::iota(range_ids.begin(), range_ids.end(), 0);
+    util::ParallelForeach(range_ids.begin(), range_ids.end(), threads_num, [&](size_t range_id) {
+        range_attrs[range_id] =
+                GetProcessedAttributes<Attribute>(domains, ranges[range_id], is_null_equal_null);
+    });
+
+    std::vector<Attribute> attrs = std::move(range_attrs.front());
+    for (size_t range_id = 1; range_id < range_attrs.size(); ++range_id) {
+        for (AttributeIndex attr_id = 0; attr_id != attrs.size(); ++attr_id) {
+            attrs[attr_id].Merge(range_attrs[range_id][attr_id]);
+        }
     }
     return attrs;
 }
@@ -103,7 +210,8 @@ std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> c
 
 void Spider::MineINDs() {
     using spider::INDAttribute;
-    std::vector const attrs = GetProcessedAttributes<INDAttribute>(domains_, is_null_equal_null_);
+    std::vector const attrs =
+            ProcessAttributes<INDAttribute>(domains_, is_null_equal_null_, threads_num_);
     for (auto const& dep : attrs) {
         for (AttributeIndex ref_id : dep.GetRefIds()) {
             RegisterIND(dep.ToCC(), attrs[ref_id].ToCC());
@@ -113,7 +221,8 @@ void Spider::MineINDs() {
 
 void Spider::MineAINDs() {
     using spider::AINDAttribute;
-    std::vector const attrs = GetProcessedAttributes<AINDAttribute>(domains_, is_null_equal_null_);
+    std::vector const attrs =
+            ProcessAttributes<AINDAttribute>(domains_, is_null_equal_null_, threads_num_);
     for (auto const& dep : attrs) {
         for (AttributeIndex ref_id : dep.GetRefIds(max_ind_error_)) {
             RegisterIND(dep.ToCC(), attrs[ref_id].ToCC(), dep.GetError(ref_id));
@@ -26,6 +26,12 @@ class CindAlgorithm;
 ///
 /// \note modification(2): algorithm mines AINDs (unary)
 ///
+/// \note modification(3): swapped partitions are prefix-compressed sorted runs, the runs of all
+///       attributes are merged at once with a loser tree
+///
+/// \note modification(4): with several threads the values are split into ranges by sampling
+///       the runs, the ranges are merged in parallel and their results combined
+///
 class Spider final : public INDAlgorithm {
 public:
     /// timing information for algorithm stages
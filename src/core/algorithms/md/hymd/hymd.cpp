@@ -2,7 +2,11 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <optional>
+
+#include <boost/container_hash/hash.hpp>
 
 #include "core/algorithms/md/hymd/lattice/cardinality/min_picking_level_getter.h"
 #include "core/algorithms/md/hymd/lattice/md_lattice.h"
@@ -16,6 +20,7 @@
 #include "core/algorithms/md/hymd/utility/index_range.h"
 #include "core/algorithms/md/hymd/utility/inverse_permutation.h"
 #include "core/algorithms/md/hymd/utility/md_less.h"
+#include "core/config/checkpoint/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/thread_number/option.h"
@@ -28,6 +33,10 @@ namespace {
 using namespace algos::hymd;
 using model::Index;
 
+// The only kind of the checkpoint records: the lattice, the state of the sampling, the level being
+// traversed and the recommendations of the last traversal
+constexpr std::uint32_t kSnapshot = 0;
+
 // Encapsulates "if using more than one thread, create a thread pool, otherwise pass nullptr to
 // indicate single-threaded execution". Could have been a unique_ptr, but I don't want to use the
 // heap when I don't have to.
@@ -71,7 +80,7 @@ HyMD::HyMD() : MdAlgorithm() {
 void HyMD::MakeExecuteOptsAvailable() {
     using namespace config::names;
     MakeOptionsAvailable({kMinSupport, kPruneNonDisjoint, kColumnMatches, kMaxCardinality, kThreads,
-                          kLevelDefinition});
+                          kLevelDefinition, kCheckpointPath, kCheckpointInterval});
 }
 
 void HyMD::RegisterOptions() {
@@ -149,6 +158,8 @@ void HyMD::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&threads_));
     RegisterOption(Option{&level_definition_, kLevelDefinition, kDLevelDefinition,
                           LevelDefinition::kCardinality});
+    RegisterOption(config::kCheckpointPathOpt(&checkpoint_path_));
+    RegisterOption(config::kCheckpointIntervalOpt(&checkpoint_interval_));
 }
 
 void HyMD::ResetStateMd() {}
@@ -194,14 +205,30 @@ unsigned long long HyMD::ExecuteInternal() {
                 .count();
     }
 
+    std::unique_ptr<util::CheckpointFile> checkpoint = OpenCheckpoint(similarity_data);
+    // Every snapshot supersedes the previous ones, so only the last one is resumed from
+    std::optional<util::CheckpointDecoder> snapshot;
+    if (checkpoint != nullptr && !checkpoint->GetRecords().empty()) {
+        snapshot.emplace(checkpoint->GetRecords().back().payload);
+    }
+
     lattice::MdLattice lattice{GetLevelDefinitionFunc(level_definition_),
                                similarity_data.GetLhsIdsInfo(), prune_nondisjoint_,
                                max_cardinality_, similarity_data.CreateMaxRhs()};
-
-    auto [record_pair_inferrer, algorithm_finished] = RecordPairInferrer::Create(
-            &lattice, records_info_.get(), &similarity_data.GetColumnMatchesInfo(),
-            similarity_data.GetLhsIdsInfo(), std::move(short_sampling_enable),
-            pool_holder.GetPtr());
+    if (snapshot.has_value()) lattice.Restore(*snapshot);
+
+    auto [record_pair_inferrer, algorithm_finished] =
+            snapshot.has_value()
+                    ? RecordPairInferrer::Restore(
+                              *snapshot, &lattice, records_info_.get(),
+                              &similarity_data.GetColumnMatchesInfo(),
+                              similarity_data.GetLhsIdsInfo(), std::move(short_sampling_enable),
+                              pool_holder.GetPtr())
+                    : RecordPairInferrer::Create(
+                              &lattice, records_info_.get(),
+                              &similarity_data.GetColumnMatchesInfo(),
+                              similarity_data.GetLhsIdsInfo(), std::move(short_sampling_enable),
+                              pool_holder.GetPtr());
 
     lattice::cardinality::MinPickingLevelGetter level_getter{&lattice};
     LatticeTraverser lattice_traverser{
@@ -209,13 +236,45 @@ unsigned long long HyMD::ExecuteInternal() {
             {pool_holder.GetPtr(), records_info_.get(), similarity_data.GetColumnMatchesInfo(),
              min_support_, &lattice},
             pool_holder.GetPtr()};
-    algorithm_finished = lattice_traverser.TraverseLattice(algorithm_finished);
+
+    indexes::CompressedRecords const& left_records =
+            records_info_->GetLeftCompressor().GetRecords();
+    indexes::CompressedRecords const& right_records =
+            records_info_->GetRightCompressor().GetRecords();
+    if (snapshot.has_value()) {
+        level_getter.Restore(*snapshot);
+        Recommendations recommendations;
+        for (auto number = snapshot->Read<std::uint64_t>(); number != 0; --number) {
+            auto const left_index = snapshot->Read<std::uint64_t>();
+            auto const right_index = snapshot->Read<std::uint64_t>();
+            recommendations.push_back({&left_records[left_index], &right_records[right_index]});
+        }
+        lattice_traverser.SetRecommendations(std::move(recommendations));
+    } else {
+        algorithm_finished = lattice_traverser.TraverseLattice(algorithm_finished);
+    }
+
+    auto save_snapshot = [&]() {
+        util::CheckpointEncoder encoder;
+        lattice.Save(encoder);
+        record_pair_inferrer.Save(encoder);
+        level_getter.Save(encoder);
+        Recommendations const& recommendations = lattice_traverser.GetRecommendations();
+        encoder.Write<std::uint64_t>(recommendations.size());
+        for (auto const& [left_record, right_record] : recommendations) {
+            encoder.Write<std::uint64_t>(left_record - left_records.data());
+            encoder.Write<std::uint64_t>(right_record - right_records.data());
+        }
+        checkpoint->AppendSnapshot(kSnapshot, encoder.Release());
+    };
 
     while (!algorithm_finished) {
+        if (checkpoint != nullptr && checkpoint->IsSnapshotDue()) save_snapshot();
         algorithm_finished =
                 record_pair_inferrer.InferFromRecordPairs(lattice_traverser.TakeRecommendations());
         algorithm_finished = lattice_traverser.TraverseLattice(algorithm_finished);
     }
+    if (checkpoint != nullptr) checkpoint->Remove();
 
     RegisterResults(similarity_data, lattice.GetAll());
 
@@ -224,6 +283,36 @@ unsigned long long HyMD::ExecuteInternal() {
             .count();
 }
 
+std::unique_ptr<util::CheckpointFile> HyMD::OpenCheckpoint(
+        SimilarityData const& similarity_data) const {
+    if (checkpoint_path_.empty()) return nullptr;
+    util::CheckpointEncoder fingerprint;
+    fingerprint.Write(std::string_view{"hymd"});
+    fingerprint.Write<std::uint64_t>(min_support_);
+    fingerprint.Write(prune_nondisjoint_);
+    fingerprint.Write<std::uint64_t>(max_cardinality_);
+    fingerprint.Write(level_definition_);
+    for (SimilarityData::CMPtr const& column_match : column_matches_option_) {
+        auto const [left_column_index, right_column_index] = column_match->GetIndices();
+        fingerprint.Write(column_match->GetName());
+        fingerprint.Write<std::uint64_t>(left_column_index);
+        fingerprint.Write<std::uint64_t>(right_column_index);
+    }
+    // Decision boundaries depend on the parameters of the column matches that are not exposed
+    for (ColumnMatchInfo const& column_match_info : similarity_data.GetColumnMatchesInfo()) {
+        fingerprint.Write(column_match_info.similarity_info.classifier_values);
+    }
+    fingerprint.Write(similarity_data.GetIndexMapping());
+    for (indexes::DictionaryCompressor const* compressor :
+         {&records_info_->GetLeftCompressor(), &records_info_->GetRightCompressor()}) {
+        indexes::CompressedRecords const& records = compressor->GetRecords();
+        fingerprint.Write<std::uint64_t>(records.size());
+        fingerprint.Write<std::uint64_t>(boost::hash_range(records.begin(), records.end()));
+    }
+    return std::make_unique<util::CheckpointFile>(checkpoint_path_, fingerprint.Release(),
+                                                  std::chrono::seconds(checkpoint_interval_));
+}
+
 // Only serves to name parts of HyMD::RegisterResults.
 class HyMD::RegisterHelper {
 private:
@@ -10,9 +10,11 @@
 #include "core/algorithms/md/hymd/preprocessing/column_matches/column_match.h"
 #include "core/algorithms/md/hymd/similarity_data.h"
 #include "core/algorithms/md/md_algorithm.h"
+#include "core/config/checkpoint/type.h"
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/config/thread_number/type.h"
 #include "core/model/table/relational_schema.h"
+#include "core/util/checkpoint_file.h"
 
 namespace algos::hymd {
 
@@ -64,6 +66,8 @@ private:
     std::size_t max_cardinality_ = -1;
     config::ThreadNumType threads_;
     LevelDefinition level_definition_ = LevelDefinition::kCardinality;
+    config::CheckpointPathType checkpoint_path_;
+    config::CheckpointIntervalType checkpoint_interval_;
     // TODO: different level definitions (cardinality currently used)
     // TODO: comparing only some values during similarity calculation
     // TODO: automatically calculating minimal support
@@ -80,6 +84,11 @@ private:
     void ResetStateMd() final;
     unsigned long long ExecuteInternal() final;
 
+    // The checkpoint to save the progress to, nullptr if no path is given. The checkpoint of an
+    // execution with other data or options is not resumed from.
+    std::unique_ptr<util::CheckpointFile> OpenCheckpoint(
+            SimilarityData const& similarity_data) const;
+
     class RegisterHelper;
     void RegisterResults(SimilarityData const& similarity_data,
                          std::vector<lattice::MdLatticeNodeInfo> lattice_mds);
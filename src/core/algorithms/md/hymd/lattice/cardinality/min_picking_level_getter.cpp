@@ -1,5 +1,7 @@
 #include "core/algorithms/md/hymd/lattice/cardinality/min_picking_level_getter.h"
 
+#include <cstdint>
+
 #include "core/algorithms/md/hymd/lattice/rhs.h"
 #include "core/algorithms/md/hymd/lowest_cc_value_id.h"
 #include "core/util/erase_if_replace.h"
@@ -58,4 +60,31 @@ std::vector<ValidationInfo> MinPickingLevelGetter::GetPendingGroupedMinimalLhsMd
     return collected;
 }
 
+void MinPickingLevelGetter::Save(util::CheckpointEncoder& encoder) const {
+    LevelGetter::Save(encoder);
+    encoder.Write<std::uint64_t>(picked_.size());
+    for (auto const& [lhs, rhs_indices] : picked_) {
+        encoder.Write<std::uint64_t>(lhs.Cardinality());
+        for (auto const& [offset, ccv_id] : lhs) {
+            encoder.Write<std::uint64_t>(offset);
+            encoder.Write(ccv_id);
+        }
+        encoder.Write(rhs_indices);
+    }
+}
+
+void MinPickingLevelGetter::Restore(util::CheckpointDecoder& decoder) {
+    LevelGetter::Restore(decoder);
+    picked_.clear();
+    for (auto lhs_number = decoder.Read<std::uint64_t>(); lhs_number != 0; --lhs_number) {
+        auto const cardinality = decoder.Read<std::uint64_t>();
+        MdLhs lhs(cardinality);
+        for (std::uint64_t i = 0; i != cardinality; ++i) {
+            auto const offset = decoder.Read<std::uint64_t>();
+            lhs.AddNext(offset) = decoder.Read<ColumnClassifierValueId>();
+        }
+        picked_.emplace(std::move(lhs), decoder.ReadBitset());
+    }
+}
+
 }  // namespace algos::hymd::lattice::cardinality
@@ -27,6 +27,9 @@ public:
         : LevelGetter(lattice),
           column_matches_number_(lattice->GetColMatchNumber()),
           min_picker_() {}
+
+    void Save(util::CheckpointEncoder& encoder) const final;
+    void Restore(util::CheckpointDecoder& decoder) final;
 };
 
 }  // namespace algos::hymd::lattice::cardinality
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "core/algorithms/md/hymd/lattice/md_lattice.h"
 #include "core/algorithms/md/hymd/lattice/validation_info.h"
+#include "core/util/checkpoint_file.h"
 
 namespace algos::hymd::lattice {
 
@@ -35,6 +37,14 @@ public:
         return {};
     }
 
+    virtual void Save(util::CheckpointEncoder& encoder) const {
+        encoder.Write<std::uint64_t>(cur_level_);
+    }
+
+    virtual void Restore(util::CheckpointDecoder& decoder) {
+        cur_level_ = decoder.Read<std::uint64_t>();
+    }
+
     virtual ~LevelGetter() = default;
 };
 
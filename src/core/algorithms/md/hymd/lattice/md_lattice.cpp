@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <numeric>
 #include <type_traits>
 
@@ -26,6 +28,37 @@ using MdGenChecker = TotalGeneralizationChecker<MdNode, MdInfoType>;
 template <typename MdInfoType>
 using MdSpecGenChecker = SpecGeneralizationChecker<MdNode, MdInfoType>;
 
+constexpr std::uint64_t kNoMoreChildren = std::numeric_limits<std::uint64_t>::max();
+
+// Pre-order: the node, then for every non-empty child map its offset, size and the children
+template <typename NodeType>
+void SaveNode(NodeType const& node, util::CheckpointEncoder& encoder, auto save_node_data) {
+    save_node_data(node);
+    node.ForEachNonEmpty([&](auto const& child_map, Index offset) {
+        encoder.Write<std::uint64_t>(offset);
+        encoder.Write<std::uint64_t>(child_map.size());
+        for (auto const& [ccv_id, child] : child_map) {
+            encoder.Write(ccv_id);
+            SaveNode(child, encoder, save_node_data);
+        }
+    });
+    encoder.Write(kNoMoreChildren);
+}
+
+template <typename NodeType>
+void RestoreNode(NodeType& node, util::CheckpointDecoder& decoder, auto restore_node_data,
+                 auto add_child) {
+    restore_node_data(node);
+    for (auto offset = decoder.Read<std::uint64_t>(); offset != kNoMoreChildren;
+         offset = decoder.Read<std::uint64_t>()) {
+        for (auto children_left = decoder.Read<std::uint64_t>(); children_left != 0;
+             --children_left) {
+            auto const ccv_id = decoder.Read<ColumnClassifierValueId>();
+            RestoreNode(*add_child(node, offset, ccv_id), decoder, restore_node_data, add_child);
+        }
+    }
+}
+
 template <typename MdInfoType, typename FGetLhsCCVId, typename FGetNonLhsCCVId>
 class Specializer {
     using SupportCheckMethod = bool (Specializer::*)();
@@ -892,4 +925,35 @@ void MdLattice::MarkUnsupported(MdLhs const& lhs) {
     CheckedAdd(&support_root_, lhs, lhs, mark_new, SetUnsupAction());
 }
 
+void MdLattice::Save(util::CheckpointEncoder& encoder) const {
+    encoder.Write<std::uint64_t>(max_level_);
+    SaveNode(md_root_, encoder, [this, &encoder](MdNode const& node) {
+        for (Index i : utility::IndexRange(column_matches_size_)) {
+            encoder.Write(node.rhs.begin[i]);
+        }
+    });
+    SaveNode(support_root_, encoder,
+             [&encoder](SupportNode const& node) { encoder.Write(node.is_unsupported); });
+}
+
+void MdLattice::Restore(util::CheckpointDecoder& decoder) {
+    max_level_ = decoder.Read<std::uint64_t>();
+    RestoreNode(
+            md_root_, decoder,
+            [this, &decoder](MdNode& node) {
+                for (Index i : utility::IndexRange(column_matches_size_)) {
+                    node.rhs.Set(i, decoder.Read<ColumnClassifierValueId>());
+                }
+            },
+            [this](MdNode& node, Index offset, ColumnClassifierValueId ccv_id) {
+                return node.AddOneUnchecked(offset, ccv_id, column_matches_size_);
+            });
+    RestoreNode(
+            support_root_, decoder,
+            [&decoder](SupportNode& node) { node.is_unsupported = decoder.Read<bool>(); },
+            [](SupportNode& node, Index offset, ColumnClassifierValueId ccv_id) {
+                return node.AddOneUnchecked(offset, ccv_id);
+            });
+}
+
 }  // namespace algos::hymd::lattice
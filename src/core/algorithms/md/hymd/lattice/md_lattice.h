@@ -22,6 +22,7 @@
 #include "core/algorithms/md/hymd/rhss.h"
 #include "core/algorithms/md/hymd/utility/invalidated_rhss.h"
 #include "core/model/index.h"
+#include "core/util/checkpoint_file.h"
 
 namespace algos::hymd::lattice {
 
@@ -165,6 +166,10 @@ public:
     std::vector<MdRefiner> CollectRefinersForViolated(
             PairComparisonResult const& pair_comparison_result);
     std::vector<MdLatticeNodeInfo> GetAll();
+
+    void Save(util::CheckpointEncoder& encoder) const;
+    // Must be called on a lattice that has just been constructed.
+    void Restore(util::CheckpointDecoder& decoder);
 };
 
 }  // namespace algos::hymd::lattice
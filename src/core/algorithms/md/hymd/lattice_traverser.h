@@ -68,6 +68,14 @@ public:
     ClearingRecRef TakeRecommendations() noexcept {
         return recommendations_;
     }
+
+    Recommendations const& GetRecommendations() const noexcept {
+        return recommendations_;
+    }
+
+    void SetRecommendations(Recommendations recommendations) noexcept {
+        recommendations_ = std::move(recommendations);
+    }
 };
 
 }  // namespace algos::hymd
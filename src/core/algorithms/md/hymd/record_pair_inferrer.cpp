@@ -399,7 +399,8 @@ RecordPairInferrer::RecordPairInferrer(InternalConstructToken, lattice::MdLattic
                                        indexes::RecordsInfo const* records_info,
                                        std::vector<ColumnMatchInfo> const* column_matches_sim_info,
                                        std::vector<LhsCCVIdsInfo> const& lhs_ccv_id_info,
-                                       std::vector<bool> sample_short, util::WorkerThreadPool* pool)
+                                       std::vector<bool> sample_short, util::WorkerThreadPool* pool,
+                                       util::CheckpointDecoder* decoder)
     : lattice_(lattice),
       records_info_(records_info),
       column_matches_sim_info_(column_matches_sim_info),
@@ -407,7 +408,35 @@ RecordPairInferrer::RecordPairInferrer(InternalConstructToken, lattice::MdLattic
       sample_short_(std::move(sample_short)),
       pool_(pool),
       ranked_records_(RecordRanker{*this}.RankRecords()),
-      sampling_queue_(CreateSamplingQueue()) {}
+      sampling_queue_(decoder == nullptr ? CreateSamplingQueue()
+                                         : RestoreSamplingQueue(*decoder)) {
+    if (decoder != nullptr) efficiency_threshold_ = decoder->Read<double>();
+}
+
+auto RecordPairInferrer::RestoreSamplingQueue(util::CheckpointDecoder& decoder)
+        -> std::priority_queue<ColumnMatchSamplingInfo> {
+    std::priority_queue<ColumnMatchSamplingInfo> sampling_queue;
+    for (auto queue_size = decoder.Read<std::uint64_t>(); queue_size != 0; --queue_size) {
+        auto const column_match_index = decoder.Read<std::uint64_t>();
+        auto const parameter = decoder.Read<std::uint64_t>();
+        auto const num_discovered = decoder.Read<std::uint64_t>();
+        auto const num_sampled = decoder.Read<std::uint64_t>();
+        sampling_queue.emplace(column_match_index, parameter, num_discovered, num_sampled);
+    }
+    return sampling_queue;
+}
+
+void RecordPairInferrer::Save(util::CheckpointEncoder& encoder) const {
+    encoder.Write<std::uint64_t>(sampling_queue_.size());
+    for (std::priority_queue queue = sampling_queue_; !queue.empty(); queue.pop()) {
+        ColumnMatchSamplingInfo const& info = queue.top();
+        encoder.Write<std::uint64_t>(info.GetColumnMatchIndex());
+        encoder.Write<std::uint64_t>(info.GetParameter());
+        encoder.Write<std::uint64_t>(info.GetDiscoveredNumber());
+        encoder.Write<std::uint64_t>(info.GetSampledNumber());
+    }
+    encoder.Write(efficiency_threshold_);
+}
 
 PairComparisonResult RecordPairInferrer::CompareRecords(
         CompressedRecord const& left_record, CompressedRecord const& right_record) const {
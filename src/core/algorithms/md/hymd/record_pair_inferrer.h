@@ -14,6 +14,7 @@
 #include "core/algorithms/md/hymd/pair_comparison_result.h"
 #include "core/algorithms/md/hymd/recommendation.h"
 #include "core/algorithms/md/hymd/similarity_data.h"
+#include "core/util/checkpoint_file.h"
 #include "core/util/desbordante_assume.h"
 #include "core/util/worker_thread_pool.h"
 
@@ -56,6 +57,13 @@ private:
         ColumnMatchSamplingInfo(std::size_t column_match_index, std::size_t parameter) noexcept
             : column_match_index_(column_match_index), parameter_(parameter) {}
 
+        ColumnMatchSamplingInfo(std::size_t column_match_index, std::size_t parameter,
+                                std::size_t num_discovered, std::size_t num_sampled) noexcept
+            : column_match_index_(column_match_index),
+              parameter_(parameter),
+              num_discovered_(num_discovered),
+              num_sampled_(num_sampled) {}
+
         // Only used in operator<.
         [[nodiscard]] double CalcEfficiency() const noexcept {
             // Column matches where no record pairs are available for comparison are filtered during
@@ -70,6 +78,10 @@ private:
             return CalcEfficiency() < other.CalcEfficiency();
         }
 
+        [[nodiscard]] std::size_t GetDiscoveredNumber() const noexcept {
+            return num_discovered_;
+        }
+
         [[nodiscard]] std::size_t GetSampledNumber() const noexcept {
             return num_sampled_;
         }
@@ -105,6 +117,8 @@ private:
             ColumnMatchSamplingInfo const& column_match_sampling_info);
 
     std::priority_queue<ColumnMatchSamplingInfo> CreateSamplingQueue();
+    static std::priority_queue<ColumnMatchSamplingInfo> RestoreSamplingQueue(
+            util::CheckpointDecoder& decoder);
 
     bool MultiThreaded() const noexcept {
         return pool_ != nullptr;
@@ -221,13 +235,27 @@ public:
         return pair;
     }
 
+    // Continues the sampling saved by Save, without a sampling round. The set of the comparisons
+    // that were already processed is not saved, they may be inferred from again.
+    template <typename... Args>
+    static std::pair<RecordPairInferrer, bool> Restore(util::CheckpointDecoder& decoder,
+                                                       Args&&... args) {
+        return {std::piecewise_construct,
+                std::forward_as_tuple(InternalConstructToken{}, std::forward<Args>(args)...,
+                                      &decoder),
+                std::forward_as_tuple(false)};
+    }
+
     RecordPairInferrer(InternalConstructToken, lattice::MdLattice* lattice,
                        indexes::RecordsInfo const* records_info,
                        std::vector<ColumnMatchInfo> const* column_matches_sim_info,
                        std::vector<LhsCCVIdsInfo> const& lhs_ccv_id_info,
-                       std::vector<bool> sample_short, util::WorkerThreadPool* pool);
+                       std::vector<bool> sample_short, util::WorkerThreadPool* pool,
+                       util::CheckpointDecoder* decoder = nullptr);
 
     bool InferFromRecordPairs(Recommendations const& recommendations);
+
+    void Save(util::CheckpointEncoder& encoder) const;
 };
 
 }  // namespace algos::hymd
@@ -1,9 +1,11 @@
 #include "core/algorithms/od/fastod/storage/data_frame.h"
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 
 #include "core/algorithms/od/fastod/util/type_util.h"
+#include "core/model/table/encoded_relation_cache.h"
 #include "core/parser/csv_parser/csv_parser.h"
 
 namespace algos::fastod {
@@ -97,6 +99,21 @@ DataFrame DataFrame::FromInputTable(config::InputTable input_table,
     return DataFrame(std::move(columns_data));
 }
 
+std::shared_ptr<DataFrame const> DataFrame::FromInputTableCached(
+        config::InputTable input_table, config::EqNullsType is_null_equal_null) {
+    model::IDatasetStream& stream = *input_table;
+    return model::EncodedRelationCache::Instance().GetOrCreate<DataFrame>(
+            stream, is_null_equal_null ? "null = null" : "null != null",
+            [&input_table, is_null_equal_null](model::IDatasetStream&) {
+                return std::make_shared<DataFrame>(FromInputTable(input_table, is_null_equal_null));
+            },
+            [](DataFrame const& data) {
+                // The values and the placements of the rows in the ranges
+                return static_cast<std::size_t>(data.GetColumnCount()) * data.GetTupleCount() *
+                       (sizeof(int) + sizeof(size_t));
+            });
+}
+
 void DataFrame::RecognizeAttributesWithRanges() {
     double constexpr accept_factor = 0.001;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -62,6 +63,10 @@ public:
 
     static DataFrame FromInputTable(config::InputTable input_table,
                                     config::EqNullsType is_null_equal_null = true);
+
+    // Same as FromInputTable, but shares the data frame through model::EncodedRelationCache
+    static std::shared_ptr<DataFrame const> FromInputTableCached(
+            config::InputTable input_table, config::EqNullsType is_null_equal_null = true);
 };
 
 inline size_t RangeSize(DataFrame::Range const& range) {
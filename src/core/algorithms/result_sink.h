@@ -0,0 +1,195 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace algos {
+
+/* Receiver of the results of an algorithm. Algorithm::Execute calls Start before the execution
+ * and Finish after it, also when the execution throws.
+ */
+class ResultSinkBase {
+public:
+    virtual ~ResultSinkBase() = default;
+
+    virtual void Start() {}
+
+    virtual void Finish() {}
+};
+
+/* Receives the dependencies of type D as they are registered by an algorithm. Consume may be
+ * called from several threads at once.
+ */
+template <typename D>
+class ResultSink : public ResultSinkBase {
+public:
+    virtual void Consume(D const& dependency) = 0;
+};
+
+// Calls the given function for every dependency, one call at a time.
+template <typename D>
+class CallbackResultSink final : public ResultSink<D> {
+private:
+    std::function<void(D const&)> callback_;
+    std::mutex mutex_;
+
+public:
+    explicit CallbackResultSink(std::function<void(D const&)> callback)
+        : callback_(std::move(callback)) {}
+
+    void Consume(D const& dependency) override {
+        std::scoped_lock lock(mutex_);
+        callback_(dependency);
+    }
+};
+
+/* Queue of at most `capacity` dependencies that are taken by another thread with Pop. The
+ * algorithm waits while the queue is full.
+ */
+template <typename D>
+class QueueResultSink final : public ResultSink<D> {
+private:
+    std::size_t const capacity_;
+    std::deque<D> queue_;
+    bool finished_ = false;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+
+public:
+    explicit QueueResultSink(std::size_t capacity) : capacity_(capacity) {
+        if (capacity_ == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+    }
+
+    void Start() override {
+        std::scoped_lock lock(mutex_);
+        finished_ = false;
+    }
+
+    void Consume(D const& dependency) override {
+        std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this]() { return queue_.size() < capacity_; });
+        queue_.push_back(dependency);
+        not_empty_.notify_one();
+    }
+
+    void Finish() override {
+        std::scoped_lock lock(mutex_);
+        finished_ = true;
+        not_empty_.notify_all();
+    }
+
+    // Waits for the next dependency, std::nullopt means that the execution has finished and all
+    // of its dependencies have been taken.
+    std::optional<D> Pop() {
+        std::unique_lock lock(mutex_);
+        not_empty_.wait(lock, [this]() { return !queue_.empty() || finished_; });
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        D dependency = std::move(queue_.front());
+        queue_.pop_front();
+        not_full_.notify_one();
+        return dependency;
+    }
+};
+
+/* Serialization of the dependencies of type D for FileResultSink, specialized next to the
+ * algorithms that discover them. A specialization provides
+ *   static constexpr std::uint8_t kKind;  // Stored in the header of binary files
+ *   static void WriteJson(std::ostream&, D const&);  // A single line without '\n'
+ *   static void WriteBinary(std::ostream&, D const&);
+ */
+template <typename D>
+struct ResultFormat;
+
+enum class ResultFileFormat : std::uint8_t {
+    // A JSON object per line
+    kNdjson,
+    // kBinaryMagic, kBinaryVersion and the kind of the dependencies, then the records. Unsigned
+    // numbers are written as LEB128 varints, a set of indices is its size followed by the indices
+    // in increasing order.
+    kBinary,
+};
+
+inline constexpr char kBinaryMagic[4] = {'D', 'S', 'N', 'K'};
+inline constexpr std::uint8_t kBinaryVersion = 1;
+
+inline void WriteVarint(std::ostream& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+template <typename Indices>
+void WriteIndices(std::ostream& out, Indices const& indices) {
+    WriteVarint(out, indices.size());
+    for (auto index : indices) {
+        WriteVarint(out, index);
+    }
+}
+
+// Writes the dependencies of an execution to a file, which is rewritten by every execution.
+template <typename D>
+class FileResultSink final : public ResultSink<D> {
+private:
+    std::filesystem::path const path_;
+    ResultFileFormat const format_;
+    std::ofstream out_;
+    std::mutex mutex_;
+
+public:
+    FileResultSink(std::filesystem::path path, ResultFileFormat format)
+        : path_(std::move(path)), format_(format) {}
+
+    void Start() override {
+        std::scoped_lock lock(mutex_);
+        out_.close();
+        out_.clear();
+        out_.open(path_, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            throw std::runtime_error("Unable to open " + path_.string() + " for writing");
+        }
+        if (format_ == ResultFileFormat::kBinary) {
+            out_.write(kBinaryMagic, sizeof(kBinaryMagic));
+            out_.put(static_cast<char>(kBinaryVersion));
+            out_.put(static_cast<char>(ResultFormat<D>::kKind));
+        }
+    }
+
+    void Consume(D const& dependency) override {
+        std::scoped_lock lock(mutex_);
+        if (format_ == ResultFileFormat::kBinary) {
+            ResultFormat<D>::WriteBinary(out_, dependency);
+        } else {
+            ResultFormat<D>::WriteJson(out_, dependency);
+            out_.put('\n');
+        }
+    }
+
+    void Finish() override {
+        std::scoped_lock lock(mutex_);
+        // A failed write, as well as the flush on closing, leaves the stream failed
+        out_.close();
+        if (out_.fail()) {
+            throw std::runtime_error("Unable to write the results to " + path_.string());
+        }
+    }
+};
+
+}  // namespace algos
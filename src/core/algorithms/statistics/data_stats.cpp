@@ -5,13 +5,10 @@
 #include <unicode/uchar.h>
 #include <unicode/unistr.h>
 
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
-#include <boost/thread.hpp>
-
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/config/thread_number/option.h"
+#include "core/util/task_scheduler.h"
 
 namespace algos {
 
@@ -34,11 +31,11 @@ void DataStats::MakeExecuteOptsAvailable() {
 }
 
 void DataStats::ResetState() {
-    all_stats_.assign(col_data_.size(), ColumnStats{});
+    all_stats_.assign(GetData().size(), ColumnStats{});
 }
 
 Statistic DataStats::GetMin(size_t index, mo::CompareResult order) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!mo::Type::IsOrdered(col.GetTypeId())) return {};
 
     mo::Type const& type = col.GetType();
@@ -61,7 +58,7 @@ Statistic DataStats::GetMax(size_t index) const {
 
 Statistic DataStats::GetSum(size_t index) const {
     if (all_stats_[index].sum.HasValue()) return all_stats_[index].sum;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     std::vector<std::byte const*> const& data = col.GetData();
@@ -75,7 +72,7 @@ Statistic DataStats::GetSum(size_t index) const {
 
 Statistic DataStats::GetAvg(size_t index) const {
     if (all_stats_[index].avg.HasValue()) return all_stats_[index].avg;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     mo::DoubleType double_type;
 
@@ -92,7 +89,7 @@ Statistic DataStats::GetAvg(size_t index) const {
 
 Statistic DataStats::CalculateCentralMoment(size_t index, int number,
                                             bool bessel_correction) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     std::vector<std::byte const*> const& data = col.GetData();
     mo::DoubleType double_type;
@@ -125,7 +122,7 @@ Statistic DataStats::CalculateCentralMoment(size_t index, int number,
 }
 
 Statistic DataStats::GetCorrectedSTD(size_t index) const {
-    if (!col_data_[index].IsNumeric()) return {};
+    if (!GetData()[index].IsNumeric()) return {};
     mo::DoubleType double_type;
     std::byte* result = double_type.Allocate();
     double_type.Power(CalculateCentralMoment(index, 2, true).GetData(), 0.5, result);
@@ -150,14 +147,14 @@ Statistic DataStats::GetStandardizedCentralMomentOfDist(size_t index, int number
 
 Statistic DataStats::GetSkewness(size_t index) const {
     if (all_stats_[index].skewness.HasValue()) return all_stats_[index].skewness;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     return GetStandardizedCentralMomentOfDist(index, 3);
 }
 
 Statistic DataStats::GetKurtosis(size_t index) const {
     if (all_stats_[index].kurtosis.HasValue()) return all_stats_[index].kurtosis;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     Statistic result = GetStandardizedCentralMomentOfDist(index, 4);
     mo::DoubleType double_type;
@@ -169,7 +166,7 @@ Statistic DataStats::GetKurtosis(size_t index) const {
 }
 
 size_t DataStats::NumberOfValues(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     return col.GetNumRows() - col.GetNumNulls() - col.GetNumEmpties();
 };
 
@@ -183,7 +180,7 @@ inline static size_t CountDistinctInSortedData(std::vector<std::byte const*> con
 }
 
 size_t DataStats::MixedDistinct(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     std::vector<std::byte const*> const& data = col.GetData();
     mo::MixedType mixed_type(is_null_equal_null_);
 
@@ -206,7 +203,7 @@ size_t DataStats::MixedDistinct(size_t index) const {
 
 size_t DataStats::Distinct(size_t index) {
     if (all_stats_[index].distinct != 0) return all_stats_[index].distinct;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() == mo::TypeId::kMixed) {
         all_stats_[index].distinct = MixedDistinct(index);
         return all_stats_[index].distinct;
@@ -225,7 +222,7 @@ std::vector<std::vector<std::string>> DataStats::ShowSample(size_t start_row, si
                                               std::vector<std::string>(end_col - start_col + 1));
 
     for (size_t j = start_col - 1; j < end_col; ++j) {
-        mo::TypedColumnData const& col = col_data_[j];
+        mo::TypedColumnData const& col = GetData()[j];
         for (size_t i = start_row - 1; i < end_row; ++i) res[i][j] = col.GetDataAsString(i);
     }
 
@@ -237,7 +234,7 @@ bool DataStats::IsCategorical(size_t index, size_t quantity) {
 }
 
 std::vector<std::byte const*> DataStats::DeleteNullAndEmpties(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::TypeId type_id = col.GetTypeId();
     if (type_id == mo::TypeId::kNull || type_id == mo::TypeId::kEmpty ||
         type_id == mo::TypeId::kUndefined)
@@ -252,7 +249,7 @@ std::vector<std::byte const*> DataStats::DeleteNullAndEmpties(size_t index) cons
 }
 
 Statistic DataStats::GetQuantile(double part, size_t index, bool calc_all) {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!mo::Type::IsOrdered(col.GetTypeId())) return {};
     mo::Type const& type = col.GetType();
     std::vector<std::byte const*> data = DeleteNullAndEmpties(index);
@@ -306,7 +303,7 @@ Statistic DataStats::CountIfInBinaryRelationWithZero(size_t index, mo::CompareRe
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
     std::byte* zero = type.MakeValueOfInt(0);
     mo::IntType int_type;
-    std::vector<std::byte const*> const& data = col_data_[index].GetData();
+    std::vector<std::byte const*> const& data = GetData()[index].GetData();
 
     auto pred = [&zero, &type, &res](std::byte const* el) {
         return el && type.Compare(el, zero) == res;
@@ -325,7 +322,7 @@ Statistic DataStats::GetNumberOfZeros(size_t index) const {
 
 Statistic DataStats::GetZeroPercent(size_t index) const {
     if (all_stats_[index].num_diacritic_chars.HasValue()) return all_stats_[index].zero_percent;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     int total = NumberOfValues(index) - GetNumNulls(index);
@@ -347,7 +344,7 @@ Statistic DataStats::GetNumberOfNegatives(size_t index) const {
 }
 
 Statistic DataStats::CountBool(size_t index, bool expected) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kBool) return {};
 
     size_t count = 0;
@@ -378,7 +375,7 @@ Statistic DataStats::GetFalseCount(size_t index) const {
 
 Statistic DataStats::GetSumOfSquares(size_t index) const {
     if (all_stats_[index].sum_of_squares.HasValue()) return all_stats_[index].sum_of_squares;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
@@ -399,7 +396,7 @@ Statistic DataStats::GetSumOfSquares(size_t index) const {
 
 Statistic DataStats::GetGeometricMean(size_t index) const {
     if (all_stats_[index].geometric_mean.HasValue()) return all_stats_[index].geometric_mean;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
@@ -431,7 +428,7 @@ Statistic DataStats::GetGeometricMean(size_t index) const {
 
 Statistic DataStats::GetMeanAD(size_t index) const {
     if (all_stats_[index].mean_ad.HasValue()) return all_stats_[index].mean_ad;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     // Convert each summand to DoubleType
@@ -501,7 +498,7 @@ std::byte* DataStats::MedianOfNumericVector(std::vector<std::byte const*> const&
 
 Statistic DataStats::GetMedian(size_t index) const {
     if (all_stats_[index].median.HasValue()) return all_stats_[index].median;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
@@ -516,7 +513,7 @@ Statistic DataStats::GetMedianAD(size_t index) const {
     if (all_stats_[index].median_ad.HasValue()) {
         return all_stats_[index].median_ad;
     }
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
     auto const& type = static_cast<mo::INumericType const&>(col.GetType());
 
@@ -544,7 +541,7 @@ Statistic DataStats::GetMedianAD(size_t index) const {
 
 Statistic DataStats::GetVocab(size_t index) const {
     if (all_stats_[index].vocab.HasValue()) return all_stats_[index].vocab;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -600,7 +597,7 @@ Statistic DataStats::GetNumberOfUppercaseChars(size_t index) const {
 
 template <class Pred>
 Statistic DataStats::CountIfInColumn(Pred pred, size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     size_t count = 0;
@@ -619,7 +616,7 @@ Statistic DataStats::CountIfInColumn(Pred pred, size_t index) const {
 }
 
 Statistic DataStats::GetNumberOfChars(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringSumOf(index, [](std::string const& line) { return line.size(); });
@@ -628,7 +625,7 @@ Statistic DataStats::GetNumberOfChars(size_t index) const {
 Statistic DataStats::GetAvgNumberOfChars(size_t index) const {
     if (all_stats_[index].num_avg_chars.HasValue()) return all_stats_[index].num_avg_chars;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     mo::DoubleType double_type;
@@ -649,7 +646,7 @@ Statistic DataStats::GetAvgNumberOfChars(size_t index) const {
 
 template <class Pred>
 Statistic DataStats::GetStringMinOf(size_t index, Pred pred) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::IntType int_type;
 
     size_t result = std::numeric_limits<size_t>::max();
@@ -669,7 +666,7 @@ Statistic DataStats::GetStringMinOf(size_t index, Pred pred) const {
 
 template <class Pred>
 Statistic DataStats::GetStringMaxOf(size_t index, Pred pred) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::IntType int_type;
 
     size_t result = 0;
@@ -689,7 +686,7 @@ Statistic DataStats::GetStringMaxOf(size_t index, Pred pred) const {
 
 template <class Pred>
 Statistic DataStats::GetStringSumOf(size_t index, Pred pred) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     mo::IntType int_type;
 
     size_t result = 0;
@@ -708,7 +705,7 @@ Statistic DataStats::GetStringSumOf(size_t index, Pred pred) const {
 
 Statistic DataStats::GetMinNumberOfChars(size_t index) const {
     if (all_stats_[index].min_num_chars.HasValue()) return all_stats_[index].min_num_chars;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringMinOf(index, [](std::string const& line) { return line.size(); });
@@ -716,7 +713,7 @@ Statistic DataStats::GetMinNumberOfChars(size_t index) const {
 
 Statistic DataStats::GetMaxNumberOfChars(size_t index) const {
     if (all_stats_[index].max_num_chars.HasValue()) return all_stats_[index].max_num_chars;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringMaxOf(index, [](std::string const& line) { return line.size(); });
@@ -724,7 +721,7 @@ Statistic DataStats::GetMaxNumberOfChars(size_t index) const {
 
 Statistic DataStats::GetMinWhiteSpaces(size_t index) const {
     if (all_stats_[index].min_white_spaces.HasValue()) return all_stats_[index].min_white_spaces;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringMinOf(index, [](std::string const& line) {
@@ -734,7 +731,7 @@ Statistic DataStats::GetMinWhiteSpaces(size_t index) const {
 
 Statistic DataStats::GetMaxWhiteSpaces(size_t index) const {
     if (all_stats_[index].max_white_spaces.HasValue()) return all_stats_[index].max_white_spaces;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringMaxOf(index, [](std::string const& line) {
@@ -750,7 +747,7 @@ std::vector<std::string> DataStats::GetWordsInString(std::string line) {
 }
 
 std::set<std::string> DataStats::GetWords(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -779,7 +776,7 @@ size_t DataStats::GetNumberOfWordsInString(std::string line) {
 Statistic DataStats::GetMinNumberOfWords(size_t index) const {
     if (all_stats_[index].min_num_words.HasValue()) return all_stats_[index].min_num_words;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringMinOf(index,
@@ -788,7 +785,7 @@ Statistic DataStats::GetMinNumberOfWords(size_t index) const {
 
 Statistic DataStats::GetMaxNumberOfWords(size_t index) const {
     if (all_stats_[index].max_num_words.HasValue()) return all_stats_[index].max_num_words;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringMaxOf(index,
@@ -797,7 +794,7 @@ Statistic DataStats::GetMaxNumberOfWords(size_t index) const {
 
 Statistic DataStats::GetNumberOfWords(size_t index) const {
     if (all_stats_[index].num_words.HasValue()) return all_stats_[index].num_words;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     return GetStringSumOf(index,
@@ -807,7 +804,7 @@ Statistic DataStats::GetNumberOfWords(size_t index) const {
 Statistic DataStats::GetNumberOfDiacriticChars(size_t index) const {
     if (all_stats_[index].num_diacritic_chars.HasValue())
         return all_stats_[index].num_diacritic_chars;
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     UErrorCode err = U_ZERO_ERROR;
@@ -842,7 +839,7 @@ Statistic DataStats::GetNumberOfDiacriticChars(size_t index) const {
 }
 
 std::vector<char> DataStats::GetTopKChars(size_t index, size_t k) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -877,7 +874,7 @@ std::vector<char> DataStats::GetTopKChars(size_t index, size_t k) const {
 }
 
 std::vector<std::string> DataStats::GetTopKWords(size_t index, size_t k) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     mo::StringType string_type;
@@ -953,7 +950,7 @@ bool DataStats::IsEntirelyLowercase(std::string word) {
 
 template <class Pred>
 Statistic DataStats::CountIfInColumnForWords(Pred pred, size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     std::size_t count = 0;
@@ -977,7 +974,7 @@ Statistic DataStats::GetWhitespaceOnlyCount(size_t index) const {
     if (all_stats_[index].whitespace_only_count.HasValue())
         return all_stats_[index].whitespace_only_count;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     size_t count = 0;
@@ -1005,7 +1002,7 @@ Statistic DataStats::GetWhitespaceCount(size_t index, CharPosition pos) const {
 
     if (stat_cache.HasValue()) return stat_cache;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     size_t count = 0;
@@ -1042,7 +1039,7 @@ Statistic DataStats::GetNumberOfRowsWithSpecialChars(size_t index) const {
     if (all_stats_[index].special_chars_count.HasValue())
         return all_stats_[index].special_chars_count;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
     static constexpr std::string_view const kSpecialChars = "@#$%^&!?*_+=~'-\"";
     size_t count = 0;
@@ -1078,7 +1075,7 @@ Statistic DataStats::GetCharFrequency(size_t index, CharPosition pos) const {
                                            : all_stats_[index].last_char_freq;
     }
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     std::unordered_map<char, size_t> freq_map;
@@ -1124,7 +1121,7 @@ unsigned long long DataStats::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
     auto task = [this](size_t index) {
         all_stats_[index].count = NumberOfValues(index);
-        if (this->col_data_[index].GetTypeId() != mo::TypeId::kMixed) {
+        if (this->GetData()[index].GetTypeId() != mo::TypeId::kMixed) {
             all_stats_[index].min = GetMin(index);
             all_stats_[index].max = GetMax(index);
             all_stats_[index].sum = GetSum(index);
@@ -1182,17 +1179,11 @@ unsigned long long DataStats::ExecuteInternal() {
 
         all_stats_[index].is_categorical = IsCategorical(
                 index, std::min(all_stats_[index].count - 1, 10 + all_stats_[index].count / 1000));
-        all_stats_[index].type = this->col_data_[index].GetType().ToString().substr(1);
+        all_stats_[index].type = this->GetData()[index].GetType().ToString().substr(1);
     };
 
-    if (threads_num_ > 1) {
-        boost::asio::thread_pool pool(threads_num_);
-        for (size_t i = 0; i < all_stats_.size(); ++i)
-            boost::asio::post(pool, [i, task]() { return task(i); });
-        pool.join();
-    } else {
-        for (size_t i = 0; i < all_stats_.size(); ++i) task(i);
-    }
+    // Columns differ a lot in cost, so they are handed out one at a time
+    util::ParallelFor(0, all_stats_.size(), 1, task, threads_num_);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -1200,34 +1191,34 @@ unsigned long long DataStats::ExecuteInternal() {
 }
 
 size_t DataStats::GetNumNulls(size_t index) const {
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     return col.GetNumNulls();
 }
 
 std::vector<size_t> DataStats::GetNullColumns() const {
-    auto pred = [this, num_rows = col_data_[0].GetNumRows()](size_t index) {
-        return col_data_[index].GetNumNulls() == num_rows;
+    auto pred = [this, num_rows = GetData()[0].GetNumRows()](size_t index) {
+        return GetData()[index].GetNumNulls() == num_rows;
     };
 
-    return FilterIndices(pred, col_data_);
+    return FilterIndices(pred, GetData());
 }
 
 std::vector<size_t> DataStats::GetColumnsWithNull() const {
-    auto pred = [this](size_t index) { return col_data_[index].GetNumNulls() != 0; };
+    auto pred = [this](size_t index) { return GetData()[index].GetNumNulls() != 0; };
 
-    return FilterIndices(pred, col_data_);
+    return FilterIndices(pred, GetData());
 }
 
 std::vector<size_t> DataStats::GetColumnsWithUniqueValues() {
-    auto pred = [this, num_rows = col_data_[0].GetNumRows()](size_t index) {
+    auto pred = [this, num_rows = GetData()[0].GetNumRows()](size_t index) {
         return Distinct(index) == num_rows;
     };
 
-    return FilterIndices(pred, col_data_);
+    return FilterIndices(pred, GetData());
 }
 
 size_t DataStats::GetNumberOfColumns() const {
-    return col_data_.size();
+    return GetData().size();
 }
 
 ColumnStats const& DataStats::GetAllStats(size_t index) const {
@@ -1239,7 +1230,7 @@ std::vector<ColumnStats> const& DataStats::GetAllStats() const {
 }
 
 std::vector<model::TypedColumnData> const& DataStats::GetData() const noexcept {
-    return col_data_;
+    return typed_relation_->GetColumnData();
 }
 
 std::string DataStats::ToString() const {
@@ -1252,15 +1243,16 @@ std::string DataStats::ToString() const {
 }
 
 void DataStats::LoadDataInternal() {
-    col_data_ = mo::CreateTypedColumnData(*input_table_, is_null_equal_null_);
-    all_stats_ = std::vector<ColumnStats>{col_data_.size()};
+    typed_relation_ = mo::ColumnLayoutTypedRelationData::CreateCachedFrom(*input_table_,
+                                                                         is_null_equal_null_);
+    all_stats_ = std::vector<ColumnStats>{GetData().size()};
 }
 
 Statistic DataStats::GetInterquartileRange(size_t index) const {
     if (all_stats_[index].interquartile_range.HasValue())
         return all_stats_[index].interquartile_range;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     Statistic q1 = all_stats_[index].quantile25;
@@ -1285,7 +1277,7 @@ Statistic DataStats::GetCoefficientOfVariation(size_t index) const {
     if (all_stats_[index].coefficient_of_variation.HasValue())
         return all_stats_[index].coefficient_of_variation;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     if (!all_stats_[index].STD.HasValue() || !all_stats_[index].avg.HasValue()) return {};
@@ -1317,7 +1309,7 @@ Statistic DataStats::GetCoefficientOfVariation(size_t index) const {
 Statistic DataStats::GetMonotonicity(size_t index) const {
     if (all_stats_[index].monotonicity.HasValue()) return all_stats_[index].monotonicity;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!mo::Type::IsOrdered(col.GetTypeId())) return {};
 
     bool increasing = true;
@@ -1354,7 +1346,7 @@ Statistic DataStats::GetJarqueBeraStatistic(size_t index) const {
     if (all_stats_[index].jarque_bera_statistic.HasValue())
         return all_stats_[index].jarque_bera_statistic;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (!col.IsNumeric()) return {};
 
     if (!all_stats_[index].skewness.HasValue() || !all_stats_[index].kurtosis.HasValue()) return {};
@@ -1375,7 +1367,7 @@ Statistic DataStats::GetJarqueBeraStatistic(size_t index) const {
 Statistic DataStats::GetEntropy(size_t index) const {
     if (all_stats_[index].entropy.HasValue()) return all_stats_[index].entropy;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     std::unordered_map<std::string, size_t> freq_map;
@@ -1404,7 +1396,7 @@ Statistic DataStats::GetEntropy(size_t index) const {
 Statistic DataStats::GetGiniCoefficient(size_t index) const {
     if (all_stats_[index].gini_coefficient.HasValue()) return all_stats_[index].gini_coefficient;
 
-    mo::TypedColumnData const& col = col_data_[index];
+    mo::TypedColumnData const& col = GetData()[index];
     if (col.GetTypeId() != mo::TypeId::kString) return {};
 
     std::unordered_map<std::string, size_t> freq_map;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <set>
 
 #include "core/algorithms/fd/fd_algorithm.h"
@@ -15,7 +16,7 @@ class DataStats : public Algorithm {
     config::EqNullsType is_null_equal_null_;
     config::ThreadNumType threads_num_;
 
-    std::vector<model::TypedColumnData> col_data_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     std::vector<ColumnStats> all_stats_;
 
     size_t MixedDistinct(size_t index) const;
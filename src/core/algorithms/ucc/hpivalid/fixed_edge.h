@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/dynamic_bitset.hpp>
+
+// see algorithms/ucc/hpivalid/LICENSE
+
+namespace algos::hpiv {
+
+// An edge of a table with at most 64 * Words columns. It has the interface of
+// boost::dynamic_bitset<> that the tree search uses, but keeps its words in place: copies do not
+// allocate and the operations are loops over a fixed number of words the compiler unrolls and
+// vectorizes. The bits past size() are always zero.
+template <std::size_t Words>
+class FixedEdge {
+private:
+    using Word = std::uint64_t;
+    static constexpr std::size_t kWordBits = 64;
+
+    std::array<Word, Words> words_{};
+    std::size_t size_ = 0;
+
+    static constexpr std::size_t WordIndex(std::size_t pos) noexcept {
+        return pos / kWordBits;
+    }
+
+    static constexpr Word BitMask(std::size_t pos) noexcept {
+        return Word{1} << (pos % kWordBits);
+    }
+
+    // Clears the bits past size() in the last word
+    void ClearUnusedBits() noexcept {
+        std::size_t const used_words = (size_ + kWordBits - 1) / kWordBits;
+        for (std::size_t i = used_words; i < Words; ++i) {
+            words_[i] = 0;
+        }
+        if (size_ % kWordBits != 0) {
+            words_[used_words - 1] &= BitMask(size_) - 1;
+        }
+    }
+
+public:
+    static constexpr std::size_t kMaxSize = Words * kWordBits;
+
+    using size_type = std::size_t;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    FixedEdge() = default;
+
+    explicit FixedEdge(size_type num_bits) noexcept : size_(num_bits) {
+        assert(num_bits <= kMaxSize);
+    }
+
+    // NOLINTBEGIN(readability-identifier-naming)
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    bool test(size_type pos) const noexcept {
+        assert(pos < size_);
+        return words_[WordIndex(pos)] & BitMask(pos);
+    }
+
+    bool operator[](size_type pos) const noexcept {
+        return test(pos);
+    }
+
+    FixedEdge& set(size_type pos) noexcept {
+        assert(pos < size_);
+        words_[WordIndex(pos)] |= BitMask(pos);
+        return *this;
+    }
+
+    FixedEdge& set() noexcept {
+        words_.fill(~Word{0});
+        ClearUnusedBits();
+        return *this;
+    }
+
+    FixedEdge& reset(size_type pos) noexcept {
+        assert(pos < size_);
+        words_[WordIndex(pos)] &= ~BitMask(pos);
+        return *this;
+    }
+
+    FixedEdge& reset() noexcept {
+        words_.fill(0);
+        return *this;
+    }
+
+    size_type count() const noexcept {
+        size_type count = 0;
+        for (Word word : words_) {
+            count += std::popcount(word);
+        }
+        return count;
+    }
+
+    bool any() const noexcept {
+        Word any = 0;
+        for (Word word : words_) {
+            any |= word;
+        }
+        return any != 0;
+    }
+
+    bool none() const noexcept {
+        return !any();
+    }
+
+    size_type find_first() const noexcept {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (words_[i] != 0) return i * kWordBits + std::countr_zero(words_[i]);
+        }
+        return npos;
+    }
+
+    size_type find_next(size_type pos) const noexcept {
+        size_type const next = pos + 1;
+        if (next >= size_) return npos;
+        std::size_t i = WordIndex(next);
+        Word word = words_[i] & ~(BitMask(next) - 1);
+        while (word == 0) {
+            if (++i == Words) return npos;
+            word = words_[i];
+        }
+        return i * kWordBits + std::countr_zero(word);
+    }
+
+    bool is_subset_of(FixedEdge const& other) const noexcept {
+        Word extra = 0;
+        for (std::size_t i = 0; i < Words; ++i) {
+            extra |= words_[i] & ~other.words_[i];
+        }
+        return extra == 0;
+    }
+
+    bool intersects(FixedEdge const& other) const noexcept {
+        Word common = 0;
+        for (std::size_t i = 0; i < Words; ++i) {
+            common |= words_[i] & other.words_[i];
+        }
+        return common != 0;
+    }
+
+    // NOLINTEND(readability-identifier-naming)
+
+    FixedEdge& operator&=(FixedEdge const& other) noexcept {
+        for (std::size_t i = 0; i < Words; ++i) {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+
+    FixedEdge& operator|=(FixedEdge const& other) noexcept {
+        for (std::size_t i = 0; i < Words; ++i) {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+
+    FixedEdge& operator-=(FixedEdge const& other) noexcept {
+        for (std::size_t i = 0; i < Words; ++i) {
+            words_[i] &= ~other.words_[i];
+        }
+        return *this;
+    }
+
+    FixedEdge operator~() const noexcept {
+        FixedEdge result = *this;
+        for (Word& word : result.words_) {
+            word = ~word;
+        }
+        result.ClearUnusedBits();
+        return result;
+    }
+
+    friend FixedEdge operator&(FixedEdge lhs, FixedEdge const& rhs) noexcept {
+        return lhs &= rhs;
+    }
+
+    friend FixedEdge operator|(FixedEdge lhs, FixedEdge const& rhs) noexcept {
+        return lhs |= rhs;
+    }
+
+    friend FixedEdge operator-(FixedEdge lhs, FixedEdge const& rhs) noexcept {
+        return lhs -= rhs;
+    }
+
+    friend bool operator==(FixedEdge const& lhs, FixedEdge const& rhs) noexcept {
+        return lhs.words_ == rhs.words_;
+    }
+
+    // Some strict weak order, the edges are only sorted to find the equal ones
+    friend bool operator<(FixedEdge const& lhs, FixedEdge const& rhs) noexcept {
+        return lhs.words_ < rhs.words_;
+    }
+
+    boost::dynamic_bitset<> ToBitset() const {
+        boost::dynamic_bitset<> bitset(size_);
+        for (size_type pos = find_first(); pos != npos; pos = find_next(pos)) {
+            bitset.set(pos);
+        }
+        return bitset;
+    }
+};
+
+}  // namespace algos::hpiv
@@ -1,5 +1,7 @@
 #include "core/algorithms/ucc/hpivalid/hpivalid.h"
 
+#include <chrono>
+#include <cstddef>
 #include <deque>
 #include <utility>
 #include <vector>
@@ -7,16 +9,50 @@
 #include "core/algorithms/fd/hycommon/preprocessor.h"
 #include "core/algorithms/fd/hycommon/types.h"
 #include "core/algorithms/ucc/hpivalid/config.h"
+#include "core/algorithms/ucc/hpivalid/fixed_edge.h"
+#include "core/algorithms/ucc/hpivalid/hypergraph.h"
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
 #include "core/algorithms/ucc/hpivalid/tree_search.h"
+#include "core/config/memory_budget/option.h"
+#include "core/config/names_and_descriptions.h"
+#include "core/config/option_using.h"
+#include "core/config/thread_number/option.h"
+#include "core/config/time_limit/option.h"
 #include "core/util/logger.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
 
 namespace algos {
 
+namespace {
+template <typename Edge>
+void SearchTree(hpiv::PLITable const& tab, hpiv::Config const& cfg, hpiv::ResultCollector& rc,
+                util::CancellationToken& cancellation_token, unsigned threads) {
+    hpiv::TreeSearch<Edge> tree_search(tab, cfg, rc, cancellation_token, threads);
+    tree_search.Run();
+}
+}  // namespace
+
+HPIValid::HPIValid() : UCCAlgorithm() {
+    DESBORDANTE_OPTION_USING;
+
+    // The threads only encode the table. The search tree is explored on one thread unless asked
+    // otherwise, several ones come out slower unless the tree is large and the cores are free.
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(Option{&search_threads_num_, kSearchThreads, kDSearchThreads,
+                          config::ThreadNumType{1}});
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterOption(config::kMemoryBudgetMbOpt(&memory_budget_mb_));
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+void HPIValid::MakeExecuteOptsAvailable() {
+    MakeOptionsAvailable({config::names::kSearchThreads, config::kTimeLimitSecondsOpt.GetName(),
+                          config::kMemoryBudgetMbOpt.GetName()});
+}
+
 void HPIValid::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = ColumnLayoutRelationData::CreateCachedFrom(*input_table_, threads_num_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -42,13 +78,24 @@ hpiv::PLITable HPIValid::Preprocess() {
 
 unsigned long long HPIValid::ExecuteInternal() {
     hpiv::Config cfg;
-    hpiv::ResultCollector rc(3600);
+    hpiv::ResultCollector rc;
 
     rc.SetStartTime();
+    util::CancellationToken& cancellation_token = GetCancellationToken();
+    cancellation_token.Start(std::chrono::seconds(time_limit_seconds_),
+                             static_cast<std::size_t>(memory_budget_mb_) << 20);
     hpiv::PLITable tab = Preprocess();
 
-    hpiv::TreeSearch tree_search(tab, cfg, rc);
-    tree_search.Run();
+    // the edges of the tables with up to 256 columns are kept in fixed-width bitsets
+    if (tab.nr_cols <= hpiv::FixedEdge<1>::kMaxSize) {
+        SearchTree<hpiv::FixedEdge<1>>(tab, cfg, rc, cancellation_token, search_threads_num_);
+    } else if (tab.nr_cols <= hpiv::FixedEdge<2>::kMaxSize) {
+        SearchTree<hpiv::FixedEdge<2>>(tab, cfg, rc, cancellation_token, search_threads_num_);
+    } else if (tab.nr_cols <= hpiv::FixedEdge<4>::kMaxSize) {
+        SearchTree<hpiv::FixedEdge<4>>(tab, cfg, rc, cancellation_token, search_threads_num_);
+    } else {
+        SearchTree<hpiv::DynamicEdge>(tab, cfg, rc, cancellation_token, search_threads_num_);
+    }
 
     RegisterUCCs(rc);
 
@@ -61,7 +108,7 @@ void HPIValid::RegisterUCCs(hpiv::ResultCollector const& rc) {
     std::vector<model::RawUCC> ucc_vector = rc.GetUCCs();
     std::shared_ptr<RelationalSchema const> const& schema = relation_->GetSharedPtrSchema();
     for (auto&& ucc : ucc_vector) {
-        ucc_collection_.Register(schema, std::move(ucc));
+        RegisterUCC(model::UCC(schema, std::move(ucc)));
     }
 }
 
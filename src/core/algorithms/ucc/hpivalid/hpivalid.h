@@ -6,6 +6,9 @@
 #include "core/algorithms/ucc/hpivalid/pli_table.h"
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
 #include "core/algorithms/ucc/ucc_algorithm.h"
+#include "core/config/memory_budget/type.h"
+#include "core/config/thread_number/type.h"
+#include "core/config/time_limit/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
@@ -15,6 +18,10 @@ namespace algos {
 class HPIValid : public UCCAlgorithm {
 private:
     std::shared_ptr<ColumnLayoutRelationData> relation_;
+    config::ThreadNumType threads_num_ = 1;
+    config::ThreadNumType search_threads_num_ = 1;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::MemoryBudgetMBType memory_budget_mb_ = 0;
 
     void LoadDataInternal() override;
     unsigned long long ExecuteInternal() override;
@@ -23,6 +30,10 @@ private:
     void PrintInfo(hpiv::ResultCollector const& rc) const;
 
     void ResetUCCAlgorithmState() override {}
+    void MakeExecuteOptsAvailable() final;
+
+public:
+    HPIValid();
 };
 
 }  // namespace algos
@@ -4,14 +4,17 @@
 
 namespace algos::hpiv {
 
-Hypergraph::Hypergraph(Edge::size_type num_vertices) : num_vertices_(num_vertices), edges_() {}
+template <typename Edge>
+Hypergraph<Edge>::Hypergraph(typename Edge::size_type num_vertices)
+    : num_vertices_(num_vertices), edges_() {}
 
-void Hypergraph::AddEdgeAndMinimizeInclusion(Edge const& new_edge) {
+template <typename Edge>
+void Hypergraph<Edge>::AddEdgeAndMinimizeInclusion(Edge const& new_edge) {
     // is new_edge a supset of an edge in edges_?
     bool is_supset = false;
     // list of indices of supsets of new_edge from edges_ in descending order
-    std::vector<std::vector<Edge>::size_type> supsets_indices;
-    for (std::vector<Edge>::size_type i_e = this->NumEdges(); i_e-- > 0;) {
+    std::vector<typename std::vector<Edge>::size_type> supsets_indices;
+    for (typename std::vector<Edge>::size_type i_e = this->NumEdges(); i_e-- > 0;) {
         if (edges_[i_e].is_subset_of(new_edge)) {
             is_supset = true;
             break;
@@ -23,7 +26,7 @@ void Hypergraph::AddEdgeAndMinimizeInclusion(Edge const& new_edge) {
     }
 
     if (!is_supset) {
-        for (std::vector<Edge>::size_type i_e : supsets_indices) {
+        for (typename std::vector<Edge>::size_type i_e : supsets_indices) {
             edges_[i_e] = edges_[edges_.size() - 1];
             edges_.pop_back();
         }
@@ -31,4 +34,9 @@ void Hypergraph::AddEdgeAndMinimizeInclusion(Edge const& new_edge) {
     }
 }
 
+template class Hypergraph<FixedEdge<1>>;
+template class Hypergraph<FixedEdge<2>>;
+template class Hypergraph<FixedEdge<4>>;
+template class Hypergraph<DynamicEdge>;
+
 }  // namespace algos::hpiv
@@ -4,27 +4,33 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "core/algorithms/ucc/hpivalid/fixed_edge.h"
+
 // see algorithms/ucc/hpivalid/LICENSE
 
 namespace algos::hpiv {
 
-typedef boost::dynamic_bitset<> Edge;
+// An edge of a table with any number of columns
+typedef boost::dynamic_bitset<> DynamicEdge;
 typedef boost::dynamic_bitset<> Edgemark;
 
+// Edge is DynamicEdge or FixedEdge<Words> for 1, 2 or 4 words, the narrowest one the columns fit
+// in is used
+template <typename Edge>
 class Hypergraph {
 private:
-    Edge::size_type num_vertices_;
+    typename Edge::size_type num_vertices_;
     std::vector<Edge> edges_;
 
 public:
     Hypergraph() = delete;
-    explicit Hypergraph(Edge::size_type num_vertices);
+    explicit Hypergraph(typename Edge::size_type num_vertices);
 
-    std::vector<Edge>::size_type NumEdges() const {
+    typename std::vector<Edge>::size_type NumEdges() const {
         return edges_.size();
     }
 
-    Edge::size_type NumVertices() const {
+    typename Edge::size_type NumVertices() const {
         return num_vertices_;
     }
 
@@ -44,28 +50,28 @@ public:
 
     // operators and related
 
-    Edge& operator[](std::vector<Edge>::size_type i_e) {
+    Edge& operator[](typename std::vector<Edge>::size_type i_e) {
         return edges_[i_e];
     }
 
-    Edge const& operator[](std::vector<Edge>::size_type i_e) const {
+    Edge const& operator[](typename std::vector<Edge>::size_type i_e) const {
         return edges_[i_e];
     }
 
     // NOLINTBEGIN(readability-identifier-naming)
-    std::vector<Edge>::iterator begin() {
+    typename std::vector<Edge>::iterator begin() {
         return edges_.begin();
     }
 
-    std::vector<Edge>::const_iterator begin() const {
+    typename std::vector<Edge>::const_iterator begin() const {
         return edges_.begin();
     }
 
-    std::vector<Edge>::iterator end() {
+    typename std::vector<Edge>::iterator end() {
         return edges_.end();
     }
 
-    std::vector<Edge>::const_iterator end() const {
+    typename std::vector<Edge>::const_iterator end() const {
         return edges_.end();
     }
 
@@ -1,8 +1,10 @@
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "core/util/logger.h"
@@ -11,9 +13,8 @@
 
 namespace algos::hpiv {
 
-ResultCollector::ResultCollector(double timeout)
-    : timeout_(timeout),
-      ucc_count_(0),
+ResultCollector::ResultCollector()
+    : ucc_count_(0),
       diff_sets_final_(0),
       diff_sets_(0),
       diff_sets_initial_(0),
@@ -22,21 +23,16 @@ ResultCollector::ResultCollector(double timeout)
       intersections_(0),
       intersection_cluster_size_(0) {}
 
-void ResultCollector::AddUCC(Edge const& ucc) {
+void ResultCollector::AddUCC(model::RawUCC ucc) {
     ucc_count_++;
-    ucc_vector_.push_back(ucc);
+    ucc_vector_.push_back(std::move(ucc));
 }
 
-bool ResultCollector::TimedOut() const {
-    return std::chrono::duration_cast<std::chrono::duration<double>>(
-                   std::chrono::high_resolution_clock::now() - exec_start_)
-                   .count() > timeout_;
-}
-
-void ResultCollector::FinalHypergraph(Hypergraph const& hg) {
+template <typename Edge>
+void ResultCollector::FinalHypergraph(Hypergraph<Edge> const& hg) {
     std::stringstream out;
     for (Edge const& e : hg) {
-        for (Edge::size_type v = e.find_first(); v != Edge::npos; v = e.find_next(v)) {
+        for (typename Edge::size_type v = e.find_first(); v != Edge::npos; v = e.find_next(v)) {
             if (v != e.find_first()) {
                 out << ",";
             }
@@ -49,6 +45,11 @@ void ResultCollector::FinalHypergraph(Hypergraph const& hg) {
     diff_sets_final_ = hg.NumEdges();
 }
 
+template void ResultCollector::FinalHypergraph(Hypergraph<FixedEdge<1>> const& hg);
+template void ResultCollector::FinalHypergraph(Hypergraph<FixedEdge<2>> const& hg);
+template void ResultCollector::FinalHypergraph(Hypergraph<FixedEdge<4>> const& hg);
+template void ResultCollector::FinalHypergraph(Hypergraph<DynamicEdge> const& hg);
+
 void ResultCollector::SetStartTime() {
     exec_start_ = std::chrono::high_resolution_clock::now();
 }
@@ -83,4 +84,21 @@ void ResultCollector::CountIntersectionClusterSize(unsigned cluster_size) {
     intersection_cluster_size_ += cluster_size;
 }
 
+void ResultCollector::Merge(ResultCollector const& other) {
+    ucc_count_ += other.ucc_count_;
+    ucc_vector_.insert(ucc_vector_.end(), other.ucc_vector_.begin(), other.ucc_vector_.end());
+    diff_sets_ += other.diff_sets_;
+    diff_sets_initial_ += other.diff_sets_initial_;
+    tree_complexity_ += other.tree_complexity_;
+    tree_nodes_ += other.tree_nodes_;
+    intersections_ += other.intersections_;
+    intersection_cluster_size_ += other.intersection_cluster_size_;
+}
+
+void ResultCollector::RemoveDuplicateUCCs() {
+    std::sort(ucc_vector_.begin(), ucc_vector_.end());
+    ucc_vector_.erase(std::unique(ucc_vector_.begin(), ucc_vector_.end()), ucc_vector_.end());
+    ucc_count_ = ucc_vector_.size();
+}
+
 }  // namespace algos::hpiv
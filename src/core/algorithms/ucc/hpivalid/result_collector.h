@@ -14,7 +14,6 @@
 namespace algos::hpiv {
 
 class ResultCollector {
-    double timeout_;
     std::chrono::high_resolution_clock::time_point exec_start_;
 
     unsigned ucc_count_;
@@ -30,19 +29,17 @@ class ResultCollector {
     std::vector<model::RawUCC> ucc_vector_;
 
 public:
-    explicit ResultCollector(double timeout);
+    ResultCollector();
 
     //////////////////////////////////////////////////////////////////////////////
     // collecting information
 
     // Report that a UCC has been found.
-    void AddUCC(Edge const& ucc);
-
-    // Return true if the timeout is reached.
-    bool TimedOut() const;
+    void AddUCC(model::RawUCC ucc);
 
     // Report the final hypergraph of difference sets.
-    void FinalHypergraph(Hypergraph const& hg);
+    template <typename Edge>
+    void FinalHypergraph(Hypergraph<Edge> const& hg);
 
     // Set execution start time for timeout tracking.
     void SetStartTime();
@@ -66,6 +63,12 @@ public:
     // Count the total cluster size in intersections.
     void CountIntersectionClusterSize(unsigned cluster_size);
 
+    // Add the UCCs and the counts of `other`, e.g. of another thread.
+    void Merge(ResultCollector const& other);
+
+    // Keep each of the found UCCs once.
+    void RemoveDuplicateUCCs();
+
     //////////////////////////////////////////////////////////////////////////////
     // getting statistics
 
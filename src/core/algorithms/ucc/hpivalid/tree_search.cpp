@@ -3,7 +3,10 @@
 #include <algorithm>
 #include <cstddef>
 #include <deque>
+#include <exception>
+#include <iterator>
 #include <limits>
+#include <mutex>
 #include <random>
 #include <stack>
 #include <tuple>
@@ -13,36 +16,307 @@
 #include "core/algorithms/ucc/hpivalid/config.h"
 #include "core/algorithms/ucc/hpivalid/pli_table.h"
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
+#include "core/util/auto_join_thread.h"
 #include "core/util/logger.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
 
 namespace algos::hpiv {
 
-TreeSearch::TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector& rc)
+namespace {
+model::RawUCC ToRawUCC(DynamicEdge const& edge) {
+    return edge;
+}
+
+template <std::size_t Words>
+model::RawUCC ToRawUCC(FixedEdge<Words> const& edge) {
+    return edge.ToBitset();
+}
+}  // namespace
+
+template <typename Edge>
+TreeSearch<Edge>::TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector& rc,
+                       util::CancellationToken& cancellation_token, unsigned threads)
     : tab_(tab),
       cfg_(cfg),
       rc_(rc),
-      partial_hg_(tab.nr_cols),
-      clusterid_to_recordindices_(tab.nr_rows),
-      gen_(cfg.seed) {
-    // add single edge containing all vertices to partial hypergraph
-    partial_hg_.AddEdge(~Edge(partial_hg_.NumVertices()));
-
+      cancellation_token_(cancellation_token),
+      threads_(std::max(threads, 1u)) {
     if (cfg_.tiebreaker_heuristic) {
         ComputeNiceness();
     }
+
+    for (unsigned i = 0; i < threads_; ++i) {
+        searchers_.push_back(std::make_unique<Searcher>(*this, cfg_.seed + i));
+    }
+}
+
+template <typename Edge>
+void TreeSearch<Edge>::Run() {
+    Searcher& root_searcher = *searchers_.front();
+    root_searcher.SampleInitialHypergraph();
+
+    Hypergraph final_hg = root_searcher.GetPartialHypergraph();
+    if (!InPasses()) {
+        try {
+            root_searcher.SearchFromRoot();
+        } catch (Cancelled const&) {
+            cancelled_ = true;
+        }
+        final_hg = root_searcher.GetPartialHypergraph();
+    } else {
+        SetPassOrigins({});
+        std::size_t passes = 0;
+        do {
+            RunPass(final_hg);
+            ++passes;
+        } while (!pass_origins_.empty() && !cancelled_);
+        LOG_DEBUG("Search passes: {}", passes);
+    }
+
+    for (auto const& searcher : searchers_) {
+        rc_.Merge(searcher->GetResultCollector());
+    }
+    if (InPasses()) {
+        // a UCC is found from every hitting set it contains that has been searched from
+        rc_.RemoveDuplicateUCCs();
+    }
+
+    if (cancelled_) {
+        // report current partial hypergraph
+        LOG_DEBUG("Current partial hypergraph:");
+    } else {
+        // report final hypergraph
+        LOG_DEBUG("Final hypergraph:");
+    }
+    rc_.FinalHypergraph(final_hg);
 }
 
-void TreeSearch::Run() {
+template <typename Edge>
+void TreeSearch<Edge>::RunPass(Hypergraph& partial_hg) {
+    for (auto const& searcher : searchers_) {
+        searcher->StartPass(partial_hg);
+    }
+
+    Searcher& root_searcher = *searchers_.front();
+    // The helpers block until the pass is over, so they get threads of their own instead of
+    // taking workers of the shared scheduler
+    std::exception_ptr helper_exception;
+    std::mutex helper_exception_mutex;
+    std::vector<util::JThread> helpers;
+    helpers.reserve(threads_ - 1);
+    auto const start_helpers = [&]() {
+        for (unsigned i = 1; i < threads_; ++i) {
+            helpers.emplace_back([this, i, &helper_exception, &helper_exception_mutex]() {
+                try {
+                    ExploreSubtrees(*searchers_[i]);
+                } catch (...) {
+                    std::scoped_lock lock(helper_exception_mutex);
+                    if (!helper_exception) helper_exception = std::current_exception();
+                }
+            });
+        }
+    };
+    if (pass_origins_.empty()) {
+        // The root is explored like the forked subtrees, the threads wait for the branches it
+        // forks until it is done
+        num_busy_ = 1;
+        start_helpers();
+        try {
+            root_searcher.SearchFromRoot();
+        } catch (Cancelled const&) {
+            cancelled_ = true;
+        } catch (...) {
+            // The other threads explore what has been forked before they stop
+            FinishSubtree();
+            throw;
+        }
+        FinishSubtree();
+    } else {
+        // Any vertex may be added to a hitting set that is no UCC, even one that has been left
+        // out in the branch it has been found in
+        for (std::size_t origin = 0; origin < pass_origins_.size(); ++origin) {
+            Edge const& s = pass_origins_[origin].s;
+            subtrees_.push_back({s, ~s, origin});
+        }
+        num_subtrees_ = subtrees_.size();
+        start_helpers();
+    }
+    ExploreSubtrees(root_searcher);
+    helpers.clear();
+    if (helper_exception) {
+        std::rethrow_exception(helper_exception);
+    }
+
+    std::vector<Edge> sampled_edges;
+    std::vector<Origin> new_non_uccs;
+    for (auto const& searcher : searchers_) {
+        sampled_edges.insert(sampled_edges.end(), searcher->GetSampledEdges().begin(),
+                             searcher->GetSampledEdges().end());
+        std::vector<Origin>& non_uccs = searcher->GetNonUCCs();
+        std::move(non_uccs.begin(), non_uccs.end(), std::back_inserter(new_non_uccs));
+        non_uccs.clear();
+    }
+    // the same edges are sampled for many hitting sets, the smaller ones go first so that their
+    // supersets are dropped right away
+    std::sort(sampled_edges.begin(), sampled_edges.end(), [](Edge const& a, Edge const& b) {
+        return a.count() < b.count() || (a.count() == b.count() && a < b);
+    });
+    sampled_edges.erase(std::unique(sampled_edges.begin(), sampled_edges.end()),
+                        sampled_edges.end());
+    for (Edge const& e : sampled_edges) {
+        partial_hg.AddEdgeAndMinimizeInclusion(e);
+    }
+    SetPassOrigins(std::move(new_non_uccs));
+}
+
+template <typename Edge>
+void TreeSearch<Edge>::SetPassOrigins(std::vector<Origin> origins) {
+    // the same hitting set may have been found in several subtrees
+    std::sort(origins.begin(), origins.end(),
+              [](Origin const& a, Origin const& b) { return a.s < b.s; });
+    origins.erase(std::unique(origins.begin(), origins.end(),
+                              [](Origin const& a, Origin const& b) { return a.s == b.s; }),
+                  origins.end());
+    pass_origins_ = std::move(origins);
+
+    origins_with_vertex_.assign(tab_.nr_cols, {});
+    for (std::size_t origin = 0; origin < pass_origins_.size(); ++origin) {
+        Edge const& s = pass_origins_[origin].s;
+        for (typename Edge::size_type v = s.find_first(); v != Edge::npos; v = s.find_next(v)) {
+            origins_with_vertex_[v].push_back(origin);
+        }
+    }
+}
+
+template <typename Edge>
+bool TreeSearch<Edge>::ContainsEarlierOrigin(Edge const& s, typename Edge::size_type v,
+                                       std::size_t origin) const {
+    // the origins are minimal hitting sets of the same hypergraph, so none contains another one
+    // and s has not contained any of the ones with v before
+    if (pass_origins_.empty()) return false;
+    for (std::size_t other : origins_with_vertex_[v]) {
+        if (other >= origin) break;
+        if (pass_origins_[other].s.is_subset_of(s)) return true;
+    }
+    return false;
+}
+
+template <typename Edge>
+void TreeSearch<Edge>::ComputeNiceness() {
+    std::vector<std::pair<unsigned long, unsigned long>> sq_sizes_col_id_pairs(tab_.nr_cols);
+
+    for (model::ColumnIndex col = 0; col < tab_.nr_cols; ++col) {
+        unsigned long sq_size = 0;
+        for (auto const& cluster : tab_.plis[col]) {
+            sq_size += cluster.size() * cluster.size();
+        }
+        sq_sizes_col_id_pairs[col] = std::make_pair(sq_size, col);
+    }
+
+    std::sort(sq_sizes_col_id_pairs.begin(), sq_sizes_col_id_pairs.end());
+    niceness_.clear();
+    niceness_.resize(tab_.nr_cols);
+    for (std::size_t pos = 0; pos < tab_.nr_cols; ++pos) {
+        unsigned long const col = sq_sizes_col_id_pairs[pos].second;
+        niceness_[col] = pos;
+    }
+}
+
+template <typename Edge>
+unsigned long TreeSearch<Edge>::Niceness(Edge const& e) const {
+    unsigned long niceness = 0;
+    if (cfg_.tiebreaker_heuristic) {
+        for (std::size_t col = e.find_first(); col != Edge::npos; col = e.find_next(col)) {
+            if (niceness < niceness_[col]) {
+                niceness = niceness_[col];
+            }
+        }
+    }
+    return niceness;
+}
+
+template <typename Edge>
+bool TreeSearch<Edge>::ShouldFork(Edge const& s, Edge const& cand) const {
+    return InPasses() && s.count() < kMaxForkDepth && cand.count() >= kMinForkCandidates &&
+           num_subtrees_.load(std::memory_order::relaxed) < threads_;
+}
+
+template <typename Edge>
+void TreeSearch<Edge>::Fork(Subtree subtree) {
+    {
+        std::scoped_lock lock(subtrees_mutex_);
+        subtrees_.push_back(std::move(subtree));
+        num_subtrees_.store(subtrees_.size(), std::memory_order::relaxed);
+    }
+    subtrees_changed_.notify_one();
+}
+
+template <typename Edge>
+void TreeSearch<Edge>::ExploreSubtrees(Searcher& searcher) {
+    std::unique_lock lock(subtrees_mutex_);
+    while (true) {
+        subtrees_changed_.wait(lock, [this]() { return !subtrees_.empty() || num_busy_ == 0; });
+        if (subtrees_.empty()) {
+            // Nobody is left to fork a subtree
+            return;
+        }
+        // The earliest forked subtree is the closest one to the root, so the largest one
+        Subtree subtree = std::move(subtrees_.front());
+        subtrees_.pop_front();
+        num_subtrees_.store(subtrees_.size(), std::memory_order::relaxed);
+        ++num_busy_;
+        lock.unlock();
+
+        try {
+            searcher.Explore(std::move(subtree));
+        } catch (Cancelled const&) {
+            // The subtrees left are dropped as soon as they are explored
+            cancelled_ = true;
+        } catch (...) {
+            FinishSubtree();
+            throw;
+        }
+        FinishSubtree();
+        lock.lock();
+    }
+}
+
+template <typename Edge>
+void TreeSearch<Edge>::FinishSubtree() {
+    {
+        std::scoped_lock lock(subtrees_mutex_);
+        if (--num_busy_ != 0 || !subtrees_.empty()) return;
+    }
+    subtrees_changed_.notify_all();
+}
+
+template <typename Edge>
+TreeSearch<Edge>::Searcher::Searcher(TreeSearch& search, unsigned seed)
+    : search_(search),
+      tab_(search.tab_),
+      cfg_(search.cfg_),
+      partial_hg_(tab_.nr_cols),
+      gen_(seed),
+      clusterid_to_recordindices_(tab_.nr_rows) {}
+
+template <typename Edge>
+void TreeSearch<Edge>::Searcher::SampleInitialHypergraph() {
+    // add single edge containing all vertices to partial hypergraph
+    partial_hg_.AddEdge(~Edge(partial_hg_.NumVertices()));
+
     for (auto const& pli : tab_.plis) {
+        if (search_.cancellation_token_.IsCancelled()) break;
         Hypergraph gen = Sample(pli);
         for (Edge const& e : gen) {
             partial_hg_.AddEdgeAndMinimizeInclusion(e);
         }
     }
     rc_.StopInitialSampling();
+}
 
+template <typename Edge>
+void TreeSearch<Edge>::Searcher::SearchFromRoot() {
     // S, CAND
     Edge s(partial_hg_.NumVertices());
     Edge cand(partial_hg_.NumVertices());
@@ -54,25 +328,18 @@ void TreeSearch::Run() {
     uncov.set();
 
     // vertexhittings
-    std::vector<Edgemark> vertexhittings(partial_hg_.NumVertices(),
-                                         Edgemark(partial_hg_.NumEdges()));
-    for (std::vector<Edge>::size_type i_e = 0; i_e < partial_hg_.NumEdges(); ++i_e) {
-        for (Edge::size_type i_v = partial_hg_[i_e].find_first(); i_v != Edge::npos;
-             i_v = partial_hg_[i_e].find_next(i_v)) {
-            vertexhittings[i_v].set(i_e);
-        }
-    }
+    std::vector<Edgemark> vertexhittings = ComputeVertexHittings();
 
-    std::vector<std::vector<Edgemark>> removed_critical_stack;
+    RemovedCriticalStack removed_critical_stack;
 
     // intersections
     std::stack<std::deque<model::PLI::Cluster>> intersection_stack;
-    std::deque<Edge::size_type> tointersect_queue;
+    std::deque<typename Edge::size_type> tointersect_queue;
 
     // Searching
     // find edge from uncov with smallest intersection C with CAND
     Edge c = partial_hg_[uncov.find_first()] & cand;
-    for (Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
+    for (typename Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
          i_e = uncov.find_next(i_e)) {
         if ((partial_hg_[i_e] & cand).count() < c.count()) {
             c = partial_hg_[i_e] & cand;
@@ -81,68 +348,104 @@ void TreeSearch::Run() {
 
     cand -= c;
 
-    try {
-        for (Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
-            // update crit and uncov
-            UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings[v]);
+    for (typename Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
+        if (search_.ShouldFork(s, cand)) {
+            Edge forked_s = s;
+            forked_s.set(v);
+            search_.Fork({std::move(forked_s), cand, origin_});
+            cand.set(v);
+            continue;
+        }
 
-            // branch
-            s.set(v);
-            intersection_stack.push(tab_.plis[v]);
-            ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_critical_stack,
-                             intersection_stack, tointersect_queue);
-            intersection_stack.pop();
-            s.reset(v);
+        // update crit and uncov
+        UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings[v]);
 
-            // reset update of crit and uncov
-            RestoreCritAndUncov(removed_critical_stack, crit, uncov);
+        // branch
+        s.set(v);
+        intersection_stack.push(tab_.plis[v]);
+        ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_critical_stack,
+                         intersection_stack, tointersect_queue);
+        intersection_stack.pop();
+        s.reset(v);
 
-            // update CAND
-            cand.set(v);
-        }
-        // report final hypergraph
-        LOG_DEBUG("Final hypergraph:");
-        rc_.FinalHypergraph(partial_hg_);
-    } catch (unsigned timeout) {
-        // report current partial hypergraph
-        LOG_DEBUG("Current partial hypergraph:");
-        rc_.FinalHypergraph(partial_hg_);
+        // reset update of crit and uncov
+        RestoreCritAndUncov(removed_critical_stack, crit, uncov);
+
+        // update CAND
+        cand.set(v);
     }
 }
 
-void TreeSearch::ComputeNiceness() {
-    std::vector<std::pair<unsigned long, unsigned long>> sq_sizes_col_id_pairs(tab_.nr_cols);
+template <typename Edge>
+void TreeSearch<Edge>::Searcher::StartPass(Hypergraph const& partial_hg) {
+    partial_hg_ = partial_hg;
+    origin_ = 0;
+    kept_records_ = 0;
+    vertexhittings_ = ComputeVertexHittings();
+    non_uccs_.clear();
+    sampled_edges_.clear();
+}
 
-    for (model::ColumnIndex col = 0; col < tab_.nr_cols; ++col) {
-        unsigned long sq_size = 0;
-        for (auto const& cluster : tab_.plis[col]) {
-            sq_size += cluster.size() * cluster.size();
-        }
-        sq_sizes_col_id_pairs[col] = std::make_pair(sq_size, col);
+template <typename Edge>
+void TreeSearch<Edge>::Searcher::Explore(Subtree subtree) {
+    Edge& s = subtree.s;
+    Edge& cand = subtree.cand;
+    origin_ = subtree.origin;
+
+    std::vector<Edgemark> crit;
+    Edgemark uncov(partial_hg_.NumEdges());
+    uncov.set();
+    RemovedCriticalStack removed_critical_stack;
+    for (typename Edge::size_type v = s.find_first(); v != Edge::npos; v = s.find_next(v)) {
+        UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings_[v]);
     }
+    // the subtree is never left, so these changes are not restored
+    removed_critical_stack.Clear();
 
-    std::sort(sq_sizes_col_id_pairs.begin(), sq_sizes_col_id_pairs.end());
-    niceness_.clear();
-    niceness_.resize(tab_.nr_cols);
-    for (std::size_t pos = 0; pos < tab_.nr_cols; ++pos) {
-        unsigned long const col = sq_sizes_col_id_pairs[pos].second;
-        niceness_[col] = pos;
+    // a hitting set found in the pass before may not be minimal with the new edges, then no
+    // minimal hitting set contains it
+    if (!SFulfillsMinimalityCondition(crit)) {
+        return;
+    }
+
+    // the vertices of S that the PLI it starts from lacks are intersected once needed
+    std::stack<std::deque<model::PLI::Cluster>> intersection_stack;
+    std::deque<typename Edge::size_type> tointersect_queue;
+    Edge to_intersect = s;
+    if (!search_.pass_origins_.empty() && !search_.pass_origins_[origin_].pli.empty()) {
+        Origin const& origin = search_.pass_origins_[origin_];
+        intersection_stack.push(origin.pli);
+        to_intersect -= origin.s;
+    } else {
+        typename Edge::size_type const first = s.find_first();
+        intersection_stack.push(tab_.plis[first]);
+        to_intersect.reset(first);
     }
+    for (typename Edge::size_type v = to_intersect.find_first(); v != Edge::npos;
+         v = to_intersect.find_next(v)) {
+        tointersect_queue.push_back(v);
+    }
+
+    ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings_, removed_critical_stack,
+                     intersection_stack, tointersect_queue);
 }
 
-unsigned long TreeSearch::Niceness(Edge const& e) const {
-    unsigned long niceness = 0;
-    if (cfg_.tiebreaker_heuristic) {
-        for (std::size_t col = e.find_first(); col != Edge::npos; col = e.find_next(col)) {
-            if (niceness < niceness_[col]) {
-                niceness = niceness_[col];
-            }
+template <typename Edge>
+std::vector<Edgemark> TreeSearch<Edge>::Searcher::ComputeVertexHittings() const {
+    std::vector<Edgemark> vertexhittings(partial_hg_.NumVertices(),
+                                         Edgemark(partial_hg_.NumEdges()));
+    for (typename std::vector<Edge>::size_type i_e = 0; i_e < partial_hg_.NumEdges(); ++i_e) {
+        for (typename Edge::size_type i_v = partial_hg_[i_e].find_first(); i_v != Edge::npos;
+             i_v = partial_hg_[i_e].find_next(i_v)) {
+            vertexhittings[i_v].set(i_e);
         }
     }
-    return niceness;
+    return vertexhittings;
 }
 
-Hypergraph TreeSearch::Sample(std::deque<model::PLI::Cluster> const& pli) {
+template <typename Edge>
+typename TreeSearch<Edge>::Hypergraph TreeSearch<Edge>::Searcher::Sample(
+        std::deque<model::PLI::Cluster> const& pli) {
     Hypergraph difference_graph(tab_.nr_cols);
     Edge temp_edge(tab_.nr_cols);
 
@@ -203,15 +506,17 @@ Hypergraph TreeSearch::Sample(std::deque<model::PLI::Cluster> const& pli) {
     return difference_graph;
 }
 
-inline void TreeSearch::UpdateCritAndUncov(
-        std::vector<std::vector<Edgemark>>& removed_critical_stack, std::vector<Edgemark>& crit,
-        Edgemark& uncov, Edgemark const& v_hittings) const {
-    // update crit[] for vertices in S and put changes on stack
+template <typename Edge>
+inline void TreeSearch<Edge>::Searcher::UpdateCritAndUncov(
+        RemovedCriticalStack& removed_critical_stack, std::vector<Edgemark>& crit, Edgemark& uncov,
+        Edgemark const& v_hittings) const {
+    // update crit[] for vertices in S and log the changes
 
-    removed_critical_stack.emplace_back(crit.size());
+    removed_critical_stack.PushLevel();
 
     for (std::vector<Edgemark>::size_type i = 0; i < crit.size(); ++i) {
-        removed_critical_stack.back()[i] = crit[i] & v_hittings;
+        if (!crit[i].intersects(v_hittings)) continue;
+        removed_critical_stack.Log(i, crit[i], v_hittings);
         crit[i] -= v_hittings;
     }
 
@@ -221,32 +526,50 @@ inline void TreeSearch::UpdateCritAndUncov(
     uncov -= v_hittings;
 }
 
-inline void TreeSearch::RestoreCritAndUncov(
-        std::vector<std::vector<Edgemark>>& removed_critical_stack, std::vector<Edgemark>& crit,
+template <typename Edge>
+inline void TreeSearch<Edge>::Searcher::RestoreCritAndUncov(
+        RemovedCriticalStack& removed_critical_stack, std::vector<Edgemark>& crit,
         Edgemark& uncov) const {
     uncov |= crit.back();
     crit.pop_back();
 
-    for (std::vector<Edgemark>::size_type i = 0; i < crit.size(); ++i) {
-        crit[i] |= removed_critical_stack.back()[i];
-    }
-
-    removed_critical_stack.pop_back();
+    removed_critical_stack.PopLevel(crit);
 }
 
-inline bool TreeSearch::ExtendOrConfirmS(
+template <typename Edge>
+inline bool TreeSearch<Edge>::Searcher::ExtendOrConfirmS(
         Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
-        std::vector<Edgemark>& vertexhittings,
-        std::vector<std::vector<Edgemark>>& removed_critical_stack,
+        std::vector<Edgemark>& vertexhittings, RemovedCriticalStack& removed_critical_stack,
         std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
-        std::deque<Edge::size_type>& tointersect_queue) {
+        std::deque<typename Edge::size_type>& tointersect_queue) {
+    if (search_.cancellation_token_.IsCancelled()) throw Cancelled{};
     rc_.CountTreeNode();
     if (uncov.none()) {
         PullUpIntersections(intersection_stack, tointersect_queue);
 
         if (intersection_stack.top().empty()) {
-            rc_.AddUCC(s);
-            if (rc_.TimedOut()) throw timeout_;
+            rc_.AddUCC(ToRawUCC(s));
+            return false;
+        }
+
+        if (search_.InPasses()) {
+            // the partial hypergraph stays the same during a pass, the next one goes on from S
+            std::deque<model::PLI::Cluster>& pli = intersection_stack.top();
+            Hypergraph new_edges = Sample(pli);
+            sampled_edges_.insert(sampled_edges_.end(), new_edges.begin(), new_edges.end());
+
+            // the PLI of S is dropped once we return, it is kept for the next pass while the
+            // ones kept by now are not too large
+            std::size_t records = 0;
+            for (auto const& cluster : pli) {
+                records += cluster.size();
+            }
+            Origin non_ucc{s, {}};
+            if (kept_records_ + records <= kMaxKeptRecords / search_.threads_) {
+                kept_records_ += records;
+                non_ucc.pli = std::move(pli);
+            }
+            non_uccs_.push_back(std::move(non_ucc));
             return false;
         }
 
@@ -262,27 +585,41 @@ inline bool TreeSearch::ExtendOrConfirmS(
     // find edge from uncov with smallest intersection C with CAND
     rc_.CountTreeComplexity(uncov.count());
     Edge c = partial_hg_[uncov.find_first()] & cand;
-    for (Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
+    for (typename Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
          i_e = uncov.find_next(i_e)) {
         Edge c_new = (partial_hg_[i_e] & cand);
         if (c_new.count() < c.count() ||
-            (c_new.count() == c.count() && Niceness(c_new) < Niceness(c))) {
+            (c_new.count() == c.count() && search_.Niceness(c_new) < search_.Niceness(c))) {
             c = std::move(c_new);
         }
     }
 
     cand -= c;
 
-    for (Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
+    for (typename Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
         // don't branch if v is violater for S
         if (IsViolater(crit, vertexhittings[v])) {
             continue;
         }
 
+        s.set(v);
+        // the hitting sets with S and v are searched for from another origin of the pass
+        if (search_.ContainsEarlierOrigin(s, v, origin_)) {
+            s.reset(v);
+            continue;
+        }
+
+        // leave the branch to another thread
+        if (search_.ShouldFork(s, cand)) {
+            search_.Fork({s, cand, origin_});
+            s.reset(v);
+            cand.set(v);
+            continue;
+        }
+
         // branch
         UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings[v]);
 
-        s.set(v);
         tointersect_queue.push_back(v);
         bool check = ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_critical_stack,
                                       intersection_stack, tointersect_queue);
@@ -314,9 +651,10 @@ inline bool TreeSearch::ExtendOrConfirmS(
     return false;
 }
 
-inline void TreeSearch::PullUpIntersections(
+template <typename Edge>
+inline void TreeSearch<Edge>::Searcher::PullUpIntersections(
         std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
-        std::deque<Edge::size_type>& tointersect_queue) {
+        std::deque<typename Edge::size_type>& tointersect_queue) {
     while (!tointersect_queue.empty()) {
         intersection_stack.push(IntersectClusterListAndClusterMapping(
                 intersection_stack.top(), tab_.inverse_mapping[tointersect_queue.front()]));
@@ -325,7 +663,8 @@ inline void TreeSearch::PullUpIntersections(
     }
 }
 
-std::deque<model::PLI::Cluster> TreeSearch::IntersectClusterListAndClusterMapping(
+template <typename Edge>
+std::deque<model::PLI::Cluster> TreeSearch<Edge>::Searcher::IntersectClusterListAndClusterMapping(
         std::deque<model::PLI::Cluster> const& pli, std::vector<unsigned> const& inverse_mapping) {
     rc_.CountIntersections();
     std::deque<model::PLI::Cluster> intersection;
@@ -355,17 +694,17 @@ std::deque<model::PLI::Cluster> TreeSearch::IntersectClusterListAndClusterMappin
     return intersection;
 }
 
-inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
-                                    std::vector<Edgemark>& vertexhittings,
-                                    std::vector<std::vector<Edgemark>>& removed_critical_stack,
-                                    std::deque<model::PLI::Cluster> const& pli) {
+template <typename Edge>
+inline void TreeSearch<Edge>::Searcher::UpdateEdges(
+        std::vector<Edgemark>& crit, Edgemark& uncov, std::vector<Edgemark>& vertexhittings,
+        RemovedCriticalStack& removed_critical_stack, std::deque<model::PLI::Cluster> const& pli) {
     // sample new edges
     Hypergraph new_edges = Sample(pli);
 
     // find out which edges are supersets and therefore can be removed and save
     // indices in descending order
-    std::vector<std::vector<Edge>::size_type> supsets_indices;
-    for (std::vector<Edge>::size_type i_e = partial_hg_.NumEdges(); i_e > 0;
+    std::vector<typename std::vector<Edge>::size_type> supsets_indices;
+    for (typename std::vector<Edge>::size_type i_e = partial_hg_.NumEdges(); i_e > 0;
          /* gets decreased below */) {
         --i_e;
 
@@ -380,7 +719,7 @@ inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov
     // remove these edges from difference_graph, vertexhittings, uncov, crit,
     // removed_critical
 
-    for (std::vector<Edge>::size_type i_e : supsets_indices) {
+    for (typename std::vector<Edge>::size_type i_e : supsets_indices) {
         // difference_graph
         partial_hg_[i_e] = partial_hg_[partial_hg_.NumEdges() - 1];
         partial_hg_.RemoveLastEdge();
@@ -402,12 +741,7 @@ inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov
         }
 
         // removed_critical
-        for (auto& removed_critical : removed_critical_stack) {
-            for (auto& removed : removed_critical) {
-                removed[i_e] = removed[removed.size() - 1];
-                removed.pop_back();
-            }
-        }
+        removed_critical_stack.MoveLastEdge(i_e);
     }
 
     // insert the new edges in difference_graph, vertexhittings, uncov, crit,
@@ -419,12 +753,12 @@ inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov
     }
 
     // vertexhittings
-    for (Edge::size_type i_v = 0; i_v < partial_hg_.NumVertices(); ++i_v) {
+    for (typename Edge::size_type i_v = 0; i_v < partial_hg_.NumVertices(); ++i_v) {
         vertexhittings[i_v].resize(partial_hg_.NumEdges());
     }
     for (std::size_t i_e = partial_hg_.NumEdges() - new_edges.NumEdges();
          i_e < partial_hg_.NumEdges(); ++i_e) {
-        for (Edge::size_type i_v = partial_hg_[i_e].find_first(); i_v != Edge::npos;
+        for (typename Edge::size_type i_v = partial_hg_[i_e].find_first(); i_v != Edge::npos;
              i_v = partial_hg_[i_e].find_next(i_v)) {
             vertexhittings[i_v].set(i_e);
         }
@@ -439,14 +773,12 @@ inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov
     }
 
     // removed_critical
-    for (auto& removed_critical : removed_critical_stack) {
-        for (auto& removed : removed_critical) {
-            removed.resize(partial_hg_.NumEdges());
-        }
-    }
+    removed_critical_stack.Resize(partial_hg_.NumEdges());
 }
 
-inline bool TreeSearch::SFulfillsMinimalityCondition(std::vector<Edgemark> const& crit) const {
+template <typename Edge>
+inline bool TreeSearch<Edge>::Searcher::SFulfillsMinimalityCondition(
+        std::vector<Edgemark> const& crit) const {
     bool fulfill = true;
     for (Edgemark const& em : crit) {
         if (em.none()) {
@@ -458,8 +790,9 @@ inline bool TreeSearch::SFulfillsMinimalityCondition(std::vector<Edgemark> const
     return fulfill;
 }
 
-inline bool TreeSearch::IsViolater(std::vector<Edgemark> const& crit,
-                                   Edgemark const& v_hittings) const {
+template <typename Edge>
+inline bool TreeSearch<Edge>::Searcher::IsViolater(std::vector<Edgemark> const& crit,
+                                             Edgemark const& v_hittings) const {
     bool is_violater = false;
     for (Edgemark const& em : crit) {
         if (em.is_subset_of(v_hittings)) {
@@ -471,4 +804,9 @@ inline bool TreeSearch::IsViolater(std::vector<Edgemark> const& crit,
     return is_violater;
 }
 
+template class TreeSearch<FixedEdge<1>>;
+template class TreeSearch<FixedEdge<2>>;
+template class TreeSearch<FixedEdge<4>>;
+template class TreeSearch<DynamicEdge>;
+
 }  // namespace algos::hpiv
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <stack>
 #include <vector>
 
 #include "core/algorithms/ucc/hpivalid/hypergraph.h"
+#include "core/algorithms/ucc/hpivalid/result_collector.h"
 #include "core/model/table/position_list_index.h"
+#include "core/util/cancellation_token.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
 
@@ -14,23 +21,194 @@ namespace algos::hpiv {
 
 struct Config;
 struct PLITable;
-class ResultCollector;
 
+// With more than one thread the search is run in passes. The partial hypergraph stays the same
+// during a pass, so the branches of the search tree can be explored on any thread and in any
+// order. A hitting set that is no UCC is not extended right away: its difference sets are added
+// to the partial hypergraph once the pass is over and the next pass searches for the minimal
+// hitting sets that contain it. Every minimal hitting set of the grown hypergraph contains a
+// minimal hitting set of the one before, which is either a UCC or has been searched from, so no
+// minimal UCC is missed. The search is over after a pass that has found no such hitting sets.
+template <typename Edge>
 class TreeSearch {
 private:
-    PLITable const& tab_;
-    Config const& cfg_;
-    ResultCollector& rc_;
+    using Hypergraph = hpiv::Hypergraph<Edge>;
+
+    // The critical edges UpdateCritAndUncov takes from the vertices of S, one level for each
+    // vertex added to S. Only the vertices that lose critical edges are logged. The entries of
+    // the popped levels keep their storage for the next ones, so that logging does not allocate.
+    class RemovedCriticalStack {
+    private:
+        struct Removed {
+            // index of the vertex in crit
+            std::size_t crit_index;
+            Edgemark edges;
+        };
+
+        std::vector<Removed> removed_;
+        std::size_t size_ = 0;
+        std::vector<std::size_t> level_begins_;
+
+    public:
+        void PushLevel() {
+            level_begins_.push_back(size_);
+        }
+
+        void Log(std::size_t crit_index, Edgemark const& crit, Edgemark const& v_hittings) {
+            if (size_ == removed_.size()) removed_.emplace_back();
+            Removed& removed = removed_[size_++];
+            removed.crit_index = crit_index;
+            removed.edges = crit;
+            removed.edges &= v_hittings;
+        }
+
+        void PopLevel(std::vector<Edgemark>& crit) {
+            for (std::size_t i = level_begins_.back(); i < size_; ++i) {
+                crit[removed_[i].crit_index] |= removed_[i].edges;
+            }
+            size_ = level_begins_.back();
+            level_begins_.pop_back();
+        }
+
+        // The partial hypergraph has moved its last edge to `edge`, which has been removed
+        void MoveLastEdge(std::size_t edge) {
+            for (std::size_t i = 0; i < size_; ++i) {
+                Edgemark& edges = removed_[i].edges;
+                edges[edge] = edges[edges.size() - 1];
+                edges.pop_back();
+            }
+        }
+
+        void Resize(std::size_t num_edges) {
+            for (std::size_t i = 0; i < size_; ++i) {
+                removed_[i].edges.resize(num_edges);
+            }
+        }
+
+        void Clear() {
+            size_ = 0;
+            level_begins_.clear();
+        }
+    };
+
+    // A hitting set that is no UCC, the next pass searches from it. Its PLI is empty unless kept.
+    struct Origin {
+        Edge s;
+        std::deque<model::PLI::Cluster> pli;
+    };
+
+    // The records in the PLIs the threads keep for the next pass at most, the PLIs of the other
+    // origins are intersected again
+    static constexpr std::size_t kMaxKeptRecords = std::size_t{1} << 25;
+
+    // A branch of the search tree that is explored apart from the one it has been forked from
+    struct Subtree {
+        Edge s;
+        Edge cand;
+        // index of the hitting set in the pass origins the branch has been reached from
+        std::size_t origin;
+    };
+
+    // Explores the subtrees on one thread, one at a time. Keeps what the threads cannot share.
+    class Searcher {
+    private:
+        TreeSearch& search_;
+        PLITable const& tab_;
+        Config const& cfg_;
+
+        // the partial hypergraph of difference sets
+        Hypergraph partial_hg_;
+        // the edges each vertex hits, kept for the whole pass
+        std::vector<Edgemark> vertexhittings_;
+
+        // the hitting sets of the partial hypergraph that are no UCCs and the difference sets
+        // sampled for them during the current pass
+        std::vector<Origin> non_uccs_;
+        std::vector<Edge> sampled_edges_;
+        // index of the pass origin the explored subtree has been reached from
+        std::size_t origin_ = 0;
+        // the records in the PLIs of non_uccs_
+        std::size_t kept_records_ = 0;
+
+        ResultCollector rc_;
+        std::default_random_engine gen_;
+
+        // a mapping from clusterid to record indices that is used for the
+        // intersection of PLIs with single-column PLIs
+        std::vector<model::PLI::Cluster> clusterid_to_recordindices_;
+
+        inline void UpdateCritAndUncov(RemovedCriticalStack& removed_critical_stack,
+                                       std::vector<Edgemark>& crit, Edgemark& uncov,
+                                       Edgemark const& v_hittings) const;
+        inline void RestoreCritAndUncov(RemovedCriticalStack& removed_critical_stack,
+                                        std::vector<Edgemark>& crit, Edgemark& uncov) const;
 
-    // the partial hypergraph of difference sets
-    Hypergraph partial_hg_;
+        inline bool ExtendOrConfirmS(
+                Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
+                std::vector<Edgemark>& vertexhittings, RemovedCriticalStack& removed_critical_stack,
+                std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+                std::deque<typename Edge::size_type>& tointersect_queue);
 
-    // exception to throw, when timeout happens
-    unsigned const timeout_ = 10;
+        inline void PullUpIntersections(
+                std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+                std::deque<typename Edge::size_type>& tointersect_queue);
 
-    // a mapping from clusterid to record indices that is used for the
-    // intersection of PLIs with single-column PLIs
-    std::vector<model::PLI::Cluster> clusterid_to_recordindices_;
+        std::deque<model::PLI::Cluster> IntersectClusterListAndClusterMapping(
+                std::deque<model::PLI::Cluster> const& pli,
+                std::vector<unsigned> const& inverse_mapping);
+
+        inline void UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
+                                std::vector<Edgemark>& vertexhittings,
+                                RemovedCriticalStack& removed_critical_stack,
+                                std::deque<model::PLI::Cluster> const& pli);
+
+        std::vector<Edgemark> ComputeVertexHittings() const;
+
+        inline bool SFulfillsMinimalityCondition(std::vector<Edgemark> const& crit) const;
+
+        inline bool IsViolater(std::vector<Edgemark> const& crit, Edgemark const& v_hittings) const;
+
+    public:
+        Searcher(TreeSearch& search, unsigned seed);
+
+        Hypergraph Sample(std::deque<model::PLI::Cluster> const& pli);
+
+        void SampleInitialHypergraph();
+        void SearchFromRoot();
+
+        void StartPass(Hypergraph const& partial_hg);
+        void Explore(Subtree subtree);
+
+        Hypergraph const& GetPartialHypergraph() const noexcept {
+            return partial_hg_;
+        }
+
+        std::vector<Origin>& GetNonUCCs() noexcept {
+            return non_uccs_;
+        }
+
+        std::vector<Edge> const& GetSampledEdges() const noexcept {
+            return sampled_edges_;
+        }
+
+        ResultCollector const& GetResultCollector() const noexcept {
+            return rc_;
+        }
+    };
+
+    // Branches are forked only while S has fewer vertices than this and there are at least
+    // kMinForkCandidates candidates left, the smaller subtrees are not worth it
+    static constexpr std::size_t kMaxForkDepth = 6;
+    static constexpr std::size_t kMinForkCandidates = 4;
+
+    // Unwinds a searcher once the token is cancelled
+    struct Cancelled {};
+
+    PLITable const& tab_;
+    Config const& cfg_;
+    ResultCollector& rc_;
+    util::CancellationToken& cancellation_token_;
+    unsigned const threads_;
 
     // mapping from column to niceness (in [0, nr_cols)) with smaller
     // values being nicer columns
@@ -38,40 +216,48 @@ private:
     void ComputeNiceness();
     unsigned long Niceness(Edge const& e) const;
 
-    std::default_random_engine gen_;
-    Hypergraph Sample(std::deque<model::PLI::Cluster> const& pli);
-
-    inline void UpdateCritAndUncov(std::vector<std::vector<Edgemark>>& removed_critical_stack,
-                                   std::vector<Edgemark>& crit, Edgemark& uncov,
-                                   Edgemark const& v_hittings) const;
-    inline void RestoreCritAndUncov(std::vector<std::vector<Edgemark>>& removed_critical_stack,
-                                    std::vector<Edgemark>& crit, Edgemark& uncov) const;
-
-    inline bool ExtendOrConfirmS(Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
-                                 std::vector<Edgemark>& vertexhittings,
-                                 std::vector<std::vector<Edgemark>>& removed_critical_stack,
-                                 std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
-                                 std::deque<Edge::size_type>& tointersect_queue);
+    // One per thread, the first one starts the search from the root
+    std::vector<std::unique_ptr<Searcher>> searchers_;
 
-    inline void PullUpIntersections(std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
-                                    std::deque<Edge::size_type>& tointersect_queue);
+    // Subtrees that no thread explores yet. A branch is only forked while there are fewer of
+    // them than threads, so the threads fork when the others may run out of work.
+    std::mutex subtrees_mutex_;
+    std::condition_variable subtrees_changed_;
+    std::deque<Subtree> subtrees_;
+    std::atomic<std::size_t> num_subtrees_ = 0;
+    // Threads exploring a subtree, the pass is over once none does and there is no subtree left
+    std::size_t num_busy_ = 0;
+    std::atomic<bool> cancelled_ = false;
 
-    std::deque<model::PLI::Cluster> IntersectClusterListAndClusterMapping(
-            std::deque<model::PLI::Cluster> const& pli,
-            std::vector<unsigned> const& inverse_mapping);
+    bool InPasses() const noexcept {
+        return threads_ > 1;
+    }
 
-    inline void UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
-                            std::vector<Edgemark>& vertexhittings,
-                            std::vector<std::vector<Edgemark>>& removed_critical_stack,
-                            std::deque<model::PLI::Cluster> const& pli);
+    // The hitting sets the current pass searches from, sorted, and the indices of the ones that
+    // contain each vertex. A hitting set that contains several of them is only searched for from
+    // the first one.
+    std::vector<Origin> pass_origins_;
+    std::vector<std::vector<std::size_t>> origins_with_vertex_;
+    void SetPassOrigins(std::vector<Origin> origins);
+    // Whether `s`, which has just gained `v`, contains an origin before `origin`
+    bool ContainsEarlierOrigin(Edge const& s, typename Edge::size_type v,
+                               std::size_t origin) const;
 
-    inline bool SFulfillsMinimalityCondition(std::vector<Edgemark> const& crit) const;
+    // Runs a pass from the root if there are no pass origins, from the origins otherwise. Adds
+    // the difference sets sampled during the pass to `partial_hg` and makes the hitting sets
+    // found to be no UCCs the origins of the next pass.
+    void RunPass(Hypergraph& partial_hg);
 
-    inline bool IsViolater(std::vector<Edgemark> const& crit, Edgemark const& v_hittings) const;
+    bool ShouldFork(Edge const& s, Edge const& cand) const;
+    void Fork(Subtree subtree);
+    void ExploreSubtrees(Searcher& searcher);
+    void FinishSubtree();
 
 public:
-    TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector& rc);
+    TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector& rc,
+               util::CancellationToken& cancellation_token, unsigned threads = 1);
 
+    // Stops early if the token is cancelled, the UCCs found by then are minimal UCCs
     void Run();
 };
 
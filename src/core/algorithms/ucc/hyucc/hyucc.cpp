@@ -1,6 +1,8 @@
 #include "core/algorithms/ucc/hyucc/hyucc.h"
 
 #include <chrono>
+#include <cstddef>
+#include <vector>
 
 #include "core/algorithms/fd/hycommon/types.h"
 #include "core/algorithms/ucc/hyucc/inductor.h"
@@ -12,7 +14,7 @@
 namespace algos {
 
 void HyUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = ColumnLayoutRelationData::CreateCachedFrom(*input_table_, threads_num_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -23,6 +25,9 @@ unsigned long long HyUCC::ExecuteInternal() {
     using namespace hy;
     using namespace hyucc;
     auto const start_time = std::chrono::system_clock::now();
+    auto& cancellation_token = GetCancellationToken();
+    cancellation_token.Start(std::chrono::seconds(time_limit_seconds_),
+                             static_cast<std::size_t>(memory_budget_mb_) << 20);
 
     auto [plis, pli_records, og_mapping] = Preprocess(relation_.get());
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
@@ -32,13 +37,17 @@ unsigned long long HyUCC::ExecuteInternal() {
 
     auto ucc_tree = std::make_unique<UCCTree>(relation_->GetNumColumns());
     Inductor inductor(ucc_tree.get());
-    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_);
+    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_,
+                        cancellation_token);
 
     IdPairs comparison_suggestions;
 
-    while (true) {
+    while (!cancellation_token.IsCancelled()) {
         LOG_DEBUG("Sampling...");
         NonUCCList non_uccs = sampler.GetNonUCCs(comparison_suggestions);
+        if (cancellation_token.IsCancelled()) {
+            break;
+        }
 
         LOG_DEBUG("Inducing...");
         inductor.UpdateUCCTree(std::move(non_uccs));
@@ -52,6 +61,12 @@ unsigned long long HyUCC::ExecuteInternal() {
     }
 
     auto uccs = ucc_tree->FillUCCs();
+    if (cancellation_token.WasCancelled()) {
+        // Only the candidates of the levels the validator has gone through are known to be unique
+        std::erase_if(uccs, [level = validator.GetLevelNum()](boost::dynamic_bitset<> const& ucc) {
+            return ucc.count() >= level;
+        });
+    }
     RegisterUCCs(std::move(uccs), og_mapping);
 
     LOG_DEBUG("Mined UCCs:");
@@ -70,7 +85,7 @@ void HyUCC::RegisterUCCs(std::vector<boost::dynamic_bitset<>>&& uccs,
     for (auto&& ucc : uccs) {
         boost::dynamic_bitset<> mapped_ucc =
                 hy::RestoreAgreeSet(ucc, og_mapping, schema->GetNumColumns());
-        ucc_collection_.Register(schema, std::move(mapped_ucc));
+        RegisterUCC(model::UCC(schema, std::move(mapped_ucc)));
     }
 }
 
@@ -4,8 +4,12 @@
 
 #include "core/algorithms/fd/hycommon/types.h"
 #include "core/algorithms/ucc/ucc_algorithm.h"
+#include "core/config/memory_budget/option.h"
+#include "core/config/memory_budget/type.h"
 #include "core/config/thread_number/option.h"
 #include "core/config/thread_number/type.h"
+#include "core/config/time_limit/option.h"
+#include "core/config/time_limit/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/idataset_stream.h"
 
@@ -13,8 +17,10 @@ namespace algos {
 
 class HyUCC : public UCCAlgorithm {
 private:
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
     config::ThreadNumType threads_num_ = 1;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    config::MemoryBudgetMBType memory_budget_mb_ = 0;
 
     void LoadDataInternal() override;
     unsigned long long ExecuteInternal() override;
@@ -25,12 +31,18 @@ private:
                       std::vector<hy::ClusterId> const& og_mapping);
 
     void MakeExecuteOptsAvailable() final {
-        MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+        MakeOptionsAvailable({config::kThreadNumberOpt.GetName(),
+                              config::kTimeLimitSecondsOpt.GetName(),
+                              config::kMemoryBudgetMbOpt.GetName()});
     }
 
 public:
     HyUCC() : UCCAlgorithm() {
         RegisterOption(config::kThreadNumberOpt(&threads_num_));
+        RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+        RegisterOption(config::kMemoryBudgetMbOpt(&memory_budget_mb_));
+        // The table is encoded in parallel too, the execution keeps the value set for loading
+        MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
     }
 };
 
@@ -1,13 +1,12 @@
 #include "core/algorithms/ucc/hyucc/validator.h"
 
-#include <future>
-
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
+#include <numeric>
+#include <vector>
 
 #include "core/algorithms/fd/hycommon/efficiency_threshold.h"
 #include "core/algorithms/fd/hycommon/validator_helpers.h"
 #include "core/algorithms/ucc/hyucc/model/ucc_tree_vertex.h"
+#include "core/util/parallel_for.h"
 
 namespace {
 
@@ -107,6 +106,9 @@ Validator::UCCValidations Validator::ValidateAndExtendSeq(
         std::vector<LhsPair> const& current_level) {
     UCCValidations result;
     for (auto const& vertex_and_ucc : current_level) {
+        if (cancellation_token_.IsCancelled()) {
+            break;
+        }
         if (!vertex_and_ucc.first->IsUCC()) {
             continue;
         }
@@ -117,26 +119,27 @@ Validator::UCCValidations Validator::ValidateAndExtendSeq(
 
 Validator::UCCValidations Validator::ValidateAndExtendParallel(
         std::vector<LhsPair> const& current_level) {
-    UCCValidations result;
-    boost::asio::thread_pool pool(threads_num_);
-    std::vector<std::future<UCCValidations>> validation_futures;
-
+    std::vector<LhsPair const*> uccs;
     for (auto const& vertex_and_ucc : current_level) {
-        if (!vertex_and_ucc.first->IsUCC()) {
-            continue;
+        if (vertex_and_ucc.first->IsUCC()) {
+            uccs.push_back(&vertex_and_ucc);
         }
-
-        std::packaged_task<UCCValidations()> task(
-                [this, &vertex_and_ucc]() { return GetValidations(vertex_and_ucc); });
-        validation_futures.push_back(task.get_future());
-        boost::asio::post(pool, std::move(task));
     }
 
-    pool.join();
+    // Merged in the order of the level, as hyfd::Validator does
+    std::vector<UCCValidations> validations(uccs.size());
+    std::vector<std::size_t> indices(uccs.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_,
+                          [this, &uccs, &validations](std::size_t i) {
+                              if (!cancellation_token_.IsCancelled()) {
+                                  validations[i] = GetValidations(*uccs[i]);
+                              }
+                          });
 
-    for (auto& future : validation_futures) {
-        assert(future.valid());
-        result.Add(future.get());
+    UCCValidations result;
+    for (UCCValidations const& vertex_validations : validations) {
+        result.Add(vertex_validations);
     }
 
     return result;
@@ -165,6 +168,10 @@ hy::IdPairs Validator::ValidateAndExtendCandidates() {
     hy::IdPairs comparison_suggestions;
     while (!current_level.empty()) {
         UCCValidations result = ValidateAndExtend(current_level);
+        // The level is validated only partially, its candidates are not specialized
+        if (cancellation_token_.WasCancelled()) {
+            return {};
+        }
         comparison_suggestions.insert(comparison_suggestions.end(),
                                       result.ComparisonSuggestions().begin(),
                                       result.ComparisonSuggestions().end());
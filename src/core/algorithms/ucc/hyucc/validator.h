@@ -10,6 +10,7 @@
 #include "core/algorithms/ucc/raw_ucc.h"
 #include "core/config/thread_number/type.h"
 #include "core/model/table/position_list_index.h"
+#include "core/util/cancellation_token.h"
 
 namespace algos::hyucc {
 
@@ -22,6 +23,7 @@ private:
     hy::RowsPtr compressed_records_;
     unsigned current_level_number_ = 1;
     config::ThreadNumType threads_num_ = 1;
+    util::CancellationToken& cancellation_token_;
 
     bool IsUnique(model::PLI const& pivot_pli, model::RawUCC const& ucc,
                   hy::IdPairs& comparison_suggestions);
@@ -32,13 +34,26 @@ private:
 
 public:
     Validator(UCCTree* tree, hy::PLIsPtr plis, hy::RowsPtr compressed_records,
-              config::ThreadNumType threads_num) noexcept
+              config::ThreadNumType threads_num,
+              util::CancellationToken& cancellation_token) noexcept
         : tree_(tree),
           plis_(std::move(plis)),
           compressed_records_(std::move(compressed_records)),
-          threads_num_(threads_num) {}
+          threads_num_(threads_num),
+          cancellation_token_(cancellation_token) {}
 
+    /**
+     * Validates the candidates level by level. Returns no suggestions if the token is cancelled,
+     * the level it was validating is left unfinished then.
+     */
     hy::IdPairs ValidateAndExtendCandidates();
+
+    /**
+     * @return the level to be validated next, the candidates of the lower levels are UCCs
+     */
+    [[nodiscard]] unsigned GetLevelNum() const {
+        return current_level_number_;
+    }
 };
 
 }  // namespace algos::hyucc
@@ -7,6 +7,7 @@
 #include "core/algorithms/fd/pyrocommon/core/key_g1_strategy.h"
 #include "core/config/error/option.h"
 #include "core/config/max_lhs/option.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/util/logger.h"
@@ -18,7 +19,7 @@ PyroUCC::PyroUCC() : UCCAlgorithm() {
     fd_consumer_ = nullptr;
     ucc_consumer_ = [this](auto const& ucc) {
         this->DiscoverUcc(ucc);
-        ucc_collection_.Register(model::UCC(this->relation_->GetSharedPtrSchema(), ucc.vertical_));
+        RegisterUCC(model::UCC(this->relation_->GetSharedPtrSchema(), ucc.vertical_));
     };
 }
 
@@ -28,15 +29,17 @@ void PyroUCC::RegisterOptions() {
     RegisterOption(config::kErrorOpt(&parameters_.max_ucc_error));
     RegisterOption(config::kMaxLhsOpt(&parameters_.max_lhs));
     RegisterOption(Option{&parameters_.seed, kSeed, kDSeed, 0});
+    RegisterOption(config::kMemLimitMbOpt(&parameters_.mem_limit_mb));
 }
 
 void PyroUCC::MakeExecuteOptsAvailable() {
     using namespace config::names;
-    MakeOptionsAvailable({config::kMaxLhsOpt.GetName(), config::kErrorOpt.GetName(), kSeed});
+    MakeOptionsAvailable({config::kMaxLhsOpt.GetName(), config::kErrorOpt.GetName(), kSeed,
+                          config::kMemLimitMbOpt.GetName()});
 }
 
 void PyroUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = ColumnLayoutRelationData::CreateCachedFrom(*input_table_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -89,6 +92,8 @@ unsigned long long PyroUCC::ExecuteInternal() {
     LOG_INFO("Init time: {} ms", init_time_millis);
     LOG_INFO("Time: {}  milliseconds", elapsed_milliseconds.count());
     LOG_INFO("Total intersection time: {} ms", model::PositionListIndex::micros_ / 1000);
+    LOG_INFO("PLI cache: {} hits, {} misses, {} evictions", profiling_context->GetPliCacheHits(),
+             profiling_context->GetPliCacheMisses(), profiling_context->GetPliCacheEvictions());
     return elapsed_milliseconds.count();
 }
 
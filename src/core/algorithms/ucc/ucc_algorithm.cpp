@@ -1,15 +1,39 @@
 #include "core/algorithms/ucc/ucc_algorithm.h"
 
+#include <utility>
+
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
 
 namespace algos {
 
+void ResultFormat<model::UCC>::WriteJson(std::ostream& out, model::UCC const& ucc) {
+    out << "{\"ucc\": [";
+    bool first = true;
+    for (auto index : ucc.GetColumnIndicesAsVector()) {
+        if (!first) out << ", ";
+        out << index;
+        first = false;
+    }
+    out << "]}";
+}
+
+void ResultFormat<model::UCC>::WriteBinary(std::ostream& out, model::UCC const& ucc) {
+    WriteIndices(out, ucc.GetColumnIndicesAsVector());
+}
+
 UCCAlgorithm::UCCAlgorithm() : Algorithm() {
     RegisterOptions();
     MakeOptionsAvailable({config::kTableOpt.GetName()});
 }
 
+void UCCAlgorithm::SetResultSink(std::shared_ptr<ResultSink<model::UCC>> sink,
+                                 bool retain_uccs) {
+    SetResultSinkBase(sink);
+    ucc_sink_ = std::move(sink);
+    retain_uccs_ = retain_uccs || ucc_sink_ == nullptr;
+}
+
 void UCCAlgorithm::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
 }
@@ -1,22 +1,38 @@
 #pragma once
 
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <ostream>
 #include <string_view>
 #include <vector>
 
 #include "core/algorithms/algorithm.h"
+#include "core/algorithms/result_sink.h"
 #include "core/algorithms/ucc/ucc.h"
 #include "core/config/equal_nulls/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/util/cancellation_token.h"
 #include "core/util/primitive_collection.h"
 
 namespace algos {
 
+template <>
+struct ResultFormat<model::UCC> {
+    static constexpr std::uint8_t kKind = 1;
+
+    // {"ucc": [column indices]}
+    static void WriteJson(std::ostream& out, model::UCC const& ucc);
+    // Indices of the columns
+    static void WriteBinary(std::ostream& out, model::UCC const& ucc);
+};
+
 // Base class for all algorithms that mine UCCs
 class UCCAlgorithm : public Algorithm {
 private:
     void ResetState() final {
         ucc_collection_.Clear();
+        cancellation_token_.Start();
         ResetUCCAlgorithmState();
     }
 
@@ -24,15 +40,49 @@ private:
 
     void RegisterOptions();
 
+    std::shared_ptr<ResultSink<model::UCC>> ucc_sink_;
+    bool retain_uccs_ = true;
+
+    util::CancellationToken cancellation_token_;
+
 protected:
     config::InputTable input_table_;
 
     // Collection of all mined UCCs. Every UCC mining algorithm must register found uccs here.
+    // Don't add new UCCs by accessing this field directly, use RegisterUCC instead.
     util::PrimitiveCollection<model::UCC> ucc_collection_;
 
+    void RegisterUCC(model::UCC ucc) {
+        if (ucc_sink_ != nullptr) ucc_sink_->Consume(ucc);
+        if (retain_uccs_) ucc_collection_.Register(std::move(ucc));
+    }
+
+    // Polled by the algorithms that honor the time and memory limits, see FDAlgorithm
+    util::CancellationToken& GetCancellationToken() noexcept {
+        return cancellation_token_;
+    }
+
 public:
     UCCAlgorithm();
 
+    /* Passes every UCC to sink as soon as it is registered. If retain_uccs is false, the UCCs are
+     * not kept in memory and UCCList() stays empty. nullptr removes the sink.
+     */
+    void SetResultSink(std::shared_ptr<ResultSink<model::UCC>> sink, bool retain_uccs = true);
+
+    /* Stops the execution running on another thread as soon as possible, the UCCs found so far
+     * are kept. Only the algorithms that honor the time limit respond to it. Called before the
+     * execution starts, it stops the execution at once.
+     */
+    void Cancel() noexcept {
+        cancellation_token_.Cancel();
+    }
+
+    // Whether the last execution found all the UCCs
+    bool IsComplete() const noexcept {
+        return !cancellation_token_.WasCancelled();
+    }
+
     std::list<model::UCC> const& UCCList() const noexcept {
         return ucc_collection_.AsList();
     }
@@ -0,0 +1,12 @@
+#include "core/config/checkpoint/option.h"
+
+#include "core/config/names_and_descriptions.h"
+
+namespace config {
+using names::kCheckpointPath, names::kCheckpointInterval, descriptions::kDCheckpointPath,
+        descriptions::kDCheckpointInterval;
+extern CommonOption<CheckpointPathType> const kCheckpointPathOpt{kCheckpointPath, kDCheckpointPath,
+                                                                 CheckpointPathType{}};
+extern CommonOption<CheckpointIntervalType> const kCheckpointIntervalOpt{
+        kCheckpointInterval, kDCheckpointInterval, 60u};
+}  // namespace config
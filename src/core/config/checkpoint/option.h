@@ -0,0 +1,9 @@
+#pragma once
+
+#include "core/config/checkpoint/type.h"
+#include "core/config/common_option.h"
+
+namespace config {
+extern CommonOption<CheckpointPathType> const kCheckpointPathOpt;
+extern CommonOption<CheckpointIntervalType> const kCheckpointIntervalOpt;
+}  // namespace config
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <filesystem>
+
+namespace config {
+using CheckpointPathType = std::filesystem::path;
+using CheckpointIntervalType = unsigned int;
+}  // namespace config
@@ -138,6 +138,21 @@ constexpr auto kDMaxFitnessEvaluations =
         "the algorithm will be stopped after calculating the fitness "
         "function this many times";
 constexpr auto kDPopulationSize = "the number of individuals in the population at any given time";
+// DFD, Pyro, Tane
+constexpr auto kDFlatPli =
+        "store the partitions of column combinations in flat arena-allocated arrays instead of a "
+        "separate vector per cluster, which reduces allocations and memory overhead";
+// DFD, HyFD, HyMD, Tane
+constexpr auto kDCheckpointPath =
+        "file the progress of the algorithm is saved to, so that an execution on the same input "
+        "with the same options can resume from it after a crash or a time limit. The file is "
+        "removed once the execution completes. Empty to disable checkpoints";
+// HyFD, HyMD, Tane
+constexpr auto kDCheckpointInterval = "minimum number of seconds between two checkpoints";
+// DFD, FastFDs, HyFD, HyUCC, HPIValid
+constexpr auto kDMemoryBudgetMB =
+        "max growth of the resident set size during the execution in MBs, the algorithm stops "
+        "early once it is exceeded. Pass 0 to remove limit";
 // Dynamic FD verifier
 constexpr auto kDDeleteStatements = "Rows to be deleted from the table using the delete operation";
 constexpr auto kDInsertStatements = "Rows to be inserted into the table using the insert operation";
@@ -193,6 +208,10 @@ constexpr auto kDGSpanOutputPath =
         "path to output file for frequent subgraphs (if empty, no file is written)";
 // GDD
 constexpr auto kDGddData = "List of GDD objects";
+// HPIValid
+constexpr auto kDSearchThreads =
+        "number of threads to explore the search tree with. The exploration only pays off on "
+        "several threads if the tree is large and the cores are free";
 // HyMD
 constexpr auto kDColumnMatches = "column matches to examine";
 constexpr auto kDLeftTable = "first table processed by the algorithm";
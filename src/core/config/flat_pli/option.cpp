@@ -0,0 +1,8 @@
+#include "core/config/flat_pli/option.h"
+
+#include "core/config/names_and_descriptions.h"
+
+namespace config {
+using names::kFlatPli, descriptions::kDFlatPli;
+extern CommonOption<FlatPliType> const kFlatPliOpt{kFlatPli, kDFlatPli, false};
+}  // namespace config
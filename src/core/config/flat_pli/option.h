@@ -0,0 +1,8 @@
+#pragma once
+
+#include "core/config/common_option.h"
+#include "core/config/flat_pli/type.h"
+
+namespace config {
+extern CommonOption<FlatPliType> const kFlatPliOpt;
+}  // namespace config
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace config {
+using FlatPliType = bool;
+}  // namespace config
@@ -0,0 +1,9 @@
+#include "core/config/memory_budget/option.h"
+
+#include "core/config/names_and_descriptions.h"
+
+namespace config {
+using names::kMemoryBudgetMB, descriptions::kDMemoryBudgetMB;
+extern CommonOption<MemoryBudgetMBType> const kMemoryBudgetMbOpt{kMemoryBudgetMB, kDMemoryBudgetMB,
+                                                                 0u};
+}  // namespace config
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "core/config/common_option.h"
+#include "core/config/memory_budget/type.h"
+
+namespace config {
+extern CommonOption<MemoryBudgetMBType> const kMemoryBudgetMbOpt;
+}  // namespace config
@@ -62,6 +62,14 @@ constexpr auto kDifferentialScale = "differential_scale";
 constexpr auto kDifferentialStrategy = "differential_strategy";
 constexpr auto kMaxFitnessEvaluations = "max_fitness_evaluations";
 constexpr auto kPopulationSize = "population_size";
+// DFD, Pyro, Tane
+constexpr auto kFlatPli = "flat_pli";
+// DFD, HyFD, HyMD, Tane
+constexpr auto kCheckpointPath = "checkpoint_path";
+// HyFD, HyMD, Tane
+constexpr auto kCheckpointInterval = "checkpoint_interval";
+// DFD, FastFDs, HyFD, HyUCC, HPIValid
+constexpr auto kMemoryBudgetMB = "memory_budget";
 // Dynamic FD verifier
 constexpr auto kDeleteStatements = "delete";
 constexpr auto kInsertStatements = "insert";
@@ -100,6 +108,8 @@ constexpr auto kGfdK = "gfd_k";
 constexpr auto kGfdSigma = "gfd_sigma";
 // GDD
 constexpr auto kGddData = "gdd";
+// HPIValid
+constexpr auto kSearchThreads = "search_threads";
 // HyMD
 constexpr auto kColumnMatches = "column_matches";
 constexpr auto kLeftTable = "left_table";
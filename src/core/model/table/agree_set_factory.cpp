@@ -1,7 +1,8 @@
 #include "core/model/table/agree_set_factory.h"
 
 #include <atomic>
-#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_set>
@@ -127,39 +128,19 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
     // compute agree sets using identifier sets
     // metanome approach (using map of identifier sets)
     if (config_.threads_num > 1) {
-        /* Not as fast and simple as it can be, need to use concurrent unordered_set.
-         * Without concurrent data structure need to create separate unordered_set<AgreeSet>
-         * for each thread, and as a consequence it is necessary to ensure the thread safety
-         * of threads_agree_sets initialization or to manually parallelize for loop over the
-         * max_representation. Leads to the bulky code with synchronization primitives or to
-         * the copying of util::ParallelForeach code.
+        /* Need to use concurrent unordered_set to avoid the merging. Without it every thread
+         * collects the agree sets into its own unordered_set. The threads of util::ParallelForeach
+         * are taken from the shared pool, so the sets are created as the threads show up.
          */
         std::map<std::thread::id, std::unordered_set<AgreeSet>> threads_agree_sets;
-        std::condition_variable map_init_cv;
-        bool map_initialized = false;
-        std::mutex map_init_mutex;
-        /* Need to know the exact number of threads used by util::ParallelForeach to identify
-         * when threads_agree_sets is initialized (when its size equals to the number
-         * of used threads).
-         * NOTE: if ParallelForeach fails to create exactly actual_threads_num threads when
-         *       threads_agree_sets.size() always will be not equal to actual_threads_num leading
-         *       to the infinite wait on cv.
-         */
-        unsigned short const actual_threads_num =
-                std::min(max_representation.size(), (size_t)config_.threads_num);
-        auto task = [&identifier_sets, actual_threads_num, &map_init_mutex, &threads_agree_sets,
-                     &map_init_cv, &map_initialized](SetOfVectors::value_type const& cluster) {
-            std::thread::id const thread_id = std::this_thread::get_id();
-
-            if (!map_initialized) {
-                std::unique_lock lock(map_init_mutex);
-                threads_agree_sets.insert({thread_id, std::unordered_set<AgreeSet>()});
-                if (threads_agree_sets.size() != actual_threads_num) {
-                    map_init_cv.wait(lock, [&map_initialized]() { return map_initialized; });
-                } else {
-                    map_initialized = true;
-                    map_init_cv.notify_all();
-                }
+        std::mutex threads_agree_sets_mutex;
+        auto task = [&identifier_sets, &threads_agree_sets_mutex,
+                     &threads_agree_sets](SetOfVectors::value_type const& cluster) {
+            std::unordered_set<AgreeSet>* thread_agree_sets;
+            {
+                // References to map elements are not invalidated by insertions
+                std::lock_guard lock(threads_agree_sets_mutex);
+                thread_agree_sets = &threads_agree_sets[std::this_thread::get_id()];
             }
 
             auto back_it = std::prev(cluster.cend());
@@ -167,7 +148,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
                 for (auto q = std::next(p); q != cluster.end(); ++q) {
                     IdentifierSet const& id_set1 = identifier_sets.at(*p);
                     IdentifierSet const& id_set2 = identifier_sets.at(*q);
-                    threads_agree_sets[thread_id].insert(id_set1.Intersect(id_set2));
+                    thread_agree_sets->insert(id_set1.Intersect(id_set2));
                 }
             }
         };
@@ -7,9 +7,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <istream>
 #include <numeric>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <utility>
 
 #include "core/config/thread_number/type.h"
 #include "core/model/table/block_dataset_stream.h"
@@ -21,27 +26,47 @@ namespace model {
 
 using PartitionReader = DomainPartition::PartitionReader;
 
+namespace {
+/* swap files store their numbers as LEB128 varints */
+void WriteVarint(std::ostream& out, std::uint64_t number) {
+    while (number >= 0x80) {
+        out.put(static_cast<char>((number & 0x7F) | 0x80));
+        number >>= 7;
+    }
+    out.put(static_cast<char>(number));
+}
+
+std::uint64_t ReadVarint(std::istream& in) {
+    std::uint64_t number = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        int const byte = in.get();
+        if (byte == std::istream::traits_type::eof() || shift > 63) {
+            throw std::runtime_error("Swap file is corrupted");
+        }
+        number |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return number;
+    }
+}
+}  // namespace
+
 /// reader for reading data from main memory
 class MemoryBackedReader final : public PartitionReader {
-public:
-    using Values = DomainPartition::Values;
-
 private:
-    using It = Values::iterator;
-
-    It cur_, end_;
+    DomainPartition const& partition_;
+    size_t cur_, end_;
 
 public:
-    explicit MemoryBackedReader(Values const& values) : cur_(values.begin()), end_(values.end()) {
-        assert(cur_ != end_);
+    MemoryBackedReader(DomainPartition const& partition, size_t begin, size_t end)
+        : partition_(partition), cur_(begin), end_(end) {
+        assert(partition_.IsCompact() && cur_ < end_ && end_ <= partition_.refs_.size());
     }
 
-    Value const& GetValue() const noexcept final {
-        return *cur_;
+    Value GetValue() const noexcept final {
+        return partition_.GetValue(partition_.refs_[cur_]);
     }
 
     bool HasNext() const noexcept final {
-        return std::next(cur_) != end_;
+        return cur_ + 1 != end_;
     }
 
     void MoveToNext() final {
@@ -53,26 +78,73 @@ public:
 class FileBackedReader final : public PartitionReader {
 private:
     std::ifstream file_;
-    Value cur_;
+    std::uint64_t remaining_; /* values in the file after next_ */
+    std::string cur_;
+    std::string next_;
+    bool has_next_ = false;
+    bool empty_ = true;
+    std::optional<std::string> upper_;
+
+    /* read the value after cur_ to next_, returns false at the end of the file */
+    bool ReadNext() {
+        if (remaining_ == 0) return false;
+        --remaining_;
+        /* the value shares a prefix with the previous one, only the rest of it is stored */
+        std::uint64_t const shared = ReadVarint(file_);
+        std::uint64_t const rest = ReadVarint(file_);
+        if (shared > cur_.size()) {
+            throw std::runtime_error("Swap file is corrupted");
+        }
+        next_.assign(cur_, 0, shared);
+        next_.resize(shared + rest);
+        if (!file_.read(next_.data() + shared, static_cast<std::streamsize>(rest))) {
+            throw std::runtime_error("Swap file is corrupted");
+        }
+        return true;
+    }
+
+    bool IsBelowUpper(std::string const& value) const {
+        return !upper_ || value < *upper_;
+    }
 
 public:
-    explicit FileBackedReader(std::filesystem::path const& path) : file_(path) {
+    /// read the values of `range` out of the `count` last values of the file, which start at
+    /// `offset` with a value that is stored whole and is not greater than the range values
+    FileBackedReader(std::filesystem::path const& path, std::uint64_t offset, std::uint64_t count,
+                     DomainValueRange const& range)
+        : file_(path, std::ios::binary), remaining_(count), upper_(range.upper) {
         if (!file_.is_open()) {
             throw std::runtime_error("Error opening file");
         }
-        MoveToNext();
+        file_.seekg(static_cast<std::streamoff>(offset));
+        bool found;
+        while ((found = ReadNext()) && range.lower && next_ < *range.lower) {
+            std::swap(cur_, next_);
+        }
+        empty_ = !found || !IsBelowUpper(next_);
+        if (!empty_) {
+            has_next_ = true;
+            MoveToNext();
+        }
+    }
+
+    /// check if there are no values in the range
+    bool IsEmpty() const noexcept {
+        return empty_;
     }
 
-    Value const& GetValue() const final {
+    Value GetValue() const noexcept final {
         return cur_;
     }
 
-    bool HasNext() const final {
-        return !file_.eof();
+    bool HasNext() const noexcept final {
+        return has_next_;
     }
 
     void MoveToNext() final {
-        std::getline(file_, cur_);
+        assert(has_next_);
+        std::swap(cur_, next_);
+        has_next_ = ReadNext() && IsBelowUpper(next_);
     }
 };
 
@@ -82,37 +154,87 @@ DomainPartition::~DomainPartition() {
     }
 }
 
-std::unique_ptr<PartitionReader> DomainPartition::GetReader() const {
+std::unique_ptr<PartitionReader> DomainPartition::GetReader(DomainValueRange const& range) const {
     if (IsSwapped()) {
-        return std::make_unique<FileBackedReader>(*swap_file_);
-    } else {
-        return std::make_unique<MemoryBackedReader>(values_);
+        /* the last fence not greater than the lower bound */
+        auto fence = fences_.begin();
+        if (range.lower) {
+            fence = std::upper_bound(fences_.begin(), fences_.end(), *range.lower,
+                                     [](std::string const& value, Fence const& fence) {
+                                         return value < fence.value;
+                                     });
+            if (fence != fences_.begin()) --fence;
+        }
+        auto reader = std::make_unique<FileBackedReader>(*swap_file_, fence->offset,
+                                                         swapped_count_ - fence->index, range);
+        if (reader->IsEmpty()) return nullptr;
+        return reader;
     }
-}
 
-size_t DomainPartition::GetMemoryUsage() const noexcept {
-    /* in reality, node in std::set uses 2.2 more memory than the presented estimate */
-    static constexpr double kAverageOverhead = 2.2;
-
-    if (IsSwapped()) return 0;
+    assert(IsCompact());
+    auto const lower_bound = [this](std::optional<std::string> const& bound, size_t none) {
+        if (!bound) return none;
+        auto const it = std::lower_bound(
+                refs_.begin(), refs_.end(), *bound,
+                [this](ValueRef ref, std::string const& value) { return GetValue(ref) < value; });
+        return static_cast<size_t>(it - refs_.begin());
+    };
+    size_t const begin = lower_bound(range.lower, 0);
+    size_t const end = lower_bound(range.upper, refs_.size());
+    if (begin >= end) return nullptr;
+    return std::make_unique<MemoryBackedReader>(*this, begin, end);
+}
 
-    size_t const data_total_size = std::accumulate(
-            values_.begin(), values_.end(), 0UL, [](size_t acc, std::string const& str) {
-                /*
-                 * if the string is small enough, then the SSO works
-                 * and the memory is not allocated on the heap
-                 */
-                return acc + (str.size() != str.capacity() ? 0 : str.capacity());
-            });
+std::vector<DomainPartition::Value> DomainPartition::GetSampleValues() const {
+    std::vector<Value> samples;
+    if (IsSwapped()) {
+        for (Fence const& fence : fences_) {
+            samples.push_back(fence.value);
+        }
+        return samples;
+    }
+    assert(IsCompact());
+    for (size_t i = 0; i < refs_.size(); i += kFenceInterval) {
+        samples.push_back(GetValue(refs_[i]));
+    }
+    return samples;
+}
 
-    size_t const node_size =
-            values_.size() * (sizeof(std::string) + sizeof(Values::node_type)) * kAverageOverhead;
+void DomainPartition::Compact() {
+    if (IsCompact()) return;
+    auto const less = [this](ValueRef lhs, ValueRef rhs) {
+        return GetValue(lhs) < GetValue(rhs);
+    };
+    auto const equal = [this](ValueRef lhs, ValueRef rhs) {
+        return GetValue(lhs) == GetValue(rhs);
+    };
+    auto const unsorted = refs_.begin() + static_cast<std::ptrdiff_t>(sorted_count_);
+    std::sort(unsorted, refs_.end(), less);
+    std::inplace_merge(refs_.begin(), unsorted, refs_.end(), less);
+    refs_.erase(std::unique(refs_.begin(), refs_.end(), equal), refs_.end());
+    refs_.shrink_to_fit();
+
+    /* copy the distinct values in order, the arena of the duplicates is freed */
+    std::string arena;
+    arena.reserve(std::accumulate(refs_.begin(), refs_.end(), 0UL,
+                                  [](size_t acc, ValueRef ref) { return acc + ref.size; }));
+    for (ValueRef& ref : refs_) {
+        Value const value = GetValue(ref);
+        ref.offset = arena.size();
+        arena.append(value);
+    }
+    arena_ = std::move(arena);
+    sorted_count_ = refs_.size();
+}
 
-    return node_size + data_total_size;
+size_t DomainPartition::GetMemoryUsage() const noexcept {
+    if (IsSwapped()) return 0;
+    return arena_.capacity() + refs_.capacity() * sizeof(ValueRef);
 }
 
 bool DomainPartition::TrySwap() {
     namespace fs = std::filesystem;
+    Compact();
     if (IsNULL() || IsSwapped()) {
         return false;
     }
@@ -120,20 +242,39 @@ bool DomainPartition::TrySwap() {
     fs::path const file_path = fs::path{kTmpDir} /
                                (std::to_string(GetTableId()) + "." + std::to_string(GetColumnId()) +
                                 "." + std::to_string(GetPartitionId()));
-    std::ofstream file{file_path};
+    std::ofstream file{file_path, std::ios::binary};
     if (!file.is_open()) {
         LOG_ERROR("unable to open file for swapping");
         throw std::runtime_error("Cannot open file for swapping");
     }
 
-    for (auto it = values_.begin(); it != values_.end(); ++it) {
-        file << *it;
-        if (std::next(it) != values_.end()) {
-            file << '\n';
+    fences_.clear();
+    Value prev;
+    for (size_t i = 0; i != refs_.size(); ++i) {
+        Value const value = GetValue(refs_[i]);
+        size_t shared = 0;
+        if (i % kFenceInterval == 0) {
+            fences_.push_back({std::string{value}, i, static_cast<std::uint64_t>(file.tellp())});
+        } else {
+            shared = std::mismatch(prev.begin(), prev.end(), value.begin(), value.end()).first -
+                     prev.begin();
         }
+        WriteVarint(file, shared);
+        WriteVarint(file, value.size() - shared);
+        file.write(value.data() + shared, static_cast<std::streamsize>(value.size() - shared));
+        prev = value;
     }
     file.close();
-    values_.clear();
+    if (!file) {
+        LOG_ERROR("unable to write swap file");
+        throw std::runtime_error("Cannot write swap file");
+    }
+    swapped_count_ = refs_.size();
+    arena_.clear();
+    arena_.shrink_to_fit();
+    refs_.clear();
+    refs_.shrink_to_fit();
+    sorted_count_ = 0;
     swap_file_ = std::make_unique<fs::path>(file_path);
     return true;
 }
@@ -157,13 +298,18 @@ private:
     size_t processed_block_count_{};         /* count of processed blocks in current table */
     size_t swap_candidate_{};                /* next domain candidate to swap  */
 
+    /* memory usage of current table domains */
+    size_t GetRawDomainsMemUsage() const {
+        return std::accumulate(raw_domains_.begin(), raw_domains_.end(), 0UL,
+                               [](size_t acc, DomainRawData const& raw_domain) {
+                                   /* only last partition isn't swapped */
+                                   return acc + raw_domain.back().GetMemoryUsage();
+                               });
+    }
+
     /* recalculate memory usage */
     void RefreshMemUsage() {
-        mem_usage_ = std::accumulate(raw_domains_.begin(), raw_domains_.end(), 0UL,
-                                     [](size_t acc, DomainRawData const& raw_domain) {
-                                         /* only last partition isn't swapped */
-                                         return acc + raw_domain.back().GetMemoryUsage();
-                                     });
+        mem_usage_ = GetRawDomainsMemUsage();
         mem_usage_ += std::accumulate(
                 domains_.begin(), domains_.end(), 0UL,
                 [](size_t acc, Domain const& domain) { return acc + domain.GetMemoryUsage(); });
@@ -176,8 +322,9 @@ private:
                     static_cast<size_t>(Partition::kMaximumBytesPerChar * block_capacity_);
             return std::max(1UL, mem_limit_ / approx_block_count);
         }
+        if (mem_usage_ >= mem_limit_) return 0;
         /* otherwise, use the average amount of memory spent per processed block */
-        size_t const per_block_mem_usage = mem_usage_ / processed_block_count_;
+        size_t const per_block_mem_usage = std::max(1UL, mem_usage_ / processed_block_count_);
         return (mem_limit_ - mem_usage_) / per_block_mem_usage;
     }
 
@@ -188,11 +335,36 @@ private:
         RefreshMemUsage();
         size_t block_count;
         while ((block_count = GetApproximateBlockCount()) == 0) {
-            SwapNext();
+            /* dropping the duplicates is cheaper than swapping, but is not worth repeating
+             * for the domains it has freed little memory of */
+            if (!TryCompact()) {
+                SwapNext();
+            }
         }
         return block_count;
     }
 
+    /* sort current table domains and drop their duplicates */
+    void CompactRawDomains() {
+        util::ParallelForeach(raw_domains_.begin(), raw_domains_.end(), threads_num_,
+                              [](DomainRawData& raw_domain) { raw_domain.back().Compact(); });
+    }
+
+    /* compact current table domains and refresh memory usage,
+     * returns true if at least half of their memory has been freed
+     */
+    bool TryCompact() {
+        bool const all_compact = std::all_of(raw_domains_.begin(), raw_domains_.end(),
+                                             [](DomainRawData const& raw_domain) {
+                                                 return raw_domain.back().IsCompact();
+                                             });
+        if (all_compact) return false;
+        size_t const raw_mem_usage = GetRawDomainsMemUsage();
+        CompactRawDomains();
+        RefreshMemUsage();
+        return GetRawDomainsMemUsage() <= raw_mem_usage / 2;
+    }
+
     /* swap next candidate and refresh memory usage */
     void SwapNext() {
         /* first, try to swap the domain, if there are any */
@@ -225,7 +397,7 @@ private:
                 Partition& partition = raw_domain.back();
                 auto it = block.GetColumn(partition.GetColumnId()).GetIt();
                 do {
-                    partition.Insert(std::string{it.GetValue()});
+                    partition.Insert(it.GetValue());
                 } while (it.TryMoveToNext());
             };
             util::ParallelForeach(raw_domains_.begin(), raw_domains_.end(), threads_num_,
@@ -279,6 +451,7 @@ public:
             block_count = GetNumberOfBlocks();
         } while (ProcessNext(block_stream, block_count));
 
+        CompactRawDomains();
         for (DomainRawData& raw_domain : raw_domains_) {
             /*
              * we do not work with columns that consist entirely of nulls.
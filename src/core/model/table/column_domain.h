@@ -6,12 +6,14 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <list>
 #include <memory>
 #include <numeric>
-#include <set>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "core/config/mem_limit/type.h"
@@ -23,11 +25,24 @@ namespace model {
 
 using PartitionIndex = unsigned int;
 
-/// column domain partition storing values in sorted order
+/// range of domain values, a bound that is not set does not limit the range
+struct DomainValueRange {
+    std::optional<std::string> lower; /* inclusive */
+    std::optional<std::string> upper; /* exclusive */
+};
+
+///
+/// @brief column domain partition storing values in sorted order
+///
+/// The values are appended to a flat arena as they come and are only sorted, and their
+/// duplicates dropped, by `Compact`. A swapped partition is a sorted run on disk, each value
+/// stored as the length of the prefix it shares with the previous one and the rest of it.
+/// Every kFenceInterval-th value is stored whole and kept in memory as a fence along with its
+/// position in the file, so that reading a range of values starts at the fence before it.
+///
 class DomainPartition {
 public:
-    using Value = std::string;
-    using Values = std::set<Value>;
+    using Value = std::string_view;
 
     ///
     /// @brief abstract reader class for receiving partition values
@@ -44,7 +59,8 @@ public:
         PartitionReader() = default;
         virtual ~PartitionReader() = default;
 
-        virtual Value const& GetValue() const = 0;
+        /// the value stays valid until the reader is moved
+        virtual Value GetValue() const = 0;
         virtual bool HasNext() const = 0;
         virtual void MoveToNext() = 0;
 
@@ -54,17 +70,41 @@ public:
     };
 
 private:
+    friend class MemoryBackedReader;
+
     struct PartitionInfo {
         TableIndex table_id;
         ColumnIndex column_id;
         PartitionIndex partition_id;
     };
 
+    /* value position in the arena */
+    struct ValueRef {
+        std::uint64_t offset;
+        std::uint32_t size;
+    };
+
+    /* value of a swapped partition stored whole */
+    struct Fence {
+        std::string value;
+        std::uint64_t index;  /* index of the value in the partition */
+        std::uint64_t offset; /* position of the value in the swap file */
+    };
+
     PartitionInfo info_;
-    Values values_;
+    std::string arena_;          /* chars of the values one after another */
+    std::vector<ValueRef> refs_; /* inserted values */
+    size_t sorted_count_ = 0;    /* refs_ before this index are sorted and distinct */
     std::unique_ptr<std::filesystem::path> swap_file_;
+    std::uint64_t swapped_count_ = 0; /* values in the swap file */
+    std::vector<Fence> fences_;
 
     static constexpr std::string_view kTmpDir = "tmp";
+    static constexpr size_t kFenceInterval = 1024;
+
+    Value GetValue(ValueRef ref) const noexcept {
+        return Value{arena_}.substr(ref.offset, ref.size);
+    }
 
 public:
     DomainPartition(TableIndex table_id, ColumnIndex column_id, PartitionIndex partition_id = 0)
@@ -73,12 +113,22 @@ public:
     ~DomainPartition();
 
     /// how many bytes partition takes to store one char in the partition
-    /// this value was obtained experimentally, the worst case is presented
-    static constexpr double kMaximumBytesPerChar = 16.0;
+    /// worst case: a value of one char takes two chars of a block with its delimiter, and one
+    /// byte of the arena and a reference, both may take twice as much with the unused capacity
+    static constexpr double kMaximumBytesPerChar = 1.0 + sizeof(ValueRef);
 
     /// insert new value to partition
-    void Insert(Value const& value) {
-        values_.insert(value);
+    void Insert(Value value) {
+        refs_.push_back({arena_.size(), static_cast<std::uint32_t>(value.size())});
+        arena_.append(value);
+    }
+
+    /// sort the values inserted since the last call and drop the duplicates
+    void Compact();
+
+    /// check if the values are sorted and distinct
+    bool IsCompact() const noexcept {
+        return sorted_count_ == refs_.size();
     }
 
     /// get table index
@@ -101,8 +151,8 @@ public:
     /// a partition is not null if and only if it contains
     /// non-null values (null value is empty string)
     bool IsNULL() const noexcept {
-        return (values_.empty() || (values_.size() == 1 && values_.begin()->empty())) &&
-               !IsSwapped();
+        assert(IsCompact());
+        return (refs_.empty() || (refs_.size() == 1 && refs_.front().size == 0)) && !IsSwapped();
     }
 
     /// get memory usage in bytes
@@ -115,8 +165,15 @@ public:
         return static_cast<bool>(swap_file_);
     }
 
-    /// create partition reader
-    std::unique_ptr<PartitionReader> GetReader() const;
+    ///
+    /// @brief create partition reader for the values in `range`
+    ///
+    /// the partition must be compact, returns nullptr if there are no values in the range
+    ///
+    std::unique_ptr<PartitionReader> GetReader(DomainValueRange const& range = {}) const;
+
+    /// get every kFenceInterval-th value in sorted order, a sample of the partition values
+    std::vector<Value> GetSampleValues() const;
 };
 
 /// represents a column domain
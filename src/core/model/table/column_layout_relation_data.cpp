@@ -4,11 +4,21 @@
 //
 #include "core/model/table/column_layout_relation_data.h"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
+#include "core/model/table/encoded_relation_cache.h"
+#include "core/model/table/snapshot_dataset_stream.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
+#include "core/util/string_hash.h"
 
 std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
     int num_columns = schema_->GetNumColumns();
@@ -19,6 +29,111 @@ std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
     return tuple;
 }
 
+namespace {
+
+using ValueDictionary = std::unordered_map<std::string, int, util::StringHash, std::equal_to<>>;
+
+/* Dictionary encoding of a consecutive range of rows. Every column has its own dictionary, so
+ * value ids only have to be consistent within a column for the PLIs to come out right. */
+class EncodedPart {
+private:
+    std::vector<ValueDictionary> dictionaries_;
+    /* Values of the column by their ids, point into the keys of the column's dictionary */
+    std::vector<std::vector<std::string const*>> values_;
+    std::vector<std::vector<int>> columns_;
+
+public:
+    EncodedPart(model::IDatasetStream& data_stream, size_t num_columns)
+        : dictionaries_(num_columns), values_(num_columns), columns_(num_columns) {
+        model::IDatasetStream::RowView row;
+        model::IDatasetStream::Row row_buffer;
+
+        while (data_stream.HasNextRow()) {
+            data_stream.GetNextRowView(row, row_buffer);
+
+            if (row.size() != num_columns) {
+                LOG_WARN(
+                        "Unexpected number of columns for a row, "
+                        "skipping (expected {}, got {})",
+                        num_columns, row.size());
+                continue;
+            }
+
+            for (size_t index = 0; index < row.size(); ++index) {
+                std::string_view const field = row[index];
+                ValueDictionary& dictionary = dictionaries_[index];
+                auto location = dictionary.find(field);
+                if (location == dictionary.end()) {
+                    location = dictionary.emplace(field, values_[index].size()).first;
+                    values_[index].push_back(&location->first);
+                }
+                columns_[index].push_back(location->second);
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> TakeColumns() {
+        return std::move(columns_);
+    }
+
+    std::vector<int> const& GetColumn(size_t index) const {
+        return columns_[index];
+    }
+
+    std::vector<std::string const*> const& GetValues(size_t index) const {
+        return values_[index];
+    }
+
+    void ReleaseColumn(size_t index) {
+        std::vector<int>().swap(columns_[index]);
+    }
+};
+
+/* Encodes the parts concurrently and then merges their dictionaries column by column. The ids
+ * are assigned in the order of the parts, so the result does not depend on the thread count. */
+std::vector<std::vector<int>> EncodeParts(
+        std::vector<std::unique_ptr<model::IDatasetStream>> const& streams, size_t num_columns,
+        config::ThreadNumType threads_num) {
+    std::vector<size_t> part_indices(streams.size());
+    std::iota(part_indices.begin(), part_indices.end(), 0);
+    std::vector<std::optional<EncodedPart>> parts(streams.size());
+    util::ParallelForeach(part_indices.begin(), part_indices.end(), threads_num, [&](size_t i) {
+        parts[i].emplace(*streams[i], num_columns);
+    });
+
+    std::vector<size_t> column_indices(num_columns);
+    std::iota(column_indices.begin(), column_indices.end(), 0);
+    std::vector<std::vector<int>> column_vectors(num_columns);
+    util::ParallelForeach(
+            column_indices.begin(), column_indices.end(), threads_num, [&](size_t column) {
+                size_t num_rows = 0;
+                for (std::optional<EncodedPart> const& part : parts) {
+                    num_rows += part->GetColumn(column).size();
+                }
+                std::vector<int>& column_vector = column_vectors[column];
+                column_vector.reserve(num_rows);
+
+                std::unordered_map<std::string_view, int> value_ids;
+                std::vector<int> id_remap;
+                for (std::optional<EncodedPart>& part : parts) {
+                    std::vector<std::string const*> const& values = part->GetValues(column);
+                    id_remap.resize(values.size());
+                    for (size_t local_id = 0; local_id < values.size(); ++local_id) {
+                        id_remap[local_id] =
+                                value_ids.try_emplace(*values[local_id], value_ids.size())
+                                        .first->second;
+                    }
+                    for (int local_id : part->GetColumn(column)) {
+                        column_vector.push_back(id_remap[local_id]);
+                    }
+                    part->ReleaseColumn(column);
+                }
+            });
+    return column_vectors;
+}
+
+}  // namespace
+
 std::shared_ptr<model::PLI const> ColumnLayoutRelationData::CalculatePLI(
         std::vector<unsigned int> const& indices) const {
     if (indices.size() <= 0) throw std::invalid_argument("received unpositive number of indices");
@@ -44,47 +159,81 @@ std::shared_ptr<model::PLIWS const> ColumnLayoutRelationData::CalculatePLIWS(
 }
 
 std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
-        model::IDatasetStream& data_stream) {
+        model::IDatasetStream& data_stream, config::ThreadNumType threads_num) {
+    if (auto* snapshot_stream = dynamic_cast<model::SnapshotDatasetStream*>(&data_stream)) {
+        if (model::RelationSnapshot const* snapshot = snapshot_stream->ReadWhole()) {
+            return CreateFrom(*snapshot, threads_num);
+        }
+    }
+
     auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
-    std::unordered_map<std::string, int> value_dictionary;
-    int next_value_id = 0;
     size_t const num_columns = data_stream.GetNumberOfColumns();
-    std::vector<std::vector<int>> column_vectors = std::vector<std::vector<int>>(num_columns);
-    std::vector<std::string> row;
-
-    while (data_stream.HasNextRow()) {
-        row = data_stream.GetNextRow();
-
-        if (row.size() != num_columns) {
-            LOG_WARN(
-                    "Unexpected number of columns for a row, "
-                    "skipping (expected {}, got {})",
-                    num_columns, row.size());
-            continue;
-        }
 
-        for (size_t index = 0; index < row.size(); ++index) {
-            std::string const& field = row[index];
-            auto location = value_dictionary.find(field);
-            int value_id;
-            if (location == value_dictionary.end()) {
-                value_dictionary[field] = next_value_id;
-                value_id = next_value_id;
-                next_value_id++;
-            } else {
-                value_id = location->second;
-            }
-            column_vectors[index].push_back(value_id);
-        }
+    std::vector<std::unique_ptr<model::IDatasetStream>> parts;
+    if (threads_num > 1) {
+        parts = data_stream.SplitRows(threads_num);
     }
+    std::vector<std::vector<int>> column_vectors =
+            parts.size() > 1 ? EncodeParts(parts, num_columns, threads_num)
+                             : EncodedPart(data_stream, num_columns).TakeColumns();
+
+    std::vector<size_t> column_indices(num_columns);
+    std::iota(column_indices.begin(), column_indices.end(), 0);
+    std::vector<std::unique_ptr<model::PLIWithSingletons>> plis(num_columns);
+    unsigned const pli_threads_num = std::max<unsigned>(threads_num, 1);
+    util::ParallelForeach(column_indices.begin(), column_indices.end(), pli_threads_num,
+                          [&](size_t i) {
+                              plis[i] = model::PLIWithSingletons::CreateFor(column_vectors[i]);
+                              std::vector<int>().swap(column_vectors[i]);
+                          });
 
     std::vector<ColumnData> column_data;
     for (size_t i = 0; i < num_columns; ++i) {
         auto column = Column(schema.get(), data_stream.GetColumnName(i), i);
         schema->AppendColumn(std::move(column));
-        auto pli = model::PLIWithSingletons::CreateFor(column_vectors[i]);
-        column_data.emplace_back(schema->GetColumn(i), std::move(pli));
+        column_data.emplace_back(schema->GetColumn(i), std::move(plis[i]));
     }
 
     return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
 }
+
+std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
+        model::RelationSnapshot const& snapshot, config::ThreadNumType threads_num) {
+    std::unique_ptr<RelationalSchema> schema = snapshot.CreateSchema();
+    size_t const num_columns = snapshot.GetNumColumns();
+
+    std::vector<size_t> column_indices(num_columns);
+    std::iota(column_indices.begin(), column_indices.end(), 0);
+    std::vector<std::optional<ColumnData>> restored(num_columns);
+    util::ParallelForeach(column_indices.begin(), column_indices.end(),
+                          std::max<unsigned>(threads_num, 1), [&](size_t i) {
+                              restored[i].emplace(schema->GetColumn(i), snapshot.CreatePli(i));
+                          });
+
+    std::vector<ColumnData> column_data;
+    column_data.reserve(num_columns);
+    for (std::optional<ColumnData>& data : restored) {
+        column_data.push_back(std::move(*data));
+    }
+    return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
+}
+
+std::shared_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateCachedFrom(
+        model::IDatasetStream& data_stream, config::ThreadNumType threads_num) {
+    // The encoding does not depend on the number of threads, so it is not a part of the variant
+    return model::EncodedRelationCache::Instance().GetOrCreate<ColumnLayoutRelationData>(
+            data_stream, "",
+            [threads_num](model::IDatasetStream& stream) {
+                return std::shared_ptr<ColumnLayoutRelationData>(CreateFrom(stream, threads_num));
+            },
+            [](ColumnLayoutRelationData const& relation) {
+                // Probing tables and clusters of the column PLIs
+                std::size_t size = 0;
+                for (ColumnData const& column : relation.GetColumnData()) {
+                    model::PositionListIndex const* pli = column.GetPositionListIndex();
+                    size += (relation.GetNumRows() + pli->GetSize()) * sizeof(int) +
+                            pli->GetIndex().size() * sizeof(model::PositionListIndex::Cluster);
+                }
+                return size;
+            });
+}
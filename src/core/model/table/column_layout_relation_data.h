@@ -6,14 +6,20 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <vector>
 
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_data.h"
 #include "core/model/table/idataset_stream.h"
 #include "core/model/table/position_list_index_with_singletons.h"
 #include "core/model/table/relation_data.h"
 #include "core/model/table/relational_schema.h"
 
+namespace model {
+class RelationSnapshot;
+}  // namespace model
+
 class ColumnLayoutRelationData final : public RelationData {
 public:
     using RelationData::AbstractRelationData;
@@ -33,5 +39,17 @@ public:
     [[nodiscard]] std::shared_ptr<model::PLIWS const> CalculatePLIWS(
             std::vector<unsigned int> const& indices) const;
 
-    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(model::IDatasetStream& data_stream);
+    /* Rows are encoded by `threads_num` threads if the stream can be split (see
+     * IDatasetStream::SplitRows), the result does not depend on the number of threads. An unread
+     * SnapshotDatasetStream is restored from its snapshot instead */
+    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(
+            model::IDatasetStream& data_stream, config::ThreadNumType threads_num = 1);
+
+    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(
+            model::RelationSnapshot const& snapshot, config::ThreadNumType threads_num = 1);
+
+    /* Same as CreateFrom, but the relation is taken from model::EncodedRelationCache if the table
+     * has already been encoded by another algorithm, so it must not be modified */
+    static std::shared_ptr<ColumnLayoutRelationData> CreateCachedFrom(
+            model::IDatasetStream& data_stream, config::ThreadNumType threads_num = 1);
 };
@@ -1,5 +1,9 @@
 #include "core/model/table/column_layout_typed_relation_data.h"
 
+#include <cstddef>
+#include <string>
+
+#include "core/model/table/encoded_relation_cache.h"
 #include "core/util/logger.h"
 
 namespace model {
@@ -10,13 +14,14 @@ std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::Cr
     size_t const num_columns = data_stream.GetNumberOfColumns();
 
     std::vector<std::vector<std::string>> columns(num_columns);
-    std::vector<std::string> row;
+    IDatasetStream::RowView row;
+    IDatasetStream::Row row_buffer;
 
     /* Parsing is very similar to ColumnLayoutRelationData::CreateFrom().
      * Maybe we need column-based parsing in addition to row-based in CSVParser
      * (now IDatasetStream) */
     while (data_stream.HasNextRow()) {
-        row = data_stream.GetNextRow();
+        data_stream.GetNextRowView(row, row_buffer);
 
         if (row.size() != num_columns) {
             LOG_WARN(
@@ -27,8 +32,7 @@ std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::Cr
         }
 
         for (size_t index = 0; index < row.size(); ++index) {
-            std::string& field = row[index];
-            columns[index].push_back(std::move(field));
+            columns[index].emplace_back(row[index]);
         }
     }
 
@@ -46,4 +50,32 @@ std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::Cr
                                                            std::move(column_data));
 }
 
+std::shared_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::CreateCachedFrom(
+        IDatasetStream& data_stream, bool is_null_eq_null, bool treat_mixed_as_string) {
+    std::string variant = is_null_eq_null ? "null = null" : "null != null";
+    if (treat_mixed_as_string) variant += ", mixed as string";
+    return EncodedRelationCache::Instance().GetOrCreate<ColumnLayoutTypedRelationData>(
+            data_stream, variant,
+            [is_null_eq_null, treat_mixed_as_string](IDatasetStream& stream) {
+                return std::shared_ptr<ColumnLayoutTypedRelationData>(
+                        CreateFrom(stream, is_null_eq_null, treat_mixed_as_string));
+            },
+            [](ColumnLayoutTypedRelationData const& relation) {
+                // Value pointers and the buffers of the values, strings are counted without their
+                // characters. A mixed value is a type id and a value, at most a string.
+                std::size_t size = 0;
+                for (TypedColumnData const& column : relation.GetColumnData()) {
+                    std::size_t const num_values =
+                            column.GetNumRows() - column.GetNumNulls() - column.GetNumEmpties();
+                    std::size_t const value_size = column.IsMixed()
+                                                           ? alignof(std::max_align_t) +
+                                                                     sizeof(std::string)
+                                                           : column.GetType().GetSize();
+                    size += column.GetNumRows() * sizeof(std::byte const*) +
+                            num_values * value_size;
+                }
+                return size;
+            });
+}
+
 }  // namespace model
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "core/model/table/idataset_stream.h"
 #include "core/model/table/relation_data.h"
 #include "core/model/table/typed_column_data.h"
@@ -23,6 +25,13 @@ public:
     static std::unique_ptr<ColumnLayoutTypedRelationData> CreateFrom(
             model::IDatasetStream& data_stream, bool is_null_eq_null,
             bool treat_mixed_as_string = false);
+
+    /* Same as CreateFrom, but the relation is taken from EncodedRelationCache if the table has
+     * already been encoded with the same options by another algorithm, so it must not be
+     * modified */
+    static std::shared_ptr<ColumnLayoutTypedRelationData> CreateCachedFrom(
+            model::IDatasetStream& data_stream, bool is_null_eq_null,
+            bool treat_mixed_as_string = false);
 };
 
 }  // namespace model
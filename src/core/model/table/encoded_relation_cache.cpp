@@ -0,0 +1,80 @@
+#include "core/model/table/encoded_relation_cache.h"
+
+#include <algorithm>
+
+namespace model {
+
+EncodedRelationCache& EncodedRelationCache::Instance() {
+    static EncodedRelationCache cache;
+    return cache;
+}
+
+std::shared_ptr<void> EncodedRelationCache::Find(std::string const& identity, std::type_index type,
+                                                 std::string const& variant) {
+    std::scoped_lock lock(mutex_);
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&](Entry const& entry) {
+        return entry.type == type && entry.identity == identity && entry.variant == variant;
+    });
+    if (it == entries_.end()) return nullptr;
+    entries_.splice(entries_.begin(), entries_, it);
+    return it->data;
+}
+
+std::shared_ptr<void> EncodedRelationCache::Insert(Entry entry) {
+    std::scoped_lock lock(mutex_);
+    // Another algorithm may have encoded the same table meanwhile
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&](Entry const& cached) {
+        return cached.type == entry.type && cached.identity == entry.identity &&
+               cached.variant == entry.variant;
+    });
+    if (it != entries_.end()) {
+        entries_.splice(entries_.begin(), entries_, it);
+        return it->data;
+    }
+    if (entry.size > memory_budget_) {
+        return std::move(entry.data);
+    }
+    memory_usage_ += entry.size;
+    entries_.push_front(std::move(entry));
+    EvictUnused();
+    return entries_.front().data;
+}
+
+void EncodedRelationCache::EvictUnused() {
+    for (auto it = entries_.end(); memory_usage_ > memory_budget_ && it != entries_.begin();) {
+        --it;
+        if (it->data.use_count() == 1) {
+            memory_usage_ -= it->size;
+            it = entries_.erase(it);
+        }
+    }
+}
+
+void EncodedRelationCache::SetMemoryBudget(std::size_t bytes) {
+    std::scoped_lock lock(mutex_);
+    memory_budget_ = bytes;
+    EvictUnused();
+}
+
+std::size_t EncodedRelationCache::GetMemoryBudget() const {
+    std::scoped_lock lock(mutex_);
+    return memory_budget_;
+}
+
+std::size_t EncodedRelationCache::GetMemoryUsage() const {
+    std::scoped_lock lock(mutex_);
+    return memory_usage_;
+}
+
+std::size_t EncodedRelationCache::GetNumEntries() const {
+    std::scoped_lock lock(mutex_);
+    return entries_.size();
+}
+
+void EncodedRelationCache::Clear() {
+    std::scoped_lock lock(mutex_);
+    entries_.clear();
+    memory_usage_ = 0;
+}
+
+}  // namespace model
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+#include "core/model/table/idataset_stream.h"
+
+namespace model {
+
+/* Process-wide cache of the data that algorithms encode from their input tables, so that
+ * algorithms executed one after another on the same table encode it only once.
+ *
+ * An entry is keyed by the identity of the table (see IDatasetStream::GetDataIdentity), the type
+ * of the encoded data and a variant that describes the options of the encoding. Tables without an
+ * identity are not cached. The cached data is shared by all the algorithms that use it, so it must
+ * not be modified.
+ *
+ * The cache holds at most GetMemoryBudget() bytes of data as estimated by the creators of the
+ * entries. When the budget is exceeded, entries that no algorithm uses are evicted, least
+ * recently used first. Entries that are in use are kept, evicting them would not free any memory.
+ * The budget is 0 by default, which disables caching.
+ */
+class EncodedRelationCache {
+private:
+    struct Entry {
+        std::string identity;
+        std::type_index type;
+        std::string variant;
+        std::shared_ptr<void> data;
+        std::size_t size;
+    };
+
+    std::mutex mutable mutex_;
+    // The most recently used entry is the first one
+    std::list<Entry> entries_;
+    std::size_t memory_budget_ = 0;
+    std::size_t memory_usage_ = 0;
+
+    std::shared_ptr<void> Find(std::string const& identity, std::type_index type,
+                               std::string const& variant);
+    std::shared_ptr<void> Insert(Entry entry);
+    void EvictUnused();
+
+public:
+    static EncodedRelationCache& Instance();
+
+    // Evicts the unused entries that do not fit into the new budget
+    void SetMemoryBudget(std::size_t bytes);
+
+    std::size_t GetMemoryBudget() const;
+
+    // Estimated size of all the cached data, including the data that exceeds the budget
+    std::size_t GetMemoryUsage() const;
+
+    std::size_t GetNumEntries() const;
+
+    // Algorithms that use the evicted data keep it until they are destroyed
+    void Clear();
+
+    /* Returns the data of type T encoded from `stream` with the given variant of the options,
+     * calling create(stream) if it is not cached. `stream` must not have been read. The size of
+     * new data is estimated by estimate_size(data).
+     */
+    template <typename T, typename Create, typename EstimateSize>
+    std::shared_ptr<T> GetOrCreate(IDatasetStream& stream, std::string const& variant,
+                                   Create create, EstimateSize estimate_size) {
+        std::optional<std::string> identity = stream.GetDataIdentity();
+        if (!identity.has_value() || GetMemoryBudget() == 0) {
+            return create(stream);
+        }
+        std::type_index const type = typeid(T);
+        if (std::shared_ptr<void> cached = Find(*identity, type, variant)) {
+            return std::static_pointer_cast<T>(std::move(cached));
+        }
+        std::shared_ptr<T> data = create(stream);
+        std::size_t const size = estimate_size(static_cast<T const&>(*data));
+        return std::static_pointer_cast<T>(
+                Insert({std::move(*identity), type, variant, data, size}));
+    }
+};
+
+}  // namespace model
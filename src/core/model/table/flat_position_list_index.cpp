@@ -0,0 +1,247 @@
+#include "core/model/table/flat_position_list_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/pli_intersector.h"
+
+namespace model {
+
+namespace {
+
+/// Probing table of a thread, all of its entries are kSingletonValueId between the uses.
+std::vector<int>& GetProbingTableScratch(std::size_t size) {
+    thread_local std::vector<int> probing_table;
+    if (probing_table.size() < size) {
+        probing_table.resize(size, PositionListIndex::kSingletonValueId);
+    }
+    return probing_table;
+}
+
+}  // namespace
+
+FlatPositionListIndex::FlatPositionListIndex(std::pmr::vector<int> positions,
+                                             std::pmr::vector<unsigned int> offsets,
+                                             unsigned int relation_size)
+    : positions_(std::move(positions)),
+      offsets_(std::move(offsets)),
+      relation_size_(relation_size),
+      nep_(0) {
+    assert(!offsets_.empty() && offsets_.front() == 0 && offsets_.back() == positions_.size());
+    double key_gap = 0.0;
+    for (std::size_t i = 0; i + 1 < offsets_.size(); ++i) {
+        unsigned long long const cluster_size = offsets_[i + 1] - offsets_[i];
+        key_gap += cluster_size * std::log(cluster_size);
+        nep_ += cluster_size * (cluster_size - 1) / 2;
+    }
+    entropy_ = std::log(relation_size_) - key_gap / relation_size_;
+}
+
+std::unique_ptr<FlatPositionListIndex> FlatPositionListIndex::CreateFrom(
+        PositionListIndex const& pli, std::pmr::memory_resource* arena) {
+    std::pmr::vector<int> positions(arena);
+    std::pmr::vector<unsigned int> offsets(arena);
+    positions.reserve(pli.GetSize());
+    offsets.reserve(pli.GetNumNonSingletonCluster() + 1);
+    offsets.push_back(0);
+    for (PositionListIndex::Cluster const& cluster : pli.GetIndex()) {
+        positions.insert(positions.end(), cluster.begin(), cluster.end());
+        offsets.push_back(positions.size());
+    }
+    return std::make_unique<FlatPositionListIndex>(std::move(positions), std::move(offsets),
+                                                   pli.GetRelationSize());
+}
+
+std::unique_ptr<PositionListIndex> FlatPositionListIndex::ToPositionListIndex() const {
+    std::deque<PositionListIndex::Cluster> index;
+    for (Cluster cluster : GetIndex()) {
+        index.emplace_back(cluster.begin(), cluster.end());
+    }
+    return std::make_unique<PositionListIndex>(std::move(index), GetSize(), entropy_, nep_,
+                                               relation_size_);
+}
+
+std::unique_ptr<PLIWithSingletons> FlatPositionListIndex::ToPLIWithSingletons() const {
+    std::deque<PositionListIndex::Cluster> index;
+    std::vector<bool> is_clustered(relation_size_);
+    for (Cluster cluster : GetIndex()) {
+        index.emplace_back(cluster.begin(), cluster.end());
+        for (int position : cluster) {
+            is_clustered[position] = true;
+        }
+    }
+    std::deque<PositionListIndex::Cluster> singletons;
+    for (unsigned int position = 0; position < relation_size_; ++position) {
+        if (!is_clustered[position]) {
+            singletons.push_back({static_cast<int>(position)});
+        }
+    }
+    return std::make_unique<PLIWithSingletons>(std::move(index), std::move(singletons), GetSize(),
+                                               entropy_, nep_, relation_size_);
+}
+
+std::vector<int> FlatPositionListIndex::CalculateProbingTable() const {
+    std::vector<int> probing_table(relation_size_, PositionListIndex::kSingletonValueId);
+    FillProbingTable(probing_table);
+    return probing_table;
+}
+
+void FlatPositionListIndex::FillProbingTable(std::span<int> probing_table) const {
+    int next_cluster_id = PositionListIndex::kSingletonValueId + 1;
+    for (Cluster cluster : GetIndex()) {
+        int const value_id = next_cluster_id++;
+        for (int position : cluster) {
+            probing_table[position] = value_id;
+        }
+    }
+}
+
+void FlatPositionListIndex::ClearProbingTable(std::span<int> probing_table) const {
+    for (int position : positions_) {
+        probing_table[position] = PositionListIndex::kSingletonValueId;
+    }
+}
+
+std::unique_ptr<FlatPositionListIndex> FlatPositionListIndex::Assemble(
+        std::vector<int> const& positions,
+        std::vector<std::pair<unsigned int, unsigned int>>& clusters, unsigned int relation_size,
+        std::pmr::memory_resource* arena) {
+    auto const first_position = [&positions](std::pair<unsigned int, unsigned int> cluster) {
+        return positions[cluster.first];
+    };
+    std::ranges::sort(clusters, std::less<>{}, first_position);
+
+    // Sizes are known at this point, so an arena only gets one allocation of the exact size
+    std::pmr::vector<int> flat_positions(arena);
+    std::pmr::vector<unsigned int> offsets(arena);
+    flat_positions.reserve(positions.size());
+    offsets.reserve(clusters.size() + 1);
+    offsets.push_back(0);
+    for (auto [begin, end] : clusters) {
+        flat_positions.insert(flat_positions.end(), positions.begin() + begin,
+                              positions.begin() + end);
+        offsets.push_back(flat_positions.size());
+    }
+    return std::make_unique<FlatPositionListIndex>(std::move(flat_positions), std::move(offsets),
+                                                   relation_size);
+}
+
+std::unique_ptr<FlatPositionListIndex> FlatPositionListIndex::Intersect(
+        FlatPositionListIndex const& that, std::pmr::memory_resource* arena) const {
+    assert(relation_size_ == that.relation_size_);
+    if (arena == nullptr) arena = GetArena();
+
+    FlatPositionListIndex const& probed = GetSize() > that.GetSize() ? that : *this;
+    FlatPositionListIndex const& probing = GetSize() > that.GetSize() ? *this : that;
+    std::span<int> const probing_table = GetProbingTableScratch(relation_size_);
+    probing.FillProbingTable(probing_table);
+    std::unique_ptr<FlatPositionListIndex> intersection;
+    try {
+        intersection = probed.Probe(probing_table, arena);
+    } catch (...) {
+        probing.ClearProbingTable(probing_table);
+        throw;
+    }
+    probing.ClearProbingTable(probing_table);
+    return intersection;
+}
+
+std::unique_ptr<FlatPositionListIndex> FlatPositionListIndex::Probe(
+        std::span<int const> probing_table, std::pmr::memory_resource* arena) const {
+    assert(probing_table.size() >= relation_size_);
+    if (arena == nullptr) arena = GetArena();
+
+    std::vector<int> new_positions;
+    new_positions.reserve(positions_.size());
+    std::vector<std::pair<unsigned int, unsigned int>> new_clusters;
+
+    PliIntersector& intersector = PliIntersector::GetThreadLocal();
+    for (Cluster cluster : GetIndex()) {
+        intersector.Refine(cluster, probing_table);
+        for (std::size_t i = 0; i < intersector.GetNumGroups(); ++i) {
+            Cluster const group = intersector.GetGroup(i);
+            unsigned int const begin = new_positions.size();
+            new_positions.insert(new_positions.end(), group.begin(), group.end());
+            new_clusters.emplace_back(begin, new_positions.size());
+        }
+    }
+
+    return Assemble(new_positions, new_clusters, relation_size_, arena);
+}
+
+std::unique_ptr<FlatPositionListIndex> FlatPositionListIndex::ProbeAll(
+        Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data,
+        std::pmr::memory_resource* arena) const {
+    assert(relation_size_ == relation_data.GetNumRows());
+    if (arena == nullptr) arena = GetArena();
+
+    std::vector<std::vector<int> const*> probing_tables;
+    boost::dynamic_bitset<> const& probing_indices = probing_columns.GetColumnIndices();
+    for (std::size_t index = probing_indices.find_first();
+         index != boost::dynamic_bitset<>::npos; index = probing_indices.find_next(index)) {
+        probing_tables.push_back(&relation_data.GetColumnData(index).GetProbingTable());
+    }
+    std::size_t const probe_size = probing_tables.size();
+
+    std::vector<int> new_positions;
+    new_positions.reserve(positions_.size());
+    std::vector<std::pair<unsigned int, unsigned int>> new_clusters;
+    // Probes of the positions of a cluster laid out back to back, `order` indexes both
+    std::vector<int> probes;
+    std::vector<int> probed_positions;
+    std::vector<unsigned int> order;
+
+    for (Cluster cluster : GetIndex()) {
+        probes.clear();
+        probed_positions.clear();
+        for (int position : cluster) {
+            std::size_t const probe_begin = probes.size();
+            for (std::vector<int> const* probing_table : probing_tables) {
+                int const value_id = (*probing_table)[position];
+                if (value_id == PositionListIndex::kSingletonValueId) break;
+                probes.push_back(value_id);
+            }
+            if (probes.size() - probe_begin != probe_size) {
+                probes.resize(probe_begin);
+                continue;
+            }
+            probed_positions.push_back(position);
+        }
+
+        auto const probe_of = [&probes, probe_size](unsigned int i) {
+            return std::span<int const>{probes.data() + i * probe_size, probe_size};
+        };
+        order.resize(probed_positions.size());
+        std::iota(order.begin(), order.end(), 0u);
+        // Positions were pushed in ascending order, a stable sort keeps them that way in a group
+        std::ranges::stable_sort(order, [&probe_of](unsigned int a, unsigned int b) {
+            return std::ranges::lexicographical_compare(probe_of(a), probe_of(b));
+        });
+
+        for (auto run_begin = order.begin(); run_begin != order.end();) {
+            auto const run_end = std::find_if(run_begin, order.end(), [&](unsigned int i) {
+                return !std::ranges::equal(probe_of(i), probe_of(*run_begin));
+            });
+            if (run_end - run_begin > 1) {
+                unsigned int const begin = new_positions.size();
+                for (auto it = run_begin; it != run_end; ++it) {
+                    new_positions.push_back(probed_positions[*it]);
+                }
+                new_clusters.emplace_back(begin, new_positions.size());
+            }
+            run_begin = run_end;
+        }
+    }
+
+    return Assemble(new_positions, new_clusters, relation_size_, arena);
+}
+
+}  // namespace model
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "core/model/table/position_list_index.h"
+#include "core/model/table/position_list_index_with_singletons.h"
+#include "core/model/table/vertical.h"
+
+class ColumnLayoutRelationData;
+
+namespace model {
+
+/// @brief Position list index that keeps all of its clusters in one flat array.
+///
+/// The positions of all non-singleton clusters are stored back to back, `offsets_` holds the
+/// start of every cluster and the end of the last one. Clusters are ordered by their first
+/// position and positions inside a cluster are ascending, just like in PositionListIndex, so both
+/// layouts describe a partition the same way and convert into each other losslessly.
+///
+/// Both arrays are allocated from the memory resource passed on creation. Algorithms that create
+/// many short-lived partitions pass an arena (a pool or a monotonic buffer) here to avoid going to
+/// the global allocator for every cluster.
+class FlatPositionListIndex {
+public:
+    using Cluster = std::span<int const>;
+
+private:
+    std::pmr::vector<int> positions_;
+    std::pmr::vector<unsigned int> offsets_;
+    unsigned int relation_size_;
+    double entropy_;
+    unsigned long long nep_;
+    unsigned int freq_ = 0;
+
+    static std::unique_ptr<FlatPositionListIndex> Assemble(
+            std::vector<int> const& positions,
+            std::vector<std::pair<unsigned int, unsigned int>>& clusters,
+            unsigned int relation_size, std::pmr::memory_resource* arena);
+
+    void FillProbingTable(std::span<int> probing_table) const;
+    void ClearProbingTable(std::span<int> probing_table) const;
+
+public:
+    /// `offsets` must start with 0 and end with `positions.size()`, every cluster has at least
+    /// two positions.
+    FlatPositionListIndex(std::pmr::vector<int> positions, std::pmr::vector<unsigned int> offsets,
+                          unsigned int relation_size);
+
+    static std::unique_ptr<FlatPositionListIndex> CreateFrom(
+            PositionListIndex const& pli,
+            std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+    std::unique_ptr<PositionListIndex> ToPositionListIndex() const;
+    std::unique_ptr<PLIWithSingletons> ToPLIWithSingletons() const;
+
+    std::pmr::memory_resource* GetArena() const noexcept {
+        return positions_.get_allocator().resource();
+    }
+
+    Cluster GetCluster(std::size_t index) const noexcept {
+        return {positions_.data() + offsets_[index], positions_.data() + offsets_[index + 1]};
+    }
+
+    /// Random access range of the clusters, mirrors PositionListIndex::GetIndex.
+    auto GetIndex() const noexcept {
+        return std::views::iota(std::size_t{0}, std::size_t{GetNumNonSingletonCluster()}) |
+               std::views::transform([this](std::size_t index) { return GetCluster(index); });
+    }
+
+    std::vector<int> CalculateProbingTable() const;
+
+    double GetNep() const {
+        return static_cast<double>(nep_);
+    }
+
+    unsigned long long GetNepAsLong() const {
+        return nep_;
+    }
+
+    unsigned int GetNumNonSingletonCluster() const {
+        return offsets_.size() - 1;
+    }
+
+    unsigned int GetNumCluster() const {
+        return GetNumNonSingletonCluster() + relation_size_ - GetSize();
+    }
+
+    unsigned int GetFreq() const {
+        return freq_;
+    }
+
+    void IncFreq() {
+        freq_++;
+    }
+
+    unsigned int GetSize() const {
+        return positions_.size();
+    }
+
+    unsigned int GetRelationSize() const {
+        return relation_size_;
+    }
+
+    double GetEntropy() const {
+        return entropy_;
+    }
+
+    double GetMaximumNip() const {
+        return static_cast<unsigned long long>(relation_size_) * (relation_size_ - 1) / 2;
+    }
+
+    double GetNip() const {
+        return GetMaximumNip() - GetNepAsLong();
+    }
+
+    bool AllValuesAreUnique() const noexcept {
+        return GetNumNonSingletonCluster() == 0;
+    }
+
+    bool IsConstant() const {
+        return relation_size_ <= 1 ||
+               (GetNumNonSingletonCluster() == 1 && GetSize() == relation_size_);
+    }
+
+    /// Estimated size of the partition in memory, mirrors PositionListIndex::EstimateBytes.
+    std::size_t EstimateBytes() const noexcept {
+        return sizeof(*this) + (GetSize() + GetNumNonSingletonCluster() + 1) * sizeof(int);
+    }
+
+    /// The resulting partitions are allocated from `arena`, nullptr means the arena of this one.
+    std::unique_ptr<FlatPositionListIndex> Intersect(
+            FlatPositionListIndex const& that, std::pmr::memory_resource* arena = nullptr) const;
+    std::unique_ptr<FlatPositionListIndex> Probe(std::span<int const> probing_table,
+                                                 std::pmr::memory_resource* arena = nullptr) const;
+    std::unique_ptr<FlatPositionListIndex> ProbeAll(
+            Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data,
+            std::pmr::memory_resource* arena = nullptr) const;
+};
+
+using FlatPLI = FlatPositionListIndex;
+
+}  // namespace model
@@ -1,5 +1,8 @@
 #pragma once
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "core/util/export.h"
@@ -9,8 +12,36 @@ namespace model {
 class DESBORDANTE_EXPORT IDatasetStream {
 public:
     using Row = std::vector<std::string>;
+    using RowView = std::vector<std::string_view>;
 
     virtual Row GetNextRow() = 0;
+
+    /* Fills `row` with views of the next row's fields. The views stay valid until the next call
+     * to a non-const method of the stream or until `buffer` is modified, whichever comes first.
+     * `buffer` is scratch storage for fields the stream has to materialize. Streams that can
+     * hand out fields without copying them should override this. */
+    virtual void GetNextRowView(RowView& row, Row& buffer) {
+        buffer = GetNextRow();
+        row.assign(buffer.begin(), buffer.end());
+    }
+
+    /* Splits the rows that have not been read yet into at most `parts_num` streams over disjoint
+     * consecutive ranges of rows, in the order of the rows, that can be read concurrently. The
+     * stream itself must not be read while the parts are in use. Streams that cannot be split
+     * return no parts. */
+    virtual std::vector<std::unique_ptr<IDatasetStream>> SplitRows(
+            [[maybe_unused]] size_t parts_num) {
+        return {};
+    }
+
+    /* Identifies the rows the stream yields from its beginning: streams with equal identities
+     * yield the same rows. Used to share the encoded data between algorithms, see
+     * EncodedRelationCache. Streams that cannot tell whether their data has changed return
+     * std::nullopt. */
+    [[nodiscard]] virtual std::optional<std::string> GetDataIdentity() const {
+        return std::nullopt;
+    }
+
     [[nodiscard]] virtual bool HasNextRow() const = 0;
     [[nodiscard]] virtual size_t GetNumberOfColumns() const = 0;
     [[nodiscard]] virtual std::string GetColumnName(size_t index) const = 0;
@@ -0,0 +1,72 @@
+#include "core/model/table/pli_intersector.h"
+
+#include "core/model/table/position_list_index.h"
+
+namespace model {
+
+void PliIntersector::StartGeneration() {
+    if (++generation_ == 0) {
+        // Stamps of 2^32 generations ago would look fresh, start over
+        for (Slot& slot : slots_) {
+            slot.generation = 0;
+        }
+        generation_ = 1;
+    }
+}
+
+std::size_t PliIntersector::Refine(std::span<int const> cluster,
+                                   std::span<int const> probing_table, bool keep_singletons) {
+    StartGeneration();
+    distinct_values_.clear();
+    positions_.clear();
+    group_ends_.clear();
+    group_values_.clear();
+
+    std::size_t matched = 0;
+    for (int position : cluster) {
+        int const value_id = probing_table[position];
+        if (value_id == PositionListIndex::kSingletonValueId) {
+            if (!keep_singletons) continue;
+        } else {
+            ++matched;
+        }
+        Slot& slot = GetSlot(value_id);
+        if (slot.generation != generation_) {
+            slot.generation = generation_;
+            slot.count = 0;
+            distinct_values_.push_back(value_id);
+        }
+        ++slot.count;
+    }
+
+    unsigned int offset = 0;
+    for (int value_id : distinct_values_) {
+        Slot& slot = slots_[value_id];
+        if (slot.count < 2 && !keep_singletons) {
+            slot.count = 0;
+            continue;
+        }
+        slot.offset = offset;
+        offset += slot.count;
+        group_ends_.push_back(offset);
+        group_values_.push_back(value_id);
+    }
+    if (offset == 0) return matched;
+
+    positions_.resize(offset);
+    for (int position : cluster) {
+        int const value_id = probing_table[position];
+        if (value_id == PositionListIndex::kSingletonValueId && !keep_singletons) continue;
+        Slot& slot = slots_[value_id];
+        if (slot.count == 0) continue;
+        positions_[slot.offset++] = position;
+    }
+    return matched;
+}
+
+PliIntersector& PliIntersector::GetThreadLocal() {
+    thread_local PliIntersector intersector;
+    return intersector;
+}
+
+}  // namespace model
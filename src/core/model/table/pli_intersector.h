@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace model {
+
+/// @brief Splits clusters of a partition by the value ids of a probing table.
+///
+/// This is the inner loop of every PLI intersection. Instead of building a hash map from value id
+/// to positions for each cluster, the intersector keeps a direct-indexed array of counters keyed
+/// by value id. Every entry is stamped with the generation it was last written in, and a new
+/// generation is started for every cluster, so the array never has to be cleared. The positions
+/// of a cluster are counted in one pass and scattered into a flat buffer in another, the groups
+/// are laid out in the order of their first position and keep the positions ascending.
+///
+/// The buffers are reused between calls, so an intersector is meant to be long-lived and used by
+/// one thread at a time, see GetThreadLocal.
+class PliIntersector {
+private:
+    struct Slot {
+        unsigned int generation = 0;
+        unsigned int count = 0;
+        unsigned int offset = 0;
+    };
+
+    std::vector<Slot> slots_;
+    unsigned int generation_ = 0;
+    std::vector<int> distinct_values_;
+
+    std::vector<int> positions_;
+    std::vector<unsigned int> group_ends_;
+    std::vector<int> group_values_;
+
+    void StartGeneration();
+
+    Slot& GetSlot(int value_id) {
+        if (static_cast<std::size_t>(value_id) >= slots_.size()) {
+            slots_.resize(std::max(static_cast<std::size_t>(value_id) + 1, slots_.size() * 2));
+        }
+        return slots_[value_id];
+    }
+
+public:
+    /// Groups the positions of `cluster` by their value in `probing_table`. Without
+    /// `keep_singletons` the positions with PositionListIndex::kSingletonValueId and the groups
+    /// of one position are dropped, otherwise the former form a group of their own.
+    /// Returns the number of positions with a value other than kSingletonValueId.
+    std::size_t Refine(std::span<int const> cluster, std::span<int const> probing_table,
+                       bool keep_singletons = false);
+
+    /// Results of the last Refine call, valid until the next one.
+    std::size_t GetNumGroups() const noexcept {
+        return group_ends_.size();
+    }
+
+    std::span<int const> GetGroup(std::size_t index) const noexcept {
+        unsigned int const begin = index == 0 ? 0 : group_ends_[index - 1];
+        return {positions_.data() + begin, positions_.data() + group_ends_[index]};
+    }
+
+    int GetGroupValue(std::size_t index) const noexcept {
+        return group_values_[index];
+    }
+
+    /// Intersector of the calling thread.
+    static PliIntersector& GetThreadLocal();
+};
+
+}  // namespace model
@@ -11,11 +11,13 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <span>
 #include <utility>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/pli_intersector.h"
 #include "core/model/table/vertical.h"
 #include "core/util/logger.h"
 
@@ -23,7 +25,7 @@ namespace model {
 
 int const PositionListIndex::kSingletonValueId = 0;
 unsigned long long PositionListIndex::micros_ = 0;
-int PositionListIndex::intersection_count_ = 0;
+std::atomic<unsigned long long> PositionListIndex::intersection_count_ = 0;
 
 PositionListIndex::PositionListIndex(std::deque<std::vector<int>> index, unsigned int size,
                                      double entropy, unsigned long long nep,
@@ -118,6 +120,17 @@ std::shared_ptr<std::vector<int> const> PositionListIndex::CalculateAndGetProbin
     return std::make_shared<std::vector<int>>(probing_table);
 }
 
+std::size_t PositionListIndex::EstimateBytes() const {
+    // Every cluster is a vector with a heap block of its own
+    constexpr std::size_t kClusterOverhead = sizeof(Cluster) + 2 * sizeof(void*);
+    std::size_t bytes =
+            sizeof(*this) + GetSize() * sizeof(int) + GetNumNonSingletonCluster() * kClusterOverhead;
+    if (probing_table_cache_ != nullptr) {
+        bytes += relation_size_ * sizeof(int);
+    }
+    return bytes;
+}
+
 // интересное место: true --> надо передать поле без копирования, false --> надо сконструировать и
 // выдать наружу кажется, самым лёгким способом будет навернуть shared_ptr
 /*std::shared_ptr<const std::vector<int>> PositionListIndex::getProbingTable(bool isCaching) {
@@ -152,34 +165,17 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
     double new_key_gap = 0.0;
     unsigned long long new_nep = 0;
 
-    std::unordered_map<int, std::vector<int>> partial_index;
-
+    PliIntersector& intersector = PliIntersector::GetThreadLocal();
     for (auto& positions : index_) {
-        for (int position : positions) {
-            if (probing_table == nullptr) LOG_DEBUG("NULLPTR");
-            if (position < 0 || static_cast<size_t>(position) >= probing_table->size()) {
-                LOG_DEBUG("position: {} size: {}", position, probing_table->size());
-                for (size_t i = 0; i < positions.size(); ++i) {
-                    LOG_DEBUG("Position {}", positions[i]);
-                }
-            }
-            int probing_table_value_id = (*probing_table)[position];
-            if (probing_table_value_id == kSingletonValueId) continue;
-            intersection_count_++;
-            partial_index[probing_table_value_id].push_back(position);
-        }
-
-        for (auto& iter : partial_index) {
-            auto& cluster = iter.second;
-            if (cluster.size() <= 1) continue;
-
+        intersection_count_ += intersector.Refine(positions, *probing_table);
+        for (std::size_t i = 0; i < intersector.GetNumGroups(); ++i) {
+            std::span<int const> cluster = intersector.GetGroup(i);
             new_size += cluster.size();
             new_key_gap += cluster.size() * log(cluster.size());
             new_nep += CalculateNep(cluster.size());
 
-            new_index.push_back(std::move(cluster));
+            new_index.emplace_back(cluster.begin(), cluster.end());
         }
-        partial_index.clear();
     }
 
     double new_entropy = log(relation_size_) - new_key_gap / relation_size_;
@@ -189,6 +185,44 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
                                                relation_size_, relation_size_);
 }
 
+std::vector<std::unique_ptr<PositionListIndex>> PositionListIndex::ProbeBatch(
+        std::vector<std::vector<int> const*> const& probing_tables) const {
+    std::size_t const batch_size = probing_tables.size();
+    std::vector<std::deque<std::vector<int>>> new_indices(batch_size);
+    std::vector<unsigned int> new_sizes(batch_size, 0);
+    std::vector<double> new_key_gaps(batch_size, 0.0);
+    std::vector<unsigned long long> new_neps(batch_size, 0);
+
+    PliIntersector& intersector = PliIntersector::GetThreadLocal();
+    // Every cluster is refined by all the tables while it is still in cache
+    for (auto& positions : index_) {
+        for (std::size_t k = 0; k < batch_size; ++k) {
+            assert(this->relation_size_ == probing_tables[k]->size());
+            intersection_count_ += intersector.Refine(positions, *probing_tables[k]);
+            for (std::size_t i = 0; i < intersector.GetNumGroups(); ++i) {
+                std::span<int const> cluster = intersector.GetGroup(i);
+                new_sizes[k] += cluster.size();
+                new_key_gaps[k] += cluster.size() * log(cluster.size());
+                new_neps[k] += CalculateNep(cluster.size());
+
+                new_indices[k].emplace_back(cluster.begin(), cluster.end());
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<PositionListIndex>> results;
+    results.reserve(batch_size);
+    for (std::size_t k = 0; k < batch_size; ++k) {
+        double new_entropy = log(relation_size_) - new_key_gaps[k] / relation_size_;
+        SortClusters(new_indices[k]);
+        results.push_back(std::make_unique<PositionListIndex>(std::move(new_indices[k]),
+                                                              new_sizes[k], new_entropy,
+                                                              new_neps[k], relation_size_,
+                                                              relation_size_));
+    }
+    return results;
+}
+
 std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
         Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) {
     assert(this->relation_size_ == relation_data.GetNumRows());
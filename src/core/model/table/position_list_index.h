@@ -4,6 +4,8 @@
 //
 
 #pragma once
+#include <atomic>
+#include <cstddef>
 #include <deque>
 #include <memory>
 #include <unordered_map>
@@ -42,7 +44,8 @@ private:
     unsigned int freq_ = 0;
 
 public:
-    static int intersection_count_;
+    // Updated from the threads of parallel algorithms
+    static std::atomic<unsigned long long> intersection_count_;
     static unsigned long long micros_;
     static int const kSingletonValueId;
 
@@ -144,9 +147,16 @@ public:
         freq_++;
     }
 
+    /// Estimated size of the partition in memory, caches keep within their budgets by it.
+    std::size_t EstimateBytes() const;
+
     std::unique_ptr<PositionListIndex> Intersect(PositionListIndex const* that) const;
     std::unique_ptr<PositionListIndex> Probe(
             std::shared_ptr<std::vector<int> const> probing_table) const;
+    /* Probes this PLI with every table in one pass over the clusters, the same as calling Probe
+     * for each of them */
+    std::vector<std::unique_ptr<PositionListIndex>> ProbeBatch(
+            std::vector<std::vector<int> const*> const& probing_tables) const;
     std::unique_ptr<PositionListIndex> ProbeAll(Vertical const& probing_columns,
                                                 ColumnLayoutRelationData& relation_data);
     std::string ToString() const;
@@ -10,11 +10,13 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <span>
 #include <utility>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/pli_intersector.h"
 #include "core/model/table/vertical.h"
 #include "core/util/logger.h"
 
@@ -94,30 +96,13 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
     double new_key_gap = 0.0;
     unsigned long long new_nep = 0;
 
-    std::unordered_map<int, std::vector<int>> partial_index;
-
+    PliIntersector& intersector = PliIntersector::GetThreadLocal();
     for (auto& positions : index_) {
-        for (int position : positions) {
-            if (probing_table == nullptr) LOG_DEBUG("NULLPTR");
-            if (position < 0 || static_cast<size_t>(position) >= probing_table->size()) {
-                LOG_DEBUG("position: {} size: {}", position, probing_table->size());
-                for (size_t i = 0; i < positions.size(); ++i) {
-                    LOG_DEBUG("Position {}", positions[i]);
-                }
-            }
-            int probing_table_value_id = (*probing_table)[position];
-            if (probing_table_value_id == kSingletonValueId) {
-                partial_index[kSingletonValueId].push_back(position);
-                continue;
-            }
-            intersection_count_++;
-            partial_index[probing_table_value_id].push_back(position);
-        }
-
-        for (auto& iter : partial_index) {
-            auto& cluster = iter.second;
-            if (cluster.size() <= 1 || iter.first == kSingletonValueId) {
-                singletons.push_back(std::move(cluster));
+        intersection_count_ += intersector.Refine(positions, *probing_table, true);
+        for (std::size_t i = 0; i < intersector.GetNumGroups(); ++i) {
+            std::span<int const> cluster = intersector.GetGroup(i);
+            if (cluster.size() <= 1 || intersector.GetGroupValue(i) == kSingletonValueId) {
+                singletons.emplace_back(cluster.begin(), cluster.end());
                 continue;
             }
 
@@ -125,9 +110,8 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
             new_key_gap += cluster.size() * log(cluster.size());
             new_nep += CalculateNep(cluster.size());
 
-            new_index.push_back(std::move(cluster));
+            new_index.emplace_back(cluster.begin(), cluster.end());
         }
-        partial_index.clear();
     }
 
     double new_entropy = log(relation_size_) - new_key_gap / relation_size_;
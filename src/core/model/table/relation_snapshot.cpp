@@ -0,0 +1,311 @@
+#include "core/model/table/relation_snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "core/model/table/column.h"
+#include "core/util/logger.h"
+#include "core/util/string_hash.h"
+
+namespace model {
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'D', 'E', 'S', 'B', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::size_t kAlignment = 8;
+
+struct Header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint64_t num_rows;
+    std::uint64_t num_columns;
+};
+
+static_assert(sizeof(Header) % kAlignment == 0);
+static_assert(sizeof(RelationSnapshot::PliStats) % kAlignment == 0);
+static_assert(std::is_trivially_copyable_v<RelationSnapshot::PliStats>);
+
+std::size_t Padding(std::size_t size) {
+    return (kAlignment - size % kAlignment) % kAlignment;
+}
+
+class BlockWriter {
+private:
+    std::ofstream out_;
+    std::filesystem::path path_;
+
+public:
+    explicit BlockWriter(std::filesystem::path const& path)
+        : out_(path, std::ios::binary | std::ios::trunc), path_(path) {
+        if (!out_) {
+            throw std::runtime_error("Error: couldn't create file " + path.string());
+        }
+    }
+
+    void WriteRaw(void const* data, std::size_t size) {
+        out_.write(static_cast<char const*>(data), size);
+    }
+
+    void WriteBlock(void const* data, std::size_t size) {
+        static constexpr std::array<char, kAlignment> kZeros{};
+        std::uint64_t const length = size;
+        WriteRaw(&length, sizeof(length));
+        WriteRaw(data, size);
+        WriteRaw(kZeros.data(), Padding(size));
+    }
+
+    template <typename T>
+    void WriteBlock(std::vector<T> const& values) {
+        WriteBlock(values.data(), values.size() * sizeof(T));
+    }
+
+    void WriteBlock(std::string_view str) {
+        WriteBlock(str.data(), str.size());
+    }
+
+    void Finish() {
+        out_.flush();
+        if (!out_) {
+            throw std::runtime_error("Error: couldn't write file " + path_.string());
+        }
+    }
+};
+
+class BlockReader {
+private:
+    char const* cur_;
+    char const* end_;
+    std::filesystem::path const& path_;
+
+    [[noreturn]] void ThrowCorrupted() const {
+        throw std::runtime_error("Error: snapshot " + path_.string() + " is corrupted");
+    }
+
+public:
+    BlockReader(std::string_view data, std::filesystem::path const& path)
+        : cur_(data.data()), end_(data.data() + data.size()), path_(path) {}
+
+    std::string_view ReadBlock() {
+        std::uint64_t length;
+        if (static_cast<std::size_t>(end_ - cur_) < sizeof(length)) ThrowCorrupted();
+        std::memcpy(&length, cur_, sizeof(length));
+        cur_ += sizeof(length);
+        auto const remaining = static_cast<std::size_t>(end_ - cur_);
+        if (remaining < length || remaining - length < Padding(length)) ThrowCorrupted();
+        std::string_view const block{cur_, length};
+        cur_ += length + Padding(length);
+        return block;
+    }
+
+    /// Blocks start at 8-byte boundaries of a page-aligned mapping, so the arrays are aligned.
+    template <typename T>
+    std::span<T const> ReadArray(std::size_t expected_size) {
+        std::string_view const block = ReadBlock();
+        // The size comes from the file, the product must not wrap around
+        if (expected_size > std::numeric_limits<std::size_t>::max() / sizeof(T) ||
+            block.size() != expected_size * sizeof(T)) {
+            ThrowCorrupted();
+        }
+        return {reinterpret_cast<T const*>(block.data()), expected_size};
+    }
+
+    template <typename T>
+    std::span<T const> ReadArray() {
+        std::string_view const block = ReadBlock();
+        if (block.size() % sizeof(T) != 0) ThrowCorrupted();
+        return {reinterpret_cast<T const*>(block.data()), block.size() / sizeof(T)};
+    }
+
+    void Check(bool condition) const {
+        if (!condition) ThrowCorrupted();
+    }
+};
+
+/// Dictionary encoding of a column, codes are assigned in the order of first occurrence.
+struct EncodedColumn {
+    std::unordered_map<std::string, int, util::StringHash, std::equal_to<>> dictionary;
+    std::vector<std::string const*> values;
+    std::vector<int> codes;
+
+    void Add(std::string_view field) {
+        auto location = dictionary.find(field);
+        if (location == dictionary.end()) {
+            location = dictionary.emplace(field, values.size()).first;
+            values.push_back(&location->first);
+        }
+        codes.push_back(location->second);
+    }
+};
+
+void WriteColumn(BlockWriter& writer, EncodedColumn& column) {
+    std::vector<std::uint64_t> value_offsets{0};
+    value_offsets.reserve(column.values.size() + 1);
+    for (std::string const* value : column.values) {
+        value_offsets.push_back(value_offsets.back() + value->size());
+    }
+    writer.WriteBlock(value_offsets);
+    std::string value_bytes;
+    value_bytes.reserve(value_offsets.back());
+    for (std::string const* value : column.values) {
+        value_bytes += *value;
+    }
+    writer.WriteBlock(value_bytes);
+    writer.WriteBlock(column.codes);
+
+    std::unique_ptr<PLIWithSingletons> const pli = PLIWithSingletons::CreateFor(column.codes);
+    RelationSnapshot::PliStats const stats{pli->GetSize(),         0,
+                                           pli->GetEntropy(),      pli->GetInvertedEntropy(),
+                                           pli->GetGiniImpurity(), pli->GetNepAsLong()};
+    writer.WriteBlock(&stats, sizeof(stats));
+
+    std::vector<std::uint32_t> cluster_offsets{0};
+    std::vector<std::uint32_t> cluster_positions;
+    cluster_positions.reserve(pli->GetSize());
+    for (PLI::Cluster const& cluster : pli->GetIndex()) {
+        cluster_positions.insert(cluster_positions.end(), cluster.begin(), cluster.end());
+        cluster_offsets.push_back(cluster_positions.size());
+    }
+    writer.WriteBlock(cluster_offsets);
+    writer.WriteBlock(cluster_positions);
+
+    std::vector<std::uint32_t> singletons;
+    singletons.reserve(pli->GetSngltnSize());
+    for (PLI::Cluster const& singleton : pli->GetSingletons()) {
+        singletons.push_back(singleton.front());
+    }
+    writer.WriteBlock(singletons);
+}
+
+}  // namespace
+
+RelationSnapshot::RelationSnapshot(std::filesystem::path const& path) : file_(path) {
+    if (file_.Size() < sizeof(Header) ||
+        std::memcmp(file_.Data(), kMagic.data(), kMagic.size()) != 0) {
+        throw std::runtime_error("Error: " + path.string() + " is not a snapshot");
+    }
+    Header header;
+    std::memcpy(&header, file_.Data(), sizeof(header));
+    if (header.byte_order_mark != kByteOrderMark) {
+        throw std::runtime_error("Error: snapshot " + path.string() +
+                                 " was written on a machine with a different byte order");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("Error: snapshot " + path.string() + " has version " +
+                                 std::to_string(header.version) + ", expected " +
+                                 std::to_string(kVersion));
+    }
+    num_rows_ = header.num_rows;
+
+    BlockReader reader{file_.View().substr(sizeof(header)), path};
+    relation_name_ = reader.ReadBlock();
+    // Every column takes at least a block header, don't trust the count beyond that
+    reader.Check(header.num_columns <= file_.Size() / sizeof(std::uint64_t));
+    columns_.resize(header.num_columns);
+    for (ColumnBlocks& column : columns_) {
+        column.name = reader.ReadBlock();
+    }
+    for (ColumnBlocks& column : columns_) {
+        column.value_offsets = reader.ReadArray<std::uint64_t>();
+        column.value_bytes = reader.ReadBlock();
+        reader.Check(!column.value_offsets.empty() &&
+                     column.value_offsets.back() == column.value_bytes.size());
+        column.codes = reader.ReadArray<std::uint32_t>(num_rows_);
+        std::uint64_t const num_values = column.value_offsets.size() - 1;
+        reader.Check(std::ranges::all_of(column.codes, [num_values](std::uint32_t code) {
+            return code < num_values;
+        }));
+        std::memcpy(&column.stats, reader.ReadArray<PliStats>(1).data(), sizeof(PliStats));
+        column.cluster_offsets = reader.ReadArray<std::uint32_t>();
+        column.cluster_positions = reader.ReadArray<std::uint32_t>(column.stats.size);
+        reader.Check(!column.cluster_offsets.empty() &&
+                     std::ranges::is_sorted(column.cluster_offsets) &&
+                     column.cluster_offsets.back() == column.stats.size);
+        column.singletons = reader.ReadArray<std::uint32_t>();
+        auto const is_row = [this](std::uint32_t position) { return position < num_rows_; };
+        reader.Check(std::ranges::all_of(column.cluster_positions, is_row) &&
+                     std::ranges::all_of(column.singletons, is_row));
+    }
+}
+
+bool RelationSnapshot::IsSnapshot(std::filesystem::path const& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::array<char, kMagic.size()> magic{};
+    return in.read(magic.data(), magic.size()) && magic == kMagic;
+}
+
+void RelationSnapshot::Write(IDatasetStream& data_stream, std::filesystem::path const& path) {
+    std::size_t const num_columns = data_stream.GetNumberOfColumns();
+    std::vector<EncodedColumn> columns(num_columns);
+    IDatasetStream::RowView row;
+    IDatasetStream::Row row_buffer;
+    std::size_t num_rows = 0;
+
+    while (data_stream.HasNextRow()) {
+        data_stream.GetNextRowView(row, row_buffer);
+
+        if (row.size() != num_columns) {
+            LOG_WARN(
+                    "Unexpected number of columns for a row, "
+                    "skipping (expected {}, got {})",
+                    num_columns, row.size());
+            continue;
+        }
+
+        for (std::size_t index = 0; index < row.size(); ++index) {
+            columns[index].Add(row[index]);
+        }
+        ++num_rows;
+    }
+
+    BlockWriter writer{path};
+    Header const header{kMagic, kVersion, kByteOrderMark, num_rows, num_columns};
+    writer.WriteRaw(&header, sizeof(header));
+    writer.WriteBlock(data_stream.GetRelationName());
+    for (std::size_t i = 0; i < num_columns; ++i) {
+        writer.WriteBlock(data_stream.GetColumnName(i));
+    }
+    for (EncodedColumn& column : columns) {
+        WriteColumn(writer, column);
+        column = EncodedColumn{};
+    }
+    writer.Finish();
+}
+
+std::unique_ptr<RelationalSchema> RelationSnapshot::CreateSchema() const {
+    auto schema = std::make_unique<RelationalSchema>(std::string{relation_name_});
+    for (ColumnBlocks const& column : columns_) {
+        schema->AppendColumn(std::string{column.name});
+    }
+    return schema;
+}
+
+std::unique_ptr<PLIWithSingletons> RelationSnapshot::CreatePli(std::size_t column) const {
+    ColumnBlocks const& blocks = columns_[column];
+    std::deque<PLI::Cluster> clusters;
+    for (std::size_t i = 0; i + 1 < blocks.cluster_offsets.size(); ++i) {
+        auto const begin = blocks.cluster_positions.begin() + blocks.cluster_offsets[i];
+        auto const end = blocks.cluster_positions.begin() + blocks.cluster_offsets[i + 1];
+        clusters.emplace_back(begin, end);
+    }
+    std::deque<PLI::Cluster> singletons;
+    for (std::uint32_t position : blocks.singletons) {
+        singletons.push_back({static_cast<int>(position)});
+    }
+    PliStats const& stats = blocks.stats;
+    return std::make_unique<PLIWithSingletons>(std::move(clusters), std::move(singletons),
+                                               stats.size, stats.entropy, stats.nep, num_rows_,
+                                               stats.inverted_entropy, stats.gini_impurity);
+}
+
+}  // namespace model
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/model/table/idataset_stream.h"
+#include "core/model/table/position_list_index_with_singletons.h"
+#include "core/model/table/relational_schema.h"
+#include "core/util/mapped_file.h"
+
+namespace model {
+
+/// @brief Read-only view of a binary snapshot of an encoded table.
+///
+/// A snapshot holds the schema, the dictionary of every column, the dictionary codes of every
+/// row and the PLI of every column together with its statistics, so a table can be restored
+/// without parsing and hashing its values again. The file is mapped into memory and the values
+/// are handed out as views into the mapping.
+///
+/// Layout (native byte order, the header records it): a 32-byte header followed by blocks, each
+/// being a 64-bit payload length and the payload padded to 8 bytes. The blocks are the relation
+/// name, the column names and then, for every column, value offsets (u64, one more than there
+/// are values), value bytes, row codes (u32), PLI statistics, cluster offsets (u32, one more
+/// than there are clusters), cluster positions (u32) and singleton positions (u32).
+class RelationSnapshot {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    struct PliStats {
+        std::uint32_t size;
+        std::uint32_t padding;
+        double entropy;
+        double inverted_entropy;
+        double gini_impurity;
+        std::uint64_t nep;
+    };
+
+private:
+    struct ColumnBlocks {
+        std::string_view name;
+        std::span<std::uint64_t const> value_offsets;
+        std::string_view value_bytes;
+        std::span<std::uint32_t const> codes;
+        PliStats stats;
+        std::span<std::uint32_t const> cluster_offsets;
+        std::span<std::uint32_t const> cluster_positions;
+        std::span<std::uint32_t const> singletons;
+    };
+
+    util::MappedFile file_;
+    std::string_view relation_name_;
+    std::size_t num_rows_;
+    std::vector<ColumnBlocks> columns_;
+
+public:
+    /// Map the snapshot at `path`, throws std::runtime_error if it is not a valid snapshot of
+    /// the current version.
+    explicit RelationSnapshot(std::filesystem::path const& path);
+
+    /// Check whether the file at `path` starts like a snapshot.
+    static bool IsSnapshot(std::filesystem::path const& path);
+
+    /// Encode all unread rows of `data_stream` and write them as a snapshot to `path`. Rows with
+    /// an unexpected number of fields are skipped like in ColumnLayoutRelationData::CreateFrom.
+    static void Write(IDatasetStream& data_stream, std::filesystem::path const& path);
+
+    std::string_view GetRelationName() const noexcept {
+        return relation_name_;
+    }
+
+    std::size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    std::size_t GetNumColumns() const noexcept {
+        return columns_.size();
+    }
+
+    std::string_view GetColumnName(std::size_t column) const {
+        return columns_[column].name;
+    }
+
+    std::string_view GetValue(std::size_t column, std::size_t row) const {
+        ColumnBlocks const& blocks = columns_[column];
+        std::uint32_t const code = blocks.codes[row];
+        std::uint64_t const begin = blocks.value_offsets[code];
+        return blocks.value_bytes.substr(begin, blocks.value_offsets[code + 1] - begin);
+    }
+
+    std::unique_ptr<RelationalSchema> CreateSchema() const;
+
+    /// Restore the PLI of the column, only the clusters are copied.
+    std::unique_ptr<PLIWithSingletons> CreatePli(std::size_t column) const;
+};
+
+}  // namespace model
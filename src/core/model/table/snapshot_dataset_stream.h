@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/model/table/idataset_stream.h"
+#include "core/model/table/relation_snapshot.h"
+
+namespace model {
+
+/// @brief Dataset stream over the rows of a RelationSnapshot.
+/// @remark Row views point into the mapping of the snapshot, nothing is copied.
+class SnapshotDatasetStream final : public IDatasetStream {
+private:
+    std::shared_ptr<RelationSnapshot const> snapshot_;
+    std::size_t begin_row_;
+    std::size_t end_row_;
+    std::size_t cur_row_;
+
+public:
+    explicit SnapshotDatasetStream(std::filesystem::path const& path)
+        : SnapshotDatasetStream(std::make_shared<RelationSnapshot const>(path)) {}
+
+    explicit SnapshotDatasetStream(std::shared_ptr<RelationSnapshot const> snapshot)
+        : SnapshotDatasetStream(snapshot, 0, snapshot->GetNumRows()) {}
+
+    SnapshotDatasetStream(std::shared_ptr<RelationSnapshot const> snapshot, std::size_t begin_row,
+                          std::size_t end_row)
+        : snapshot_(std::move(snapshot)),
+          begin_row_(begin_row),
+          end_row_(end_row),
+          cur_row_(begin_row) {}
+
+    Row GetNextRow() override {
+        Row row;
+        row.reserve(snapshot_->GetNumColumns());
+        for (std::size_t column = 0; column < snapshot_->GetNumColumns(); ++column) {
+            row.emplace_back(snapshot_->GetValue(column, cur_row_));
+        }
+        ++cur_row_;
+        return row;
+    }
+
+    void GetNextRowView(RowView& row, [[maybe_unused]] Row& buffer) override {
+        row.clear();
+        for (std::size_t column = 0; column < snapshot_->GetNumColumns(); ++column) {
+            row.push_back(snapshot_->GetValue(column, cur_row_));
+        }
+        ++cur_row_;
+    }
+
+    std::vector<std::unique_ptr<IDatasetStream>> SplitRows(std::size_t parts_num) override {
+        std::vector<std::unique_ptr<IDatasetStream>> parts;
+        std::size_t const num_rows = end_row_ - cur_row_;
+        parts_num = std::min(parts_num, num_rows);
+        for (std::size_t part = 0; part < parts_num; ++part) {
+            parts.push_back(std::make_unique<SnapshotDatasetStream>(
+                    snapshot_, cur_row_ + num_rows * part / parts_num,
+                    cur_row_ + num_rows * (part + 1) / parts_num));
+        }
+        return parts;
+    }
+
+    /// The whole snapshot if none of its rows have been read yet, nullptr otherwise. Marks all
+    /// rows as read, so that the snapshot can be used in place of reading the rows.
+    RelationSnapshot const* ReadWhole() noexcept {
+        if (cur_row_ != 0 || begin_row_ != 0 || end_row_ != snapshot_->GetNumRows()) {
+            return nullptr;
+        }
+        cur_row_ = end_row_;
+        return snapshot_.get();
+    }
+
+    bool HasNextRow() const override {
+        return cur_row_ != end_row_;
+    }
+
+    std::size_t GetNumberOfColumns() const override {
+        return snapshot_->GetNumColumns();
+    }
+
+    std::string GetColumnName(std::size_t index) const override {
+        return std::string{snapshot_->GetColumnName(index)};
+    }
+
+    std::string GetRelationName() const override {
+        return std::string{snapshot_->GetRelationName()};
+    }
+
+    void Reset() override {
+        cur_row_ = begin_row_;
+    }
+};
+
+}  // namespace model
@@ -9,6 +9,7 @@
 #include "core/algorithms/fd/pyrocommon/core/dependency_candidate.h"
 #include "core/algorithms/fd/pyrocommon/core/vertical_info.h"
 #include "core/algorithms/fd/pyrocommon/model/agree_set_sample.h"
+#include "core/model/table/flat_position_list_index.h"
 #include "core/model/table/position_list_index.h"
 
 namespace model {
@@ -516,6 +517,8 @@ std::shared_ptr<Value const> VerticalMap<Value>::Get(Bitset const& key) const {
 // explicitly instantiate to solve template implementation linking issues
 template class VerticalMap<PositionListIndex>;
 
+template class VerticalMap<FlatPositionListIndex>;
+
 template class VerticalMap<AgreeSetSample>;
 
 template class VerticalMap<DependencyCandidate>;
@@ -696,6 +699,8 @@ long long BlockingVerticalMap<V>::GetTimeSpentOnShrinking() {
 
 template class BlockingVerticalMap<PositionListIndex>;
 
+template class BlockingVerticalMap<FlatPositionListIndex>;
+
 template class BlockingVerticalMap<AgreeSetSample>;
 
 template class BlockingVerticalMap<DependencyCandidate>;
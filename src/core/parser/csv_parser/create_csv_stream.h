@@ -0,0 +1,22 @@
+#pragma once
+
+#include <memory>
+
+#include "core/model/table/idataset_stream.h"
+#include "core/model/table/relation_snapshot.h"
+#include "core/model/table/snapshot_dataset_stream.h"
+#include "core/parser/csv_parser/csv_parser.h"
+#include "core/parser/csv_parser/mmap_csv_parser.h"
+
+/* Create the dataset stream selected by the config. A path to a snapshot written by
+ * model::RelationSnapshot::Write is accepted in place of a CSV file, the separator and the
+ * header flag are ignored then */
+inline std::shared_ptr<model::IDatasetStream> CreateCSVStream(CSVConfig const& csv_config) {
+    if (model::RelationSnapshot::IsSnapshot(csv_config.path)) {
+        return std::make_shared<model::SnapshotDatasetStream>(csv_config.path);
+    }
+    if (csv_config.memory_mapped) {
+        return std::make_shared<MmapCSVParser>(csv_config);
+    }
+    return std::make_shared<CSVParser>(csv_config);
+}
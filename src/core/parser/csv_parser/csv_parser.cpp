@@ -2,15 +2,40 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/tokenizer.hpp>
 
+std::optional<std::string> MakeCsvDataIdentity(std::filesystem::path const& path, char separator,
+                                               bool has_header, std::string_view parser_kind) {
+    std::error_code error;
+    std::filesystem::path const canonical_path = std::filesystem::canonical(path, error);
+    if (error) return std::nullopt;
+    std::uintmax_t const size = std::filesystem::file_size(canonical_path, error);
+    if (error) return std::nullopt;
+    std::filesystem::file_time_type const write_time =
+            std::filesystem::last_write_time(canonical_path, error);
+    if (error) return std::nullopt;
+
+    std::string identity{parser_kind};
+    identity += '\n' + canonical_path.string();
+    identity += '\n' + std::to_string(size);
+    identity += '\n' + std::to_string(write_time.time_since_epoch().count());
+    identity += '\n';
+    identity += separator;
+    identity += has_header ? "\nheader" : "\nno header";
+    return identity;
+}
+
 inline std::string& CSVParser::Rtrim(std::string& s) {
     boost::trim_right(s);
     return s;
@@ -26,7 +51,8 @@ CSVParser::CSVParser(std::filesystem::path const& path, char separator, bool has
       next_line_(),
       number_of_columns_(),
       column_names_(),
-      relation_name_(path.filename().string()) {
+      relation_name_(path.filename().string()),
+      data_identity_(MakeCsvDataIdentity(path, separator, has_header, "csv")) {
     // Wrong path
     if (!source_) {
         throw std::runtime_error("Error: couldn't find file " + path.string());
@@ -7,7 +7,9 @@
 
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "core/model/table/idataset_stream.h"
@@ -16,8 +18,16 @@ struct CSVConfig {
     std::filesystem::path path;
     char separator;
     bool has_header;
+    /* Read the file through MmapCSVParser instead of CSVParser, see CreateCSVStream */
+    bool memory_mapped = false;
 };
 
+/* Identity of the data read from the file at `path` (see IDatasetStream::GetDataIdentity), made
+ * of its canonical path, size and modification time and the way it is parsed. `parser_kind`
+ * distinguishes parsers that may split the same file differently. */
+std::optional<std::string> MakeCsvDataIdentity(std::filesystem::path const& path, char separator,
+                                               bool has_header, std::string_view parser_kind);
+
 class CSVParser : public model::IDatasetStream {
 private:
     std::ifstream source_;
@@ -30,6 +40,7 @@ private:
     int number_of_columns_;
     std::vector<std::string> column_names_;
     std::string relation_name_;
+    std::optional<std::string> data_identity_;
     void GetNext();
     void PeekNext();
     void GetLine(unsigned long long const line_index);
@@ -69,5 +80,9 @@ public:
         return relation_name_;
     }
 
+    std::optional<std::string> GetDataIdentity() const override {
+        return data_identity_;
+    }
+
     void Reset() override;
 };
@@ -0,0 +1,258 @@
+#include "core/parser/csv_parser/mmap_csv_parser.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+bool IsSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+char const* FindLineEnd(char const* begin, char const* end) noexcept {
+    if (begin == end) return end;
+    void const* const newline = std::memchr(begin, '\n', end - begin);
+    return newline == nullptr ? end : static_cast<char const*>(newline);
+}
+
+}  // namespace
+
+using RowReader = MmapCSVParser::RowReader;
+
+/* Stream over a part of the rows of the parser */
+class MmapCSVParser::Part final : public model::IDatasetStream {
+private:
+    MmapCSVParser const& parser_;
+    RowReader reader_;
+
+public:
+    Part(MmapCSVParser const& parser, char const* begin, char const* end)
+        : parser_(parser),
+          reader_(begin, end, parser.separator_, parser.number_of_columns_) {}
+
+    Row GetNextRow() override {
+        return reader_.GetNextRow();
+    }
+
+    void GetNextRowView(RowView& row, Row& buffer) override {
+        reader_.GetNextRowView(row, buffer);
+    }
+
+    bool HasNextRow() const override {
+        return reader_.HasNextRow();
+    }
+
+    size_t GetNumberOfColumns() const override {
+        return parser_.GetNumberOfColumns();
+    }
+
+    std::string GetColumnName(size_t index) const override {
+        return parser_.GetColumnName(index);
+    }
+
+    std::string GetRelationName() const override {
+        return parser_.GetRelationName();
+    }
+
+    void Reset() override {
+        reader_.Reset();
+    }
+};
+
+MmapCSVParser::MmapCSVParser(std::filesystem::path const& path) : MmapCSVParser(path, ',', true) {}
+
+MmapCSVParser::MmapCSVParser(std::filesystem::path const& path, char separator, bool has_header)
+    : file_(path),
+      reader_(file_.Data(), GetDataEnd(), separator, 0),
+      separator_(separator),
+      number_of_columns_(0),
+      relation_name_(path.filename().string()),
+      data_identity_(MakeCsvDataIdentity(path, separator, has_header, "mmap csv")) {
+    if (separator == '\0') {
+        throw std::invalid_argument("Invalid separator");
+    }
+    file_.AdviseSequential();
+
+    // The first line defines the number of columns whether it is a header or not
+    column_names_ = reader_.GetNextRow();
+    number_of_columns_ = column_names_.size();
+    if (has_header) {
+        reader_ = RowReader(reader_.GetPosition(), GetDataEnd(), separator_, number_of_columns_);
+    } else {
+        for (size_t i = 0; i < number_of_columns_; ++i) {
+            column_names_[i] = std::to_string(i);
+        }
+        reader_ = RowReader(file_.Data(), GetDataEnd(), separator_, number_of_columns_);
+    }
+}
+
+MmapCSVParser::MmapCSVParser(CSVConfig const& csv_config)
+    : MmapCSVParser(csv_config.path, csv_config.separator, csv_config.has_header) {}
+
+std::vector<std::unique_ptr<model::IDatasetStream>> MmapCSVParser::SplitRows(size_t parts_num) {
+    char const* const begin = reader_.GetPosition();
+    char const* const end = GetDataEnd();
+    size_t const length = end - begin;
+    parts_num = std::max<size_t>(1, std::min(parts_num, length));
+
+    std::vector<std::unique_ptr<model::IDatasetStream>> parts;
+    parts.reserve(parts_num);
+    char const* part_begin = begin;
+    for (size_t part = 1; part <= parts_num && part_begin != end; ++part) {
+        char const* part_end = end;
+        if (part != parts_num) {
+            char const* const approx_end = std::max(part_begin, begin + length * part / parts_num);
+            part_end = FindLineEnd(approx_end, end);
+            if (part_end != end) ++part_end;
+        }
+        if (part_end != part_begin) {
+            parts.push_back(std::make_unique<Part>(*this, part_begin, part_end));
+        }
+        part_begin = part_end;
+    }
+    return parts;
+}
+
+char const* RowReader::FindFieldBoundary(char const* begin, char const* end) const noexcept {
+#ifdef __AVX2__
+    __m256i const separator_vect = _mm256_set1_epi8(separator_);
+    __m256i const quote_vect = _mm256_set1_epi8(kQuote);
+    for (; end - begin >= 32; begin += 32) {
+        __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(begin));
+        __m256i const hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, separator_vect),
+                                             _mm256_cmpeq_epi8(chunk, quote_vect));
+        auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) return begin + std::countr_zero(mask);
+    }
+#elif defined(__SSE2__)
+    __m128i const separator_vect = _mm_set1_epi8(separator_);
+    __m128i const quote_vect = _mm_set1_epi8(kQuote);
+    for (; end - begin >= 16; begin += 16) {
+        __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+        __m128i const hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, separator_vect),
+                                          _mm_cmpeq_epi8(chunk, quote_vect));
+        auto const mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) return begin + std::countr_zero(mask);
+    }
+#endif
+    for (; begin != end; ++begin) {
+        if (*begin == separator_ || *begin == kQuote) return begin;
+    }
+    return end;
+}
+
+void RowReader::SplitLine(char const* begin, char const* end) {
+    fields_.clear();
+    if (begin == end) return;
+
+    char const* field_begin = begin;
+    bool has_quotes = false;
+    char const* pos = begin;
+    while (true) {
+        pos = FindFieldBoundary(pos, end);
+        if (pos == end) {
+            fields_.push_back({field_begin, end, has_quotes});
+            return;
+        }
+        if (*pos == kQuote) {
+            has_quotes = true;
+            // Separators are a part of the field until the quote is closed
+            void const* const closing = std::memchr(pos + 1, kQuote, end - pos - 1);
+            if (closing == nullptr) {
+                fields_.push_back({field_begin, end, has_quotes});
+                return;
+            }
+            pos = static_cast<char const*>(closing) + 1;
+            continue;
+        }
+        fields_.push_back({field_begin, pos, has_quotes});
+        field_begin = ++pos;
+        has_quotes = false;
+        if (pos == end) {
+            fields_.push_back({end, end, false});
+            return;
+        }
+    }
+}
+
+void RowReader::SplitNextLine() {
+    char const* const line_end = FindLineEnd(cur_, end_);
+    char const* trimmed_end = line_end;
+    while (trimmed_end != cur_ && IsSpace(*(trimmed_end - 1))) --trimmed_end;
+
+    SplitLine(cur_, trimmed_end);
+    cur_ = line_end == end_ ? end_ : line_end + 1;
+
+    if (number_of_columns_ == 1 && fields_.empty()) {
+        fields_.push_back({trimmed_end, trimmed_end, false});
+    }
+}
+
+std::string RowReader::Unquote(FieldSpan const& field) {
+    std::string_view const token{field.begin, static_cast<size_t>(field.end - field.begin)};
+    size_t const token_length = token.size();
+    // States whether a field is enclosed in double-quotes
+    bool const is_enclosed =
+            token_length >= 2 && token.front() == kQuote && token.back() == kQuote;
+
+    std::string unquoted;
+    unquoted.reserve(token_length);
+    for (size_t index = 0; index < token_length; ++index) {
+        if (token[index] != kQuote) {
+            unquoted.push_back(token[index]);
+        } else if (is_enclosed && index > 0 && index + 2 < token_length &&
+                   token[index + 1] == kQuote) {
+            // "" stands for " inside an enclosed field
+            unquoted.push_back(kQuote);
+            ++index;
+        }
+    }
+    return unquoted;
+}
+
+MmapCSVParser::Row RowReader::GetNextRow() {
+    SplitNextLine();
+
+    Row row;
+    row.reserve(fields_.size());
+    for (FieldSpan const& field : fields_) {
+        if (field.has_quotes) {
+            row.push_back(Unquote(field));
+        } else {
+            row.emplace_back(field.begin, field.end);
+        }
+    }
+    return row;
+}
+
+void RowReader::GetNextRowView(RowView& row, Row& buffer) {
+    SplitNextLine();
+
+    // Materialize quoted fields first: views into `buffer` must not be taken while it grows
+    buffer.clear();
+    for (FieldSpan const& field : fields_) {
+        if (field.has_quotes) buffer.push_back(Unquote(field));
+    }
+
+    row.clear();
+    row.reserve(fields_.size());
+    auto unquoted_it = buffer.begin();
+    for (FieldSpan const& field : fields_) {
+        if (field.has_quotes) {
+            row.emplace_back(*unquoted_it++);
+        } else {
+            row.emplace_back(field.begin, field.end - field.begin);
+        }
+    }
+}
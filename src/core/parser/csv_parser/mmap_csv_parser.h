@@ -0,0 +1,130 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/model/table/idataset_stream.h"
+#include "core/parser/csv_parser/csv_parser.h"
+#include "core/util/mapped_file.h"
+
+/* CSV reader that maps the whole file into memory and splits it in place.
+ * Accepts the same dialect as CSVParser: every line is a row, trailing whitespace of a line is
+ * dropped, a quote character toggles quoting (separators inside quotes are part of the field),
+ * quotes themselves are removed and "" inside a field enclosed in quotes stands for a single ".
+ * Fields without quotes are handed out by GetNextRowView as views into the mapping, only quoted
+ * fields are copied.
+ */
+class MmapCSVParser : public model::IDatasetStream {
+public:
+    /* Splits a range of whole lines of the mapping into rows */
+    class RowReader {
+    private:
+        struct FieldSpan {
+            char const* begin;
+            char const* end;
+            bool has_quotes;
+        };
+
+        static constexpr char kQuote = '\"';
+
+        char const* begin_;
+        char const* cur_;
+        char const* end_;
+        char separator_;
+        size_t number_of_columns_;
+        std::vector<FieldSpan> fields_;
+
+        /* Splits the next line into fields_ and advances cur_ past it */
+        void SplitNextLine();
+        void SplitLine(char const* begin, char const* end);
+        char const* FindFieldBoundary(char const* begin, char const* end) const noexcept;
+        static std::string Unquote(FieldSpan const& field);
+
+    public:
+        RowReader(char const* begin, char const* end, char separator, size_t number_of_columns)
+            : begin_(begin),
+              cur_(begin),
+              end_(end),
+              separator_(separator),
+              number_of_columns_(number_of_columns) {}
+
+        Row GetNextRow();
+        void GetNextRowView(RowView& row, Row& buffer);
+
+        bool HasNextRow() const noexcept {
+            return cur_ != end_;
+        }
+
+        char const* GetPosition() const noexcept {
+            return cur_;
+        }
+
+        void Reset() noexcept {
+            cur_ = begin_;
+        }
+    };
+
+private:
+    class Part;
+
+    util::MappedFile file_;
+    RowReader reader_;
+    char separator_;
+    size_t number_of_columns_;
+    std::vector<std::string> column_names_;
+    std::string relation_name_;
+    std::optional<std::string> data_identity_;
+
+    char const* GetDataEnd() const noexcept {
+        return file_.Data() + file_.Size();
+    }
+
+public:
+    explicit MmapCSVParser(std::filesystem::path const& path);
+    MmapCSVParser(std::filesystem::path const& path, char separator, bool has_header);
+    explicit MmapCSVParser(CSVConfig const& csv_config);
+
+    Row GetNextRow() override {
+        return reader_.GetNextRow();
+    }
+
+    void GetNextRowView(RowView& row, Row& buffer) override {
+        reader_.GetNextRowView(row, buffer);
+    }
+
+    /* Parts are byte ranges of the mapping cut at line ends, they refer to this parser and must
+     * not outlive it */
+    std::vector<std::unique_ptr<model::IDatasetStream>> SplitRows(size_t parts_num) override;
+
+    bool HasNextRow() const override {
+        return reader_.HasNextRow();
+    }
+
+    char GetSeparator() const {
+        return separator_;
+    }
+
+    size_t GetNumberOfColumns() const override {
+        return number_of_columns_;
+    }
+
+    std::string GetColumnName(size_t index) const override {
+        return column_names_[index];
+    }
+
+    std::string GetRelationName() const override {
+        return relation_name_;
+    }
+
+    std::optional<std::string> GetDataIdentity() const override {
+        return data_identity_;
+    }
+
+    void Reset() override {
+        reader_.Reset();
+    }
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace util {
+
+/// @brief Accounting of a cache that keeps the estimated size of its entries within a budget.
+///
+/// The cache reports the entries it puts in and takes out. Once Admit tells it is over the budget,
+/// it offers its entries to Evict in the order it prefers to lose them. Evict takes them out until
+/// the cached size is down to 3/4 of the budget, which spares ranking the entries on every
+/// admission.
+///
+/// All of the methods may be called from several threads at once.
+class CacheBudget {
+public:
+    struct Stats {
+        /// Requests served from the cache
+        std::size_t hits = 0;
+        /// Requests the entry had to be computed for
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+        /// Estimated size of the cached entries
+        std::size_t cached_bytes = 0;
+        std::size_t peak_cached_bytes = 0;
+    };
+
+private:
+    std::size_t const budget_;
+
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+    std::atomic<std::size_t> evictions_ = 0;
+    std::atomic<std::size_t> cached_bytes_ = 0;
+    std::atomic<std::size_t> peak_cached_bytes_ = 0;
+
+public:
+    explicit CacheBudget(std::size_t budget_bytes) noexcept : budget_(budget_bytes) {}
+
+    void CountHit() noexcept {
+        ++hits_;
+    }
+
+    void CountMiss() noexcept {
+        ++misses_;
+    }
+
+    /// Accounts for an entry put into the cache, returns whether the cache is over the budget.
+    bool Admit(std::size_t bytes) noexcept {
+        std::size_t const cached_bytes = cached_bytes_ += bytes;
+        std::size_t peak = peak_cached_bytes_;
+        while (peak < cached_bytes &&
+               !peak_cached_bytes_.compare_exchange_weak(peak, cached_bytes)) {
+        }
+        return cached_bytes > budget_;
+    }
+
+    /// Accounts for an entry taken out of the cache not to free memory, e.g. a replaced one.
+    void Release(std::size_t bytes) noexcept {
+        cached_bytes_ -= bytes;
+    }
+
+    /// Offers `candidates` in order to `evict` while the cache has to shrink. `evict` takes the
+    /// entry out of the cache and returns its size, or std::nullopt if it is not there anymore.
+    template <typename Candidates, typename EvictFunction>
+    void Evict(Candidates&& candidates, EvictFunction evict) {
+        std::size_t const target = budget_ / 4 * 3;
+        for (auto&& candidate : candidates) {
+            if (cached_bytes_ <= target) break;
+            std::optional<std::size_t> const bytes = evict(candidate);
+            if (!bytes) continue;
+            cached_bytes_ -= *bytes;
+            ++evictions_;
+        }
+    }
+
+    Stats GetStats() const noexcept {
+        return {hits_, misses_, evictions_, cached_bytes_, peak_cached_bytes_};
+    }
+};
+
+}  // namespace util
@@ -1,3 +1,15 @@
 #pragma once
 
-enum class CacheEvictionMethod { kDefault, kMedainUsage, kHottoRemain };
+/// Order in which PLICache evicts partitions once it is over its budget.
+enum class CacheEvictionMethod {
+    /// The least recently used first
+    kDefault,
+    /// Partitions used less often than the median first, the least recently used among them
+    kMedainUsage,
+    /// The least often used first, so that the hot partitions remain
+    kHottoRemain,
+    /// The lowest entropy first, such partitions are the largest and refine the least
+    kLowEntropyFirst,
+    /// The largest size per use first
+    kSizeWeighted
+};
@@ -0,0 +1,50 @@
+#include "core/util/cancellation_token.h"
+
+#include "core/util/memory_usage.h"
+
+namespace util {
+
+void CancellationToken::Start(std::chrono::seconds time_limit, std::size_t mem_limit_bytes) {
+    Clock::time_point const now = Clock::now();
+    deadline_ = time_limit.count() == 0 ? Clock::time_point::max() : now + time_limit;
+    mem_limit_bytes_ = mem_limit_bytes;
+    start_rss_bytes_ = mem_limit_bytes == 0 ? 0 : GetCurrentRssBytes();
+    next_memory_check_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+    State cancelled = State::kCancelled;
+    state_.compare_exchange_strong(cancelled, State::kRunning, std::memory_order_relaxed);
+}
+
+bool CancellationToken::IsOutOfMemory(Clock::time_point now) noexcept {
+    Clock::rep next_check = next_memory_check_.load(std::memory_order_relaxed);
+    if (now.time_since_epoch().count() < next_check) return false;
+    // Only the thread that moves the next check forward queries the memory
+    Clock::rep const following_check = (now + kMemoryCheckInterval).time_since_epoch().count();
+    if (!next_memory_check_.compare_exchange_strong(next_check, following_check,
+                                                    std::memory_order_relaxed)) {
+        return false;
+    }
+    std::size_t const rss_bytes = GetCurrentRssBytes();
+    return rss_bytes > start_rss_bytes_ && rss_bytes - start_rss_bytes_ > mem_limit_bytes_;
+}
+
+bool CancellationToken::IsCancelled() noexcept {
+    switch (state_.load(std::memory_order_relaxed)) {
+        case State::kCancelled:
+            return true;
+        case State::kCancelRequested:
+            state_.store(State::kCancelled, std::memory_order_relaxed);
+            return true;
+        case State::kRunning:
+            break;
+    }
+    if (deadline_ == Clock::time_point::max() && mem_limit_bytes_ == 0) return false;
+
+    Clock::time_point const now = Clock::now();
+    if (now >= deadline_ || (mem_limit_bytes_ != 0 && IsOutOfMemory(now))) {
+        state_.store(State::kCancelled, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+}  // namespace util
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace util {
+
+/// @brief Cooperative cancellation of a long computation.
+///
+/// The computation polls IsCancelled in its loops and stops as soon as it returns true, keeping
+/// what it has found so far. It is cancelled by Cancel, which may be called from any thread, or
+/// when it runs out of the time or memory given to Start. The memory is the growth of the resident
+/// set size of the process since Start, so the data loaded before does not count. It is queried
+/// at most once in kMemoryCheckInterval, polling is cheap enough for inner loops.
+///
+/// A Cancel the computation has not responded to yet, e.g. one that came before Start, is kept
+/// for the next computation, which then stops at its first poll.
+///
+/// IsCancelled may be called from several threads at once.
+class CancellationToken {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State : unsigned char {
+        kRunning,
+        // Cancel was called, IsCancelled has not returned true since
+        kCancelRequested,
+        kCancelled,
+    };
+
+    static constexpr Clock::duration kMemoryCheckInterval = std::chrono::milliseconds(10);
+
+    std::atomic<State> state_ = State::kRunning;
+    Clock::time_point deadline_ = Clock::time_point::max();
+    std::size_t mem_limit_bytes_ = 0;
+    std::size_t start_rss_bytes_ = 0;
+    std::atomic<Clock::rep> next_memory_check_ = 0;
+
+    bool IsOutOfMemory(Clock::time_point now) noexcept;
+
+public:
+    /// Starts a new computation. 0 stands for no limit. The cancellation the previous computation
+    /// stopped at is forgotten, a pending Cancel is not.
+    void Start(std::chrono::seconds time_limit = {}, std::size_t mem_limit_bytes = 0);
+
+    void Cancel() noexcept {
+        State running = State::kRunning;
+        state_.compare_exchange_strong(running, State::kCancelRequested,
+                                       std::memory_order_relaxed);
+    }
+
+    /// Whether the computation must stop. Once it returns true, it keeps returning true until the
+    /// next Start.
+    bool IsCancelled() noexcept;
+
+    /// Whether IsCancelled returned true or Cancel was called since the last Start.
+    [[nodiscard]] bool WasCancelled() const noexcept {
+        return state_.load(std::memory_order_relaxed) != State::kRunning;
+    }
+};
+
+}  // namespace util
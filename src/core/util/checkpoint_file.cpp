@@ -0,0 +1,310 @@
+#include "core/util/checkpoint_file.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <unistd.h>
+
+#include "core/util/logger.h"
+
+namespace util {
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'D', 'E', 'S', 'B', 'C', 'K', 'P', 'T'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::uint32_t kSnapshotFlag = 1;
+constexpr std::size_t kCopyBufferSize = 1 << 20;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint64_t fingerprint_size;
+};
+
+struct RecordHeader {
+    std::uint32_t kind;
+    std::uint32_t flags;
+    std::uint64_t size;
+    std::uint64_t checksum;
+};
+
+// FNV-1a of the header with a zero checksum and of the payload
+std::uint64_t Checksum(RecordHeader header, std::string_view payload) {
+    header.checksum = 0;
+    std::uint64_t hash = 0xcbf29ce484222325;
+    auto add = [&hash](char const* data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 0x100000001b3;
+        }
+    };
+    add(reinterpret_cast<char const*>(&header), sizeof(header));
+    add(payload.data(), payload.size());
+    return hash;
+}
+
+void WriteRaw(std::FILE* file, void const* data, std::size_t size) {
+    if (std::fwrite(data, 1, size, file) != size) {
+        throw std::runtime_error("couldn't write the checkpoint");
+    }
+}
+
+void Sync(std::FILE* file) {
+    if (std::fflush(file) != 0 || fsync(fileno(file)) != 0) {
+        throw std::runtime_error("couldn't flush the checkpoint");
+    }
+}
+
+}  // namespace
+
+void CheckpointEncoder::Write(boost::dynamic_bitset<> const& bitset) {
+    Write<std::uint64_t>(bitset.size());
+    std::vector<boost::dynamic_bitset<>::block_type> blocks(bitset.num_blocks());
+    boost::to_block_range(bitset, blocks.begin());
+    Write(blocks);
+}
+
+boost::dynamic_bitset<> CheckpointDecoder::ReadBitset() {
+    auto const size = Read<std::uint64_t>();
+    auto const blocks = ReadVector<boost::dynamic_bitset<>::block_type>();
+    boost::dynamic_bitset<> bitset(blocks.begin(), blocks.end());
+    if (bitset.size() < size) ThrowCorrupted();
+    bitset.resize(size);
+    return bitset;
+}
+
+CheckpointFile::CheckpointFile(std::filesystem::path path, std::string fingerprint,
+                               std::chrono::seconds snapshot_interval)
+    : path_(std::move(path)), fingerprint_(std::move(fingerprint)),
+      snapshot_interval_(snapshot_interval) {
+    Load();
+    DiscardAfter(records_.size());
+}
+
+CheckpointFile::~CheckpointFile() {
+    Stop();
+}
+
+void CheckpointFile::Load() {
+    std::ifstream in(path_, std::ios::binary);
+    if (!in) return;
+    std::string const data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    std::string_view rest = data;
+
+    FileHeader header;
+    if (rest.size() < sizeof(header)) return;
+    std::memcpy(&header, rest.data(), sizeof(header));
+    rest.remove_prefix(sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion ||
+        header.byte_order_mark != kByteOrderMark || header.fingerprint_size != fingerprint_.size() ||
+        !rest.starts_with(fingerprint_)) {
+        LOG_INFO("Checkpoint {} was made for another input, not resuming", path_.string());
+        return;
+    }
+    rest.remove_prefix(fingerprint_.size());
+    header_size_ = data.size() - rest.size();
+
+    // The records after a torn or corrupted one are lost
+    while (rest.size() >= sizeof(RecordHeader)) {
+        RecordHeader record_header;
+        std::memcpy(&record_header, rest.data(), sizeof(record_header));
+        if (rest.size() - sizeof(record_header) < record_header.size) break;
+        std::string_view const payload = rest.substr(sizeof(record_header), record_header.size);
+        if (Checksum(record_header, payload) != record_header.checksum) break;
+        records_.push_back({record_header.kind, (record_header.flags & kSnapshotFlag) != 0,
+                            std::string{payload}});
+        record_spans_.push_back(
+                {data.size() - rest.size(), sizeof(record_header) + payload.size()});
+        rest.remove_prefix(sizeof(record_header) + payload.size());
+    }
+    if (!records_.empty()) {
+        LOG_INFO("Loaded {} records of checkpoint {}", records_.size(), path_.string());
+    }
+}
+
+void CheckpointFile::Track(Span span, bool is_snapshot) {
+    if (!is_snapshot) {
+        delta_spans_.push_back(span);
+        return;
+    }
+    if (snapshot_span_.has_value()) {
+        dead_bytes_ += snapshot_span_->size;
+    }
+    snapshot_span_ = span;
+}
+
+void CheckpointFile::DiscardAfter(std::size_t num_records) {
+    num_records = std::min(num_records, records_.size());
+    records_.resize(num_records);
+    record_spans_.resize(num_records);
+
+    delta_spans_.clear();
+    snapshot_span_.reset();
+    dead_bytes_ = 0;
+    for (std::size_t i = 0; i < num_records; ++i) {
+        Track(record_spans_[i], records_[i].is_snapshot);
+    }
+    kept_size_ = record_spans_.empty() ? header_size_
+                                       : record_spans_.back().offset + record_spans_.back().size;
+}
+
+void CheckpointFile::Append(std::uint32_t kind, std::string payload) {
+    Enqueue({kind, false, std::move(payload)});
+}
+
+void CheckpointFile::AppendSnapshot(std::uint32_t kind, std::string payload) {
+    last_snapshot_time_ = Clock::now();
+    Enqueue({kind, true, std::move(payload)});
+}
+
+void CheckpointFile::Enqueue(Record record) {
+    std::scoped_lock lock(mutex_);
+    if (failed_ || stopping_) return;
+    pending_.push_back(std::move(record));
+    if (!writer_.joinable()) {
+        writer_ = std::thread(&CheckpointFile::WriteLoop, this);
+    }
+    has_pending_.notify_one();
+}
+
+void CheckpointFile::Stop() {
+    {
+        std::scoped_lock lock(mutex_);
+        stopping_ = true;
+    }
+    has_pending_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    file_.reset();
+}
+
+void CheckpointFile::Remove() {
+    Stop();
+    std::error_code error;
+    std::filesystem::remove(path_, error);
+    std::filesystem::remove(path_.string() + ".tmp", error);
+}
+
+void CheckpointFile::WriteLoop() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        has_pending_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) return;
+        Record const record = std::move(pending_.front());
+        pending_.pop_front();
+        lock.unlock();
+        try {
+            if (file_ == nullptr) Open();
+            Write(record);
+        } catch (std::exception const& e) {
+            // The computation goes on, it just cannot be resumed from this point
+            LOG_WARN("Checkpointing to {} stopped: {}", path_.string(), e.what());
+            lock.lock();
+            failed_ = true;
+            pending_.clear();
+            return;
+        }
+        lock.lock();
+    }
+}
+
+void CheckpointFile::Open() {
+    if (kept_size_ != 0) {
+        std::filesystem::resize_file(path_, kept_size_);
+        file_.reset(std::fopen(path_.c_str(), "ab"));
+        end_ = kept_size_;
+    } else {
+        file_.reset(std::fopen(path_.c_str(), "wb"));
+        if (file_ != nullptr) {
+            FileHeader const header{kMagic, kVersion, kByteOrderMark, fingerprint_.size()};
+            WriteRaw(file_.get(), &header, sizeof(header));
+            WriteRaw(file_.get(), fingerprint_.data(), fingerprint_.size());
+        }
+        end_ = sizeof(FileHeader) + fingerprint_.size();
+    }
+    if (file_ == nullptr) {
+        throw std::runtime_error("couldn't open the file");
+    }
+}
+
+void CheckpointFile::Write(Record const& record) {
+    RecordHeader header{record.kind, record.is_snapshot ? kSnapshotFlag : 0, record.payload.size(),
+                        0};
+    header.checksum = Checksum(header, record.payload);
+    WriteRaw(file_.get(), &header, sizeof(header));
+    WriteRaw(file_.get(), record.payload.data(), record.payload.size());
+    Span const span{end_, sizeof(header) + record.payload.size()};
+    end_ += span.size;
+    Track(span, record.is_snapshot);
+    if (!record.is_snapshot) {
+        if (std::fflush(file_.get()) != 0) {
+            throw std::runtime_error("couldn't write the checkpoint");
+        }
+        return;
+    }
+    // A snapshot is the point a later execution resumes from, it must survive a restart
+    Sync(file_.get());
+    if (dead_bytes_ > end_ - dead_bytes_) {
+        Compact();
+    }
+}
+
+void CheckpointFile::Compact() {
+    std::filesystem::path const tmp_path = path_.string() + ".tmp";
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> source{std::fopen(path_.c_str(), "rb"),
+                                                            &std::fclose};
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> target{std::fopen(tmp_path.c_str(), "wb"),
+                                                            &std::fclose};
+    if (source == nullptr || target == nullptr) {
+        throw std::runtime_error("couldn't open the files to compact the checkpoint");
+    }
+    FileHeader const header{kMagic, kVersion, kByteOrderMark, fingerprint_.size()};
+    WriteRaw(target.get(), &header, sizeof(header));
+    WriteRaw(target.get(), fingerprint_.data(), fingerprint_.size());
+    std::uint64_t end = sizeof(FileHeader) + fingerprint_.size();
+
+    std::vector<char> buffer(kCopyBufferSize);
+    auto copy = [&](Span span) {
+        if (std::fseek(source.get(), static_cast<long>(span.offset), SEEK_SET) != 0) {
+            throw std::runtime_error("couldn't read the checkpoint");
+        }
+        for (std::uint64_t left = span.size; left != 0;) {
+            std::size_t const chunk = std::min<std::uint64_t>(left, buffer.size());
+            if (std::fread(buffer.data(), 1, chunk, source.get()) != chunk) {
+                throw std::runtime_error("couldn't read the checkpoint");
+            }
+            WriteRaw(target.get(), buffer.data(), chunk);
+            left -= chunk;
+        }
+        Span const copied{end, span.size};
+        end += span.size;
+        return copied;
+    };
+    std::vector<Span> delta_spans;
+    delta_spans.reserve(delta_spans_.size());
+    for (Span span : delta_spans_) {
+        delta_spans.push_back(copy(span));
+    }
+    Span const snapshot_span = copy(*snapshot_span_);
+    Sync(target.get());
+    target.reset();
+    source.reset();
+
+    std::filesystem::rename(tmp_path, path_);
+    file_.reset(std::fopen(path_.c_str(), "ab"));
+    if (file_ == nullptr) {
+        throw std::runtime_error("couldn't reopen the compacted checkpoint");
+    }
+    end_ = end;
+    delta_spans_ = std::move(delta_spans);
+    snapshot_span_ = snapshot_span;
+    dead_bytes_ = 0;
+}
+
+}  // namespace util
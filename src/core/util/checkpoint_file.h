@@ -0,0 +1,212 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+namespace util {
+
+/// Builds the payload of a checkpoint record. Values are stored in the native byte order, a
+/// checkpoint is only read on the machine that wrote it.
+class CheckpointEncoder {
+private:
+    std::string data_;
+
+public:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Write(T value) {
+        data_.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Write(std::vector<T> const& values) {
+        Write<std::uint64_t>(values.size());
+        data_.append(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(T));
+    }
+
+    void Write(std::string_view str) {
+        Write<std::uint64_t>(str.size());
+        data_.append(str);
+    }
+
+    void Write(boost::dynamic_bitset<> const& bitset);
+
+    /// Returns the payload and starts a new one.
+    std::string Release() noexcept {
+        std::string data = std::move(data_);
+        data_.clear();
+        return data;
+    }
+};
+
+/// Reads the values written by CheckpointEncoder in the same order, throws std::runtime_error if
+/// the payload ends too early.
+class CheckpointDecoder {
+private:
+    std::string_view data_;
+
+    [[noreturn]] static void ThrowCorrupted() {
+        throw std::runtime_error("Error: checkpoint record is corrupted");
+    }
+
+    std::string_view Take(std::size_t size) {
+        if (data_.size() < size) ThrowCorrupted();
+        std::string_view const taken = data_.substr(0, size);
+        data_.remove_prefix(size);
+        return taken;
+    }
+
+public:
+    explicit CheckpointDecoder(std::string_view data) noexcept : data_(data) {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    T Read() {
+        T value;
+        std::memcpy(&value, Take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    std::vector<T> ReadVector() {
+        auto const size = Read<std::uint64_t>();
+        if (size > data_.size() / sizeof(T)) ThrowCorrupted();
+        std::vector<T> values(size);
+        std::memcpy(values.data(), Take(size * sizeof(T)).data(), size * sizeof(T));
+        return values;
+    }
+
+    std::string ReadString() {
+        auto const size = Read<std::uint64_t>();
+        return std::string{Take(size)};
+    }
+
+    boost::dynamic_bitset<> ReadBitset();
+
+    bool AtEnd() const noexcept {
+        return data_.empty();
+    }
+};
+
+/// @brief Append-only file of the progress of a long computation, which lets a later execution
+/// on the same input resume it.
+///
+/// The computation appends two kinds of records. Deltas, e.g. the dependencies found so far, are
+/// kept until the computation completes. A snapshot of the frontier of the computation supersedes
+/// all the previous ones. Records are written by a background thread, so Append only moves the
+/// payload to a queue and the computation is not stalled by the disk. Once the superseded
+/// snapshots take more space than the live records, the thread copies the live records to a new
+/// file that replaces the old one.
+///
+/// Every record carries a checksum. A record that was being written when the process died is
+/// ignored together with everything after it, so the file can be resumed from after a crash.
+/// The file starts with a fingerprint of the input and the options of the computation, a file
+/// with another fingerprint is not resumed from and is overwritten by the first Append.
+class CheckpointFile {
+public:
+    struct Record {
+        std::uint32_t kind;
+        bool is_snapshot;
+        std::string payload;
+    };
+
+private:
+    // Location of a record in the file, including its header
+    struct Span {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    std::filesystem::path const path_;
+    std::string const fingerprint_;
+    Clock::duration const snapshot_interval_;
+    Clock::time_point last_snapshot_time_ = Clock::now();
+
+    std::vector<Record> records_;
+    std::vector<Span> record_spans_;
+    // Size of the header of the existing file, 0 if it is not resumed from
+    std::uint64_t header_size_ = 0;
+    // Bytes of the existing file that are kept, 0 if it is overwritten
+    std::uint64_t kept_size_ = 0;
+
+    // Owned by the writer thread once it has been started
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file_{nullptr, &std::fclose};
+    std::uint64_t end_ = 0;
+    std::vector<Span> delta_spans_;
+    std::optional<Span> snapshot_span_;
+    std::uint64_t dead_bytes_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable has_pending_;
+    std::deque<Record> pending_;
+    bool stopping_ = false;
+    bool failed_ = false;
+    std::thread writer_;
+
+    void Load();
+    void Track(Span span, bool is_snapshot);
+    void Enqueue(Record record);
+    void Stop();
+    void WriteLoop();
+    void Open();
+    void Write(Record const& record);
+    void Compact();
+
+public:
+    /// Loads the records of a previous execution from `path` if the file exists and was written
+    /// with the same fingerprint. IsSnapshotDue turns true every `snapshot_interval`.
+    CheckpointFile(std::filesystem::path path, std::string fingerprint,
+                   std::chrono::seconds snapshot_interval);
+
+    CheckpointFile(CheckpointFile const&) = delete;
+    CheckpointFile& operator=(CheckpointFile const&) = delete;
+
+    /// Waits for the queued records to be written.
+    ~CheckpointFile();
+
+    /// Intact records of the previous execution in the order they were appended, the superseded
+    /// snapshots that were not compacted away yet included.
+    std::vector<Record> const& GetRecords() const noexcept {
+        return records_;
+    }
+
+    /// Forgets the records of the previous execution after the first `num_records`, e.g. the
+    /// deltas that were appended after its last snapshot and will be found again. Must be called
+    /// before the first Append.
+    void DiscardAfter(std::size_t num_records);
+
+    /// May be called from several threads at once.
+    void Append(std::uint32_t kind, std::string payload);
+
+    /// IsSnapshotDue and AppendSnapshot must be called from one thread.
+    bool IsSnapshotDue() const noexcept {
+        return Clock::now() - last_snapshot_time_ >= snapshot_interval_;
+    }
+
+    void AppendSnapshot(std::uint32_t kind, std::string payload);
+
+    /// Called once the computation has completed, waits for the writer and removes the file.
+    void Remove();
+};
+
+}  // namespace util
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/// \brief tournament tree of losers for merging sorted sequences
+///
+/// The tree knows its sequences only by index, `Less` compares the current elements of two of
+/// them and must order the exhausted ones after all others. Once the current element of the
+/// winner has changed, `Replay` finds the next winner in log(size) comparisons, a binary heap
+/// needs about twice as many.
+template <typename Less>
+class LoserTree {
+private:
+    std::size_t size_;
+    /* losers_[node] is the loser of the match at inner node `node`, losers_[0] is the winner.
+     * The leaves are the nodes size_ .. 2 * size_ - 1, the children of `node` are 2 * node and
+     * 2 * node + 1. */
+    std::vector<std::size_t> losers_;
+    Less less_;
+
+    std::size_t Build(std::size_t node) {
+        if (node >= size_) return node - size_;
+        std::size_t const left = Build(2 * node);
+        std::size_t const right = Build(2 * node + 1);
+        if (less_(right, left)) {
+            losers_[node] = left;
+            return right;
+        }
+        losers_[node] = right;
+        return left;
+    }
+
+public:
+    LoserTree(std::size_t size, Less less) : size_(size), losers_(size), less_(std::move(less)) {
+        assert(size_ != 0);
+        losers_[0] = Build(1);
+    }
+
+    /// index of the sequence with the least current element
+    std::size_t Winner() const noexcept {
+        return losers_[0];
+    }
+
+    /// find the winner again after the current element of the winner has changed
+    void Replay() {
+        std::size_t winner = losers_[0];
+        for (std::size_t node = (winner + size_) / 2; node != 0; node /= 2) {
+            if (less_(losers_[node], winner)) {
+                std::swap(losers_[node], winner);
+            }
+        }
+        losers_[0] = winner;
+    }
+};
+
+}  // namespace util
@@ -0,0 +1,79 @@
+#include "core/util/mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace util {
+
+namespace {
+class FileDescriptor {
+    int fd_;
+
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+
+    ~FileDescriptor() {
+        if (fd_ != -1) close(fd_);
+    }
+
+    int Get() const noexcept {
+        return fd_;
+    }
+};
+}  // namespace
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+    FileDescriptor const fd{open(path.c_str(), O_RDONLY)};
+    if (fd.Get() == -1) {
+        throw std::runtime_error("Error: couldn't find file " + path.string());
+    }
+
+    struct stat file_stat{};
+    if (fstat(fd.Get(), &file_stat) == -1) {
+        throw std::runtime_error("Error: couldn't stat file " + path.string() + ": " +
+                                 std::strerror(errno));
+    }
+    size_ = static_cast<std::size_t>(file_stat.st_size);
+    if (size_ == 0) return;
+
+    void* const mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.Get(), 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Error: couldn't map file " + path.string() + ": " +
+                                 std::strerror(errno));
+    }
+    data_ = static_cast<char const*>(mapping);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::Unmap() noexcept {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+}
+
+void MappedFile::AdviseSequential() const noexcept {
+    if (data_ != nullptr) {
+        madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace util {
+
+/// @brief RAII wrapper around a read-only memory mapping of a whole file.
+/// @remark Empty files are not mapped, Data() returns nullptr for them.
+class MappedFile {
+private:
+    char const* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    void Unmap() noexcept;
+
+public:
+    explicit MappedFile(std::filesystem::path const& path);
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile() {
+        Unmap();
+    }
+
+    char const* Data() const noexcept {
+        return data_;
+    }
+
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    std::string_view View() const noexcept {
+        return {data_, size_};
+    }
+
+    /// Tell the kernel the mapping is going to be read front to back.
+    void AdviseSequential() const noexcept;
+};
+
+}  // namespace util
@@ -0,0 +1,30 @@
+#include "core/util/memory_usage.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <fstream>
+
+namespace util {
+
+std::size_t GetPeakRssBytes() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // Linux reports it in kilobytes
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+std::size_t GetCurrentRssBytes() {
+    // Total program size and resident set size in pages, not available outside of Linux
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size_pages = 0;
+    std::size_t resident_pages = 0;
+    if (!(statm >> size_pages >> resident_pages)) return 0;
+    return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+}  // namespace util
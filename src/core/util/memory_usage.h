@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace util {
+
+/// Peak resident set size of the process in bytes, 0 if it could not be queried.
+std::size_t GetPeakRssBytes();
+
+/// Current resident set size of the process in bytes, 0 if it could not be queried.
+std::size_t GetCurrentRssBytes();
+
+}  // namespace util
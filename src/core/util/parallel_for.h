@@ -1,61 +1,60 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
-#include <system_error>
-#include <thread>
+#include <cstddef>
+#include <iterator>
 #include <vector>
 
-#include "core/util/logger.h"
+#include "core/util/task_scheduler.h"
 
 namespace util {
 
 /* Parallel version of std::for_each which allows to specify the number of threads to use.
  * If threads_num_max == 1 then behaves like a sequential std::for_each.
- * NOTE: actual number of threads to be used is minimum of the
- *       std::distance(begin, end) and threads_num_max.
+ * The elements are processed on the threads of the process-wide TaskScheduler, the calling one
+ * included, so no threads are created per call. The range is split into several chunks per
+ * thread that are handed out as the threads get free, so that elements of uneven cost are
+ * balanced.
+ * NOTE: the same thread may process any number of chunks, f must not rely on the elements being
+ *       processed by a fixed set of threads.
  */
 template <typename It, typename UnaryFunction>
 inline void ParallelForeach(It begin, It end, unsigned const threads_num_max, UnaryFunction f) {
+    // Enough to even out the chunks, few enough for handing them out to be cheap
+    constexpr std::size_t kChunksPerThread = 8;
+
     assert(threads_num_max != 0);
-    auto const length = std::distance(begin, end);
+    auto const length = static_cast<std::size_t>(std::distance(begin, end));
     if (length == 0) {
         return;
     }
-    auto const threads_num_actual =
-            static_cast<unsigned>(std::min(length, static_cast<decltype(length)>(threads_num_max)));
-    auto const items_per_thread = std::distance(begin, end) / threads_num_actual;
-    std::vector<std::thread> threads;
-    threads.reserve(threads_num_actual);
-
-    auto const task = [&f](It first, It last) {
+    auto const process = [&f](It first, It last) {
         for (; first != last; ++first) {
             f(*first);
         }
     };
-
-    It p = begin;
-    for (unsigned i = 0; i < threads_num_actual - 1; ++i) {
-        It prev = p;
-        std::advance(p, items_per_thread);
-        try {
-            threads.emplace_back(task, prev, p);
-        } catch (std::system_error const& e) {
-            /* Could not create a new thread */
-            LOG_WARN("Created {} threads in ParallelForeach. Could not create new thread:",
-                     threads.size(), e.what());
-            /* Fall through to the serial case for the remaining elements */
-            p = prev;
-            break;
-        }
-    }
-
-    for (; p != end; ++p) {
-        f(*p);
+    if (threads_num_max == 1 || length == 1) {
+        process(begin, end);
+        return;
     }
 
-    for (auto& thread : threads) {
-        thread.join();
+    std::size_t const grain =
+            std::max(std::size_t{1}, length / (threads_num_max * kChunksPerThread));
+    std::vector<It> chunk_begins;
+    chunk_begins.reserve(length / grain + 1);
+    for (std::size_t offset = 0; offset < length; offset += grain) {
+        chunk_begins.push_back(begin);
+        std::advance(begin, std::min(grain, length - offset));
     }
+    chunk_begins.push_back(end);
+
+    ParallelFor(
+            0, chunk_begins.size() - 1, 1,
+            [&chunk_begins, &process](std::size_t chunk) {
+                process(chunk_begins[chunk], chunk_begins[chunk + 1]);
+            },
+            threads_num_max);
 }
 
 }  // namespace util
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace util {
+
+/// Transparent string hash: lets unordered containers keyed by std::string be searched by
+/// std::string_view without constructing a temporary key.
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const noexcept {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+}  // namespace util
@@ -0,0 +1,161 @@
+#include "core/util/task_scheduler.h"
+
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "core/util/logger.h"
+
+namespace util {
+
+namespace {
+
+// Scheduler the current thread is a worker of and its index there
+thread_local TaskScheduler const* current_scheduler = nullptr;
+thread_local std::size_t current_index = 0;
+
+TaskScheduler::Task PopFront(std::deque<TaskScheduler::Task>& tasks) {
+    TaskScheduler::Task task = std::move(tasks.front());
+    tasks.pop_front();
+    return task;
+}
+
+}  // namespace
+
+TaskScheduler::TaskScheduler(std::size_t capacity)
+    : capacity_(capacity), worker_queues_(std::make_unique<TaskQueue[]>(capacity)) {}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard lock{sleep_mutex_};
+        stopping_ = true;
+    }
+    sleep_var_.notify_all();
+    // Workers use the queues, they have to be joined first
+    workers_.clear();
+}
+
+TaskScheduler& TaskScheduler::Global() {
+    // Algorithms may be asked for more threads than there are cores, the workers are only
+    // started when requested anyway
+    static TaskScheduler scheduler{
+            std::max(std::size_t{64}, std::size_t{4} * std::thread::hardware_concurrency())};
+    return scheduler;
+}
+
+void TaskScheduler::Reserve(std::size_t num_threads) {
+    std::size_t const num_workers = std::min(num_threads == 0 ? 0 : num_threads - 1, capacity_);
+    if (GetNumWorkers() >= num_workers) return;
+    std::lock_guard lock{grow_mutex_};
+    for (std::size_t index = workers_.size(); index < num_workers; ++index) {
+        try {
+            workers_.emplace_back(&TaskScheduler::WorkerLoop, this, index);
+        } catch (std::system_error const& e) {
+            LOG_WARN("Started {} worker threads, could not start a new one: {}", workers_.size(),
+                     e.what());
+            break;
+        }
+        num_workers_.store(index + 1, std::memory_order::release);
+    }
+}
+
+void TaskScheduler::Spawn(Task task) {
+    TaskQueue& queue = current_scheduler == this ? worker_queues_[current_index] : shared_queue_;
+    // Counted first, so that the counter does not wrap if the task is taken right away
+    num_queued_.fetch_add(1);
+    {
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    if (num_sleeping_.load() != 0) {
+        // A worker that is about to sleep has checked num_queued_ under the mutex
+        { std::lock_guard lock{sleep_mutex_}; }
+        sleep_var_.notify_one();
+    }
+}
+
+TaskScheduler::Task TaskScheduler::TakeTask() {
+    if (num_queued_.load() == 0) return {};
+    bool const is_worker = current_scheduler == this;
+    auto const take = [this](Task task) {
+        num_queued_.fetch_sub(1);
+        return task;
+    };
+    if (is_worker) {
+        TaskQueue& own = worker_queues_[current_index];
+        std::lock_guard lock{own.mutex};
+        if (!own.tasks.empty()) {
+            Task task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return take(std::move(task));
+        }
+    }
+    {
+        std::lock_guard lock{shared_queue_.mutex};
+        if (!shared_queue_.tasks.empty()) return take(PopFront(shared_queue_.tasks));
+    }
+    std::size_t const num_workers = GetNumWorkers();
+    std::size_t const first = is_worker ? current_index + 1 : 0;
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        TaskQueue& victim = worker_queues_[(first + i) % num_workers];
+        std::lock_guard lock{victim.mutex};
+        if (!victim.tasks.empty()) return take(PopFront(victim.tasks));
+    }
+    return {};
+}
+
+bool TaskScheduler::RunPendingTask() {
+    Task task = TakeTask();
+    if (!task) return false;
+    task();
+    return true;
+}
+
+void TaskScheduler::WorkerLoop(std::size_t index) {
+    current_scheduler = this;
+    current_index = index;
+    while (true) {
+        if (RunPendingTask()) continue;
+        std::unique_lock lock{sleep_mutex_};
+        num_sleeping_.fetch_add(1);
+        sleep_var_.wait(lock, [this]() { return stopping_ || num_queued_.load() != 0; });
+        num_sleeping_.fetch_sub(1);
+        if (stopping_) return;
+    }
+}
+
+bool TaskGroup::State::RunNext() {
+    std::unique_lock lock{mutex};
+    if (not_started.empty()) return false;
+    TaskScheduler::Task task = PopFront(not_started);
+    lock.unlock();
+
+    std::exception_ptr task_exception;
+    try {
+        task();
+    } catch (...) {
+        task_exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (task_exception && !exception) {
+        exception = std::move(task_exception);
+    }
+    if (--pending == 0) {
+        done_var.notify_all();
+    }
+    return true;
+}
+
+void TaskGroup::Wait() {
+    // The tasks started by then are running on other threads, the last one to finish wakes us
+    while (state_->RunNext()) {
+    }
+    std::unique_lock lock{state_->mutex};
+    state_->done_var.wait(lock, [this]() { return state_->pending == 0; });
+    if (state_->exception) {
+        std::rethrow_exception(std::exchange(state_->exception, nullptr));
+    }
+}
+
+}  // namespace util
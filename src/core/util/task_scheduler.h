@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/util/auto_join_thread.h"
+
+namespace util {
+
+/// @brief Work-stealing pool of threads shared by the whole process.
+///
+/// Every worker has a deque of tasks of its own. Tasks spawned by a worker are pushed to the back
+/// of its deque and the worker takes them from the back too, idle workers steal from the front of
+/// the deques of the others. Tasks spawned by other threads go to a shared queue.
+///
+/// Workers are started on demand by Reserve, up to the capacity of the scheduler, and live until
+/// the scheduler is destroyed.
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::size_t const capacity_;
+    std::unique_ptr<TaskQueue[]> worker_queues_;
+    TaskQueue shared_queue_;
+    std::atomic<std::size_t> num_workers_ = 0;
+    // Tasks in the queues, not counting the running ones
+    std::atomic<std::size_t> num_queued_ = 0;
+    std::atomic<std::size_t> num_sleeping_ = 0;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_var_;
+    bool stopping_ = false;
+
+    std::mutex grow_mutex_;
+    std::vector<JThread> workers_;
+
+    void WorkerLoop(std::size_t index);
+    Task TakeTask();
+
+public:
+    /// `capacity` is the maximum number of workers.
+    explicit TaskScheduler(std::size_t capacity);
+    TaskScheduler(TaskScheduler const&) = delete;
+    TaskScheduler& operator=(TaskScheduler const&) = delete;
+    ~TaskScheduler();
+
+    static TaskScheduler& Global();
+
+    /// Start workers so that `num_threads` threads, the calling one included, can run tasks.
+    void Reserve(std::size_t num_threads);
+
+    std::size_t GetNumWorkers() const noexcept {
+        return num_workers_.load(std::memory_order::acquire);
+    }
+
+    /// Tasks must not throw, TaskGroup takes care of the exceptions.
+    void Spawn(Task task);
+
+    /// Run one pending task on the calling thread, returns false if there was none.
+    bool RunPendingTask();
+};
+
+/// @brief Tasks run on a TaskScheduler that can be waited for together.
+///
+/// The tasks of the group are kept by the group, the scheduler only gets a ticket for each of
+/// them that runs the next task not started yet. The thread that waits for the group runs the
+/// tasks not started yet itself, never the tasks of others, so groups can be nested in tasks
+/// without a task being reentered on the same thread.
+///
+/// The first exception thrown by a task is rethrown by Wait. The destructor waits for the tasks,
+/// exceptions are lost then.
+class TaskGroup {
+private:
+    // Outlives the group while the scheduler holds tickets for it
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done_var;
+        std::deque<TaskScheduler::Task> not_started;
+        // Tasks not finished yet, the ones not started included
+        std::size_t pending = 0;
+        std::exception_ptr exception;
+
+        /// Run the next task not started yet, returns false if there was none.
+        bool RunNext();
+    };
+
+    TaskScheduler& scheduler_;
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::Global())
+        : scheduler_(scheduler) {}
+
+    TaskGroup(TaskGroup const&) = delete;
+    TaskGroup& operator=(TaskGroup const&) = delete;
+
+    ~TaskGroup() {
+        try {
+            Wait();
+        } catch (...) {
+        }
+    }
+
+    template <typename Function>
+    void Run(Function func) {
+        {
+            std::lock_guard lock{state_->mutex};
+            state_->not_started.emplace_back(std::move(func));
+            ++state_->pending;
+        }
+        scheduler_.Spawn([state = state_]() { state->RunNext(); });
+    }
+
+    void Wait();
+};
+
+/// Call `func(i)` for every i in [begin, end) on up to `max_threads` threads of the scheduler, the
+/// calling one included. The indices are handed out in chunks of `grain` as the threads get free,
+/// so iterations of uneven cost are balanced. With `max_threads` of 0 all the current workers
+/// of the scheduler are used.
+template <typename Function>
+void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, Function const& func,
+                 std::size_t max_threads = 0, TaskScheduler& scheduler = TaskScheduler::Global()) {
+    if (begin >= end) return;
+    grain = std::max(grain, std::size_t{1});
+    std::size_t const num_chunks = (end - begin + grain - 1) / grain;
+    if (max_threads == 0) {
+        max_threads = scheduler.GetNumWorkers() + 1;
+    } else {
+        scheduler.Reserve(max_threads);
+    }
+    std::size_t const num_threads = std::min(max_threads, num_chunks);
+    if (num_threads <= 1) {
+        for (std::size_t i = begin; i != end; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_chunk = 0;
+    auto const work = [&]() {
+        std::size_t chunk;
+        while ((chunk = next_chunk.fetch_add(1, std::memory_order::relaxed)) < num_chunks) {
+            std::size_t const chunk_begin = begin + chunk * grain;
+            std::size_t const chunk_end = std::min(end, chunk_begin + grain);
+            try {
+                for (std::size_t i = chunk_begin; i != chunk_end; ++i) {
+                    func(i);
+                }
+            } catch (...) {
+                // The other threads do not take new chunks then
+                next_chunk.store(num_chunks, std::memory_order::relaxed);
+                throw;
+            }
+        }
+    };
+    TaskGroup group{scheduler};
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        group.Run(work);
+    }
+    work();
+    group.Wait();
+}
+
+}  // namespace util
@@ -1,119 +1,42 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
 #include <cstddef>
-#include <functional>
-#include <future>
 #include <memory>
-#include <mutex>
+#include <utility>
 #include <variant>
-#include <vector>
 
 #include "core/model/index.h"
-#include "core/util/auto_join_thread.h"
-#include "core/util/barrier.h"
 #include "core/util/desbordante_assume.h"
+#include "core/util/task_scheduler.h"
 
 namespace util {
+/// @brief Runs index loops on `thread_num` threads of the process-wide TaskScheduler.
+///
+/// The calling thread takes part in the work. Calls can be nested, the threads waiting for the
+/// inner ones run the pending tasks meanwhile.
 class WorkerThreadPool {
-public:
-    // Must be thread-safe.
-    using Worker = std::function<void()>;
-
 private:
-    struct Completion {
-        WorkerThreadPool& pool;
-
-        void operator()() {
-            pool.SetWorkingStatus(false);
-        }
-    };
-
-    struct DoWork {
-        void operator()(WorkerThreadPool& pool) {
-            DESBORDANTE_ASSUME(pool.work_);
-            try {
-                pool.work_();
-            } catch (...) {
-                pool.barrier_.ArriveAndWait();
-                throw;
-            }
-            pool.barrier_.ArriveAndWait();
-        }
-    };
-
-    Worker work_;
-    std::vector<JThread> worker_threads_;
-    std::vector<std::packaged_task<void(WorkerThreadPool&)>> tasks_;
-    util::Barrier<Completion> barrier_;
-    std::condition_variable working_var_;
-    std::mutex working_mutex_;
-    bool is_working_ = false;
-
-    void SetWorkingStatus(bool value) {
-        std::unique_lock<std::mutex> lk{working_mutex_};
-        is_working_ = value;
-    }
-
-    void Work(std::packaged_task<void(WorkerThreadPool&)>& thread_task) {
-        while (true) {
-            {
-                std::unique_lock<std::mutex> lk{working_mutex_};
-                working_var_.wait(lk, [this]() { return is_working_; });
-            }
-            if (!work_) break;
-            ResetAndWork(thread_task);
-        }
-    }
-
-    void Terminate() {
-        SetWork(nullptr);
-    }
-
-    void ResetAndWork(std::packaged_task<void(WorkerThreadPool&)>& thread_task) {
-        thread_task.reset();
-        thread_task(*this);
-    }
-
-    // Must be called from the main thread to finish.
-    void Wait() {
-        std::packaged_task<void(WorkerThreadPool&)>& main_task = tasks_.front();
-        ResetAndWork(main_task);
-        // Rethrow exceptions
-        for (std::packaged_task<void(WorkerThreadPool&)>& task : tasks_) {
-            task.get_future().get();
-        }
-    }
-
-    // Previous tasks must be finished before calling this.
-    template <typename WorkerType>
-    void SetWork(WorkerType work) {
-        work_ = std::move(work);
-        SetWorkingStatus(true);
-        working_var_.notify_all();
-    }
+    std::size_t thread_num_;
+    TaskScheduler& scheduler_;
 
 public:
     class Waiter {
-        bool active_ = true;
-        WorkerThreadPool& pool_;
+        std::unique_ptr<TaskGroup> group_;
 
     public:
-        Waiter(WorkerThreadPool& pool) : pool_(pool) {}
+        explicit Waiter(TaskScheduler& scheduler)
+            : group_(std::make_unique<TaskGroup>(scheduler)) {}
 
-        ~Waiter() {
-            if (active_) {
-                try {
-                    Wait();
-                } catch (...) {
-                }
-            }
+        Waiter(Waiter&&) = default;
+        Waiter& operator=(Waiter&&) = default;
+
+        TaskGroup& GetGroup() {
+            return *group_;
         }
 
         void Wait() {
-            active_ = false;
-            pool_.Wait();
+            group_->Wait();
         }
     };
 
@@ -122,27 +45,35 @@ public:
     // Return Waiter object to force user to wait on pool.
     template <typename FunctionType>
     [[nodiscard]] Waiter SubmitSingleTask(FunctionType task) {
-        SetWork([task, flag = std::make_shared<std::once_flag>()]() {
-            std::call_once(*flag, task);
-        });
-        return {*this};
+        Waiter waiter{scheduler_};
+        waiter.GetGroup().Run(std::move(task));
+        return waiter;
     }
 
     void ExecIndexWithResource(auto do_work, auto acquire_resource, model::Index size,
                                auto finish) {
         DESBORDANTE_ASSUME(size + ThreadNum() <= std::size_t{} - 1);
         std::atomic<model::Index> index = 0;
-        auto work = [do_work = std::move(do_work), acquire_resource = std::move(acquire_resource),
-                     size, finish = std::move(finish), &index]() {
+        auto work = [&]() {
             model::Index i;
             auto resource = acquire_resource();
-            while ((i = index.fetch_add(1, std::memory_order::acquire)) < size) {
-                do_work(i, resource);
+            try {
+                while ((i = index.fetch_add(1, std::memory_order::acquire)) < size) {
+                    do_work(i, resource);
+                }
+            } catch (...) {
+                // The other threads do not take new indices then
+                index.store(size, std::memory_order::relaxed);
+                throw;
             }
             finish(std::move(resource));
         };
-        SetWork(work);
-        Wait();
+        TaskGroup group{scheduler_};
+        for (std::size_t thread = 1; thread < thread_num_; ++thread) {
+            group.Run(work);
+        }
+        work();
+        group.Wait();
     }
 
     void ExecIndexWithResource(auto do_work, auto acquire_resource, model::Index size) {
@@ -157,17 +88,7 @@ public:
     }
 
     std::size_t ThreadNum() const noexcept {
-        return worker_threads_.size() + 1;
-    }
-
-    ~WorkerThreadPool() {
-        Terminate();
-        // Join workers before any other member is destroyed. Members are
-        // destroyed in reverse declaration order, so worker_threads_ would
-        // otherwise be destroyed AFTER working_mutex_/working_var_, allowing
-        // a worker that is still inside its unique_lock dtor to touch a
-        // destroyed mutex.
-        worker_threads_.clear();
+        return thread_num_;
     }
 };
 }  // namespace util
@@ -2,6 +2,7 @@
 
 #include <pybind11/pybind11.h>
 
+#include <cstddef>
 #include <typeindex>
 #include <typeinfo>
 
@@ -11,6 +12,7 @@
 #include "core/algorithms/algorithm.h"
 #include "core/config/exceptions.h"
 #include "core/config/names.h"
+#include "core/model/table/encoded_relation_cache.h"
 #include "python_bindings/py_util/get_py_type.h"
 #include "python_bindings/py_util/opt_to_py.h"
 #include "python_bindings/py_util/py_to_any.h"
@@ -113,5 +115,15 @@ void BindMainClasses(py::module_& main_module) {
                     },
                     "Process data.");
 #undef CERTAIN_SCRIPTS_ONLY
+
+    main_module.def(
+            "set_relation_cache_budget",
+            [](std::size_t bytes) {
+                model::EncodedRelationCache::Instance().SetMemoryBudget(bytes);
+            },
+            "bytes"_a,
+            "Set how many bytes the tables encoded by algorithms may take in the cache shared by "
+            "all algorithms. Algorithms that load a table already encoded by another algorithm "
+            "reuse it. 0, the default, disables the cache.");
 }
 }  // namespace python_bindings
@@ -3,9 +3,12 @@
 #include <pybind11/pybind11.h>
 
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/model/table/column_combination.h"
+#include "core/model/table/relation_snapshot.h"
+#include "python_bindings/py_util/py_to_any.h"
 
 namespace {
 namespace py = pybind11;
@@ -20,6 +23,20 @@ void BindDataTypes(py::module_& main_module) {
         Currently only used as tags for Algorithm.get_option_type
     )doc";
     py::class_<config::InputTable>(data_module, "Table");
+    data_module.def(
+            "write_snapshot",
+            [](py::handle table, std::filesystem::path const& path) {
+                auto const input_table = boost::any_cast<config::InputTable>(
+                        PyToAny("table", typeid(config::InputTable), table));
+                model::RelationSnapshot::Write(*input_table, path);
+            },
+            py::arg("table"), py::arg("path"),
+            R"doc(
+        Encode the table and write it as a binary snapshot to the given path.
+
+        The path of a snapshot can be passed as a table to any algorithm, loading it
+        skips parsing and encoding of the values.
+    )doc");
 
     using namespace model;
     py::class_<ColumnCombination>(data_module, "ColumnCombination")
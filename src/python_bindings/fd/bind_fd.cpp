@@ -80,6 +80,9 @@ void BindFd(py::module_& main_module) {
             fd_module, &FDAlgorithm::SortedFdList, "FdAlgorithm", "get_fds",
             {"HyFD", "Aid", "EulerFD", "Depminer", "DFD", "FastFDs", "FDep", "FdMine", "FUN",
              kPyroName, kTaneName, kPFDTaneName});
+    // Time and memory limited executions may stop before all FDs are found
+    py::reinterpret_borrow<py::class_<FDAlgorithm, Algorithm>>(fd_module.attr("FdAlgorithm"))
+            .def("is_complete", &FDAlgorithm::IsComplete);
 
     auto define_submodule = [&fd_algos_module, &main_module](char const* name,
                                                              std::vector<char const*> algorithms) {
@@ -127,7 +127,8 @@ void BindOd(py::module_& main_module) {
             BindPrimitiveNoBase<algos::Fastod>(od_module, "Fastod")
                     .def("get_asc_ods", &algos::Fastod::GetAscendingDependencies)
                     .def("get_desc_ods", &algos::Fastod::GetDescendingDependencies)
-                    .def("get_simple_ods", &algos::Fastod::GetSimpleDependencies);
+                    .def("get_simple_ods", &algos::Fastod::GetSimpleDependencies)
+                    .def("is_complete", &algos::Fastod::IsComplete);
     auto order_algos_module =
             BindPrimitiveNoBase<Order>(od_module, "Order").def("get_list_ods", [](Order& algo) {
                 OrderDependencies const& map_res = algo.GetValidODs();
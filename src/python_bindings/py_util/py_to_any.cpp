@@ -28,6 +28,7 @@
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/config/tabular_data/input_tables_type.h"
 #include "core/model/transaction/input_format_type.h"
+#include "core/parser/csv_parser/create_csv_stream.h"
 #include "core/parser/csv_parser/csv_parser.h"
 #include "core/parser/sequence_parser/file_sequence_parser.h"
 #include "core/util/enum_to_available_values.h"
@@ -52,20 +53,30 @@ T CastAndReplaceCastError(std::string_view option_name, py::handle value) {
 }
 
 config::InputTable CreateCsvParser(std::string_view option_name, py::tuple const& arguments) {
-    if (py::len(arguments) != 3) {
+    std::size_t const arguments_num = py::len(arguments);
+    if (arguments_num != 3 && arguments_num != 4) {
         throw config::ConfigurationError("Cannot create a CSV parser from passed tuple.");
     }
 
-    return std::make_shared<CSVParser>(
-            CastAndReplaceCastError<std::string>(option_name, arguments[0]),
-            CastAndReplaceCastError<char>(option_name, arguments[1]),
-            CastAndReplaceCastError<bool>(option_name, arguments[2]));
+    CSVConfig csv_config{CastAndReplaceCastError<std::string>(option_name, arguments[0]),
+                         CastAndReplaceCastError<char>(option_name, arguments[1]),
+                         CastAndReplaceCastError<bool>(option_name, arguments[2])};
+    if (arguments_num == 4) {
+        csv_config.memory_mapped = CastAndReplaceCastError<bool>(option_name, arguments[3]);
+    }
+    return CreateCSVStream(csv_config);
 }
 
 config::InputTable PythonObjToInputTable(std::string_view option_name, py::handle obj) {
     if (py::isinstance<py::tuple>(obj)) {
         return CreateCsvParser(option_name, py::cast<py::tuple>(obj));
     }
+    if (py::isinstance<py::str>(obj) ||
+        py::isinstance(obj, py::module_::import("pathlib").attr("Path"))) {
+        // A snapshot, otherwise a CSV file with a header and commas as separators
+        return CreateCSVStream(
+                {CastAndReplaceCastError<std::filesystem::path>(option_name, obj), ',', true});
+    }
     return python_bindings::CreateDataFrameReader(obj);
 }
 
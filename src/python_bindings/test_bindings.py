@@ -200,6 +200,37 @@ class TestPythonBindings(unittest.TestCase):
                 
 
 
+class TestIsComplete(unittest.TestCase):
+    # Neither the time nor the memory of an execution is limited unless asked for
+    def test_default_options(self):
+        for algo in (desb.fd.algorithms.HyFD, desb.fd.algorithms.DFD,
+                     desb.ucc.algorithms.HyUCC, desb.ucc.algorithms.HPIValid):
+            with self.subTest(msg=f"testing is_complete for {algo.__name__}"):
+                testing_algo = algo()
+                testing_algo.load_data(table=("WDC_satellites.csv", ",", True))
+                testing_algo.execute()
+                self.assertTrue(testing_algo.is_complete())
+
+
+class TestTablePath(unittest.TestCase):
+    # A path is loaded as a snapshot if it is one, as a CSV file with a header otherwise
+    def _get_fds(self, table):
+        algo = desb.fd.algorithms.HyFD()
+        algo.load_data(table=table)
+        algo.execute()
+        return set(algo.get_fds())
+
+    def test_csv_and_snapshot_paths(self):
+        csv_table = ("WDC_satellites.csv", ",", True)
+        expected = self._get_fds(csv_table)
+        self.assertEqual(self._get_fds("WDC_satellites.csv"), expected)
+        self.assertEqual(self._get_fds(pathlib.Path("WDC_satellites.csv")), expected)
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            snapshot_path = pathlib.Path(tmp_dir) / "WDC_satellites.bin"
+            desb.data_types.write_snapshot(csv_table, snapshot_path)
+            self.assertEqual(self._get_fds(str(snapshot_path)), expected)
+
+
 class TestMaxFEM(unittest.TestCase):
     # Sequence: event 1 three times, event 2 twice (infrequent at minsup=3),
     # window_size=1 prevents composite episodes.
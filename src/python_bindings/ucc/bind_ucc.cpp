@@ -67,5 +67,8 @@ void BindUcc(py::module_& main_module) {
     BindPrimitive<HPIValid, HyUCC, PyroUCC>(
             ucc_module, py::overload_cast<>(&UCCAlgorithm::UCCList, py::const_), "UccAlgorithm",
             "get_uccs", {"HPIValid", "HyUCC", "PyroUCC"});
+    // Time and memory limited executions may stop before all UCCs are found
+    py::reinterpret_borrow<py::class_<UCCAlgorithm, Algorithm>>(ucc_module.attr("UccAlgorithm"))
+            .def("is_complete", &UCCAlgorithm::IsComplete);
 }
 }  // namespace python_bindings
@@ -27,6 +27,14 @@ inline void FDBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer) {
             "");
     comparer.SetThreshold(hyfd_name, 75);
 
+    // Validation levels are run on the shared pool, the threads are not recreated for each one
+    auto hyfd_parallel_name = runner.RegisterSimpleBenchmark<algos::hyfd::HyFD>(
+            tests::kIowa650k,
+            {{kThreads, static_cast<config::ThreadNumType>(4)},
+             {kMaximumLhs, static_cast<config::MaxLhsType>(2)}},
+            "4 threads");
+    comparer.SetThreshold(hyfd_parallel_name, 75);
+
     auto pyro_name = runner.RegisterSimpleBenchmark<algos::Pyro>(
             tests::kIowa550k,
             {{kError, static_cast<config::ErrorType>(0.0)},
@@ -18,6 +18,8 @@
 #include "tests/benchmark/ind_benchmark.h"
 #include "tests/benchmark/md_benchmark.h"
 #include "tests/benchmark/nar_benchmark.h"
+#include "tests/benchmark/ucc_benchmark.h"
+#include "tests/benchmark/util_benchmark.h"
 
 namespace po = boost::program_options;
 
@@ -28,8 +30,8 @@ int main(int argc, char* argv[]) {
 
     BenchmarkRunner bm_runner;
     BenchmarkComparer bm_comparer;
-    for (auto test_register_func :
-         {ADCBenchmark, DDBenchmark, INDBenchmark, FDBenchmark, MDBenchmark, NARBenchmark}) {
+    for (auto test_register_func : {ADCBenchmark, DDBenchmark, INDBenchmark, FDBenchmark,
+                                    MDBenchmark, NARBenchmark, UCCBenchmark, UtilBenchmark}) {
         test_register_func(bm_runner, bm_comparer);
     }
     bm_runner.ExecuteAll();
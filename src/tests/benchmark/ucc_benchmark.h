@@ -0,0 +1,25 @@
+#pragma once
+
+#include "core/algorithms/ucc/hpivalid/hpivalid.h"
+#include "core/config/names.h"
+#include "core/config/thread_number/type.h"
+#include "tests/benchmark/benchmark_comparer.h"
+#include "tests/benchmark/benchmark_runner.h"
+#include "tests/common/all_csv_configs.h"
+
+namespace benchmark {
+
+inline void UCCBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer) {
+    using namespace config::names;
+
+    // The edges of EpicMeds and Iowa1kk fit in one word, the ones of Flight1k in two, so the
+    // tree search is run on both fixed-width edge types. The tables are among the ones
+    // datasets/CMakeLists.txt downloads, the benchmark cannot run without them.
+    for (auto const& dataset : {tests::kEpicMeds, tests::kIowa1kk, tests::kFlight1k}) {
+        auto hpivalid_name = runner.RegisterSimpleBenchmark<algos::HPIValid>(
+                dataset, {{kThreads, static_cast<config::ThreadNumType>(1)}}, "");
+        comparer.SetThreshold(hpivalid_name, 25);
+    }
+}
+
+}  // namespace benchmark
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "core/util/parallel_for.h"
+#include "tests/benchmark/benchmark_comparer.h"
+#include "tests/benchmark/benchmark_runner.h"
+
+namespace benchmark {
+
+namespace detail {
+
+// Keeps the compiler from throwing away the work done for an element
+inline std::size_t SpinWork(std::size_t iterations) {
+    std::size_t volatile sink = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sink = sink + i;
+    }
+    return sink;
+}
+
+}  // namespace detail
+
+inline void UtilBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer) {
+    constexpr unsigned kThreads = 4;
+
+    // Lots of short calls, like a levelwise algorithm on a wide and short table: dominated by
+    // the cost of getting the threads to work
+    constexpr auto many_calls_name = "ParallelForeach, many small calls";
+    runner.RegisterBenchmark(many_calls_name, [] {
+        constexpr std::size_t kCalls = 100'000;
+        std::vector<std::size_t> elements(4 * kThreads);
+        std::iota(elements.begin(), elements.end(), 0);
+        for (std::size_t call = 0; call < kCalls; ++call) {
+            util::ParallelForeach(elements.begin(), elements.end(), kThreads,
+                                  [](std::size_t element) { detail::SpinWork(element); });
+        }
+    });
+    comparer.SetThreshold(many_calls_name, 30);
+
+    // The cost of an element grows with its index, a fixed split of the range into one part per
+    // thread leaves the last thread with most of the work
+    constexpr auto skewed_name = "ParallelForeach, skewed work";
+    runner.RegisterBenchmark(skewed_name, [] {
+        constexpr std::size_t kElements = 4096;
+        std::vector<std::size_t> elements(kElements);
+        std::iota(elements.begin(), elements.end(), 0);
+        for (int repeat = 0; repeat < 10; ++repeat) {
+            util::ParallelForeach(elements.begin(), elements.end(), kThreads,
+                                  [](std::size_t element) {
+                                      detail::SpinWork(element * element / 64);
+                                  });
+        }
+    });
+    comparer.SetThreshold(skewed_name, 30);
+}
+
+}  // namespace benchmark
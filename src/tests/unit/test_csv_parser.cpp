@@ -98,4 +98,51 @@ TEST(TestCSVParser, TestReset) {
     CheckReset(kTest1, 20);
 }
 
+static void CheckMmapParserMatches(CSVConfig table) {
+    CSVParser parser{table};
+    table.memory_mapped = true;
+    config::InputTable mmap_parser = MakeInputTable(table);
+
+    ASSERT_EQ(parser.GetNumberOfColumns(), mmap_parser->GetNumberOfColumns())
+            << "Fail on " << table.path;
+    for (std::size_t index = 0; index < parser.GetNumberOfColumns(); index++) {
+        ASSERT_EQ(parser.GetColumnName(index), mmap_parser->GetColumnName(index))
+                << "Fail on " << table.path;
+    }
+
+    model::IDatasetStream::RowView row_view;
+    model::IDatasetStream::Row row_buffer;
+    for (std::size_t row_index = 0; parser.HasNextRow(); row_index++) {
+        ASSERT_TRUE(mmap_parser->HasNextRow()) << "Fail on " << table.path;
+        std::vector<std::string> expected = parser.GetNextRow();
+        if (row_index % 2 == 0) {
+            ASSERT_THAT(mmap_parser->GetNextRow(), ContainerEq(expected))
+                    << "Fail on " << table.path << ", row " << row_index;
+        } else {
+            mmap_parser->GetNextRowView(row_view, row_buffer);
+            std::vector<std::string> actual{row_view.begin(), row_view.end()};
+            ASSERT_THAT(actual, ContainerEq(expected))
+                    << "Fail on " << table.path << ", row " << row_index;
+        }
+    }
+    ASSERT_FALSE(mmap_parser->HasNextRow()) << "Fail on " << table.path;
+}
+
+TEST(TestCSVParser, TestMmapParserMatchesCSVParser) {
+    CheckMmapParserMatches(kNullEmpty);
+    CheckMmapParserMatches(kTestSingleColumn);
+    CheckMmapParserMatches(kTestWide);
+    CheckMmapParserMatches(kTestEmpty);
+    CheckMmapParserMatches(kTestParse);
+    CheckMmapParserMatches(kCIPublicHighway700);
+    CheckMmapParserMatches(kTest1);
+    CheckMmapParserMatches(kACShippingDates);
+}
+
+TEST(TestCSVParser, TestMmapParserReset) {
+    CSVConfig table = kACShippingDates;
+    table.memory_mapped = true;
+    CheckReset(table, 6);
+}
+
 }  // namespace tests
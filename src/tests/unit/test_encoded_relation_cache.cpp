@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/algorithms/algo_factory.h"
+#include "core/algorithms/fd/hyfd/hyfd.h"
+#include "core/algorithms/fd/tane/tane.h"
+#include "core/config/names.h"
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/encoded_relation_cache.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+
+namespace fs = std::filesystem;
+using model::EncodedRelationCache;
+
+class EncodedRelationCacheTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t kBudget = 1 << 30;
+
+    EncodedRelationCache& cache_ = EncodedRelationCache::Instance();
+
+    void SetUp() override {
+        cache_.Clear();
+        cache_.SetMemoryBudget(kBudget);
+    }
+
+    void TearDown() override {
+        cache_.SetMemoryBudget(0);
+        cache_.Clear();
+    }
+};
+
+TEST_F(EncodedRelationCacheTest, IsDisabledByDefault) {
+    cache_.SetMemoryBudget(0);
+    auto first = ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kTestFD));
+    auto second = ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kTestFD));
+    EXPECT_NE(first, second);
+    EXPECT_EQ(cache_.GetNumEntries(), 0);
+}
+
+TEST_F(EncodedRelationCacheTest, SharesEncodedTable) {
+    auto relation = ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kTestFD));
+    EXPECT_EQ(relation, ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kTestFD), 4));
+    EXPECT_GT(cache_.GetMemoryUsage(), 0);
+
+    // Other tables, options of parsing and kinds of encoding are cached separately
+    CSVConfig no_header = kTestFD;
+    no_header.has_header = false;
+    EXPECT_NE(relation, ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(no_header)));
+    EXPECT_NE(relation,
+              ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kCIPublicHighway700)));
+    auto typed = model::ColumnLayoutTypedRelationData::CreateCachedFrom(*MakeInputTable(kTestFD),
+                                                                        true);
+    EXPECT_NE(typed, model::ColumnLayoutTypedRelationData::CreateCachedFrom(
+                             *MakeInputTable(kTestFD), false));
+    EXPECT_EQ(typed, model::ColumnLayoutTypedRelationData::CreateCachedFrom(
+                             *MakeInputTable(kTestFD), true));
+    EXPECT_EQ(cache_.GetNumEntries(), 5);
+}
+
+TEST_F(EncodedRelationCacheTest, NoticesChangedFiles) {
+    fs::path const path = fs::temp_directory_path() / "encoded_relation_cache_test.csv";
+    {
+        std::ofstream file(path);
+        file << "a,b\n1,2\n";
+    }
+    CSVConfig const csv_config{path, ',', true};
+    auto relation = ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(csv_config));
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "3,4\n";
+    }
+    auto changed = ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(csv_config));
+    fs::remove(path);
+    EXPECT_EQ(relation->GetNumRows(), 1);
+    EXPECT_EQ(changed->GetNumRows(), 2);
+}
+
+TEST_F(EncodedRelationCacheTest, EvictsOnlyUnusedData) {
+    auto relation = ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kTestFD));
+    ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kCIPublicHighway700));
+    ASSERT_EQ(cache_.GetNumEntries(), 2);
+
+    cache_.SetMemoryBudget(1);
+    EXPECT_EQ(cache_.GetNumEntries(), 1);
+    EXPECT_EQ(relation, ColumnLayoutRelationData::CreateCachedFrom(*MakeInputTable(kTestFD)));
+
+    relation.reset();
+    cache_.SetMemoryBudget(1);
+    EXPECT_EQ(cache_.GetNumEntries(), 0);
+    EXPECT_EQ(cache_.GetMemoryUsage(), 0);
+}
+
+TEST_F(EncodedRelationCacheTest, AlgorithmsShareTable) {
+    algos::StdParamsMap const params{{config::names::kCsvConfig, kCIPublicHighway700}};
+    cache_.SetMemoryBudget(0);
+    auto expected_tane = algos::CreateAndLoadAlgorithm<algos::Tane>(params);
+    expected_tane->Execute();
+    auto expected_hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params);
+    expected_hyfd->Execute();
+
+    cache_.SetMemoryBudget(kBudget);
+    auto tane = algos::CreateAndLoadAlgorithm<algos::Tane>(params);
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params);
+    EXPECT_EQ(cache_.GetNumEntries(), 1);
+    tane->Execute();
+    hyfd->Execute();
+    EXPECT_EQ(tane->GetJsonFDs(), expected_tane->GetJsonFDs());
+    EXPECT_EQ(hyfd->GetJsonFDs(), expected_hyfd->GetJsonFDs());
+}
+
+}  // namespace tests
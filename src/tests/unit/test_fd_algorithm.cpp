@@ -1,17 +1,38 @@
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "core/algorithms/fd/aidfd/aid.h"
 #include "core/algorithms/fd/depminer/depminer.h"
 #include "core/algorithms/fd/dfd/dfd.h"
 #include "core/algorithms/fd/fastfds/fastfds.h"
+#include "core/algorithms/fd/fd_store.h"
 #include "core/algorithms/fd/fdep/fdep.h"
 #include "core/algorithms/fd/fun/fun.h"
 #include "core/algorithms/fd/hyfd/hyfd.h"
 #include "core/algorithms/fd/pyro/pyro.h"
 #include "core/algorithms/fd/tane/pfdtane.h"
 #include "core/algorithms/fd/tane/tane.h"
+#include "core/algorithms/result_sink.h"
+#include "core/config/checkpoint/type.h"
+#include "core/config/max_lhs/type.h"
+#include "core/config/memory_budget/type.h"
+#include "core/config/names.h"
+#include "core/config/thread_number/type.h"
+#include "core/config/time_limit/type.h"
 #include "core/model/table/relational_schema.h"
 #include "tests/unit/test_fd_util.h"
 
@@ -161,4 +182,532 @@ using Algorithms =
                          algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane>;
 INSTANTIATE_TYPED_TEST_SUITE_P(AlgorithmTest, AlgorithmTest, Algorithms);
 
+template <typename T>
+class FlatPliAlgorithmTest : public AlgorithmTest<T> {};
+
+using FlatPliAlgorithms = ::testing::Types<algos::Tane, algos::Pyro, algos::DFD, algos::PFDTane>;
+TYPED_TEST_SUITE(FlatPliAlgorithmTest, FlatPliAlgorithms);
+
+TYPED_TEST(FlatPliAlgorithmTest, MatchesDefaultLayout) {
+    for (CSVConfig const& csv_config :
+         {kTestFD, kCIPublicHighway700, kWdcAstronomical, kWdcKepler, kLineItem}) {
+        for (config::ErrorType error : {0.0, 0.05}) {
+            algos::StdParamsMap params = TestFixture::GetParamMap(csv_config);
+            params[config::names::kError] = error;
+            auto expected = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+            expected->Execute();
+
+            params[config::names::kFlatPli] = true;
+            auto actual = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+            actual->Execute();
+            ASSERT_TRUE(CheckFdListEquality(FDsToSet(expected->FdList()), actual->FdList()))
+                    << csv_config.path.filename() << ", error " << error;
+        }
+    }
+}
+
+// The lattice traversals of Tane, PFDTane and FUN, the tuple pair comparison of FDep, the
+// negative cover of AID-FD and the validation and induction of HyFD run on several threads
+template <typename T>
+class ParallelAlgorithmTest : public AlgorithmTest<T> {};
+
+using ParallelAlgorithms = ::testing::Types<algos::Tane, algos::PFDTane, algos::FUN, algos::FDep,
+                                            algos::Aid, algos::hyfd::HyFD>;
+TYPED_TEST_SUITE(ParallelAlgorithmTest, ParallelAlgorithms);
+
+TYPED_TEST(ParallelAlgorithmTest, MatchesSequential) {
+    auto to_strings = [](std::list<FD> const& fds) {
+        std::vector<std::string> strings;
+        for (FD const& fd : fds) {
+            strings.push_back(fd.ToLongString());
+        }
+        return strings;
+    };
+    for (CSVConfig const& csv_config :
+         {kTestFD, kCIPublicHighway700, kWdcAstronomical, kWdcKepler, kLineItem}) {
+        algos::StdParamsMap params = TestFixture::GetParamMap(csv_config);
+        params[config::names::kThreads] = config::ThreadNumType{1};
+        auto expected = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+        expected->Execute();
+
+        params[config::names::kThreads] = config::ThreadNumType{4};
+        auto actual = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+        actual->Execute();
+        // The order of the FDs must not depend on the number of threads either
+        ASSERT_EQ(to_strings(expected->FdList()), to_strings(actual->FdList()))
+                << csv_config.path.filename();
+    }
+}
+
+// The attribute sets of FDep are 64, 128 or 256 bits wide or dynamic depending on the width of the
+// table. The first column is a key, the last one is its copy, the others are constant.
+TEST(FDepTest, WorksOnTablesOfAnyWidth) {
+    ::testing::TestInfo const* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    for (unsigned num_columns : {10u, 100u, 200u, 300u}) {
+        fs::path const path = fs::temp_directory_path() /
+                              (std::string(test_info->test_suite_name()) + '_' +
+                               test_info->name() + '_' + std::to_string(num_columns) + ".csv");
+        {
+            std::ofstream file(path);
+            for (unsigned row = 0; row < 4; ++row) {
+                for (unsigned column = 0; column < num_columns; ++column) {
+                    bool const is_key = column == 0 || column == num_columns - 1;
+                    file << (is_key ? row : column) << (column + 1 == num_columns ? '\n' : ',');
+                }
+            }
+        }
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::FDep>(
+                {{config::names::kCsvConfig, CSVConfig{path, ',', false}}});
+        algorithm->Execute();
+        std::remove(path.c_str());
+
+        std::set<std::pair<std::vector<unsigned int>, unsigned int>> expected = {
+                {{0}, num_columns - 1}, {{num_columns - 1}, 0}};
+        for (unsigned column = 1; column < num_columns - 1; ++column) {
+            expected.emplace(std::vector<unsigned int>{}, column);
+        }
+        ASSERT_EQ(FDsToSet(algorithm->FdList()), expected) << num_columns << " columns";
+    }
+}
+
+namespace {
+// 130 columns take three blocks per LHS
+std::shared_ptr<RelationalSchema const> MakeWideSchema() {
+    auto schema = std::make_shared<RelationalSchema>("wide");
+    for (int i = 0; i < 130; ++i) {
+        schema->AppendColumn("c" + std::to_string(i));
+    }
+    return schema;
+}
+}  // namespace
+
+TEST(FdStoreTest, MaterializesInRegistrationOrder) {
+    std::shared_ptr<RelationalSchema const> schema = MakeWideSchema();
+    std::vector<FD> expected;
+    for (model::ColumnIndex rhs : {129u, 0u, 64u}) {
+        boost::dynamic_bitset<> lhs(schema->GetNumColumns());
+        lhs.set(rhs == 0 ? 129 : 0).set(63).set(rhs == 64 ? 65 : 64);
+        expected.emplace_back(Vertical(schema.get(), lhs), *schema->GetColumn(rhs), schema);
+    }
+    expected.emplace_back(Vertical(), *schema->GetColumn(5), schema);
+
+    algos::FdStore store;
+    for (FD const& fd : expected) {
+        store.Register(fd);
+    }
+    ASSERT_EQ(store.Size(), expected.size());
+
+    std::vector<std::string> json_strings = store.ToJsonStrings();
+    std::list<FD> const& fds = store.AsList();
+    ASSERT_EQ(fds.size(), expected.size());
+    auto fd_it = fds.begin();
+    for (std::size_t i = 0; i < expected.size(); ++i, ++fd_it) {
+        EXPECT_EQ(fd_it->ToLongString(), expected[i].ToLongString());
+        EXPECT_EQ(json_strings[i], expected[i].ToJSONString());
+    }
+
+    store.Clear();
+    EXPECT_EQ(store.Size(), 0);
+    EXPECT_TRUE(store.AsList().empty());
+}
+
+TEST(FdStoreTest, RegistersFromSeveralThreads) {
+    std::shared_ptr<RelationalSchema const> schema = MakeWideSchema();
+    constexpr unsigned kThreads = 4;
+    constexpr unsigned kFdsPerThread = 1000;
+    algos::FdStore store;
+    auto register_fds = [&store, &schema](unsigned thread) {
+        for (unsigned i = 0; i < kFdsPerThread; ++i) {
+            store.Register(boost::dynamic_bitset<>(schema->GetNumColumns(), i), thread, schema);
+        }
+    };
+    // The main thread registers too, the second time it must not use its shard of the cleared
+    // store
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        store.Clear();
+        std::vector<std::thread> threads;
+        for (unsigned thread = 1; thread < kThreads; ++thread) {
+            threads.emplace_back(register_fds, thread);
+        }
+        register_fds(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(store.Size(), kThreads * kFdsPerThread);
+        std::set<std::pair<std::vector<unsigned int>, unsigned int>> expected;
+        for (unsigned thread = 0; thread < kThreads; ++thread) {
+            for (unsigned i = 0; i < kFdsPerThread; ++i) {
+                expected.emplace(BitsetToIndexVector(boost::dynamic_bitset<>(130, i)), thread);
+            }
+        }
+        ASSERT_EQ(FDsToSet(store.AsList()), expected);
+    }
+}
+
+namespace {
+algos::StdParamsMap TaneParams(CSVConfig const& csv_config, unsigned threads) {
+    return {{config::names::kCsvConfig, csv_config},
+            {config::names::kThreads, config::ThreadNumType(threads)}};
+}
+
+std::unique_ptr<algos::Tane> CreateTane(CSVConfig const& csv_config, unsigned threads) {
+    return algos::CreateAndLoadAlgorithm<algos::Tane>(TaneParams(csv_config, threads));
+}
+}  // namespace
+
+TEST(ResultSinkTest, CallbackReceivesEveryFd) {
+    auto algorithm = CreateTane(kCIPublicHighway700, 4);
+    std::list<FD> streamed;
+    algorithm->SetResultSink(std::make_shared<algos::CallbackResultSink<FD>>(
+            [&streamed](FD const& fd) { streamed.push_back(fd); }));
+    algorithm->Execute();
+    ASSERT_FALSE(streamed.empty());
+    EXPECT_EQ(FDsToSet(streamed), FDsToSet(algorithm->FdList()));
+
+    // Every execution streams its FDs anew
+    streamed.clear();
+    algos::ConfigureFromMap(*algorithm, TaneParams(kCIPublicHighway700, 4));
+    algorithm->Execute();
+    EXPECT_EQ(FDsToSet(streamed), FDsToSet(algorithm->FdList()));
+}
+
+TEST(ResultSinkTest, DoesNotRetainFds) {
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+
+    auto algorithm = CreateTane(kCIPublicHighway700, 1);
+    std::list<FD> streamed;
+    algorithm->SetResultSink(std::make_shared<algos::CallbackResultSink<FD>>(
+                                     [&streamed](FD const& fd) { streamed.push_back(fd); }),
+                             false);
+    algorithm->Execute();
+    EXPECT_TRUE(algorithm->FdList().empty());
+    EXPECT_EQ(FDsToSet(streamed), FDsToSet(expected->FdList()));
+}
+
+TEST(ResultSinkTest, QueueIsDrainedByAnotherThread) {
+    auto algorithm = CreateTane(kCIPublicHighway700, 2);
+    // Much less than the number of FDs, so the algorithm has to wait for the consumer
+    auto queue = std::make_shared<algos::QueueResultSink<FD>>(4);
+    algorithm->SetResultSink(queue, false);
+    std::list<FD> streamed;
+    std::thread consumer([&queue, &streamed]() {
+        while (std::optional<FD> fd = queue->Pop()) {
+            streamed.push_back(std::move(*fd));
+        }
+    });
+    algorithm->Execute();
+    consumer.join();
+
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+    EXPECT_EQ(FDsToSet(streamed), FDsToSet(expected->FdList()));
+}
+
+TEST(ResultSinkTest, WritesFiles) {
+    auto algorithm = CreateTane(kTestFD, 1);
+    ::testing::TestInfo const* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    fs::path const base_path = fs::temp_directory_path() /
+                               (std::string(test_info->test_suite_name()) + '_' + test_info->name());
+    fs::path const ndjson_path = base_path.string() + ".ndjson";
+    algorithm->SetResultSink(std::make_shared<algos::FileResultSink<FD>>(
+            ndjson_path, algos::ResultFileFormat::kNdjson));
+    algorithm->Execute();
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(ndjson_path);
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(std::move(line));
+        }
+    }
+    std::remove(ndjson_path.c_str());
+    std::vector<std::string> expected_lines;
+    for (FD const& fd : algorithm->FdList()) {
+        expected_lines.push_back(fd.ToJSONString());
+    }
+    EXPECT_EQ(lines, expected_lines);
+
+    fs::path const binary_path = base_path.string() + ".bin";
+    algorithm->SetResultSink(std::make_shared<algos::FileResultSink<FD>>(
+            binary_path, algos::ResultFileFormat::kBinary));
+    algos::ConfigureFromMap(*algorithm, TaneParams(kTestFD, 1));
+    algorithm->Execute();
+    std::string contents;
+    {
+        std::ifstream file(binary_path, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    std::remove(binary_path.c_str());
+    // Header, then at least a byte for the LHS size and a byte for the RHS of every FD
+    ASSERT_GE(contents.size(), 6 + 2 * algorithm->FdList().size());
+    EXPECT_EQ(contents.substr(0, 6), std::string("DSNK\x01\x00", 6));
+
+    std::size_t pos = 6;
+    auto const read_varint = [&contents, &pos]() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; pos < contents.size(); shift += 7) {
+            auto const byte = static_cast<unsigned char>(contents[pos++]);
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) return value;
+        }
+        ADD_FAILURE() << "Truncated varint";
+        return value;
+    };
+    std::vector<std::pair<std::vector<model::ColumnIndex>, model::ColumnIndex>> records;
+    while (pos < contents.size()) {
+        std::vector<model::ColumnIndex> lhs(read_varint());
+        for (model::ColumnIndex& index : lhs) {
+            index = read_varint();
+        }
+        records.emplace_back(std::move(lhs), read_varint());
+    }
+    std::vector<std::pair<std::vector<model::ColumnIndex>, model::ColumnIndex>> expected_records;
+    for (FD const& fd : algorithm->FdList()) {
+        expected_records.emplace_back(fd.GetLhsIndices(), fd.GetRhsIndex());
+    }
+    EXPECT_EQ(records, expected_records);
+}
+
+// /dev/full accepts the file to be opened, but every write to it fails
+TEST(ResultSinkTest, ThrowsOnFailedWrite) {
+    if (!fs::exists("/dev/full")) {
+        GTEST_SKIP() << "No /dev/full";
+    }
+    auto algorithm = CreateTane(kTestFD, 1);
+    algorithm->SetResultSink(std::make_shared<algos::FileResultSink<FD>>(
+            "/dev/full", algos::ResultFileFormat::kNdjson));
+    EXPECT_THROW(algorithm->Execute(), std::runtime_error);
+}
+
+TEST(CancellationTest, KeepsFdsFoundSoFar) {
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+    ASSERT_TRUE(expected->IsComplete());
+
+    auto algorithm = CreateTane(kCIPublicHighway700, 1);
+    algos::Tane* tane = algorithm.get();
+    algorithm->SetResultSink(
+            std::make_shared<algos::CallbackResultSink<FD>>([tane](FD const&) { tane->Cancel(); }));
+    algorithm->Execute();
+    EXPECT_FALSE(algorithm->IsComplete());
+    auto const found = FDsToSet(algorithm->FdList());
+    auto const all = FDsToSet(expected->FdList());
+    EXPECT_FALSE(found.empty());
+    EXPECT_LT(found.size(), all.size());
+    EXPECT_TRUE(std::includes(all.begin(), all.end(), found.begin(), found.end()));
+
+    // The next execution starts anew
+    algorithm->SetResultSink(nullptr);
+    algos::ConfigureFromMap(*algorithm, TaneParams(kCIPublicHighway700, 1));
+    algorithm->Execute();
+    EXPECT_TRUE(algorithm->IsComplete());
+    EXPECT_EQ(FDsToSet(algorithm->FdList()), all);
+}
+
+TEST(CancellationTest, CancelBeforeExecutionIsKept) {
+    auto algorithm = CreateTane(kCIPublicHighway700, 1);
+    algorithm->Cancel();
+    algorithm->Execute();
+    EXPECT_FALSE(algorithm->IsComplete());
+
+    // The cancellation the execution stopped at does not carry over to the next one
+    algos::ConfigureFromMap(*algorithm, TaneParams(kCIPublicHighway700, 1));
+    algorithm->Execute();
+    EXPECT_TRUE(algorithm->IsComplete());
+}
+
+TEST(CancellationTest, CompletesWithinLimits) {
+    algos::StdParamsMap params = TaneParams(kCIPublicHighway700, 2);
+    params.emplace(config::names::kTimeLimitSeconds, config::TimeLimitSecondsType(3600));
+    params.emplace(config::names::kMemoryBudgetMB, config::MemoryBudgetMBType(16 * 1024));
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params);
+    hyfd->Execute();
+    EXPECT_TRUE(hyfd->IsComplete());
+    EXPECT_EQ(FDsToSet(hyfd->FdList()), FDsToSet(expected->FdList()));
+    auto dfd = algos::CreateAndLoadAlgorithm<algos::DFD>(params);
+    dfd->Execute();
+    EXPECT_TRUE(dfd->IsComplete());
+    EXPECT_EQ(FDsToSet(dfd->FdList()), FDsToSet(expected->FdList()));
+}
+
+// Neither the time nor the memory of an execution is limited unless asked for
+TEST(CancellationTest, CompletesWithDefaultOptions) {
+    algos::StdParamsMap const params = {{config::names::kCsvConfig, kCIPublicHighway700}};
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params);
+    hyfd->Execute();
+    EXPECT_TRUE(hyfd->IsComplete());
+    EXPECT_EQ(FDsToSet(hyfd->FdList()), FDsToSet(expected->FdList()));
+    auto dfd = algos::CreateAndLoadAlgorithm<algos::DFD>(params);
+    dfd->Execute();
+    EXPECT_TRUE(dfd->IsComplete());
+    EXPECT_EQ(FDsToSet(dfd->FdList()), FDsToSet(expected->FdList()));
+    auto fastfds = algos::CreateAndLoadAlgorithm<algos::FastFDs>(params);
+    fastfds->Execute();
+    EXPECT_TRUE(fastfds->IsComplete());
+    EXPECT_EQ(FDsToSet(fastfds->FdList()), FDsToSet(expected->FdList()));
+}
+
+TEST(CheckpointTest, TaneResumesCancelledExecution) {
+    fs::path const path = fs::temp_directory_path() / "tane_checkpoint_test.bin";
+    fs::remove(path);
+    algos::StdParamsMap params = TaneParams(kCIPublicHighway700, 2);
+    params.emplace(config::names::kCheckpointPath, config::CheckpointPathType(path));
+    params.emplace(config::names::kCheckpointInterval, config::CheckpointIntervalType(0));
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+    auto const all = FDsToSet(expected->FdList());
+
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::Tane>(params);
+    algos::Tane* tane = algorithm.get();
+    // The FDs with the widest LHS are found on the last level, after several snapshots
+    std::size_t num_found = 0;
+    algorithm->SetResultSink(std::make_shared<algos::CallbackResultSink<FD>>(
+            [tane, &num_found, last = all.size()](FD const&) {
+                if (++num_found == last) tane->Cancel();
+            }));
+    algorithm->Execute();
+    ASSERT_FALSE(algorithm->IsComplete());
+    EXPECT_TRUE(fs::exists(path));
+
+    auto resumed = algos::CreateAndLoadAlgorithm<algos::Tane>(params);
+    resumed->Execute();
+    EXPECT_TRUE(resumed->IsComplete());
+    EXPECT_EQ(FDsToSet(resumed->FdList()), all);
+    EXPECT_FALSE(fs::exists(path));
+}
+
+TEST(CheckpointTest, DfdSkipsSavedRhss) {
+    fs::path const path = fs::temp_directory_path() / "dfd_checkpoint_test.bin";
+    fs::remove(path);
+    algos::StdParamsMap const params{
+            {config::names::kCsvConfig, kLineItem},
+            {config::names::kThreads, config::ThreadNumType(1)},
+            {config::names::kCheckpointPath, config::CheckpointPathType(path)}};
+    auto expected = algos::CreateAndLoadAlgorithm<algos::DFD>(params);
+    expected->Execute();
+    auto const all = FDsToSet(expected->FdList());
+    EXPECT_FALSE(fs::exists(path));
+
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::DFD>(params);
+    algos::DFD* dfd = algorithm.get();
+    std::size_t num_found = 0;
+    algorithm->SetResultSink(std::make_shared<algos::CallbackResultSink<FD>>(
+            [dfd, &num_found, half = all.size() / 2](FD const&) {
+                if (++num_found == half) dfd->Cancel();
+            }));
+    algorithm->Execute();
+    ASSERT_FALSE(algorithm->IsComplete());
+    EXPECT_TRUE(fs::exists(path));
+
+    auto resumed = algos::CreateAndLoadAlgorithm<algos::DFD>(params);
+    resumed->Execute();
+    EXPECT_TRUE(resumed->IsComplete());
+    EXPECT_EQ(FDsToSet(resumed->FdList()), all);
+    EXPECT_FALSE(fs::exists(path));
+}
+
+namespace {
+// The checkpoint is removed once the execution completes, a hard link keeps its content. A prefix
+// of it is what an interrupted execution leaves.
+std::string RecordHyfdCheckpoint(algos::StdParamsMap const& params, fs::path const& path) {
+    fs::path const link = path.string() + ".link";
+    fs::remove(path);
+    fs::remove(link);
+    std::ofstream{path};
+    fs::create_hard_link(path, link);
+    algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params)->Execute();
+    std::ifstream in(link, std::ios::binary);
+    std::string checkpoint{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    fs::remove(link);
+    return checkpoint;
+}
+
+void WriteFile(fs::path const& path, std::string_view content) {
+    std::ofstream{path, std::ios::binary | std::ios::trunc}.write(content.data(), content.size());
+}
+}  // namespace
+
+TEST(CheckpointTest, HyfdResumesInterruptedExecution) {
+    fs::path const path = fs::temp_directory_path() / "hyfd_checkpoint_test.bin";
+    algos::StdParamsMap params = TaneParams(kLineItem, 1);
+    params.emplace(config::names::kCheckpointPath, config::CheckpointPathType(path));
+    params.emplace(config::names::kCheckpointInterval, config::CheckpointIntervalType(0));
+    auto expected = CreateTane(kLineItem, 1);
+    expected->Execute();
+    auto const all = FDsToSet(expected->FdList());
+
+    std::string const checkpoint = RecordHyfdCheckpoint(params, path);
+    ASSERT_FALSE(checkpoint.empty());
+    EXPECT_FALSE(fs::exists(path));
+    // Interrupted in the middle of the execution and in the middle of writing the last record,
+    // after the snapshot of the last cycle
+    for (std::size_t size : {checkpoint.size() / 2, checkpoint.size() - 1}) {
+        WriteFile(path, std::string_view{checkpoint}.substr(0, size));
+        auto resumed = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params);
+        resumed->Execute();
+        EXPECT_TRUE(resumed->IsComplete());
+        EXPECT_EQ(FDsToSet(resumed->FdList()), all) << size << " bytes of the checkpoint";
+        EXPECT_FALSE(fs::exists(path));
+    }
+}
+
+// A checkpoint made with other options or of another table is not resumed from
+TEST(CheckpointTest, HyfdStartsOverOnAnotherInput) {
+    fs::path const path = fs::temp_directory_path() / "hyfd_checkpoint_input_test.bin";
+    fs::path const half_table_path = fs::temp_directory_path() / "hyfd_checkpoint_input_test.csv";
+    auto const with_checkpoint = [&path](algos::StdParamsMap params) {
+        params.emplace(config::names::kCheckpointPath, config::CheckpointPathType(path));
+        params.emplace(config::names::kCheckpointInterval, config::CheckpointIntervalType(0));
+        return params;
+    };
+    std::string const checkpoint =
+            RecordHyfdCheckpoint(with_checkpoint(TaneParams(kCIPublicHighway700, 1)), path);
+
+    // The first half of the rows of the same table
+    {
+        std::ifstream in(kCIPublicHighway700.path);
+        std::ofstream out(half_table_path);
+        std::string line;
+        for (std::size_t i = 0; i <= 350 && std::getline(in, line); ++i) out << line << '\n';
+    }
+    CSVConfig const half_table{half_table_path, kCIPublicHighway700.separator,
+                               kCIPublicHighway700.has_header};
+    algos::StdParamsMap max_lhs_params = TaneParams(kCIPublicHighway700, 1);
+    max_lhs_params.emplace(config::names::kMaximumLhs, config::MaxLhsType(2));
+    for (algos::StdParamsMap const& params :
+         {max_lhs_params, TaneParams(half_table, 1), TaneParams(kTestFD, 1)}) {
+        auto expected = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params);
+        expected->Execute();
+        WriteFile(path, checkpoint);
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(with_checkpoint(params));
+        algorithm->Execute();
+        EXPECT_EQ(FDsToSet(algorithm->FdList()), FDsToSet(expected->FdList()));
+        EXPECT_FALSE(fs::exists(path));
+    }
+    fs::remove(half_table_path);
+}
+
+// The table is encoded in parallel with the threads option, the execution keeps its value
+TEST(LoadThreadsTest, ExecutionKeepsThreadsSetForLoading) {
+    algos::hyfd::HyFD algorithm;
+    algos::LoadAlgorithmData(algorithm, TaneParams(kCIPublicHighway700, 3));
+    algos::ConfigureFromMap(algorithm, {});
+    auto const opt_values = algorithm.GetOptValues();
+    ASSERT_TRUE(opt_values.contains(config::names::kThreads));
+    EXPECT_EQ(boost::any_cast<config::ThreadNumType>(opt_values.at(config::names::kThreads).value),
+              3u);
+
+    algorithm.Execute();
+    auto expected = CreateTane(kCIPublicHighway700, 1);
+    expected->Execute();
+    EXPECT_EQ(FDsToSet(algorithm.FdList()), FDsToSet(expected->FdList()));
+}
+
 }  // namespace tests
@@ -1,9 +1,12 @@
 #include <algorithm>
+#include <optional>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "core/algorithms/fd/eulerfd/eulerfd.h"
+#include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "core/util/bitset_utils.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/unit/test_fd_util.h"
@@ -99,4 +102,23 @@ REGISTER_TYPED_TEST_SUITE_P(ApproximateFDTest, ThrowsOnEmpty, ReturnsEmptyOnSing
 
 using Algorithms = ::testing::Types<algos::EulerFD>;
 INSTANTIATE_TYPED_TEST_SUITE_P(ApproximateFDTest, ApproximateFDTest, Algorithms);
+
+// The clusters are sampled in batches whose size depends on the number of threads, with the same
+// seed and number of threads the answer must be the same
+TEST(EulerFDTest, ParallelSamplingIsDeterministic) {
+    for (CSVConfig const& csv_config :
+         {kCIPublicHighway700, kWdcAstronomical, kWdcAstrology, kLineItem}) {
+        algos::StdParamsMap params = {
+                {config::names::kCsvConfig, csv_config},
+                {config::names::kCustomRandom, std::optional<int>{47}},
+                {config::names::kThreads, config::ThreadNumType{4}},
+        };
+        auto first = algos::CreateAndLoadAlgorithm<algos::EulerFD>(params);
+        first->Execute();
+        auto second = algos::CreateAndLoadAlgorithm<algos::EulerFD>(params);
+        second->Execute();
+        ASSERT_TRUE(CheckFdListEquality(FDsToSet(first->FdList()), second->FdList()))
+                << csv_config.path.filename();
+    }
+}
 }  // namespace tests
@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gtest/gtest.h>
+
+#include "core/algorithms/ucc/hpivalid/fixed_edge.h"
+
+namespace tests {
+
+namespace {
+template <typename Edge>
+Edge RandomEdge(std::size_t size, std::mt19937& gen, boost::dynamic_bitset<>& expected) {
+    Edge edge(size);
+    expected = boost::dynamic_bitset<>(size);
+    // Sparse and dense edges both
+    std::bernoulli_distribution bit(std::uniform_real_distribution<>(0.0, 1.0)(gen));
+    for (std::size_t pos = 0; pos < size; ++pos) {
+        if (bit(gen)) {
+            edge.set(pos);
+            expected.set(pos);
+        }
+    }
+    return edge;
+}
+}  // namespace
+
+template <typename Edge>
+class FixedEdgeTest : public ::testing::Test {};
+
+using FixedEdges = ::testing::Types<algos::hpiv::FixedEdge<1>, algos::hpiv::FixedEdge<2>,
+                                    algos::hpiv::FixedEdge<4>>;
+TYPED_TEST_SUITE(FixedEdgeTest, FixedEdges);
+
+// Every operation the tree search uses gives the same result as on boost::dynamic_bitset<>
+TYPED_TEST(FixedEdgeTest, BehavesLikeDynamicBitset) {
+    using Edge = TypeParam;
+    std::mt19937 gen(47);
+    std::vector<std::size_t> sizes = {1, Edge::kMaxSize / 2 + 1, Edge::kMaxSize};
+    if (Edge::kMaxSize > 64) sizes.push_back(64);
+    for (std::size_t size : sizes) {
+        for (int round = 0; round < 200; ++round) {
+            boost::dynamic_bitset<> expected_a;
+            boost::dynamic_bitset<> expected_b;
+            Edge a = RandomEdge<Edge>(size, gen, expected_a);
+            Edge b = RandomEdge<Edge>(size, gen, expected_b);
+
+            ASSERT_EQ(a.ToBitset(), expected_a);
+            EXPECT_EQ(a.count(), expected_a.count());
+            EXPECT_EQ(a.any(), expected_a.any());
+            EXPECT_EQ(a.none(), expected_a.none());
+            EXPECT_EQ(a.is_subset_of(b), expected_a.is_subset_of(expected_b));
+            EXPECT_EQ((a & b).is_subset_of(a), true);
+            EXPECT_EQ(a.intersects(b), expected_a.intersects(expected_b));
+            EXPECT_EQ((a & b).ToBitset(), expected_a & expected_b);
+            EXPECT_EQ((a | b).ToBitset(), expected_a | expected_b);
+            EXPECT_EQ((a - b).ToBitset(), expected_a - expected_b);
+            EXPECT_EQ((~a).ToBitset(), ~expected_a);
+            EXPECT_EQ(a == b, expected_a == expected_b);
+            EXPECT_EQ(a == a, true);
+
+            std::size_t found = a.find_first();
+            for (std::size_t pos = expected_a.find_first(); pos != expected_a.npos;
+                 pos = expected_a.find_next(pos)) {
+                ASSERT_EQ(found, pos);
+                EXPECT_TRUE(a[pos]);
+                found = a.find_next(found);
+            }
+            EXPECT_EQ(found, Edge::npos);
+        }
+
+        Edge full(size);
+        full.set();
+        EXPECT_EQ(full.count(), size);
+        EXPECT_EQ(full, ~Edge(size));
+        full.reset(size - 1);
+        EXPECT_EQ(full.count(), size - 1);
+        EXPECT_EQ(full.find_next(size - 2), Edge::npos);
+        full.reset();
+        EXPECT_TRUE(full.none());
+    }
+}
+
+}  // namespace tests
@@ -1,5 +1,7 @@
 #include <cstddef>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -13,6 +15,7 @@
 #include "core/algorithms/md/hymd/hymd.h"
 #include "core/algorithms/md/hymd/preprocessing/column_matches/levenshtein.h"
 #include "core/algorithms/md/hymd/utility/md_less.h"
+#include "core/config/checkpoint/type.h"
 #include "core/config/names.h"
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/model/index.h"
@@ -139,4 +142,48 @@ TEST_F(HyMDTest, AdultMDs) {
     ASSERT_EQ(111u, actual_mds.size());
 }
 
+TEST_F(HyMDTest, ResumesInterruptedExecution) {
+    namespace fs = std::filesystem;
+    using model::md::DecisionBoundary, model::Index;
+    using MdPair = std::pair<std::vector<DecisionBoundary>, std::pair<Index, DecisionBoundary>>;
+    fs::path const path = fs::temp_directory_path() / "hymd_checkpoint_test.bin";
+    fs::path const link = path.string() + ".link";
+    auto const execute = [&path](bool with_checkpoint) {
+        // Takes several snapshots, so that the last one can be torn with an earlier one intact
+        auto param_map = GetParamMap(kCIPublicHighway700, std::nullopt, false);
+        if (with_checkpoint) {
+            param_map[config::names::kCheckpointPath] = config::CheckpointPathType(path);
+            param_map[config::names::kCheckpointInterval] = config::CheckpointIntervalType(0);
+        }
+        auto hymd = algos::CreateAndLoadAlgorithm<algos::hymd::HyMD>(param_map);
+        hymd->Execute();
+        std::vector<MdPair> mds;
+        for (model::MD const& md : hymd->MdList()) {
+            mds.emplace_back(md.GetLhsDecisionBounds(), md.GetRhs());
+        }
+        return mds;
+    };
+    std::vector<MdPair> const expected = execute(false);
+
+    // The checkpoint is removed once the execution completes, a hard link keeps its content. A
+    // prefix of it is what an interrupted execution leaves.
+    fs::remove(path);
+    fs::remove(link);
+    std::ofstream{path};
+    fs::create_hard_link(path, link);
+    EXPECT_EQ(execute(true), expected);
+    std::ifstream in(link, std::ios::binary);
+    std::string const checkpoint{std::istreambuf_iterator<char>(in),
+                                 std::istreambuf_iterator<char>()};
+    fs::remove(link);
+    ASSERT_FALSE(checkpoint.empty());
+
+    // Interrupted in the middle of the execution and in the middle of writing the last snapshot
+    for (std::size_t size : {checkpoint.size() / 2, checkpoint.size() - 1}) {
+        std::ofstream{path, std::ios::binary | std::ios::trunc}.write(checkpoint.data(), size);
+        EXPECT_EQ(execute(true), expected) << size << " bytes of the checkpoint";
+        EXPECT_FALSE(fs::exists(path));
+    }
+}
+
 }  // namespace tests
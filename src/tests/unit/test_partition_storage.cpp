@@ -0,0 +1,111 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gtest/gtest.h>
+
+#include "core/algorithms/fd/dfd/partition_storage/partition_storage.h"
+#include "core/model/table/column_layout_relation_data.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+
+using std::vector;
+
+namespace {
+// Pairs and triples of columns are intersected one by one, the whole schema is probed
+void CollectVerticals(ColumnLayoutRelationData& relation, vector<Vertical>& verticals,
+                      vector<unsigned long long>& expected_neps) {
+    RelationalSchema const* schema = relation.GetSchema();
+    std::size_t const num_columns = relation.GetNumColumns();
+    for (std::size_t i = 0; i < num_columns; ++i) {
+        for (std::size_t j = i + 1; j < num_columns; ++j) {
+            auto pair_pli = relation.GetColumnData(i).GetPositionListIndex()->Intersect(
+                    relation.GetColumnData(j).GetPositionListIndex());
+            boost::dynamic_bitset<> indices(num_columns);
+            verticals.push_back(schema->GetVertical(indices.set(i).set(j)));
+            expected_neps.push_back(pair_pli->GetNepAsLong());
+            if (j + 1 < num_columns) {
+                auto const* next_pli = relation.GetColumnData(j + 1).GetPositionListIndex();
+                verticals.push_back(schema->GetVertical(indices.set(j + 1)));
+                expected_neps.push_back(pair_pli->Intersect(next_pli)->GetNepAsLong());
+            }
+        }
+    }
+    auto all_columns_pli = relation.GetColumnData(0).GetPositionListIndex()->ProbeAll(
+            schema->GetVertical(boost::dynamic_bitset<>(num_columns).set().reset(0)), relation);
+    verticals.push_back(schema->GetVertical(boost::dynamic_bitset<>(num_columns).set()));
+    expected_neps.push_back(all_columns_pli->GetNepAsLong());
+}
+}  // namespace
+
+class PartitionStorageTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(PartitionStorageTest, EvictedPartitionsAreRecomputed) {
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700}) {
+        auto input_table = MakeInputTable(csv_config);
+        auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+        std::size_t const num_columns = relation->GetNumColumns();
+        vector<Vertical> verticals;
+        vector<unsigned long long> expected_neps;
+        CollectVerticals(*relation, verticals, expected_neps);
+
+        // With no budget every partition is evicted right after it is cached
+        PartitionStorage storage{relation.get(), GetParam(), 0};
+        // Requested twice, the second time everything has to be recomputed
+        for (int round = 0; round < 2; ++round) {
+            for (std::size_t k = 0; k < verticals.size(); ++k) {
+                ASSERT_EQ(storage.GetOrCreateNepFor(verticals[k]), expected_neps[k])
+                        << csv_config.path.filename() << ", " << verticals[k].ToString();
+            }
+        }
+        PartitionStorage::Stats const stats = storage.GetStats();
+        EXPECT_EQ(stats.hits, 0u);
+        EXPECT_EQ(stats.misses, 2 * verticals.size());
+        EXPECT_GT(stats.evictions, 0u);
+        EXPECT_EQ(stats.cached_bytes, 0u);
+        EXPECT_EQ(storage.Size(), num_columns);
+    }
+}
+
+TEST_P(PartitionStorageTest, ConcurrentRequestsComputeEachPartitionOnce) {
+    auto input_table = MakeInputTable(kCIPublicHighway700);
+    auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+    vector<Vertical> verticals;
+    vector<unsigned long long> expected_neps;
+    CollectVerticals(*relation, verticals, expected_neps);
+
+    PartitionStorage storage{relation.get(), GetParam()};
+    constexpr std::size_t kThreadNumber = 8;
+    // Every thread asks for the same partitions, each of them starting elsewhere
+    vector<vector<unsigned long long>> neps(kThreadNumber,
+                                            vector<unsigned long long>(verticals.size()));
+    vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreadNumber; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < verticals.size(); ++i) {
+                std::size_t const k = (i + t * verticals.size() / kThreadNumber) % verticals.size();
+                neps[t][k] = storage.GetOrCreateNepFor(verticals[k]);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t t = 0; t < kThreadNumber; ++t) {
+        EXPECT_EQ(neps[t], expected_neps);
+    }
+    PartitionStorage::Stats const stats = storage.GetStats();
+    EXPECT_EQ(stats.hits + stats.misses, kThreadNumber * verticals.size());
+    // A pair may be cached on the way to a triple before it is asked for
+    EXPECT_LE(stats.misses, verticals.size());
+    EXPECT_EQ(stats.evictions, 0u);
+    EXPECT_EQ(stats.cached_bytes, stats.peak_cached_bytes);
+}
+
+INSTANTIATE_TEST_SUITE_P(PartitionStorage, PartitionStorageTest, ::testing::Bool());
+
+}  // namespace tests
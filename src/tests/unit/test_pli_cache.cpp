@@ -0,0 +1,100 @@
+#include <memory>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gtest/gtest.h>
+
+#include "core/algorithms/fd/pyrocommon/core/profiling_context.h"
+#include "core/algorithms/fd/pyrocommon/model/pli_cache.h"
+#include "core/model/table/column_layout_relation_data.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+
+using std::vector;
+
+class PliCacheEvictionTest : public ::testing::TestWithParam<CacheEvictionMethod> {};
+
+TEST_P(PliCacheEvictionTest, EvictedPartitionsAreRecomputed) {
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700}) {
+        auto input_table = MakeInputTable(csv_config);
+        auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+        RelationalSchema const* schema = relation->GetSchema();
+        std::size_t const num_columns = relation->GetNumColumns();
+
+        algos::pyro::Parameters parameters;
+        parameters.sample_size = 0;
+        ProfilingContext context{parameters, relation.get(), nullptr, nullptr,
+                                 CachingMethod::kAllCaching, GetParam(), 0};
+
+        // Pairs and triples of columns are intersected one by one, the whole schema is probed
+        vector<Vertical> verticals;
+        vector<unsigned long long> expected_neps;
+        for (std::size_t i = 0; i < num_columns; ++i) {
+            for (std::size_t j = i + 1; j < num_columns; ++j) {
+                auto pair_pli = relation->GetColumnData(i).GetPositionListIndex()->Intersect(
+                        relation->GetColumnData(j).GetPositionListIndex());
+                boost::dynamic_bitset<> indices(num_columns);
+                verticals.push_back(schema->GetVertical(indices.set(i).set(j)));
+                expected_neps.push_back(pair_pli->GetNepAsLong());
+                if (j + 1 < num_columns) {
+                    auto const* next_pli = relation->GetColumnData(j + 1).GetPositionListIndex();
+                    verticals.push_back(schema->GetVertical(indices.set(j + 1)));
+                    expected_neps.push_back(pair_pli->Intersect(next_pli)->GetNepAsLong());
+                }
+            }
+        }
+        auto all_columns_pli = relation->GetColumnData(0).GetPositionListIndex()->ProbeAll(
+                schema->GetVertical(boost::dynamic_bitset<>(num_columns).set().reset(0)),
+                *relation);
+        verticals.push_back(schema->GetVertical(boost::dynamic_bitset<>(num_columns).set()));
+        expected_neps.push_back(all_columns_pli->GetNepAsLong());
+
+        for (bool flat : {false, true}) {
+            // With no budget every partition is evicted right after it is cached
+            model::PLICache cache{relation.get(), CachingMethod::kAllCaching, GetParam(), 0, 0, 0,
+                                  0, 0, 0, 0, flat, 0};
+            // Requested twice, the second time everything has to be recomputed
+            for (int round = 0; round < 2; ++round) {
+                for (std::size_t k = 0; k < verticals.size(); ++k) {
+                    ASSERT_EQ(cache.GetOrCreateNepFor(verticals[k], &context), expected_neps[k])
+                            << csv_config.path.filename() << ", " << verticals[k].ToString();
+                }
+            }
+            model::PLICache::Stats const stats = cache.GetStats();
+            EXPECT_EQ(stats.hits, 0u);
+            EXPECT_EQ(stats.misses, 2 * verticals.size());
+            EXPECT_GT(stats.evictions, 0u);
+            EXPECT_EQ(stats.cached_bytes, 0u);
+            EXPECT_EQ(cache.Size(), num_columns);
+        }
+    }
+}
+
+TEST_P(PliCacheEvictionTest, NothingIsEvictedWithinBudget) {
+    auto input_table = MakeInputTable(kTestFD);
+    auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+    RelationalSchema const* schema = relation->GetSchema();
+
+    algos::pyro::Parameters parameters;
+    parameters.sample_size = 0;
+    ProfilingContext context{parameters, relation.get(), nullptr, nullptr,
+                             CachingMethod::kAllCaching, GetParam(), 0};
+    model::PLICache& cache = *context.GetPliCache();
+    Vertical const vertical =
+            schema->GetVertical(boost::dynamic_bitset<>(relation->GetNumColumns()).set(0, 3, true));
+    unsigned long long const nep = cache.GetOrCreateNepFor(vertical, &context);
+    EXPECT_EQ(cache.GetOrCreateNepFor(vertical, &context), nep);
+    EXPECT_EQ(context.GetPliCacheHits(), 1u);
+    EXPECT_EQ(context.GetPliCacheEvictions(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(PliCache, PliCacheEvictionTest,
+                         ::testing::Values(CacheEvictionMethod::kDefault,
+                                           CacheEvictionMethod::kMedainUsage,
+                                           CacheEvictionMethod::kHottoRemain,
+                                           CacheEvictionMethod::kLowEntropyFirst,
+                                           CacheEvictionMethod::kSizeWeighted));
+
+}  // namespace tests
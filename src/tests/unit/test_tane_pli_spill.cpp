@@ -0,0 +1,91 @@
+#include <memory>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/algorithms/fd/tane/model/lattice_vertex.h"
+#include "core/algorithms/fd/tane/model/pli_spill_store.h"
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/flat_position_list_index.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+
+using std::vector, std::unique_ptr;
+using ::testing::ContainerEq;
+
+class PliSpillTest : public ::testing::TestWithParam<CSVConfig> {};
+
+TEST_P(PliSpillTest, RestoresEvictedPartitions) {
+    auto input_table = MakeInputTable(GetParam());
+    auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+    RelationalSchema const* schema = relation->GetSchema();
+
+    // With no budget every partition is evicted as soon as it is unpinned
+    model::PliSpillStore store{0, false};
+    model::PliSpillStore flat_store{0, true};
+    vector<unique_ptr<model::LatticeVertex>> vertices;
+    vector<unique_ptr<model::LatticeVertex>> flat_vertices;
+    vector<unique_ptr<model::PLIWS>> expected;
+    for (size_t i = 0; i < relation->GetNumColumns(); ++i) {
+        for (size_t j = i + 1; j < relation->GetNumColumns(); ++j) {
+            Vertical const vertical = schema->GetVertical(
+                    boost::dynamic_bitset<>(relation->GetNumColumns()).set(i).set(j));
+            auto const* lhs = relation->GetColumnData(i).GetPLWSIndex();
+            auto const* rhs = relation->GetColumnData(j).GetPLWSIndex();
+            expected.push_back(lhs->Intersect(rhs));
+
+            auto& vertex = vertices.emplace_back(std::make_unique<model::LatticeVertex>(vertical));
+            vertex->AcquirePLIWithSingletons(lhs->Intersect(rhs));
+            store.Admit(vertex.get());
+            ASSERT_EQ(vertex->GetPositionListIndex(), nullptr);
+
+            auto& flat_vertex =
+                    flat_vertices.emplace_back(std::make_unique<model::LatticeVertex>(vertical));
+            flat_vertex->AcquireFlatPositionListIndex(
+                    model::FlatPLI::CreateFrom(*expected.back()));
+            flat_store.Admit(flat_vertex.get());
+            ASSERT_EQ(flat_vertex->GetFlatPositionListIndex(), nullptr);
+        }
+    }
+    EXPECT_EQ(store.GetNumSpilled(), expected.size());
+    EXPECT_EQ(flat_store.GetNumSpilled(), expected.size());
+
+    // Reloaded twice to check that an evicted partition is not written again
+    for (int round = 0; round < 2; ++round) {
+        for (size_t k = 0; k < expected.size(); ++k) {
+            ASSERT_EQ(vertices[k]->GetNepAsLong(), expected[k]->GetNepAsLong());
+            store.Pin(vertices[k].get());
+            model::PLIWS const* actual = vertices[k]->GetPositionListIndexWithSingletons();
+            ASSERT_NE(actual, nullptr);
+            EXPECT_THAT(actual->GetIndex(), ContainerEq(expected[k]->GetIndex()));
+            EXPECT_THAT(actual->GetSingletons(), ContainerEq(expected[k]->GetSingletons()));
+            EXPECT_EQ(actual->GetSize(), expected[k]->GetSize());
+            EXPECT_EQ(actual->GetNepAsLong(), expected[k]->GetNepAsLong());
+            EXPECT_EQ(actual->GetEntropy(), expected[k]->GetEntropy());
+            EXPECT_EQ(actual->GetInvertedEntropy(), expected[k]->GetInvertedEntropy());
+            EXPECT_EQ(actual->GetGiniImpurity(), expected[k]->GetGiniImpurity());
+            store.Unpin(vertices[k].get());
+
+            ASSERT_EQ(flat_vertices[k]->GetNepAsLong(), expected[k]->GetNepAsLong());
+            flat_store.Pin(flat_vertices[k].get());
+            model::FlatPLI const* flat = flat_vertices[k]->GetFlatPositionListIndex();
+            ASSERT_NE(flat, nullptr);
+            EXPECT_THAT(flat->ToPositionListIndex()->GetIndex(),
+                        ContainerEq(expected[k]->GetIndex()));
+            EXPECT_EQ(flat->GetNepAsLong(), expected[k]->GetNepAsLong());
+            flat_store.Unpin(flat_vertices[k].get());
+        }
+    }
+    EXPECT_EQ(store.GetNumSpilled(), expected.size());
+    EXPECT_EQ(store.GetNumReloaded(), 2 * expected.size());
+    EXPECT_EQ(flat_store.GetNumReloaded(), 2 * expected.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(PliSpillStore, PliSpillTest,
+                         ::testing::Values(kTest1, kNullEmpty, kCIPublicHighway700, kLineItem));
+
+}  // namespace tests
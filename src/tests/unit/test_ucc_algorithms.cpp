@@ -66,11 +66,11 @@ protected:
 public:
     static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config) {
         using namespace config::names;
-        // Here we return StdParamsMap with option kThreads but some algorithms does not need this
-        // option (PyroUCC for example). This does not generate errors, because when creating the
-        // algorithm with function CreateAndLoadAlgorithm only the options necessary for the
-        // algorithm will be used
-        return {{kCsvConfig, csv_config}, {kThreads, threads_}};
+        // Here we return StdParamsMap with options kThreads and kSearchThreads but some
+        // algorithms does not need them (PyroUCC for example). This does not generate errors,
+        // because when creating the algorithm with function CreateAndLoadAlgorithm only the
+        // options necessary for the algorithm will be used
+        return {{kCsvConfig, csv_config}, {kThreads, threads_}, {kSearchThreads, threads_}};
     }
 
     static std::unique_ptr<algos::UCCAlgorithm> CreateAlgorithmInstance(
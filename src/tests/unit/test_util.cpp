@@ -1,14 +1,32 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "core/algorithms/fd/pyrocommon/model/list_agree_set_sample.h"
 #include "core/model/table/agree_set_factory.h"
+#include "core/model/table/column_domain.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/flat_position_list_index.h"
 #include "core/model/table/identifier_set.h"
+#include "core/model/table/pli_intersector.h"
+#include "core/model/table/relation_snapshot.h"
+#include "core/model/table/snapshot_dataset_stream.h"
+#include "core/util/cancellation_token.h"
+#include "core/util/checkpoint_file.h"
 #include "core/util/levenshtein_distance.h"
+#include "core/util/loser_tree.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -98,6 +116,227 @@ TEST(pliwsIntersectChecker, first) {
     ASSERT_THAT(intersection->GetSingletons(), ContainerEq(ans_sngt));
 }
 
+TEST(PliIntersectorTest, Refine) {
+    //                                    0  1  2  3  4  5  6  7  8  9
+    std::vector<int> const probing_table{2, 1, 2, 0, 3, 1, 2, 0, 4, 3};
+    std::vector<int> const cluster{0, 1, 2, 3, 5, 6, 7, 8};
+    model::PliIntersector intersector;
+    auto groups = [&intersector] {
+        deque<vector<int>> groups;
+        for (size_t i = 0; i < intersector.GetNumGroups(); ++i) {
+            groups.emplace_back(intersector.GetGroup(i).begin(), intersector.GetGroup(i).end());
+        }
+        return groups;
+    };
+
+    ASSERT_EQ(intersector.Refine(cluster, probing_table), 6);
+    ASSERT_THAT(groups(), ContainerEq(deque<vector<int>>{{0, 2, 6}, {1, 5}}));
+
+    // Stale counters of the previous call must not leak into this one
+    ASSERT_EQ(intersector.Refine(std::vector<int>{4, 6, 9}, probing_table), 3);
+    ASSERT_THAT(groups(), ContainerEq(deque<vector<int>>{{4, 9}}));
+
+    ASSERT_EQ(intersector.Refine(cluster, probing_table, true), 6);
+    ASSERT_THAT(groups(), ContainerEq(deque<vector<int>>{{0, 2, 6}, {1, 5}, {3, 7}, {8}}));
+    ASSERT_EQ(intersector.GetGroupValue(2), model::PositionListIndex::kSingletonValueId);
+}
+
+class PliProbeTest : public ::testing::TestWithParam<CSVConfig> {};
+
+TEST_P(PliProbeTest, MatchesProbeAll) {
+    auto input_table = MakeInputTable(GetParam());
+    auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+    RelationalSchema const* schema = relation->GetSchema();
+
+    for (size_t i = 0; i < relation->GetNumColumns(); ++i) {
+        model::PositionListIndex* pli = relation->GetColumnData(i).GetPositionListIndex();
+        std::vector<std::vector<int> const*> probing_tables;
+        std::vector<std::unique_ptr<model::PositionListIndex>> expected;
+        for (size_t j = 0; j < relation->GetNumColumns(); ++j) {
+            auto const* that = relation->GetColumnData(j).GetPositionListIndex();
+            probing_tables.push_back(&relation->GetColumnData(j).GetProbingTable());
+            expected.push_back(pli->ProbeAll(
+                    static_cast<Vertical>(*schema->GetColumn(j)), *relation));
+
+            auto const actual = pli->Intersect(that);
+            ASSERT_THAT(actual->GetIndex(), ContainerEq(expected.back()->GetIndex()));
+            ASSERT_EQ(actual->GetNepAsLong(), expected.back()->GetNepAsLong());
+            ASSERT_NEAR(actual->GetEntropy(), expected.back()->GetEntropy(), 1e-9);
+
+            auto const actual_ws = relation->GetColumnData(i).GetPLWSIndex()->Intersect(
+                    relation->GetColumnData(j).GetPLWSIndex());
+            ASSERT_THAT(actual_ws->GetIndex(), ContainerEq(expected.back()->GetIndex()));
+        }
+
+        auto const batch = pli->ProbeBatch(probing_tables);
+        ASSERT_EQ(batch.size(), expected.size());
+        for (size_t j = 0; j < batch.size(); ++j) {
+            ASSERT_THAT(batch[j]->GetIndex(), ContainerEq(expected[j]->GetIndex()));
+            ASSERT_EQ(batch[j]->GetNepAsLong(), expected[j]->GetNepAsLong());
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(PositionListIndex, PliProbeTest,
+                         ::testing::Values(kTest1, kTestWide, kCIPublicHighway700,
+                                           kWdcAstronomical, kWdcSatellites));
+
+class ParallelCreateFromTest : public ::testing::TestWithParam<CSVConfig> {};
+
+TEST_P(ParallelCreateFromTest, MatchesSequential) {
+    CSVConfig csv_config = GetParam();
+    csv_config.memory_mapped = true;
+    auto input_table = MakeInputTable(csv_config);
+    auto const expected = ColumnLayoutRelationData::CreateFrom(*input_table);
+
+    for (config::ThreadNumType threads_num : {2, 3, 8}) {
+        input_table->Reset();
+        auto const actual = ColumnLayoutRelationData::CreateFrom(*input_table, threads_num);
+        ASSERT_EQ(actual->GetNumRows(), expected->GetNumRows());
+        ASSERT_EQ(actual->GetNumColumns(), expected->GetNumColumns());
+        for (size_t i = 0; i < expected->GetNumColumns(); ++i) {
+            auto const& expected_column = expected->GetColumnData(i);
+            auto const& actual_column = actual->GetColumnData(i);
+            EXPECT_THAT(actual_column.GetPositionListIndex()->GetIndex(),
+                        ContainerEq(expected_column.GetPositionListIndex()->GetIndex()));
+            EXPECT_THAT(actual_column.GetProbingTable(),
+                        ContainerEq(expected_column.GetProbingTable()));
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ColumnLayoutRelationData, ParallelCreateFromTest,
+                         ::testing::Values(kTest1, kTestWide, kNullEmpty, kCIPublicHighway700,
+                                           kLineItem, kWdcSatellites));
+
+class FlatPliTest : public ::testing::TestWithParam<CSVConfig> {
+protected:
+    static deque<vector<int>> ToDeque(model::FlatPLI const& pli) {
+        deque<vector<int>> index;
+        for (model::FlatPLI::Cluster cluster : pli.GetIndex()) {
+            index.emplace_back(cluster.begin(), cluster.end());
+        }
+        return index;
+    }
+};
+
+TEST_P(FlatPliTest, MatchesPositionListIndex) {
+    auto input_table = MakeInputTable(GetParam());
+    auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+    RelationalSchema const* schema = relation->GetSchema();
+    std::pmr::monotonic_buffer_resource arena;
+
+    for (size_t i = 0; i < relation->GetNumColumns(); ++i) {
+        model::PositionListIndex* pli = relation->GetColumnData(i).GetPositionListIndex();
+        auto const flat = model::FlatPLI::CreateFrom(*pli, &arena);
+        ASSERT_THAT(ToDeque(*flat), ContainerEq(pli->GetIndex()));
+        ASSERT_THAT(flat->ToPositionListIndex()->GetIndex(), ContainerEq(pli->GetIndex()));
+        ASSERT_EQ(flat->GetNepAsLong(), pli->GetNepAsLong());
+        ASSERT_DOUBLE_EQ(flat->GetEntropy(), pli->GetEntropy());
+        ASSERT_THAT(flat->CalculateProbingTable(),
+                    ContainerEq(*pli->CalculateAndGetProbingTable()));
+
+        for (size_t j = i + 1; j < relation->GetNumColumns(); ++j) {
+            auto const* that = relation->GetColumnData(j).GetPositionListIndex();
+            auto const expected = pli->Intersect(that);
+            auto const actual = flat->Intersect(*model::FlatPLI::CreateFrom(*that, &arena));
+            ASSERT_THAT(ToDeque(*actual), ContainerEq(expected->GetIndex()));
+            ASSERT_EQ(actual->GetNepAsLong(), expected->GetNepAsLong());
+            ASSERT_EQ(actual->GetArena(), &arena);
+        }
+
+        boost::dynamic_bitset<> rest_indices(relation->GetNumColumns());
+        rest_indices.set().reset(i);
+        Vertical const rest = schema->GetVertical(rest_indices);
+        if (rest.GetArity() != 0) {
+            ASSERT_THAT(ToDeque(*flat->ProbeAll(rest, *relation)),
+                        ContainerEq(pli->ProbeAll(rest, *relation)->GetIndex()));
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(FlatPositionListIndex, FlatPliTest,
+                         ::testing::Values(kTest1, kTestWide, kNullEmpty, kCIPublicHighway700,
+                                           kWdcAstronomical, kWdcSatellites, kLineItem));
+
+class RelationSnapshotTest : public ::testing::TestWithParam<CSVConfig> {
+protected:
+    fs::path const snapshot_path_ = fs::temp_directory_path() / "desbordante_test_snapshot.bin";
+
+    void TearDown() override {
+        fs::remove(snapshot_path_);
+    }
+};
+
+TEST_P(RelationSnapshotTest, RoundTrip) {
+    auto input_table = MakeInputTable(GetParam());
+    model::RelationSnapshot::Write(*input_table, snapshot_path_);
+    input_table->Reset();
+    auto const expected = ColumnLayoutRelationData::CreateFrom(*input_table);
+
+    CSVConfig snapshot_config = GetParam();
+    snapshot_config.path = snapshot_path_;
+    auto snapshot_table = MakeInputTable(snapshot_config);
+    ASSERT_NE(dynamic_cast<model::SnapshotDatasetStream*>(snapshot_table.get()), nullptr);
+    ASSERT_EQ(snapshot_table->GetRelationName(), input_table->GetRelationName());
+    ASSERT_EQ(snapshot_table->GetNumberOfColumns(), input_table->GetNumberOfColumns());
+    for (size_t i = 0; i < input_table->GetNumberOfColumns(); ++i) {
+        EXPECT_EQ(snapshot_table->GetColumnName(i), input_table->GetColumnName(i));
+    }
+
+    auto const actual = ColumnLayoutRelationData::CreateFrom(*snapshot_table);
+    EXPECT_FALSE(snapshot_table->HasNextRow());
+    ASSERT_EQ(actual->GetNumRows(), expected->GetNumRows());
+    for (size_t i = 0; i < expected->GetNumColumns(); ++i) {
+        auto const* expected_pli = expected->GetColumnData(i).GetPLWSIndex();
+        auto const* actual_pli = actual->GetColumnData(i).GetPLWSIndex();
+        EXPECT_THAT(actual_pli->GetIndex(), ContainerEq(expected_pli->GetIndex()));
+        EXPECT_THAT(actual_pli->GetSingletons(), ContainerEq(expected_pli->GetSingletons()));
+        EXPECT_EQ(actual_pli->GetEntropy(), expected_pli->GetEntropy());
+        EXPECT_EQ(actual_pli->GetNepAsLong(), expected_pli->GetNepAsLong());
+        EXPECT_THAT(actual->GetColumnData(i).GetProbingTable(),
+                    ContainerEq(expected->GetColumnData(i).GetProbingTable()));
+    }
+
+    // Rows that were not skipped while writing come back unchanged
+    input_table->Reset();
+    snapshot_table->Reset();
+    while (input_table->HasNextRow()) {
+        auto row = input_table->GetNextRow();
+        if (row.size() != input_table->GetNumberOfColumns()) continue;
+        ASSERT_TRUE(snapshot_table->HasNextRow());
+        ASSERT_THAT(snapshot_table->GetNextRow(), ContainerEq(row));
+    }
+    EXPECT_FALSE(snapshot_table->HasNextRow());
+}
+
+INSTANTIATE_TEST_SUITE_P(ColumnLayoutRelationData, RelationSnapshotTest,
+                         ::testing::Values(kTest1, kTestWide, kNullEmpty, kCIPublicHighway700,
+                                           kWdcSatellites));
+
+TEST(RelationSnapshot, RejectsOtherFiles) {
+    EXPECT_FALSE(model::RelationSnapshot::IsSnapshot(kTest1.path));
+    EXPECT_THROW(model::RelationSnapshot{kTest1.path}, std::runtime_error);
+}
+
+// A row count that wraps the size of the codes around to the size of their block
+TEST(RelationSnapshot, RejectsOverflowingRowCount) {
+    fs::path const csv_path = fs::temp_directory_path() / "snapshot_overflow_test.csv";
+    fs::path const snapshot_path = fs::temp_directory_path() / "snapshot_overflow_test.bin";
+    std::ofstream{csv_path} << "a\n";
+    auto input_table = MakeInputTable(CSVConfig{csv_path, ',', true});
+    model::RelationSnapshot::Write(*input_table, snapshot_path);
+    {
+        std::fstream file(snapshot_path, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint64_t const num_rows = std::uint64_t{1} << 62;
+        file.seekp(16);
+        file.write(reinterpret_cast<char const*>(&num_rows), sizeof(num_rows));
+    }
+    EXPECT_THROW(model::RelationSnapshot{snapshot_path}, std::runtime_error);
+    fs::remove(snapshot_path);
+    fs::remove(csv_path);
+}
+
 TEST(pliEntropyTest, first) {
     std::shared_ptr<model::PositionListIndex> res_pli;
 
@@ -293,4 +532,215 @@ INSTANTIATE_TEST_SUITE_P(TestLevenshteinSuite, TestLevenshtein,
                                            TestLevenshteinParam("", "book", 4),
                                            TestLevenshteinParam("randomstring", "juststring", 6)));
 
+TEST(DomainPartitionTest, SwappedRunKeepsSortedDistinctValues) {
+    std::mt19937 gen(17);
+    std::vector<std::string> values;
+    for (int i = 0; i < 5000; ++i) {
+        /* long shared prefixes, duplicates and empty values */
+        values.push_back(std::string(gen() % 40, 'p') + std::to_string(gen() % 2000));
+    }
+    values.emplace_back();
+
+    model::DomainPartition partition{42, 0};
+    for (std::size_t i = 0; i != values.size(); ++i) {
+        partition.Insert(values[i]);
+        /* the values inserted after a compaction are merged with the sorted ones */
+        if (i == values.size() / 2) partition.Compact();
+    }
+    partition.Compact();
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    auto read_all = [&partition] {
+        std::vector<std::string> read;
+        auto reader = partition.GetReader();
+        do {
+            read.emplace_back(reader->GetValue());
+        } while (reader->TryMove());
+        return read;
+    };
+    EXPECT_THAT(read_all(), ContainerEq(values));
+    ASSERT_TRUE(partition.TrySwap());
+    EXPECT_EQ(partition.GetMemoryUsage(), 0);
+    EXPECT_THAT(read_all(), ContainerEq(values));
+}
+
+TEST(DomainPartitionTest, ReadsValueRanges) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 5000; ++i) {
+        values.push_back("value" + std::to_string(i));
+    }
+    model::DomainPartition partition{43, 0};
+    for (std::string const& value : values) {
+        partition.Insert(value);
+    }
+    partition.Compact();
+    std::sort(values.begin(), values.end());
+
+    std::vector<model::DomainValueRange> ranges = {
+            {},
+            {std::nullopt, "value2"},
+            {"value2", "value3"},
+            {"value4999", std::nullopt},
+            {"value2500x", "value2501"},
+            {"a", "b"},
+            {"value3", "value3"},
+            {"value1234", "value2345"}};
+    for (std::size_t i = 1; i < partition.GetSampleValues().size(); ++i) {
+        /* the bounds at the fences of the swapped partition */
+        ranges.push_back({std::string{partition.GetSampleValues()[i - 1]},
+                          std::string{partition.GetSampleValues()[i]}});
+    }
+    auto read_range = [&partition](model::DomainValueRange const& range) {
+        std::vector<std::string> read;
+        auto reader = partition.GetReader(range);
+        if (reader == nullptr) return read;
+        do {
+            read.emplace_back(reader->GetValue());
+        } while (reader->TryMove());
+        return read;
+    };
+    auto expected_range = [&values](model::DomainValueRange const& range) {
+        std::vector<std::string> expected;
+        std::copy_if(values.begin(), values.end(), std::back_inserter(expected),
+                     [&range](std::string const& value) {
+                         return (!range.lower || value >= *range.lower) &&
+                                (!range.upper || value < *range.upper);
+                     });
+        return expected;
+    };
+
+    std::vector<std::vector<std::string>> in_memory;
+    for (auto const& range : ranges) {
+        in_memory.push_back(read_range(range));
+        EXPECT_THAT(in_memory.back(), ContainerEq(expected_range(range)));
+    }
+    ASSERT_TRUE(partition.TrySwap());
+    for (std::size_t i = 0; i != ranges.size(); ++i) {
+        EXPECT_THAT(read_range(ranges[i]), ContainerEq(in_memory[i]));
+    }
+}
+
+namespace {
+std::vector<std::string> GetPayloads(fs::path const& path, std::string const& fingerprint) {
+    util::CheckpointFile const checkpoint{path, fingerprint, std::chrono::seconds(0)};
+    std::vector<std::string> payloads;
+    for (util::CheckpointFile::Record const& record : checkpoint.GetRecords()) {
+        payloads.push_back(record.payload);
+    }
+    return payloads;
+}
+}  // namespace
+
+TEST(CheckpointFileTest, IgnoresTornTrailingRecord) {
+    fs::path const path = fs::temp_directory_path() / "checkpoint_file_torn_test.bin";
+    fs::remove(path);
+    {
+        util::CheckpointFile checkpoint{path, "input", std::chrono::seconds(0)};
+        checkpoint.Append(0, "delta");
+        checkpoint.AppendSnapshot(1, "snapshot");
+    }
+    // The process died while writing the snapshot
+    fs::resize_file(path, fs::file_size(path) - 1);
+    EXPECT_THAT(GetPayloads(path, "input"), ContainerEq(std::vector<std::string>{"delta"}));
+
+    {
+        util::CheckpointFile checkpoint{path, "input", std::chrono::seconds(0)};
+        checkpoint.Append(0, "next delta");
+    }
+    EXPECT_THAT(GetPayloads(path, "input"),
+                ContainerEq(std::vector<std::string>{"delta", "next delta"}));
+    fs::remove(path);
+}
+
+TEST(CheckpointFileTest, StartsOverOnAnotherFingerprint) {
+    fs::path const path = fs::temp_directory_path() / "checkpoint_file_fingerprint_test.bin";
+    fs::remove(path);
+    {
+        util::CheckpointFile checkpoint{path, "input", std::chrono::seconds(0)};
+        checkpoint.AppendSnapshot(0, "snapshot");
+    }
+    {
+        util::CheckpointFile checkpoint{path, "other input", std::chrono::seconds(0)};
+        EXPECT_TRUE(checkpoint.GetRecords().empty());
+        checkpoint.AppendSnapshot(0, "other snapshot");
+    }
+    EXPECT_TRUE(GetPayloads(path, "input").empty());
+    EXPECT_THAT(GetPayloads(path, "other input"),
+                ContainerEq(std::vector<std::string>{"other snapshot"}));
+    fs::remove(path);
+}
+
+TEST(CheckpointFileTest, CompactsSupersededSnapshots) {
+    fs::path const path = fs::temp_directory_path() / "checkpoint_file_compaction_test.bin";
+    fs::remove(path);
+    std::string const delta(10, 'd');
+    auto const snapshot = [](char c) { return std::string(100, c); };
+    {
+        util::CheckpointFile checkpoint{path, "input", std::chrono::seconds(0)};
+        checkpoint.Append(0, delta);
+        checkpoint.AppendSnapshot(1, snapshot('a'));
+        checkpoint.AppendSnapshot(1, snapshot('b'));
+    }
+    // The superseded snapshot takes less space than the live records yet
+    EXPECT_THAT(GetPayloads(path, "input"),
+                ContainerEq(std::vector<std::string>{delta, snapshot('a'), snapshot('b')}));
+    std::uintmax_t const size = fs::file_size(path);
+
+    {
+        util::CheckpointFile checkpoint{path, "input", std::chrono::seconds(0)};
+        checkpoint.AppendSnapshot(1, snapshot('c'));
+    }
+    EXPECT_THAT(GetPayloads(path, "input"),
+                ContainerEq(std::vector<std::string>{delta, snapshot('c')}));
+    EXPECT_LT(fs::file_size(path), size);
+    EXPECT_FALSE(fs::exists(path.string() + ".tmp"));
+    fs::remove(path);
+}
+
+TEST(CancellationTokenTest, KeepsPendingCancel) {
+    util::CancellationToken token;
+    token.Cancel();
+    token.Start();
+    EXPECT_TRUE(token.WasCancelled());
+    EXPECT_TRUE(token.IsCancelled());
+    EXPECT_TRUE(token.IsCancelled());
+
+    token.Start();
+    EXPECT_FALSE(token.WasCancelled());
+    EXPECT_FALSE(token.IsCancelled());
+    token.Cancel();
+    EXPECT_TRUE(token.IsCancelled());
+}
+
+TEST(LoserTreeTest, MergesSortedSequences) {
+    std::mt19937 gen(3);
+    for (std::size_t size : {1, 2, 5, 8, 13}) {
+        std::vector<vector<int>> sequences(size);
+        std::vector<int> expected;
+        for (auto& sequence : sequences) {
+            sequence.resize(gen() % 50);
+            for (int& element : sequence) element = static_cast<int>(gen() % 100);
+            std::sort(sequence.begin(), sequence.end());
+            expected.insert(expected.end(), sequence.begin(), sequence.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<std::size_t> positions(size);
+        auto exhausted = [&](std::size_t i) { return positions[i] == sequences[i].size(); };
+        auto less = [&](std::size_t lhs, std::size_t rhs) {
+            if (exhausted(lhs) || exhausted(rhs)) return !exhausted(lhs);
+            return sequences[lhs][positions[lhs]] < sequences[rhs][positions[rhs]];
+        };
+        util::LoserTree tree{size, less};
+        std::vector<int> merged;
+        while (!exhausted(tree.Winner())) {
+            std::size_t const winner = tree.Winner();
+            merged.push_back(sequences[winner][positions[winner]++]);
+            tree.Replay();
+        }
+        EXPECT_THAT(merged, ContainerEq(expected));
+    }
+}
+
 }  // namespace tests
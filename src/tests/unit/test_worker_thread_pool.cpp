@@ -1,5 +1,15 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "core/util/parallel_for.h"
+#include "core/util/task_scheduler.h"
 #include "core/util/worker_thread_pool.h"
 
 namespace tests {
@@ -14,4 +24,107 @@ TEST(WorkerThreadPool, RepeatedConstructAndDestroyWithoutWork) {
     }
 }
 
+TEST(WorkerThreadPool, PoolsShareWorkers) {
+    std::size_t const num_workers = util::TaskScheduler::Global().GetNumWorkers();
+    for (int i = 0; i < 10; ++i) {
+        util::WorkerThreadPool pool{4};
+    }
+    EXPECT_LE(util::TaskScheduler::Global().GetNumWorkers(), std::max<std::size_t>(num_workers, 3));
+}
+
+TEST(WorkerThreadPool, NestedExecIndex) {
+    util::WorkerThreadPool outer{4};
+    util::WorkerThreadPool inner{3};
+    constexpr std::size_t kSize = 50;
+    std::vector<std::atomic<std::size_t>> counts(kSize);
+    outer.ExecIndex(
+            [&](std::size_t i) { inner.ExecIndex([&](std::size_t j) { ++counts[j]; }, i + 1); },
+            kSize);
+    for (std::size_t j = 0; j < kSize; ++j) {
+        EXPECT_EQ(counts[j], kSize - j);
+    }
+}
+
+TEST(WorkerThreadPool, ExecIndexRethrows) {
+    util::WorkerThreadPool pool{4};
+    EXPECT_THROW(pool.ExecIndex(
+                         [](std::size_t i) {
+                             if (i == 500) throw std::runtime_error("test");
+                         },
+                         1000),
+                 std::runtime_error);
+}
+
+TEST(TaskScheduler, ParallelForVisitsEveryIndexOnce) {
+    for (std::size_t grain : {1, 7, 1000}) {
+        std::vector<std::atomic<int>> visits(10007);
+        util::ParallelFor(3, visits.size(), grain, [&](std::size_t i) { ++visits[i]; }, 4);
+        for (std::size_t i = 0; i < visits.size(); ++i) {
+            ASSERT_EQ(visits[i], i < 3 ? 0 : 1) << "grain " << grain << ", index " << i;
+        }
+    }
+}
+
+TEST(TaskScheduler, ParallelForeachOverForwardIterators) {
+    std::list<std::atomic<int>> visits(1001);
+    for (unsigned threads : {1u, 3u, 2000u}) {
+        util::ParallelForeach(visits.begin(), visits.end(), threads,
+                              [](std::atomic<int>& element_visits) { ++element_visits; });
+    }
+    for (std::atomic<int> const& element_visits : visits) {
+        ASSERT_EQ(element_visits, 3);
+    }
+}
+
+TEST(TaskScheduler, ParallelForRethrows) {
+    EXPECT_THROW(util::ParallelFor(
+                         0, 1000, 10,
+                         [](std::size_t i) {
+                             if (i == 990) throw std::runtime_error("test");
+                         },
+                         4),
+                 std::runtime_error);
+}
+
+std::size_t Fibonacci(std::size_t n) {
+    if (n < 2) return n;
+    std::size_t a;
+    std::size_t b;
+    util::TaskGroup group;
+    group.Run([&a, n]() { a = Fibonacci(n - 1); });
+    b = Fibonacci(n - 2);
+    group.Wait();
+    return a + b;
+}
+
+TEST(TaskScheduler, NestedGroups) {
+    util::TaskScheduler::Global().Reserve(4);
+    EXPECT_EQ(Fibonacci(20), 6765u);
+}
+
+TEST(TaskScheduler, WaitRunsOnlyTasksOfItsGroup) {
+    util::TaskScheduler::Global().Reserve(2);
+    std::thread::id const waiting_thread = std::this_thread::get_id();
+    std::atomic<bool> waiting = false;
+    std::atomic<int> run_by_waiting_thread = 0;
+    util::TaskGroup other;
+    for (int i = 0; i < 100; ++i) {
+        other.Run([&]() {
+            if (waiting && std::this_thread::get_id() == waiting_thread) ++run_by_waiting_thread;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        });
+    }
+    util::TaskGroup group;
+    std::atomic<int> num_run = 0;
+    for (int i = 0; i < 10; ++i) {
+        group.Run([&num_run]() { ++num_run; });
+    }
+    waiting = true;
+    group.Wait();
+    waiting = false;
+    EXPECT_EQ(num_run, 10);
+    EXPECT_EQ(run_by_waiting_thread, 0);
+    other.Wait();
+}
+
 }  // namespace tests